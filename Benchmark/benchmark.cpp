@@ -0,0 +1,180 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <benchmark.hpp>
+
+#include <qle/version.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+namespace ore {
+namespace bench {
+
+namespace {
+
+Real secondsSince(const std::chrono::steady_clock::time_point& start) {
+    return std::chrono::duration<Real>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string escape(const std::string& s) {
+    std::ostringstream os;
+    for (char c : s) {
+        switch (c) {
+        case '"':
+            os << "\\\"";
+            break;
+        case '\\':
+            os << "\\\\";
+            break;
+        case '\n':
+            os << "\\n";
+            break;
+        case '\r':
+            os << "\\r";
+            break;
+        case '\t':
+            os << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+            else
+                os << c;
+        }
+    }
+    return os.str();
+}
+
+std::string quoted(const std::string& s) { return "\"" + escape(s) + "\""; }
+
+std::string timestamp() {
+    std::time_t t = std::time(nullptr);
+    std::tm tm = *std::gmtime(&t);
+    std::ostringstream os;
+    os << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+    return os.str();
+}
+
+std::string compiler() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+} // namespace
+
+BenchmarkResult runBenchmark(const Benchmark& benchmark, const BenchmarkConfig& config) {
+    BenchmarkResult result;
+    result.name = benchmark.name;
+    result.group = benchmark.group;
+    try {
+        auto start = std::chrono::steady_clock::now();
+        std::function<Size()> run = benchmark.setup(config);
+        result.setupTime = secondsSince(start);
+        for (Size i = 0; i < config.warmup; ++i)
+            run();
+        for (Size i = 0; i < std::max<Size>(config.repetitions, 1); ++i) {
+            start = std::chrono::steady_clock::now();
+            result.operations = run();
+            result.times.push_back(secondsSince(start));
+        }
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error = e.what();
+        return result;
+    }
+
+    std::vector<Real> sorted(result.times);
+    std::sort(sorted.begin(), sorted.end());
+    Size n = sorted.size();
+    result.min = sorted.front();
+    result.max = sorted.back();
+    result.median = n % 2 == 1 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+    result.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / n;
+    Real var = 0.0;
+    for (auto t : sorted)
+        var += (t - result.mean) * (t - result.mean);
+    result.stdDev = n > 1 ? std::sqrt(var / (n - 1)) : 0.0;
+    return result;
+}
+
+void writeJson(std::ostream& os, const BenchmarkConfig& config, const std::vector<BenchmarkResult>& results) {
+    os << std::setprecision(9);
+    os << "{\n";
+    os << "  \"context\": {\n";
+    os << "    \"oreVersion\": " << quoted(OPEN_SOURCE_RISK_VERSION) << ",\n";
+    os << "    \"timestamp\": " << quoted(timestamp()) << ",\n";
+    os << "    \"compiler\": " << quoted(compiler()) << ",\n";
+#ifdef NDEBUG
+    os << "    \"buildType\": \"release\",\n";
+#else
+    os << "    \"buildType\": \"debug\",\n";
+#endif
+    os << "    \"hardwareConcurrency\": " << std::thread::hardware_concurrency() << ",\n";
+    os << "    \"size\": " << config.size << ",\n";
+    os << "    \"trades\": " << config.trades << ",\n";
+    os << "    \"samples\": " << config.samples << ",\n";
+    os << "    \"repetitions\": " << config.repetitions << ",\n";
+    os << "    \"warmup\": " << config.warmup << ",\n";
+    os << "    \"seed\": " << config.seed << "\n";
+    os << "  },\n";
+    os << "  \"benchmarks\": [";
+    for (Size i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        os << (i == 0 ? "\n" : ",\n");
+        os << "    {\n";
+        os << "      \"name\": " << quoted(r.name) << ",\n";
+        os << "      \"group\": " << quoted(r.group) << ",\n";
+        os << "      \"success\": " << (r.success ? "true" : "false") << ",\n";
+        if (!r.success) {
+            os << "      \"error\": " << quoted(r.error) << "\n";
+        } else {
+            os << "      \"operations\": " << r.operations << ",\n";
+            os << "      \"setupTime\": " << r.setupTime << ",\n";
+            os << "      \"min\": " << r.min << ",\n";
+            os << "      \"max\": " << r.max << ",\n";
+            os << "      \"mean\": " << r.mean << ",\n";
+            os << "      \"median\": " << r.median << ",\n";
+            os << "      \"stdDev\": " << r.stdDev << ",\n";
+            os << "      \"nsPerOperation\": " << (r.operations > 0 ? 1E9 * r.median / r.operations : 0.0) << ",\n";
+            os << "      \"times\": [";
+            for (Size j = 0; j < r.times.size(); ++j)
+                os << (j == 0 ? "" : ", ") << r.times[j];
+            os << "]\n";
+        }
+        os << "    }";
+    }
+    os << (results.empty() ? "]\n" : "\n  ]\n");
+    os << "}\n";
+}
+
+} // namespace bench
+} // namespace ore
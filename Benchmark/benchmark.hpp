@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file benchmark.hpp
+    \brief Minimal benchmark harness for ore-bench
+*/
+
+#pragma once
+
+#include <ql/types.hpp>
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ore {
+namespace bench {
+using QuantLib::Real;
+using QuantLib::Size;
+
+//! Settings shared by all benchmarks, all data is generated from the given seed
+struct BenchmarkConfig {
+    //! problem size of the micro benchmarks (e.g. number of paths, cube samples, CRIF records)
+    Size size = 10000;
+    //! number of trades in the synthetic portfolios of the macro benchmarks
+    Size trades = 100;
+    //! number of Monte Carlo samples in the macro benchmarks
+    Size samples = 100;
+    //! number of timed repetitions
+    Size repetitions = 5;
+    //! number of untimed warmup runs
+    Size warmup = 1;
+    //! seed of the random number generators used to build the benchmark data
+    unsigned long seed = 42;
+    //! root of the Examples directory, the market data and configuration files are taken from there
+    std::string examplesDir;
+    //! scratch directory for generated input and the output of the macro benchmarks
+    std::string workDir;
+};
+
+/*! A benchmark case: setup builds the benchmark data and returns the function to be timed. The timed function
+    returns the number of operations it performed, which is used to report the time per operation. */
+struct Benchmark {
+    std::string name;
+    std::string group;
+    std::string description;
+    std::function<std::function<Size()>(const BenchmarkConfig&)> setup;
+};
+
+//! Timing statistics of a benchmark run, times are in seconds
+struct BenchmarkResult {
+    std::string name;
+    std::string group;
+    Size operations = 0;
+    Real setupTime = 0.0;
+    std::vector<Real> times;
+    Real min = 0.0, max = 0.0, mean = 0.0, median = 0.0, stdDev = 0.0;
+    bool success = true;
+    std::string error;
+};
+
+//! The micro benchmarks of single building blocks
+std::vector<Benchmark> microBenchmarks();
+
+//! The macro benchmarks driving OREApp on synthetic portfolios
+std::vector<Benchmark> macroBenchmarks();
+
+//! Set up and run a benchmark, errors are caught and reported in the result
+BenchmarkResult runBenchmark(const Benchmark& benchmark, const BenchmarkConfig& config);
+
+//! Write the results as JSON
+void writeJson(std::ostream& os, const BenchmarkConfig& config, const std::vector<BenchmarkResult>& results);
+
+} // namespace bench
+} // namespace ore
@@ -0,0 +1,244 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <benchmark.hpp>
+
+#include <orea/app/oreapp.hpp>
+#include <orea/app/parameters.hpp>
+
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <regex>
+#include <sstream>
+
+using namespace QuantLib;
+using namespace ore::analytics;
+
+namespace ore {
+namespace bench {
+
+namespace {
+
+void writeFile(const std::string& fileName, const std::string& content) {
+    std::ofstream os(fileName);
+    QL_REQUIRE(os.is_open(), "could not open '" << fileName << "' for writing");
+    os << content;
+    QL_REQUIRE(!os.fail(), "error while writing '" << fileName << "'");
+}
+
+std::string readFile(const std::string& fileName) {
+    std::ifstream is(fileName);
+    QL_REQUIRE(is.is_open(), "could not open '" << fileName << "'");
+    std::ostringstream os;
+    os << is.rdbuf();
+    return os.str();
+}
+
+std::string legData(const std::string& legType, bool payer, const std::string& ccy, Real notional,
+                    const std::string& dayCounter, const std::string& legSpecific, const std::string& endDate,
+                    const std::string& tenor, const std::string& calendar) {
+    std::ostringstream os;
+    os << "      <LegData>\n"
+       << "        <LegType>" << legType << "</LegType>\n"
+       << "        <Payer>" << (payer ? "true" : "false") << "</Payer>\n"
+       << "        <Currency>" << ccy << "</Currency>\n"
+       << "        <Notionals><Notional>" << notional << "</Notional></Notionals>\n"
+       << "        <DayCounter>" << dayCounter << "</DayCounter>\n"
+       << "        <PaymentConvention>MF</PaymentConvention>\n"
+       << legSpecific
+       << "        <ScheduleData>\n"
+       << "          <Rules>\n"
+       << "            <StartDate>20160301</StartDate>\n"
+       << "            <EndDate>" << endDate << "</EndDate>\n"
+       << "            <Tenor>" << tenor << "</Tenor>\n"
+       << "            <Calendar>" << calendar << "</Calendar>\n"
+       << "            <Convention>MF</Convention>\n"
+       << "            <TermConvention>MF</TermConvention>\n"
+       << "            <Rule>Forward</Rule>\n"
+       << "          </Rules>\n"
+       << "        </ScheduleData>\n"
+       << "      </LegData>\n";
+    return os.str();
+}
+
+// a portfolio of forward starting EUR and USD vanilla swaps in netting set CPTY_A
+std::string syntheticPortfolio(const BenchmarkConfig& config) {
+    MersenneTwisterUniformRng rng(config.seed);
+    std::ostringstream os;
+    os.precision(10);
+    os << "<?xml version=\"1.0\"?>\n<Portfolio>\n";
+    for (Size i = 0; i < config.trades; ++i) {
+        bool eur = i % 2 == 0;
+        std::string ccy = eur ? "EUR" : "USD";
+        std::string calendar = eur ? "TARGET" : "US";
+        Size years = 1 + static_cast<Size>(rng.nextReal() * 30.0) % 30;
+        Real notional = 1.0E6 * (1 + static_cast<Size>(rng.nextReal() * 10.0) % 10);
+        Real rate = 0.005 + 0.035 * rng.nextReal();
+        bool payer = rng.nextReal() < 0.5;
+        std::string endDate = std::to_string(2016 + years) + "0301";
+        std::ostringstream fixed, floating;
+        fixed.precision(10);
+        fixed << "        <FixedLegData><Rates><Rate>" << rate << "</Rate></Rates></FixedLegData>\n";
+        floating << "        <FloatingLegData>\n"
+                 << "          <Index>" << (eur ? "EUR-EURIBOR-6M" : "USD-LIBOR-3M") << "</Index>\n"
+                 << "          <Spreads><Spread>0.0</Spread></Spreads>\n"
+                 << "          <IsInArrears>false</IsInArrears>\n"
+                 << "          <FixingDays>2</FixingDays>\n"
+                 << "        </FloatingLegData>\n";
+        os << "  <Trade id=\"Swap_" << i << "\">\n"
+           << "    <TradeType>Swap</TradeType>\n"
+           << "    <Envelope>\n"
+           << "      <CounterParty>CPTY_A</CounterParty>\n"
+           << "      <NettingSetId>CPTY_A</NettingSetId>\n"
+           << "      <AdditionalFields/>\n"
+           << "    </Envelope>\n"
+           << "    <SwapData>\n"
+           << legData("Fixed", payer, ccy, notional, "30/360", fixed.str(), endDate, eur ? "1Y" : "6M", calendar)
+           << legData("Floating", !payer, ccy, notional, "A360", floating.str(), endDate, eur ? "6M" : "3M",
+                      calendar)
+           << "    </SwapData>\n"
+           << "  </Trade>\n";
+    }
+    os << "</Portfolio>\n";
+    return os.str();
+}
+
+/* Write the ore.xml for the given analytics section into a fresh directory under the work directory. The market
+   data and configuration is taken from the examples, the portfolio is synthetic. */
+std::string writeInputs(const BenchmarkConfig& config, const std::string& name, const std::string& analytics) {
+    boost::filesystem::path dir = boost::filesystem::absolute(boost::filesystem::path(config.workDir) / name);
+    boost::filesystem::path output = dir / "Output";
+    boost::filesystem::create_directories(output);
+    std::string examples = boost::filesystem::absolute(config.examplesDir).generic_string();
+    std::string input = examples + "/Input/";
+
+    writeFile((dir / "portfolio.xml").string(), syntheticPortfolio(config));
+
+    // the Example_1 simulation with the configured number of samples
+    std::string simulation = readFile(examples + "/Example_1/Input/simulation.xml");
+    simulation = std::regex_replace(simulation, std::regex("<Samples>[0-9]+</Samples>"),
+                                    "<Samples>" + std::to_string(config.samples) + "</Samples>");
+    writeFile((dir / "simulation.xml").string(), simulation);
+
+    std::ostringstream os;
+    os << "<?xml version=\"1.0\"?>\n"
+       << "<ORE>\n"
+       << "  <Setup>\n"
+       << "    <Parameter name=\"asofDate\">2016-02-05</Parameter>\n"
+       << "    <Parameter name=\"inputPath\">" << dir.generic_string() << "</Parameter>\n"
+       << "    <Parameter name=\"outputPath\">" << output.generic_string() << "</Parameter>\n"
+       << "    <Parameter name=\"logFile\">log.txt</Parameter>\n"
+       << "    <Parameter name=\"logMask\">1</Parameter>\n"
+       << "    <Parameter name=\"marketDataFile\">" << input << "market_20160205_flat.txt</Parameter>\n"
+       << "    <Parameter name=\"fixingDataFile\">" << input << "fixings_20160205.txt</Parameter>\n"
+       << "    <Parameter name=\"implyTodaysFixings\">Y</Parameter>\n"
+       << "    <Parameter name=\"curveConfigFile\">" << input << "curveconfig.xml</Parameter>\n"
+       << "    <Parameter name=\"conventionsFile\">" << input << "conventions.xml</Parameter>\n"
+       << "    <Parameter name=\"marketConfigFile\">" << input << "todaysmarket.xml</Parameter>\n"
+       << "    <Parameter name=\"pricingEnginesFile\">" << input << "pricingengine.xml</Parameter>\n"
+       << "    <Parameter name=\"portfolioFile\">portfolio.xml</Parameter>\n"
+       << "    <Parameter name=\"observationModel\">None</Parameter>\n"
+       << "    <Parameter name=\"continueOnError\">false</Parameter>\n"
+       << "    <Parameter name=\"calendarAdjustment\">" << input << "calendaradjustment.xml</Parameter>\n"
+       << "    <Parameter name=\"currencyConfiguration\">" << input << "currencies.xml</Parameter>\n"
+       << "  </Setup>\n"
+       << "  <Markets>\n"
+       << "    <Parameter name=\"lgmcalibration\">libor</Parameter>\n"
+       << "    <Parameter name=\"fxcalibration\">libor</Parameter>\n"
+       << "    <Parameter name=\"eqcalibration\">libor</Parameter>\n"
+       << "    <Parameter name=\"pricing\">libor</Parameter>\n"
+       << "    <Parameter name=\"simulation\">libor</Parameter>\n"
+       << "  </Markets>\n"
+       << "  <Analytics>\n"
+       << analytics
+       << "  </Analytics>\n"
+       << "</ORE>\n";
+    std::string oreXml = (dir / "ore.xml").string();
+    writeFile(oreXml, os.str());
+
+    // the netting set definitions of Example_1 cover CPTY_A
+    writeFile((dir / "netting.xml").string(), readFile(examples + "/Example_1/Input/netting.xml"));
+    return oreXml;
+}
+
+std::function<Size()> oreAppRun(const BenchmarkConfig& config, const std::string& name,
+                                const std::string& analytics) {
+    std::string oreXml = writeInputs(config, name, analytics);
+    Size trades = config.trades;
+    return [oreXml, trades]() {
+        auto params = QuantLib::ext::make_shared<Parameters>();
+        params->fromFile(oreXml);
+        OREApp app(params, false);
+        app.run();
+        return trades;
+    };
+}
+
+const std::string npvAnalytics = "    <Analytic type=\"npv\">\n"
+                                  "      <Parameter name=\"active\">Y</Parameter>\n"
+                                  "      <Parameter name=\"baseCurrency\">EUR</Parameter>\n"
+                                  "      <Parameter name=\"outputFileName\">npv.csv</Parameter>\n"
+                                  "    </Analytic>\n"
+                                  "    <Analytic type=\"cashflow\">\n"
+                                  "      <Parameter name=\"active\">Y</Parameter>\n"
+                                  "      <Parameter name=\"outputFileName\">flows.csv</Parameter>\n"
+                                  "    </Analytic>\n";
+
+const std::string exposureAnalytics = "    <Analytic type=\"simulation\">\n"
+                                       "      <Parameter name=\"active\">Y</Parameter>\n"
+                                       "      <Parameter name=\"simulationConfigFile\">simulation.xml</Parameter>\n"
+                                       "      <Parameter name=\"baseCurrency\">EUR</Parameter>\n"
+                                       "      <Parameter name=\"observationModel\">Disable</Parameter>\n"
+                                       "      <Parameter name=\"cubeFile\">cube.csv.gz</Parameter>\n"
+                                       "      <Parameter name=\"aggregationScenarioDataFileName\">"
+                                       "scenariodata.csv.gz</Parameter>\n"
+                                       "    </Analytic>\n"
+                                       "    <Analytic type=\"xva\">\n"
+                                       "      <Parameter name=\"active\">Y</Parameter>\n"
+                                       "      <Parameter name=\"csaFile\">netting.xml</Parameter>\n"
+                                       "      <Parameter name=\"cubeFile\">cube.csv.gz</Parameter>\n"
+                                       "      <Parameter name=\"scenarioFile\">scenariodata.csv.gz</Parameter>\n"
+                                       "      <Parameter name=\"baseCurrency\">EUR</Parameter>\n"
+                                       "      <Parameter name=\"exposureProfiles\">Y</Parameter>\n"
+                                       "      <Parameter name=\"quantile\">0.95</Parameter>\n"
+                                       "      <Parameter name=\"calculationType\">Symmetric</Parameter>\n"
+                                       "      <Parameter name=\"allocationMethod\">None</Parameter>\n"
+                                       "      <Parameter name=\"marginalAllocationLimit\">1.0</Parameter>\n"
+                                       "      <Parameter name=\"exerciseNextBreak\">N</Parameter>\n"
+                                       "      <Parameter name=\"cva\">Y</Parameter>\n"
+                                       "      <Parameter name=\"dva\">N</Parameter>\n"
+                                       "      <Parameter name=\"fva\">N</Parameter>\n"
+                                       "      <Parameter name=\"colva\">N</Parameter>\n"
+                                       "      <Parameter name=\"collateralFloor\">N</Parameter>\n"
+                                       "    </Analytic>\n";
+
+} // namespace
+
+std::vector<Benchmark> macroBenchmarks() {
+    return {{"OREApp.npv", "macro", "npv and cashflow analytics on a synthetic portfolio of <trades> swaps",
+             [](const BenchmarkConfig& c) { return oreAppRun(c, "npv", npvAnalytics); }},
+            {"OREApp.exposure", "macro",
+             "simulation and xva analytics on a synthetic portfolio of <trades> swaps with <samples> samples",
+             [](const BenchmarkConfig& c) { return oreAppRun(c, "exposure", exposureAnalytics); }}};
+}
+
+} // namespace bench
+} // namespace ore
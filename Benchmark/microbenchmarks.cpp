@@ -0,0 +1,350 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <benchmark.hpp>
+
+#include <orea/cube/inmemorycube.hpp>
+#include <orea/scenario/scenariosimmarket.hpp>
+#include <orea/scenario/scenariosimmarketparameters.hpp>
+#include <orea/simm/crifloader.hpp>
+#include <orea/simm/simmbucketmapperbase.hpp>
+#include <orea/simm/simmcalculator.hpp>
+#include <orea/simm/utilities.hpp>
+#include <ored/configuration/conventions.hpp>
+#include <ored/configuration/curveconfigurations.hpp>
+#include <ored/marketdata/csvloader.hpp>
+#include <ored/marketdata/todaysmarket.hpp>
+#include <ored/marketdata/todaysmarketparameters.hpp>
+#include <qle/ad/computationgraph.hpp>
+#include <qle/ad/forwardevaluation.hpp>
+#include <qle/math/randomvariable.hpp>
+#include <qle/math/randomvariable_ops.hpp>
+#include <qle/models/irlgm1fconstantparametrization.hpp>
+#include <qle/models/lgmconvolutionsolver2.hpp>
+#include <qle/pricingengines/numericlgmmultilegoptionengine.hpp>
+
+#include <ql/currencies/europe.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/instruments/swaption.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/randomnumbers/inversecumulativerng.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/settings.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+
+#include <sstream>
+
+using namespace QuantLib;
+using namespace QuantExt;
+using namespace ore::data;
+using namespace ore::analytics;
+
+namespace ore {
+namespace bench {
+
+namespace {
+
+typedef InverseCumulativeRng<MersenneTwisterUniformRng, InverseCumulativeNormal> NormalRng;
+
+const Date benchmarkAsof(5, February, 2016);
+
+RandomVariable normalVariable(NormalRng& rng, Size n) {
+    RandomVariable r(n);
+    for (Size i = 0; i < n; ++i)
+        r.set(i, rng.next().value);
+    return r;
+}
+
+// market and configuration inputs of the examples, shared by the market related benchmarks
+struct ExampleInputs {
+    explicit ExampleInputs(const BenchmarkConfig& config) {
+        std::string input = config.examplesDir + "/Input/";
+        Settings::instance().evaluationDate() = benchmarkAsof;
+        auto conventions = QuantLib::ext::make_shared<Conventions>();
+        conventions->fromFile(input + "conventions.xml");
+        InstrumentConventions::instance().setConventions(conventions);
+        todaysMarketParams = QuantLib::ext::make_shared<TodaysMarketParameters>();
+        todaysMarketParams->fromFile(input + "todaysmarket.xml");
+        curveConfigs = QuantLib::ext::make_shared<CurveConfigurations>();
+        curveConfigs->fromFile(input + "curveconfig.xml");
+        loader = QuantLib::ext::make_shared<CSVLoader>(input + "market_20160205_flat.txt",
+                                                       input + "fixings_20160205.txt", true);
+        simMarketParams = QuantLib::ext::make_shared<ScenarioSimMarketParameters>();
+        simMarketParams->fromFile(config.examplesDir + "/Example_1/Input/simulation.xml");
+    }
+    QuantLib::ext::shared_ptr<TodaysMarket> market() const {
+        return QuantLib::ext::make_shared<TodaysMarket>(benchmarkAsof, todaysMarketParams, loader, curveConfigs, true);
+    }
+    QuantLib::ext::shared_ptr<TodaysMarketParameters> todaysMarketParams;
+    QuantLib::ext::shared_ptr<CurveConfigurations> curveConfigs;
+    QuantLib::ext::shared_ptr<Loader> loader;
+    QuantLib::ext::shared_ptr<ScenarioSimMarketParameters> simMarketParams;
+};
+
+// elementwise arithmetic, transcendental functions and conditionals on random variables
+std::function<Size()> randomVariableArithmetic(const BenchmarkConfig& config) {
+    NormalRng rng{MersenneTwisterUniformRng(config.seed)};
+    auto x = QuantLib::ext::make_shared<RandomVariable>(normalVariable(rng, config.size));
+    auto y = QuantLib::ext::make_shared<RandomVariable>(normalVariable(rng, config.size));
+    return [x, y]() {
+        RandomVariable one(x->size(), 1.0), half(x->size(), 0.5);
+        RandomVariable z = (*x) * (*y) + (*x) - (*y) / (abs(*x) + one);
+        z = exp(half * z) + max(*x, *y) - sqrt(abs(z));
+        z = conditionalResult(*x > *y, z, *x);
+        z = normalCdf(z) * log(abs(z) + one);
+        return 14 * x->size();
+    };
+}
+
+// forward evaluation of a computation graph pricing a strip of call options on random variables
+std::function<Size()> computationGraphForwardEvaluation(const BenchmarkConfig& config) {
+    auto g = QuantLib::ext::make_shared<ComputationGraph>();
+    Size nUnderlyings = 10, nStrikes = 20;
+    std::vector<std::size_t> payoffs;
+    for (Size i = 0; i < nUnderlyings; ++i) {
+        auto s = cg_var(*g, "S_" + std::to_string(i), ComputationGraph::VarDoesntExist::Create);
+        auto fwd = cg_mult(*g, cg_exp(*g, cg_mult(*g, s, cg_const(*g, 0.2))), cg_const(*g, 100.0));
+        for (Size k = 0; k < nStrikes; ++k) {
+            auto call = cg_max(*g, cg_subtract(*g, fwd, cg_const(*g, 80.0 + 2.0 * k)), cg_const(*g, 0.0));
+            payoffs.push_back(cg_mult(*g, call, cg_const(*g, std::exp(-0.01 * i))));
+        }
+    }
+    cg_add(*g, payoffs);
+
+    Size n = config.size;
+    NormalRng rng{MersenneTwisterUniformRng(config.seed)};
+    auto values = QuantLib::ext::make_shared<std::vector<RandomVariable>>(g->size(), RandomVariable(n));
+    for (auto const& v : g->variables())
+        (*values)[v.second] = normalVariable(rng, n);
+    for (auto const& c : g->constants())
+        (*values)[c.second] = RandomVariable(n, c.first);
+    auto ops = getRandomVariableOps(n);
+
+    return [g, values, ops, n]() {
+        forwardEvaluation(*g, *values, ops);
+        return g->size() * n;
+    };
+}
+
+// set and get all entries of an in memory npv cube
+template <class Cube> std::function<Size()> cubeAccess(const BenchmarkConfig& config, bool set) {
+    Size nIds = 100, nDates = 50, nSamples = std::max<Size>(config.size / 100, 1);
+    std::set<std::string> ids;
+    for (Size i = 0; i < nIds; ++i)
+        ids.insert("Trade_" + std::to_string(i));
+    std::vector<Date> dates;
+    for (Size j = 0; j < nDates; ++j)
+        dates.push_back(benchmarkAsof + static_cast<Integer>(j + 1) * Months);
+    auto cube = QuantLib::ext::make_shared<Cube>(benchmarkAsof, ids, dates, nSamples, 1);
+    MersenneTwisterUniformRng rng(config.seed);
+    for (Size i = 0; i < nIds; ++i)
+        for (Size j = 0; j < nDates; ++j)
+            for (Size k = 0; k < nSamples; ++k)
+                cube->set(rng.nextReal(), i, j, k);
+
+    if (set) {
+        return [cube, nIds, nDates, nSamples]() {
+            for (Size i = 0; i < nIds; ++i)
+                for (Size j = 0; j < nDates; ++j)
+                    for (Size k = 0; k < nSamples; ++k)
+                        cube->set(static_cast<Real>(i + j + k), i, j, k);
+            return nIds * nDates * nSamples;
+        };
+    }
+    return [cube, nIds, nDates, nSamples]() {
+        Real sum = 0.0;
+        for (Size i = 0; i < nIds; ++i)
+            for (Size j = 0; j < nDates; ++j)
+                for (Size k = 0; k < nSamples; ++k)
+                    sum += cube->get(i, j, k);
+        QL_REQUIRE(sum == sum, "cube sum is not a number");
+        return nIds * nDates * nSamples;
+    };
+}
+
+// build the example market
+std::function<Size()> todaysMarketBuild(const BenchmarkConfig& config) {
+    auto inputs = QuantLib::ext::make_shared<ExampleInputs>(config);
+    return [inputs]() {
+        inputs->market();
+        return Size(1);
+    };
+}
+
+// apply randomly perturbed scenarios to a simulation market built on the example market
+std::function<Size()> scenarioSimMarketApplyScenario(const BenchmarkConfig& config, bool cacheSimData) {
+    ExampleInputs inputs(config);
+    auto simMarket = QuantLib::ext::make_shared<ScenarioSimMarket>(
+        inputs.market(), inputs.simMarketParams, Market::defaultConfiguration, *inputs.curveConfigs,
+        *inputs.todaysMarketParams, true, false, cacheSimData);
+
+    Size nScenarios = 10;
+    auto scenarios = QuantLib::ext::make_shared<std::vector<QuantLib::ext::shared_ptr<Scenario>>>();
+    NormalRng rng{MersenneTwisterUniformRng(config.seed)};
+    for (Size i = 0; i < nScenarios; ++i) {
+        auto s = simMarket->baseScenario()->clone();
+        for (auto const& k : s->keys())
+            s->add(k, s->get(k) * (1.0 + 0.001 * rng.next().value));
+        scenarios->push_back(s);
+    }
+
+    Size n = std::max<Size>(config.size / 100, nScenarios);
+    return [simMarket, scenarios, n]() {
+        for (Size i = 0; i < n; ++i)
+            simMarket->applyScenario((*scenarios)[i % scenarios->size()]);
+        return n;
+    };
+}
+
+// load the example market data and fixings file
+std::function<Size()> csvLoaderLoad(const BenchmarkConfig& config) {
+    std::string input = config.examplesDir + "/Input/";
+    return [input]() {
+        CSVLoader loader(input + "market_20160205.txt", input + "fixings_20160205.txt", false);
+        return loader.loadQuotes(benchmarkAsof).size() + loader.loadFixings().size();
+    };
+}
+
+// a synthetic CRIF with interest rate delta and fx delta sensitivities over a number of portfolios
+std::string syntheticCrif(const BenchmarkConfig& config) {
+    static const std::vector<std::string> tenors = {"2w", "1m", "3m",  "6m",  "1y",  "2y",
+                                                    "3y", "5y", "10y", "15y", "20y", "30y"};
+    static const std::vector<std::string> indices = {"OIS", "Libor3m", "Libor6m"};
+    static const std::vector<std::pair<std::string, std::string>> currencies = {
+        {"USD", "1"}, {"EUR", "1"}, {"GBP", "1"}, {"JPY", "2"}};
+    Size nPortfolios = 10;
+    MersenneTwisterUniformRng rng(config.seed);
+    std::ostringstream os;
+    os << "TradeID,PortfolioID,ProductClass,RiskType,Qualifier,Bucket,Label1,Label2,AmountCurrency,Amount,AmountUSD,"
+          "IMModel,collect_regulations,post_regulations\n";
+    for (Size i = 0; i < config.size; ++i) {
+        std::string trade = "Trade_" + std::to_string(i / 20);
+        std::string portfolio = "Portfolio_" + std::to_string((i / 20) % nPortfolios);
+        Real amount = 10000.0 * (rng.nextReal() - 0.5);
+        auto const& ccy = currencies[static_cast<Size>(rng.nextReal() * currencies.size()) % currencies.size()];
+        os << trade << "," << portfolio << ",RatesFX,";
+        if (i % 10 == 9)
+            os << "Risk_FX," << ccy.first << ",,,,";
+        else
+            os << "Risk_IRCurve," << ccy.first << "," << ccy.second << ","
+               << tenors[static_cast<Size>(rng.nextReal() * tenors.size()) % tenors.size()] << ","
+               << indices[static_cast<Size>(rng.nextReal() * indices.size()) % indices.size()] << ",";
+        os << "USD," << amount << "," << amount << ",SIMM,SEC,SEC\n";
+    }
+    return os.str();
+}
+
+QuantLib::ext::shared_ptr<SimmConfiguration> simmConfiguration() {
+    return buildSimmConfiguration("2.6", QuantLib::ext::make_shared<SimmBucketMapperBase>());
+}
+
+// parse a synthetic CRIF
+std::function<Size()> crifLoad(const BenchmarkConfig& config) {
+    auto crif = QuantLib::ext::make_shared<std::string>(syntheticCrif(config));
+    auto simmConfig = simmConfiguration();
+    return [crif, simmConfig]() {
+        CsvBufferCrifLoader loader(*crif, simmConfig, CrifRecord::additionalHeaders, true, false, '\n', ',', '"');
+        return loader.loadCrif().size();
+    };
+}
+
+// SIMM on a synthetic CRIF
+std::function<Size()> simmCalculation(const BenchmarkConfig& config) {
+    auto simmConfig = simmConfiguration();
+    CsvBufferCrifLoader loader(syntheticCrif(config), simmConfig, CrifRecord::additionalHeaders, true, false, '\n',
+                               ',', '"');
+    auto crif = QuantLib::ext::make_shared<Crif>(loader.loadCrif());
+    return [crif, simmConfig]() {
+        SimmCalculator simm(*crif, simmConfig, "USD", "USD", "USD", nullptr, true, false, true);
+        return crif->size();
+    };
+}
+
+// 20y bermudan swaptions priced with the LGM convolution solver on the fine grids used for sensitivities
+std::function<Size()> lgmBermudanSwaptions(const BenchmarkConfig& config, LgmConvolutionSolver2::Method method) {
+    Settings::instance().evaluationDate() = benchmarkAsof;
+    Handle<YieldTermStructure> yts(QuantLib::ext::make_shared<FlatForward>(benchmarkAsof, 0.02, Actual365Fixed()));
+    auto euribor6m = QuantLib::ext::make_shared<Euribor>(6 * Months, yts);
+    auto lgm = QuantLib::ext::make_shared<LinearGaussMarkovModel>(
+        QuantLib::ext::make_shared<IrLgm1fConstantParametrization>(EURCurrency(), yts, 0.0070, 0.03));
+    auto engine = QuantLib::ext::make_shared<NumericLgmSwaptionEngine>(lgm, 7.0, 32, 7.0, 64, yts, 24, method);
+
+    Size n = std::max<Size>(config.size / 1000, 1);
+    auto swaptions = QuantLib::ext::make_shared<std::vector<QuantLib::ext::shared_ptr<QuantLib::Swaption>>>();
+    for (Size i = 0; i < n; ++i) {
+        Real strike = 0.01 + 0.02 * static_cast<Real>(i) / static_cast<Real>(n);
+        QuantLib::ext::shared_ptr<VanillaSwap> swap = MakeVanillaSwap(20 * Years, euribor6m, strike, 1 * Years)
+                                                          .withFixedLegTenor(1 * Years)
+                                                          .withNominal(1.0);
+        std::vector<Date> exerciseDates;
+        for (Size j = 1; j < swap->fixedSchedule().size() - 1; ++j)
+            exerciseDates.push_back(TARGET().advance(swap->fixedSchedule()[j], -2 * Days));
+        swaptions->push_back(QuantLib::ext::make_shared<QuantLib::Swaption>(
+            swap, QuantLib::ext::make_shared<BermudanExercise>(exerciseDates)));
+        swaptions->back()->setPricingEngine(engine);
+    }
+
+    return [swaptions]() {
+        for (auto const& s : *swaptions)
+            s->recalculate();
+        return swaptions->size();
+    };
+}
+
+} // namespace
+
+std::vector<Benchmark> microBenchmarks() {
+    return {
+        {"RandomVariable.arithmetic", "micro", "elementwise operations on random variables of <size> paths",
+         randomVariableArithmetic},
+        {"ComputationGraph.forwardEvaluation", "micro",
+         "forward evaluation of a 200 option payoff graph on random variables of <size> paths",
+         computationGraphForwardEvaluation},
+        {"InMemoryCube.set", "micro", "set all entries of a double precision cube with 100 x 50 x <size>/100 cells",
+         [](const BenchmarkConfig& c) { return cubeAccess<DoublePrecisionInMemoryCubeN>(c, true); }},
+        {"InMemoryCube.get", "micro", "get all entries of a double precision cube with 100 x 50 x <size>/100 cells",
+         [](const BenchmarkConfig& c) { return cubeAccess<DoublePrecisionInMemoryCubeN>(c, false); }},
+        {"SinglePrecisionInMemoryCube.set", "micro",
+         "set all entries of a single precision cube with 100 x 50 x <size>/100 cells",
+         [](const BenchmarkConfig& c) { return cubeAccess<SinglePrecisionInMemoryCubeN>(c, true); }},
+        {"SinglePrecisionInMemoryCube.get", "micro",
+         "get all entries of a single precision cube with 100 x 50 x <size>/100 cells",
+         [](const BenchmarkConfig& c) { return cubeAccess<SinglePrecisionInMemoryCubeN>(c, false); }},
+        {"CSVLoader.load", "micro", "load the example market data and fixings files", csvLoaderLoad},
+        {"CrifLoader.load", "micro", "parse a synthetic CRIF with <size> records", crifLoad},
+        {"SimmCalculator.calculate", "micro", "SIMM 2.6 on a synthetic CRIF with <size> records", simmCalculation},
+        {"NumericLgmSwaptionEngine.direct", "micro",
+         "price max(<size>/1000, 1) 20y bermudan swaptions, direct convolution rollback",
+         [](const BenchmarkConfig& c) { return lgmBermudanSwaptions(c, LgmConvolutionSolver2::Method::Direct); }},
+        {"NumericLgmSwaptionEngine.fft", "micro",
+         "price max(<size>/1000, 1) 20y bermudan swaptions, FFT convolution rollback",
+         [](const BenchmarkConfig& c) { return lgmBermudanSwaptions(c, LgmConvolutionSolver2::Method::FFT); }},
+        {"TodaysMarket.build", "micro", "build the example market", todaysMarketBuild},
+        {"ScenarioSimMarket.applyScenario", "micro",
+         "apply max(<size>/100, 10) scenarios to the Example_1 simulation market",
+         [](const BenchmarkConfig& c) { return scenarioSimMarketApplyScenario(c, false); }},
+        {"ScenarioSimMarket.applyScenarioCached", "micro",
+         "apply max(<size>/100, 10) scenarios to the Example_1 simulation market with cached sim data",
+         [](const BenchmarkConfig& c) { return scenarioSimMarketApplyScenario(c, true); }}};
+}
+
+} // namespace bench
+} // namespace ore
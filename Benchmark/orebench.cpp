@@ -0,0 +1,187 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#ifdef BOOST_MSVC
+// disable warning C4503: '__LINE__Var': decorated name length exceeded, name was truncated
+#pragma warning(disable : 4503)
+#endif
+
+#include <benchmark.hpp>
+
+#include <orea/app/initbuilders.hpp>
+
+#include <qle/version.hpp>
+
+#include <ql/errors.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <regex>
+
+#ifdef BOOST_MSVC
+#include <orea/auto_link.hpp>
+#include <ored/auto_link.hpp>
+#include <ql/auto_link.hpp>
+#include <qle/auto_link.hpp>
+// Find the name of the correct boost library with which to link.
+#define BOOST_LIB_NAME boost_regex
+#include <boost/config/auto_link.hpp>
+#define BOOST_LIB_NAME boost_serialization
+#include <boost/config/auto_link.hpp>
+#define BOOST_LIB_NAME boost_date_time
+#include <boost/config/auto_link.hpp>
+#define BOOST_LIB_NAME boost_filesystem
+#include <boost/config/auto_link.hpp>
+#define BOOST_LIB_NAME boost_system
+#include <boost/config/auto_link.hpp>
+#define BOOST_LIB_NAME boost_timer
+#include <boost/config/auto_link.hpp>
+#define BOOST_LIB_NAME boost_chrono
+#include <boost/config/auto_link.hpp>
+#endif
+
+#ifndef ORE_BENCH_EXAMPLES_DIR
+#define ORE_BENCH_EXAMPLES_DIR "Examples"
+#endif
+
+using namespace std;
+using namespace ore::bench;
+
+namespace {
+
+void usage() {
+    cout << "usage: ore-bench [options]\n\n"
+         << "  --list              list the benchmarks and exit\n"
+         << "  --filter <regex>    run the benchmarks whose name or group matches <regex>\n"
+         << "  --size <n>          problem size of the micro benchmarks (default 10000)\n"
+         << "  --trades <n>        number of trades in the macro benchmark portfolios (default 100)\n"
+         << "  --samples <n>       number of Monte Carlo samples in the macro benchmarks (default 100)\n"
+         << "  --repetitions <n>   number of timed repetitions (default 5)\n"
+         << "  --warmup <n>        number of untimed warmup runs (default 1)\n"
+         << "  --seed <n>          seed for the generated benchmark data (default 42)\n"
+         << "  --examples <dir>    ORE Examples directory providing the market data and configuration\n"
+         << "  --workdir <dir>     scratch directory for generated inputs and outputs\n"
+         << "  --output <file>     write the JSON results to <file> instead of stdout\n"
+         << endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+
+    BenchmarkConfig config;
+    config.examplesDir = ORE_BENCH_EXAMPLES_DIR;
+    string filter, output;
+    bool list = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            string arg(argv[i]);
+            auto value = [&i, argc, argv, &arg]() {
+                QL_REQUIRE(i + 1 < argc, "missing value for option " << arg);
+                return string(argv[++i]);
+            };
+            if (arg == "-h" || arg == "--help") {
+                usage();
+                return 0;
+            } else if (arg == "-v" || arg == "--version") {
+                cout << "ORE version " << OPEN_SOURCE_RISK_VERSION << endl;
+                return 0;
+            } else if (arg == "--list")
+                list = true;
+            else if (arg == "--filter")
+                filter = value();
+            else if (arg == "--size")
+                config.size = stoul(value());
+            else if (arg == "--trades")
+                config.trades = stoul(value());
+            else if (arg == "--samples")
+                config.samples = stoul(value());
+            else if (arg == "--repetitions")
+                config.repetitions = stoul(value());
+            else if (arg == "--warmup")
+                config.warmup = stoul(value());
+            else if (arg == "--seed")
+                config.seed = stoul(value());
+            else if (arg == "--examples")
+                config.examplesDir = value();
+            else if (arg == "--workdir")
+                config.workDir = value();
+            else if (arg == "--output")
+                output = value();
+            else
+                QL_FAIL("unknown option " << arg);
+        }
+    } catch (const exception& e) {
+        cerr << "ore-bench: " << e.what() << endl;
+        usage();
+        return -1;
+    }
+
+    vector<Benchmark> benchmarks = microBenchmarks();
+    for (auto const& b : macroBenchmarks())
+        benchmarks.push_back(b);
+
+    regex re(filter.empty() ? string(".*") : filter);
+    vector<Benchmark> selected;
+    for (auto const& b : benchmarks) {
+        if (regex_search(b.name, re) || regex_search(b.group, re))
+            selected.push_back(b);
+    }
+
+    if (list) {
+        for (auto const& b : selected)
+            cout << b.group << "\t" << b.name << "\t" << b.description << endl;
+        return 0;
+    }
+
+    if (config.workDir.empty())
+        config.workDir =
+            (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("ore-bench-%%%%-%%%%"))
+                .string();
+
+    ore::analytics::initBuilders();
+
+    vector<BenchmarkResult> results;
+    bool success = true;
+    for (auto const& b : selected) {
+        cerr << "running " << b.name << " ... " << flush;
+        results.push_back(runBenchmark(b, config));
+        const BenchmarkResult& r = results.back();
+        if (r.success)
+            cerr << "median " << r.median << "s over " << r.times.size() << " repetitions" << endl;
+        else
+            cerr << "failed: " << r.error << endl;
+        success = success && r.success;
+    }
+
+    if (output.empty()) {
+        writeJson(cout, config, results);
+    } else {
+        ofstream os(output);
+        if (!os.is_open()) {
+            cerr << "ore-bench: could not open " << output << endl;
+            return -1;
+        }
+        writeJson(os, config, results);
+    }
+
+    return success ? 0 : 1;
+}
@@ -70,6 +70,10 @@ ExposureCalculator::ExposureCalculator(
 }
 
 void ExposureCalculator::build() {
+    if (auto streamingCube = QuantLib::ext::dynamic_pointer_cast<StreamingNPVCube>(cube_)) {
+        buildFromNettingSetCube(streamingCube);
+        return;
+    }
     LOG("Compute trade exposure profiles, " << (flipViewXVA_ ? "inverted (flipViewXVA = Y)" : "regular (flipViewXVA = N)"));
     size_t i = 0;
     for (auto tradeIt = portfolio_->trades().begin(); tradeIt != portfolio_->trades().end(); ++tradeIt, ++i) {
@@ -216,6 +220,50 @@ void ExposureCalculator::build() {
     }
 }
 
+void ExposureCalculator::buildFromNettingSetCube(const QuantLib::ext::shared_ptr<StreamingNPVCube>& cube) {
+    LOG("Compute netting set values from streamed netting set cube, trade exposure profiles are not available");
+    QL_REQUIRE(!exerciseNextBreak_, "ExposureCalculator: exerciseNextBreak is not supported for a streaming cube");
+    QL_REQUIRE(!multiPath_, "ExposureCalculator: multi path exposures are not supported for a streaming cube");
+
+    // trade level values are only known as of today
+    size_t i = 0;
+    for (auto tradeIt = portfolio_->trades().begin(); tradeIt != portfolio_->trades().end(); ++tradeIt, ++i) {
+        string tradeId = tradeIt->first;
+        Real npv0 = flipViewXVA_ ? -cube_->getT0(i) : cube_->getT0(i);
+        vector<Real> epe(dates_.size() + 1, 0.0);
+        epe[0] = std::max(npv0, 0.0);
+        exposureCube_->setT0(epe[0], tradeId, ExposureIndex::EPE);
+        exposureCube_->setT0(std::max(-npv0, 0.0), tradeId, ExposureIndex::ENE);
+        ee_b_[tradeId] = epe;
+        eee_b_[tradeId] = epe;
+        pfe_[tradeId] = epe;
+        epe_b_[tradeId] = 0.0;
+        eepe_b_[tradeId] = 0.0;
+    }
+
+    const QuantLib::ext::shared_ptr<NPVCube>& nettingSetCube = cube->nettingSetCube();
+    for (auto const& [nettingSetId, n] : nettingSetCube->idsAndIndexes()) {
+        LOG("Aggregate values for netting set " << nettingSetId);
+        auto& defaultValue = nettingSetDefaultValue_[nettingSetId];
+        auto& closeOutValue = nettingSetCloseOutValue_[nettingSetId];
+        auto& positiveFlow = nettingSetMporPositiveFlow_[nettingSetId];
+        auto& negativeFlow = nettingSetMporNegativeFlow_[nettingSetId];
+        defaultValue = closeOutValue = positiveFlow = negativeFlow =
+            vector<vector<Real>>(dates_.size(), vector<Real>(cube_->samples(), 0.0));
+        for (Size j = 0; j < dates_.size(); ++j) {
+            for (Size k = 0; k < cube_->samples(); ++k) {
+                defaultValue[j][k] = cubeInterpretation_->getDefaultNpv(nettingSetCube, n, j, k);
+                if (isRegularCubeStorage_ && j == dates_.size() - 1)
+                    closeOutValue[j][k] = defaultValue[j][k];
+                else
+                    closeOutValue[j][k] = cubeInterpretation_->getCloseOutNpv(nettingSetCube, n, j, k);
+                positiveFlow[j][k] = cubeInterpretation_->getMporPositiveFlows(nettingSetCube, n, j, k);
+                negativeFlow[j][k] = cubeInterpretation_->getMporNegativeFlows(nettingSetCube, n, j, k);
+            }
+        }
+    }
+}
+
 vector<Real> ExposureCalculator::getMeanExposure(const string& tid, ExposureIndex index) {
     vector<Real> exp(dates_.size() + 1, 0.0);
     exp[0] = exposureCube_->getT0(tid, index);
@@ -27,6 +27,7 @@
 #include <orea/aggregation/collatexposurehelper.hpp>
 #include <orea/cube/cubeinterpretation.hpp>
 #include <orea/cube/npvcube.hpp>
+#include <orea/cube/streamingnpvcube.hpp>
 #include <ored/portfolio/portfolio.hpp>
 
 #include <ql/shared_ptr.hpp>
@@ -74,6 +75,7 @@ public:
     virtual ~ExposureCalculator() {}
 
     //! Compute exposures along all paths and fill result structures
+    /*! If the cube is a StreamingNPVCube only the netting set values are filled, trade exposures are zero after T0 */
     virtual void build();
 
     enum ExposureIndex {
@@ -151,6 +153,7 @@ protected:
     map<string, Real> epe_b_;
     map<string, Real> eepe_b_;
     vector<Real> getMeanExposure(const string& tid, ExposureIndex index);
+    void buildFromNettingSetCube(const QuantLib::ext::shared_ptr<StreamingNPVCube>& cube);
     bool flipViewXVA_;
 };
 
@@ -25,6 +25,7 @@
 #include <orea/aggregation/staticcreditxvacalculator.hpp>
 #include <orea/aggregation/cvaspreadsensitivitycalculator.hpp>
 #include <ored/utilities/log.hpp>
+#include <ored/utilities/profiler.hpp>
 #include <ored/utilities/vectorutils.hpp>
 #include <ql/errors.hpp>
 #include <ql/time/calendars/weekendsonly.hpp>
@@ -83,6 +84,8 @@ PostProcess::PostProcess(
       creditMigrationTimeSteps_(creditMigrationTimeSteps), creditStateCorrelationMatrix_(creditStateCorrelationMatrix),
       withMporStickyDate_(withMporStickyDate), mporCashFlowMode_(mporCashFlowMode) {
 
+    ORE_PROFILE_SCOPE("PostProcess");
+
     QL_REQUIRE(cubeInterpretation_ != nullptr, "PostProcess: cubeInterpretation is not given.");
 
     if (mporCashFlowMode_ == MporCashFlowMode::Unspecified) {
@@ -141,6 +144,19 @@ PostProcess::PostProcess(
 
     ExposureAllocator::AllocationMethod allocationMethod = parseAllocationMethod(allocMethod);
 
+    // a streaming cube only provides netting set values, so no analytics that need trade level paths
+    if (QuantLib::ext::dynamic_pointer_cast<StreamingNPVCube>(cube_)) {
+        LOG("cube is a streaming cube, trade level exposures are not available");
+        tradeLevelResults_ = false;
+        QL_REQUIRE(allocationMethod == ExposureAllocator::AllocationMethod::None,
+                   "PostProcess: allocation method " << allocationMethod << " requires trade level cube values, "
+                                                     << "use None with a streaming cube");
+        QL_REQUIRE(!analytics_["dim"] && !analytics_["mva"] && !analytics_["creditMigration"] &&
+                       !analytics_["dynamicCredit"] && !analytics_["exerciseNextBreak"],
+                   "PostProcess: dim, mva, creditMigration, dynamicCredit and exerciseNextBreak require trade level "
+                   "cube values and are not supported with a streaming cube");
+    }
+
     /***********************************************
      * Step 0: Netting as of today
      * a) Compute the netting set NPV as of today
@@ -296,6 +296,8 @@ public:
 
     //! Inspector for the input NPV cube (by trade, time, scenario)
     const QuantLib::ext::shared_ptr<NPVCube>& cube() { return cube_; }
+    //! False if the cube only provides netting set level values (StreamingNPVCube), trade results are T0 only then
+    bool tradeLevelResults() const { return tradeLevelResults_; }
     //! Inspector for the input Cpty cube (by name, time, scenario)
     const QuantLib::ext::shared_ptr<NPVCube>& cptyCube() { return cptyCube_; }
     //! Return the  for the input NPV cube after netting and collateral (by netting set, time, scenario)
@@ -381,6 +383,7 @@ protected:
     std::vector<std::vector<Real>> creditMigrationCdf_;
     std::vector<std::vector<Real>> creditMigrationPdf_;
     bool withMporStickyDate_;
+    bool tradeLevelResults_ = true;
     MporCashFlowMode mporCashFlowMode_;
 };
 
@@ -38,6 +38,7 @@
 #include <ored/portfolio/builders/multilegoption.hpp>
 #include <ored/portfolio/builders/swaption.hpp>
 #include <ored/portfolio/structuredtradeerror.hpp>
+#include <ored/utilities/profiler.hpp>
 
 #include <boost/timer/timer.hpp>
 
@@ -179,6 +180,7 @@ QuantLib::ext::shared_ptr<EngineFactory> Analytic::Impl::engineFactory() {
 void Analytic::buildMarket(const QuantLib::ext::shared_ptr<ore::data::InMemoryLoader>& loader,
                            const bool marketRequired) {
     LOG("Analytic::buildMarket called");    
+    ORE_PROFILE_SCOPE("Analytic::buildMarket", label());
     cpu_timer mtimer;
 
     QL_REQUIRE(loader, "market data loader not set");
@@ -221,6 +223,7 @@ void Analytic::marketCalibration(const QuantLib::ext::shared_ptr<MarketCalibrati
 }
 
 void Analytic::buildPortfolio() {
+    ORE_PROFILE_SCOPE("Analytic::buildPortfolio", label());
     QuantLib::ext::shared_ptr<Portfolio> tmp = portfolio_ ? portfolio_ : inputs()->portfolio();
         
     // create a new empty portfolio
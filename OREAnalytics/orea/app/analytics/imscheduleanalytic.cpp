@@ -84,7 +84,7 @@ void IMScheduleAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::da
     auto imSchedule = QuantLib::ext::make_shared<IMScheduleCalculator>(
         imAnalytic->crif(), inputs_->simmResultCurrency(), analytic()->market(),
         true, inputs_->enforceIMRegulations(), false, imAnalytic->hasSEC(),
-        imAnalytic->hasCFTC());
+        imAnalytic->hasCFTC(), inputs_->nThreads());
     imAnalytic->setImSchedule(imSchedule);
 
     Real fxSpotReport = 1.0;
@@ -113,8 +113,20 @@ void ParConversionAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore:
         std::vector<SensitivityRecord> results;
         std::map<RiskFactorKey, std::string> descriptions = getScenarioDescriptions(simMarket->scenarioGenerator());
 
+        // collect the zero deltas of all valid trades as rows of a sparse matrix, so that they can be converted
+        // in one go below
+        struct TradeData {
+            std::string id;
+            Real baseNpv;
+            std::string currency;
+            std::vector<SensitivityRecord> excludedDeltas;
+        };
+        std::vector<TradeData> trades;
+        std::vector<Size> rowPointers(1, 0), columnIndices;
+        std::vector<Real> values;
+
         for (const auto& [id, sensis] : zeroSensis) {
-            boost::numeric::ublas::vector<Real> zeroDeltas(parConverter->rawKeys().size(), 0.0);
+            std::map<Size, Real> zeroDeltas;
             std::vector<SensitivityRecord> excludedDeltas;
             bool valid = true;
             for (const auto& zero : sensis) {
@@ -160,26 +172,39 @@ void ParConversionAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore:
                 }
             }
             if (!sensis.empty() && valid) {
-                boost::numeric::ublas::vector<Real> parDeltas = parConverter->convertSensitivity(zeroDeltas);
-                Size counter = 0;
-                for (const auto& key : parConverter->parKeys()) {
-                    if (!close(parDeltas[counter], 0.0)) {
-                        SensitivityRecord sr;
-                        sr.tradeId = id;
-                        sr.isPar = true;
-                        sr.key_1 = key;
-                        sr.desc_1 = descriptions[key];
-                        sr.delta = parDeltas[counter];
-                        sr.baseNpv = sensis.begin()->baseNpv;
-                        sr.currency = sensis.begin()->currency;
-                        sr.shift_1 = shiftSizes[key].second;
-                        sr.gamma = QuantLib::Null<QuantLib::Real>();
-                        results.push_back(sr);
-                    }
-                    counter++;
+                trades.push_back({id, sensis.begin()->baseNpv, sensis.begin()->currency, std::move(excludedDeltas)});
+                for (auto const& [idx, delta] : zeroDeltas) {
+                    columnIndices.push_back(idx);
+                    values.push_back(delta);
+                }
+                rowPointers.push_back(values.size());
+            }
+        }
+
+        QuantExt::CsrMatrix zeroDeltas(trades.size(), parConverter->rawKeys().size(), std::move(rowPointers),
+                                       std::move(columnIndices), std::move(values));
+        QuantExt::CsrMatrix parDeltas = parConverter->convertSensitivities(zeroDeltas, inputs_->nThreads());
+
+        std::vector<RiskFactorKey> parKeys(parConverter->parKeys().begin(), parConverter->parKeys().end());
+        for (Size t = 0; t < trades.size(); ++t) {
+            for (Size k = parDeltas.rowPointers()[t]; k < parDeltas.rowPointers()[t + 1]; ++k) {
+                Real delta = parDeltas.values()[k];
+                if (!close(delta, 0.0)) {
+                    const RiskFactorKey& key = parKeys[parDeltas.columnIndices()[k]];
+                    SensitivityRecord sr;
+                    sr.tradeId = trades[t].id;
+                    sr.isPar = true;
+                    sr.key_1 = key;
+                    sr.desc_1 = descriptions[key];
+                    sr.delta = delta;
+                    sr.baseNpv = trades[t].baseNpv;
+                    sr.currency = trades[t].currency;
+                    sr.shift_1 = shiftSizes[key].second;
+                    sr.gamma = QuantLib::Null<QuantLib::Real>();
+                    results.push_back(sr);
                 }
-                results.insert(results.end(), excludedDeltas.begin(), excludedDeltas.end());
             }
+            results.insert(results.end(), trades[t].excludedDeltas.begin(), trades[t].excludedDeltas.end());
         }
 
         auto ss = QuantLib::ext::make_shared<SensitivityInMemoryStream>(results.begin(), results.end());
@@ -105,7 +105,8 @@ void PnlExplainAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::da
     } else {
         auto scenarios = buildHistoricalScenarioGenerator(inputs_->historicalScenarioReader(), adjFactors, pnlDates,
                                                           analytic()->configurations().simMarketParams,
-                                                          analytic()->configurations().todaysMarketParams);
+                                                          analytic()->configurations().todaysMarketParams,
+                                                          inputs_->singlePrecisionScenarioData());
     }
 
     auto simMarket = QuantLib::ext::make_shared<ScenarioSimMarket>(
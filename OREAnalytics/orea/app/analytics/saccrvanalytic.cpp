@@ -76,7 +76,7 @@ void SaccrvAnalyticImpl::runAnalytic(const boost::shared_ptr<ore::data::InMemory
     CONSOLE("OK");
 
     CONSOLEW("SACCRV: Run Calculations");
-    RunSaccrvCalculations runSaccrvCalculations;
+    RunSaccrvCalculations runSaccrvCalculations(inputs_->nThreads());
     runSaccrvCalculations.runCalcs();
     CONSOLE("OK");
 
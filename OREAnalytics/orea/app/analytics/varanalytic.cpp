@@ -110,7 +110,8 @@ void ParametricVarAnalyticImpl::setVarReport(const QuantLib::ext::shared_ptr<ore
 
         auto scenarios = buildHistoricalScenarioGenerator(inputs_->historicalScenarioReader(), adjFactors,
             benchmarkVarPeriod, inputs_->mporCalendar(), inputs_->mporDays(), analytic()->configurations().simMarketParams,
-            analytic()->configurations().todaysMarketParams, inputs_->mporOverlappingPeriods());
+            analytic()->configurations().todaysMarketParams, inputs_->mporOverlappingPeriods(),
+            inputs_->singlePrecisionScenarioData());
 
         if (inputs_->outputHistoricalScenarios())
             ReportWriter().writeHistoricalScenarios(
@@ -156,7 +157,8 @@ void HistoricalSimulationVarAnalyticImpl::setVarReport(
     auto scenarios =
         buildHistoricalScenarioGenerator(inputs_->historicalScenarioReader(), adjFactors, benchmarkVarPeriod, inputs_->mporCalendar(),
         inputs_->mporDays(), analytic()->configurations().simMarketParams,
-        analytic()->configurations().todaysMarketParams, inputs_->mporOverlappingPeriods());
+        analytic()->configurations().todaysMarketParams, inputs_->mporOverlappingPeriods(),
+        inputs_->singlePrecisionScenarioData());
     
     if (inputs_->outputHistoricalScenarios())
         ore::analytics::ReportWriter().writeHistoricalScenarios(
@@ -24,6 +24,7 @@
 #include <orea/app/structuredanalyticserror.hpp>
 #include <orea/app/structuredanalyticswarning.hpp>
 #include <orea/cube/jointnpvcube.hpp>
+#include <orea/cube/streamingnpvcube.hpp>
 #include <orea/engine/amcvaluationengine.hpp>
 #include <orea/engine/cptycalculator.hpp>
 #include <orea/engine/mporcalculator.hpp>
@@ -37,6 +38,10 @@
 #include <ored/model/crossassetmodelbuilder.hpp>
 #include <ored/portfolio/structuredtradeerror.hpp>
 
+#include <qle/pricingengines/amccalibrationpathcache.hpp>
+
+#include <boost/algorithm/string/join.hpp>
+
 using namespace ore::data;
 using namespace boost::filesystem;
 
@@ -230,12 +235,74 @@ void XvaAnalyticImpl::initCube(QuantLib::ext::shared_ptr<NPVCube>& cube, const s
     for (Size i = 0; i < grid_->valuationDates().size(); ++i)
         DLOG("initCube: grid[" << i << "]=" << io::iso_date(grid_->valuationDates()[i]));
 
-    if (cubeDepth == 1)
-        cube = QuantLib::ext::make_shared<SinglePrecisionInMemoryCube>(inputs_->asof(), ids, grid_->valuationDates(),
-                                                                       samples_, 0.0f);
+    cube = createCube(inputs_->asof(), ids, grid_->valuationDates(), samples_, cubeDepth);
+}
+
+bool XvaAnalyticImpl::singlePrecisionCubes() const {
+    // the validation run compares single precision against double precision storage, so the main run keeps doubles
+    return inputs_->singlePrecisionCubes() && !inputs_->storagePrecisionValidation();
+}
+
+bool XvaAnalyticImpl::singlePrecisionScenarioData() const {
+    return inputs_->singlePrecisionScenarioData() && !inputs_->storagePrecisionValidation();
+}
+
+QuantLib::ext::shared_ptr<NPVCube> XvaAnalyticImpl::createCube(const Date& asof, const std::set<std::string>& ids,
+                                                               const std::vector<Date>& dates, Size samples,
+                                                               Size cubeDepth) const {
+    if (singlePrecisionCubes()) {
+        if (cubeDepth == 1)
+            return QuantLib::ext::make_shared<SinglePrecisionInMemoryCube>(asof, ids, dates, samples, 0.0f);
+        else
+            return QuantLib::ext::make_shared<SinglePrecisionInMemoryCubeN>(asof, ids, dates, samples, cubeDepth,
+                                                                            0.0f);
+    } else {
+        if (cubeDepth == 1)
+            return QuantLib::ext::make_shared<DoublePrecisionInMemoryCube>(asof, ids, dates, samples, 0.0);
+        else
+            return QuantLib::ext::make_shared<DoublePrecisionInMemoryCubeN>(asof, ids, dates, samples, cubeDepth,
+                                                                            0.0);
+    }
+}
+
+QuantLib::ext::shared_ptr<AggregationScenarioData> XvaAnalyticImpl::createScenarioData() const {
+    if (singlePrecisionScenarioData())
+        return QuantLib::ext::make_shared<SinglePrecisionInMemoryAggregationScenarioData>(
+            grid_->valuationDates().size(), samples_);
     else
-        cube = QuantLib::ext::make_shared<SinglePrecisionInMemoryCubeN>(inputs_->asof(), ids, grid_->valuationDates(),
-                                                                        samples_, cubeDepth, 0.0f);
+        return QuantLib::ext::make_shared<InMemoryAggregationScenarioData>(grid_->valuationDates().size(), samples_);
+}
+
+bool XvaAnalyticImpl::useStreamingAggregation(bool doAmcRun) const {
+    if (!inputs_->streamingAggregation())
+        return false;
+    // the streaming cube only keeps netting set values, fall back to a trade level cube if anything needs more
+    std::vector<std::string> reasons;
+    if (!runXva_)
+        reasons.push_back("no xva run");
+    if (doAmcRun)
+        reasons.push_back("amc");
+    if (inputs_->exposureProfilesByTrade())
+        reasons.push_back("exposureProfilesByTrade");
+    if (inputs_->writeCube() || inputs_->rawCubeOutput())
+        reasons.push_back("cube output");
+    if (inputs_->exposureAllocationMethod() != "None")
+        reasons.push_back("allocation method " + inputs_->exposureAllocationMethod());
+    if (inputs_->dimAnalytic() || inputs_->mvaAnalytic())
+        reasons.push_back("dim/mva");
+    if (inputs_->creditMigrationAnalytic() || inputs_->dynamicCredit())
+        reasons.push_back("credit migration / dynamic credit");
+    if (inputs_->exerciseNextBreak())
+        reasons.push_back("exerciseNextBreak");
+    if (inputs_->storagePrecisionValidation())
+        reasons.push_back("storagePrecisionValidation");
+    if (!reasons.empty()) {
+        WLOG("XVA: streaming aggregation is switched off, trade level cube values are required for: "
+             << boost::algorithm::join(reasons, ", "));
+        return false;
+    }
+    LOG("XVA: streaming aggregation, trade values are aggregated into netting sets during valuation");
+    return true;
 }
 
 void XvaAnalyticImpl::initClassicRun(const QuantLib::ext::shared_ptr<Portfolio>& portfolio) {
@@ -247,15 +314,20 @@ void XvaAnalyticImpl::initClassicRun(const QuantLib::ext::shared_ptr<Portfolio>&
     // May have been set already
     if (scenarioData_.empty()) {
         LOG("XVA: Create asd " << grid_->valuationDates().size() << " x " << samples_);
-        scenarioData_.linkTo(
-            QuantLib::ext::make_shared<InMemoryAggregationScenarioData>(grid_->valuationDates().size(), samples_));
+        scenarioData_.linkTo(createScenarioData());
         simMarket_->aggregationScenarioData() = *scenarioData_;
     }
 
     // We can skip the cube initialization if the mt val engine is used, since it builds its own cubes
     if (inputs_->nThreads() == 1) {
-        if (portfolio->size() > 0)
-            initCube(cube_, portfolio->ids(), cubeDepth_);
+        if (portfolio->size() > 0) {
+            if (streamingAggregation_)
+                cube_ = QuantLib::ext::make_shared<StreamingNPVCube>(inputs_->asof(), portfolio->ids(),
+                                                                     grid_->valuationDates(), samples_, cubeDepth_,
+                                                                     portfolio->nettingSetMap());
+            else
+                initCube(cube_, portfolio->ids(), cubeDepth_);
+        }
         // not required by any calculators in ore at the moment
         nettingSetCube_ = nullptr;
         // Init counterparty cube for the storage of survival probabilities
@@ -375,14 +447,14 @@ void XvaAnalyticImpl::buildClassicCube(const QuantLib::ext::shared_ptr<Portfolio
         /* TODO we assume no netting output cube is needed. Currently there are no valuation calculators in ore that
          * require this cube. */
 
-        auto cubeFactory = [this](const QuantLib::Date& asof, const std::set<std::string>& ids,
-                                  const std::vector<QuantLib::Date>& dates,
-                                  const Size samples) -> QuantLib::ext::shared_ptr<NPVCube> {
-            if (cubeDepth_ == 1)
-                return QuantLib::ext::make_shared<SinglePrecisionInMemoryCube>(asof, ids, dates, samples, 0.0f);
-            else
-                return QuantLib::ext::make_shared<SinglePrecisionInMemoryCubeN>(asof, ids, dates, samples, cubeDepth_,
-                                                                                0.0f);
+        auto nettingSetMap = portfolio->nettingSetMap();
+        auto cubeFactory = [this, nettingSetMap](const QuantLib::Date& asof, const std::set<std::string>& ids,
+                                                 const std::vector<QuantLib::Date>& dates,
+                                                 const Size samples) -> QuantLib::ext::shared_ptr<NPVCube> {
+            if (streamingAggregation_)
+                return QuantLib::ext::make_shared<StreamingNPVCube>(asof, ids, dates, samples, cubeDepth_,
+                                                                    nettingSetMap);
+            return createCube(asof, ids, dates, samples, cubeDepth_);
         };
 
         std::function<QuantLib::ext::shared_ptr<NPVCube>(const QuantLib::Date&, const std::set<std::string>&,
@@ -415,7 +487,10 @@ void XvaAnalyticImpl::buildClassicCube(const QuantLib::ext::shared_ptr<Portfolio
         engine.buildCube(portfolio, calculators, cptyCalculators,
                          analytic()->configurations().scenarioGeneratorData->withMporStickyDate());
 
-        cube_ = QuantLib::ext::make_shared<JointNPVCube>(engine.outputCubes(), portfolio->ids());
+        if (streamingAggregation_)
+            cube_ = QuantLib::ext::make_shared<StreamingNPVCube>(engine.outputCubes());
+        else
+            cube_ = QuantLib::ext::make_shared<JointNPVCube>(engine.outputCubes(), portfolio->ids());
 
         if (inputs_->storeSurvivalProbabilities())
             cptyCube_ = QuantLib::ext::make_shared<JointNPVCube>(
@@ -494,8 +569,7 @@ void XvaAnalyticImpl::amcRun(bool doClassicRun) {
 
     if (scenarioData_.empty()) {
         LOG("XVA: Create asd " << grid_->valuationDates().size() << " x " << samples_);
-        scenarioData_.linkTo(
-            QuantLib::ext::make_shared<InMemoryAggregationScenarioData>(grid_->valuationDates().size(), samples_));
+        scenarioData_.linkTo(createScenarioData());
         simMarket_->aggregationScenarioData() = *scenarioData_;
     }
 
@@ -525,11 +599,7 @@ void XvaAnalyticImpl::amcRun(bool doClassicRun) {
         auto cubeFactory = [this](const QuantLib::Date& asof, const std::set<std::string>& ids,
                                   const std::vector<QuantLib::Date>& dates,
                                   const Size samples) -> QuantLib::ext::shared_ptr<NPVCube> {
-            if (cubeDepth_ == 1)
-                return QuantLib::ext::make_shared<SinglePrecisionInMemoryCube>(asof, ids, dates, samples, 0.0f);
-            else
-                return QuantLib::ext::make_shared<SinglePrecisionInMemoryCubeN>(asof, ids, dates, samples, cubeDepth_,
-                                                                                0.0f);
+            return createCube(asof, ids, dates, samples, cubeDepth_);
         };
 
         auto simMarketParams =
@@ -657,6 +727,117 @@ void XvaAnalyticImpl::runPostProcessor() {
     LOG("post done");
 }
 
+void XvaAnalyticImpl::validateStoragePrecision() {
+    LOG("XVA: Storage precision validation");
+    QL_REQUIRE(cube_, "XVA: storage precision validation requires an npv cube");
+
+    // copy the double precision cube and scenario data into single precision storage
+    QuantLib::ext::shared_ptr<NPVCube> floatCube;
+    if (cube_->depth() == 1)
+        floatCube = QuantLib::ext::make_shared<SinglePrecisionInMemoryCube>(cube_->asof(), cube_->ids(),
+                                                                            cube_->dates(), cube_->samples(), 0.0f);
+    else
+        floatCube = QuantLib::ext::make_shared<SinglePrecisionInMemoryCubeN>(
+            cube_->asof(), cube_->ids(), cube_->dates(), cube_->samples(), cube_->depth(), 0.0f);
+    for (auto const& [id, index] : cube_->idsAndIndexes()) {
+        Size j = floatCube->index(id);
+        for (Size d = 0; d < cube_->depth(); ++d) {
+            floatCube->setT0(cube_->getT0(index, d), j, d);
+            for (Size i = 0; i < cube_->numDates(); ++i)
+                for (Size k = 0; k < cube_->samples(); ++k)
+                    floatCube->set(cube_->get(index, i, k, d), j, i, k, d);
+        }
+    }
+
+    auto floatScenarioData = QuantLib::ext::make_shared<SinglePrecisionInMemoryAggregationScenarioData>(
+        scenarioData_->dimDates(), scenarioData_->dimSamples());
+    for (auto const& [type, qualifier] : scenarioData_->keys())
+        for (Size i = 0; i < scenarioData_->dimDates(); ++i)
+            for (Size k = 0; k < scenarioData_->dimSamples(); ++k)
+                floatScenarioData->set(i, k, scenarioData_->get(i, k, type, qualifier), type, qualifier);
+
+    // rerun the post processor on the single precision copies, the cube interpreter follows the relinked handle
+    auto doubleCube = cube_;
+    auto doubleScenarioData = *scenarioData_;
+    auto doublePostProcess = postProcess_;
+    auto doubleDimCalculator = dimCalculator_;
+    cube_ = floatCube;
+    scenarioData_.linkTo(floatScenarioData);
+    dimCalculator_ = nullptr;
+    try {
+        runPostProcessor();
+    } catch (...) {
+        cube_ = doubleCube;
+        scenarioData_.linkTo(doubleScenarioData);
+        postProcess_ = doublePostProcess;
+        dimCalculator_ = doubleDimCalculator;
+        throw;
+    }
+    auto floatPostProcess = postProcess_;
+    cube_ = doubleCube;
+    scenarioData_.linkTo(doubleScenarioData);
+    postProcess_ = doublePostProcess;
+    dimCalculator_ = doubleDimCalculator;
+
+    auto report = QuantLib::ext::make_shared<InMemoryReport>();
+    report->addColumn("Type", string())
+        .addColumn("Id", string())
+        .addColumn("Metric", string())
+        .addColumn("MaxAbsDiff", double(), 6)
+        .addColumn("MaxRelDiff", double(), 6)
+        .addColumn("Reference", double(), 6);
+
+    Real maxRelDiff = 0.0;
+    auto addRow = [&report, &maxRelDiff](const string& type, const string& id, const string& metric,
+                                         const vector<Real>& ref, const vector<Real>& val) {
+        Real absDiff = 0.0, relDiff = 0.0, refValue = 0.0;
+        for (Size i = 0; i < std::min(ref.size(), val.size()); ++i) {
+            if (ref[i] == Null<Real>() || val[i] == Null<Real>())
+                continue;
+            Real diff = std::abs(ref[i] - val[i]);
+            if (diff > absDiff) {
+                absDiff = diff;
+                refValue = ref[i];
+            }
+            if (!QuantLib::close_enough(ref[i], 0.0))
+                relDiff = std::max(relDiff, diff / std::abs(ref[i]));
+        }
+        maxRelDiff = std::max(maxRelDiff, relDiff);
+        report->next().add(type).add(id).add(metric).add(absDiff).add(relDiff).add(refValue);
+    };
+
+    for (auto const& [tradeId, pos] : postProcess_->tradeIds()) {
+        addRow("Trade", tradeId, "EPE", postProcess_->tradeEPE(tradeId), floatPostProcess->tradeEPE(tradeId));
+        addRow("Trade", tradeId, "ENE", postProcess_->tradeENE(tradeId), floatPostProcess->tradeENE(tradeId));
+        if (inputs_->cvaAnalytic())
+            addRow("Trade", tradeId, "CVA", {postProcess_->tradeCVA(tradeId)}, {floatPostProcess->tradeCVA(tradeId)});
+        if (inputs_->dvaAnalytic())
+            addRow("Trade", tradeId, "DVA", {postProcess_->tradeDVA(tradeId)}, {floatPostProcess->tradeDVA(tradeId)});
+    }
+    for (auto const& [nettingSetId, pos] : postProcess_->nettingSetIds()) {
+        addRow("NettingSet", nettingSetId, "EPE", postProcess_->netEPE(nettingSetId),
+               floatPostProcess->netEPE(nettingSetId));
+        addRow("NettingSet", nettingSetId, "ENE", postProcess_->netENE(nettingSetId),
+               floatPostProcess->netENE(nettingSetId));
+        if (inputs_->cvaAnalytic())
+            addRow("NettingSet", nettingSetId, "CVA", {postProcess_->nettingSetCVA(nettingSetId)},
+                   {floatPostProcess->nettingSetCVA(nettingSetId)});
+        if (inputs_->dvaAnalytic())
+            addRow("NettingSet", nettingSetId, "DVA", {postProcess_->nettingSetDVA(nettingSetId)},
+                   {floatPostProcess->nettingSetDVA(nettingSetId)});
+        if (inputs_->fvaAnalytic()) {
+            addRow("NettingSet", nettingSetId, "FBA", {postProcess_->nettingSetFBA(nettingSetId)},
+                   {floatPostProcess->nettingSetFBA(nettingSetId)});
+            addRow("NettingSet", nettingSetId, "FCA", {postProcess_->nettingSetFCA(nettingSetId)},
+                   {floatPostProcess->nettingSetFCA(nettingSetId)});
+        }
+    }
+    report->end();
+    analytic()->reports()["XVA"]["storage_precision_validation"] = report;
+    LOG("XVA: Storage precision validation done, max relative difference single vs double precision is "
+        << maxRelDiff);
+}
+
 void XvaAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InMemoryLoader>& loader,
                                   const std::set<std::string>& runTypes) {
 
@@ -726,6 +907,13 @@ void XvaAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InM
         auto residualPortfolio = QuantLib::ext::make_shared<Portfolio>(inputs_->buildFailedTrades());
 
         if (inputs_->amc()) {
+            // Calibration paths and regression factorisations are shared across the AMC trades if configured
+            QuantExt::AmcCalibrationPathCache::instance().clear();
+            QuantExt::AmcCalibrationPathCache::instance().setMemoryBudget(inputs_->amcPathCacheMemoryBudget() * 1024 *
+                                                                          1024);
+            QuantExt::AmcCalibrationPathCache::instance().setShareRegressionFactorisations(
+                inputs_->amcShareRegressionFactorisations());
+
             // Build a separate sub-portfolio for the AMC cube generation and perform its training
             buildAmcPortfolio();
 
@@ -745,6 +933,8 @@ void XvaAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InM
                 residualPortfolio->add(trade);
         }
 
+        streamingAggregation_ = useStreamingAggregation(doAmcRun);
+
         /********************************************************************************
          * This is where we build cubes and the "classic" valuation work is done
          * The bulk of the AMC work is done before in the AMC portfolio building/training
@@ -755,6 +945,15 @@ void XvaAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InM
         else
             amcPortfolio_ = QuantLib::ext::make_shared<Portfolio>(inputs_->buildFailedTrades());
 
+        if (inputs_->amc()) {
+            auto& pathCache = QuantExt::AmcCalibrationPathCache::instance();
+            LOG("AMC calibration path cache: " << pathCache.hits() << " hits, " << pathCache.misses() << " misses, "
+                                               << pathCache.memoryUsage() << " bytes used");
+            pathCache.clear();
+            pathCache.setMemoryBudget(0);
+            pathCache.setShareRegressionFactorisations(false);
+        }
+
         if (doClassicRun)
             classicPortfolio_ = classicRun(residualPortfolio);
         else
@@ -851,6 +1050,9 @@ void XvaAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InM
         CONSOLE("OK");
         ProgressMessage(msg, 1, 1).log();
 
+        if (inputs_->storagePrecisionValidation())
+            validateStoragePrecision();
+
         /******************************************************
          * Finally generate various (in-memory) reports/outputs
          ******************************************************/
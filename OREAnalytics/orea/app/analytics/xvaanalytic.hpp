@@ -55,6 +55,12 @@ protected:
 
     void initCubeDepth();
     void initCube(QuantLib::ext::shared_ptr<NPVCube>& cube, const std::set<std::string>& ids, Size cubeDepth);
+    bool singlePrecisionCubes() const;
+    bool singlePrecisionScenarioData() const;
+    QuantLib::ext::shared_ptr<NPVCube> createCube(const Date& asof, const std::set<std::string>& ids,
+                                                  const std::vector<Date>& dates, Size samples, Size cubeDepth) const;
+    QuantLib::ext::shared_ptr<AggregationScenarioData> createScenarioData() const;
+    bool useStreamingAggregation(bool doAmcRun) const;
 
     void initClassicRun(const QuantLib::ext::shared_ptr<Portfolio>& portfolio);
     void buildClassicCube(const QuantLib::ext::shared_ptr<Portfolio>& portfolio);
@@ -66,6 +72,8 @@ protected:
     void amcRun(bool doClassicRun);
 
     void runPostProcessor();
+    //! rerun the post processor on single precision copies of the cube and scenario data and report the differences
+    void validateStoragePrecision();
 
     Matrix creditStateCorrelationMatrix() const;
 
@@ -84,6 +92,7 @@ protected:
     QuantLib::ext::shared_ptr<Scenario> offsetScenario_;
     QuantLib::ext::shared_ptr<ScenarioSimMarketParameters> offsetSimMarketParams_;
     Size cubeDepth_ = 0;
+    bool streamingAggregation_ = false;
     QuantLib::ext::shared_ptr<DateGrid> grid_;
     Size samples_ = 0;
 
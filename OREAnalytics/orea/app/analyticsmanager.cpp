@@ -42,6 +42,7 @@
 // SACCRV end 
 
 #include <ored/utilities/log.hpp>
+#include <ored/utilities/profiler.hpp>
 #include <ored/utilities/to_string.hpp>
 
 #include <ql/errors.hpp>
@@ -120,6 +121,8 @@ void AnalyticsManager::runAnalytics(const QuantLib::ext::shared_ptr<MarketCalibr
     if (analytics_.size() == 0)
         return;
 
+    ORE_PROFILE_SCOPE("AnalyticsManager::runAnalytics");
+
     std::vector<QuantLib::ext::shared_ptr<ore::data::TodaysMarketParameters>> tmps = todaysMarketParams();
     std::set<Date> marketDates;
     for (const auto& a : analytics_) {
@@ -140,6 +143,7 @@ void AnalyticsManager::runAnalytics(const QuantLib::ext::shared_ptr<MarketCalibr
         // load the market data
         if (tmps.size() > 0) {
             LOG("AnalyticsManager::runAnalytics: populate loader for dates: " << to_string(marketDates));
+            ORE_PROFILE_SCOPE("MarketDataLoader::populateLoader");
             marketDataLoader_->populateLoader(tmps, marketDates);
         }
         
@@ -164,6 +168,7 @@ void AnalyticsManager::runAnalytics(const QuantLib::ext::shared_ptr<MarketCalibr
     // run requested analytics
     for (auto a : analytics_) {
         LOG("run analytic with label '" << a.first << "'");
+        ORE_PROFILE_SCOPE("Analytic::runAnalytic", a.first);
         a.second->runAnalytic(marketDataLoader_->loader(), inputs_->analytics());
         LOG("run analytic with label '" << a.first << "' finished.");
         // then populate the market calibration report if required
@@ -279,6 +284,7 @@ void AnalyticsManager::toFile(const ore::analytics::Analytic::analytic_reports&
                 suffix = ".csv";
             std::string fullFileName = outputPath + "/" + fileName + suffix;
 
+            ORE_PROFILE_SCOPE("InMemoryReport::toFile", reportName);
             report->toFile(fullFileName, sep, commentCharacter, quoteChar, nullString,
                            lowerHeaderReportNames.find(reportName) != lowerHeaderReportNames.end());
             LOG("report " << reportName << " written to " << fullFileName); 
@@ -28,6 +28,7 @@
 
 #include <qle/math/computeenvironment.hpp>
 #include <qle/math/randomvariable.hpp>
+#include <qle/pricingengines/amccalibrationpathcache.hpp>
 #include <qle/pricingengines/mcmultilegbaseengine.hpp>
 #include <qle/utilities/savedobservablesettings.hpp>
 
@@ -48,6 +49,7 @@ CleanUpThreadGlobalSingletons::~CleanUpThreadGlobalSingletons() {
     ore::data::CalendarParser::instance().reset();
     ore::data::CurrencyParser::instance().reset();
     ore::data::ScriptLibraryStorage::instance().clear();
+    QuantExt::AmcCalibrationPathCache::instance().clear();
 }
 
 CleanUpLogSingleton::CleanUpLogSingleton(const bool removeLoggers, const bool clearIndependentLoggers)
@@ -56,6 +56,12 @@ void InputParameters::setAsOfDate(const std::string& s) {
     Settings::instance().evaluationDate() = asof_;
 }
 
+void InputParameters::setStoragePrecision(const std::string& s) {
+    QL_REQUIRE(s == "Default" || s == "Single" || s == "Double",
+               "storage precision '" << s << "' not recognised, expected Default, Single or Double");
+    storagePrecision_ = s;
+}
+
 void InputParameters::setMarketConfig(const std::string& config, const std::string& context) {
     auto it = marketConfigs_.find(context);
     QL_REQUIRE(it == marketConfigs_.end(),
@@ -137,13 +143,13 @@ void InputParameters::setTodaysMarketParamsFromFile(const std::string& fileName)
 }
 
 void InputParameters::setPortfolio(const std::string& xml) {
-    portfolio_ = QuantLib::ext::make_shared<Portfolio>(buildFailedTrades_);
+    portfolio_ = QuantLib::ext::make_shared<Portfolio>(buildFailedTrades_, false, nThreads_);
     portfolio_->fromXMLString(xml);
 }
 
 void InputParameters::setPortfolioFromFile(const std::string& fileNameString, const std::filesystem::path& inputPath) {
     vector<string> files = getFileNames(fileNameString, inputPath);
-    portfolio_ = QuantLib::ext::make_shared<Portfolio>(buildFailedTrades_);
+    portfolio_ = QuantLib::ext::make_shared<Portfolio>(buildFailedTrades_, false, nThreads_);
     for (auto file : files) {
         LOG("Loading portfolio from file: " << file);
         portfolio_->fromFile(file);
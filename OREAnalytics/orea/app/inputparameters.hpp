@@ -111,6 +111,8 @@ public:
     void setBuildFailedTrades(bool b) { buildFailedTrades_ = b; }
     void setObservationModel(const std::string& s) { observationModel_ = s; }
     void setImplyTodaysFixings(bool b) { implyTodaysFixings_ = b; }
+    void setStoragePrecision(const std::string& s); // Default, Single or Double
+    void setStoragePrecisionValidation(bool b) { storagePrecisionValidation_ = b; }
     void setMarketConfig(const std::string& config, const std::string& context);
     void setRefDataManager(const std::string& xml);
     void setRefDataManagerFromFile(const std::string& fileName);
@@ -140,6 +142,8 @@ public:
     void setCsvSeparator(const char& c) { csvSeparator_ = c; }
     void setCsvCommentCharacter(const char& c) { csvCommentCharacter_ = c; }
     void setDryRun(bool b) { dryRun_ = b; }
+    void setProfile(bool b) { profile_ = b; }
+    void setProfileTraceFile(const std::string& s) { profileTraceFile_ = s; }
     void setMporDays(Size s) { mporDays_ = s; }
     void setMporOverlappingPeriods(bool b) { mporOverlappingPeriods_ = b; }
     void setMporDate(const QuantLib::Date& d) { mporDate_ = d; }
@@ -234,6 +238,8 @@ public:
     void setXvaCgSensiScenarioData(const std::string& xml);
     void setXvaCgSensiScenarioDataFromFile(const std::string& fileName);
     void setAmcTradeTypes(const std::string& s); // parse to set<string>
+    void setAmcPathCacheMemoryBudget(QuantLib::Size mb) { amcPathCacheMemoryBudget_ = mb; }
+    void setAmcShareRegressionFactorisations(bool b) { amcShareRegressionFactorisations_ = b; }
     void setExposureBaseCurrency(const std::string& s) { exposureBaseCurrency_ = s; } 
     void setExposureObservationModel(const std::string& s) { exposureObservationModel_ = s; }
     void setNettingSetId(const std::string& s) { nettingSetId_ = s; }
@@ -285,6 +291,7 @@ public:
     void setFullInitialCollateralisation(bool b) { fullInitialCollateralisation_ = b; }
     void setExposureProfiles(bool b) { exposureProfiles_ = b; }
     void setExposureProfilesByTrade(bool b) { exposureProfilesByTrade_ = b; }
+    void setStreamingAggregation(bool b) { streamingAggregation_ = b; }
     void setPfeQuantile(Real r) { pfeQuantile_ = r; }
     void setCollateralCalculationType(const std::string& s) { collateralCalculationType_ = s; }
     void setExposureAllocationMethod(const std::string& s) { exposureAllocationMethod_ = s; }
@@ -485,6 +492,12 @@ public:
     bool buildFailedTrades() const { return buildFailedTrades_; }
     const std::string& observationModel() const { return observationModel_; }
     bool implyTodaysFixings() const { return implyTodaysFixings_; }
+    const std::string& storagePrecision() const { return storagePrecision_; }
+    //! NPV cubes are stored in single precision unless Double storage is requested
+    bool singlePrecisionCubes() const { return storagePrecision_ != "Double"; }
+    //! Scenario data (aggregation scenario data, historical scenarios) is stored in single precision on request only
+    bool singlePrecisionScenarioData() const { return storagePrecision_ == "Single"; }
+    bool storagePrecisionValidation() const { return storagePrecisionValidation_; }
     const std::map<std::string, std::string>&  marketConfigs() const { return marketConfigs_; }
     const std::string& marketConfig(const std::string& context);
     const QuantLib::ext::shared_ptr<ore::data::BasicReferenceDataManager>& refDataManager() const { return refDataManager_; }
@@ -512,6 +525,8 @@ public:
     char csvSeparator() const { return csvSeparator_; }
     char csvEscapeChar() const { return csvEscapeChar_; }
     bool dryRun() const { return dryRun_; }
+    bool profile() const { return profile_; }
+    const std::string& profileTraceFile() const { return profileTraceFile_; }
     QuantLib::Size mporDays() const { return mporDays_; }
     QuantLib::Date mporDate();
     const QuantLib::Calendar mporCalendar() {
@@ -623,6 +638,8 @@ public:
     const std::string& xvaCgExternalComputeDevice() const { return xvaCgExternalComputeDevice_; }
     const QuantLib::ext::shared_ptr<ore::analytics::SensitivityScenarioData>& xvaCgSensiScenarioData() const { return xvaCgSensiScenarioData_; }
     const std::set<std::string>& amcTradeTypes() const { return amcTradeTypes_; }
+    QuantLib::Size amcPathCacheMemoryBudget() const { return amcPathCacheMemoryBudget_; }
+    bool amcShareRegressionFactorisations() const { return amcShareRegressionFactorisations_; }
     const std::string& exposureBaseCurrency() const { return exposureBaseCurrency_; }
     const std::string& exposureObservationModel() const { return exposureObservationModel_; }
     const std::string& nettingSetId() const { return nettingSetId_; }
@@ -656,6 +673,7 @@ public:
     bool fullInitialCollateralisation() const { return fullInitialCollateralisation_; }
     bool exposureProfiles() const { return exposureProfiles_; }
     bool exposureProfilesByTrade() const { return exposureProfilesByTrade_; }
+    bool streamingAggregation() const { return streamingAggregation_; }
     Real pfeQuantile() const { return pfeQuantile_; }
     const std::string&  collateralCalculationType() const { return collateralCalculationType_; }
     const std::string& exposureAllocationMethod() const { return exposureAllocationMethod_; }
@@ -863,6 +881,8 @@ protected:
     bool buildFailedTrades_ = true;
     std::string observationModel_ = "None";
     bool implyTodaysFixings_ = false;
+    std::string storagePrecision_ = "Default";
+    bool storagePrecisionValidation_ = false;
     std::map<std::string, std::string> marketConfigs_;
     QuantLib::ext::shared_ptr<ore::data::BasicReferenceDataManager> refDataManager_;
     QuantLib::ext::shared_ptr<ore::data::Conventions> conventions_;
@@ -886,6 +906,8 @@ protected:
     char csvEscapeChar_ = '\\';
     std::string reportNaString_ = "#N/A";
     bool dryRun_ = false;
+    bool profile_ = false;
+    std::string profileTraceFile_ = "profile_trace.json";
     QuantLib::Date mporDate_;
     QuantLib::Size mporDays_ = 10;
     bool mporOverlappingPeriods_ = true;
@@ -980,6 +1002,9 @@ protected:
     string xvaCgExternalComputeDevice_;
     QuantLib::ext::shared_ptr<ore::analytics::SensitivityScenarioData> xvaCgSensiScenarioData_;
     std::set<std::string> amcTradeTypes_;
+    // memory budget in MB for the amc calibration path cache, zero disables the cache
+    QuantLib::Size amcPathCacheMemoryBudget_ = 0;
+    bool amcShareRegressionFactorisations_ = false;
     std::string exposureBaseCurrency_ = "";
     std::string exposureObservationModel_ = "Disable";
     std::string nettingSetId_ = "";
@@ -998,6 +1023,7 @@ protected:
     QuantLib::ext::shared_ptr<ore::data::CollateralBalances> collateralBalances_;
     bool exposureProfiles_ = true;
     bool exposureProfilesByTrade_ = true;
+    bool streamingAggregation_ = false;
     Real pfeQuantile_ = 0.95;
     bool fullInitialCollateralisation_ = false;
     std::string collateralCalculationType_ = "NoLag";
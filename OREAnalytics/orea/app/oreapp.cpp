@@ -37,6 +37,7 @@
 
 #include <ored/report/inmemoryreport.hpp>
 #include <ored/utilities/calendaradjustmentconfig.hpp>
+#include <ored/utilities/profiler.hpp>
 #include <ored/configuration/currencyconfig.hpp>
 #include <ored/portfolio/collateralbalance.hpp>
 
@@ -219,6 +220,7 @@ QuantLib::ext::shared_ptr<CSVLoader> OREApp::buildCsvLoader(const QuantLib::ext:
 void OREApp::analytics() {
 
     try {
+        ORE_PROFILE_SCOPE("OREApp::analytics");
         LOG("ORE analytics starting");
         MEM_LOG_USING_LEVEL(ORE_WARNING)
 
@@ -265,6 +267,7 @@ void OREApp::analytics() {
                 string reportName = b.first;
                 std::string fileName = inputs_->resultsPath().string() + "/" + outputs_->outputFileName(reportName, "csv.gz");
                 LOG("write npv cube " << reportName << " to file " << fileName);
+                ORE_PROFILE_SCOPE("OREApp::saveCube", reportName);
                 NPVCubeWithMetaData r;
                 r.cube = b.second;
                 if (b.first == "cube") {
@@ -283,6 +286,7 @@ void OREApp::analytics() {
                 string reportName = b.first;
                 std::string fileName = inputs_->resultsPath().string() + "/" + outputs_->outputFileName(reportName, "csv.gz");
                 LOG("write market cube " << reportName << " to file " << fileName);
+                ORE_PROFILE_SCOPE("OREApp::saveAggregationScenarioData", reportName);
                 saveAggregationScenarioData(fileName, *b.second);
             }
         }
@@ -419,6 +423,9 @@ void OREApp::run() {
 	return;
     }
 
+    if (inputs_->profile())
+        Profiler::instance().start();
+
     runTimer_.start();
     
     try {
@@ -427,11 +434,14 @@ void OREApp::run() {
     } catch (std::exception& e) {
         StructuredAnalyticsWarningMessage("OREApp::run()", "Error", e.what()).log();
         CONSOLE("Error: " << e.what());
+        writeProfile();
         return;
     }
 
     runTimer_.stop();
 
+    writeProfile();
+
     // cache the error messages because we reset the loggers 
     errorMessages_ = structuredLogger_->messages();
 
@@ -464,9 +474,13 @@ void OREApp::run(const std::vector<std::string>& marketData,
 	return;
     }
 
+    if (inputs_->profile())
+        Profiler::instance().start();
+
     runTimer_.start();
 
     try {
+        ORE_PROFILE_SCOPE("OREApp::run");
         LOG("ORE analytics starting");
         structuredLogger_->clear();
         MEM_LOG_USING_LEVEL(ORE_WARNING)
@@ -512,15 +526,38 @@ void OREApp::run(const std::vector<std::string>& marketData,
         StructuredAnalyticsWarningMessage("OREApp::run()", oss.str(), e.what()).log();
         MEM_LOG_USING_LEVEL(ORE_WARNING)
         CONSOLE(oss.str());
+        writeProfile();
         QL_FAIL(oss.str());
         return;
     }
 
     runTimer_.stop();
+
+    writeProfile();
     
     LOG("ORE analytics done");
 }
 
+void OREApp::writeProfile() {
+    if (!inputs_ || !inputs_->profile())
+        return;
+    Profiler::instance().stop();
+    try {
+        string path = inputs_->resultsPath().string();
+        string traceFile = path + "/" + inputs_->profileTraceFile();
+        LOG("write profile trace to file " << traceFile);
+        Profiler::instance().writeChromeTrace(traceFile);
+        string summaryFile = path + "/" + (outputs_ ? outputs_->outputFileName("profile", "csv") : "profile.csv");
+        LOG("write profile summary to file " << summaryFile);
+        InMemoryReport summary;
+        Profiler::instance().writeSummary(summary);
+        summary.toFile(summaryFile, inputs_->csvSeparator(), inputs_->csvCommentCharacter(), inputs_->csvQuoteChar(),
+                       inputs_->reportNaString());
+    } catch (const std::exception& e) {
+        StructuredAnalyticsWarningMessage("OREApp::run()", "Error writing profile", e.what()).log();
+    }
+}
+
 void OREApp::setupLog(const std::string& path, const std::string& file, Size mask,
                       const boost::filesystem::path& logRootPath, const std::string& progressLogFile,
                       Size progressLogRotationSize, bool progressLogToConsole, const std::string& structuredLogFile,
@@ -626,6 +663,14 @@ void OREAppInputParameters::loadParameters() {
     if (tmp != "")
         setDryRun(parseBool(tmp));
 
+    tmp = params_->get("setup", "profile", false);
+    if (tmp != "")
+        setProfile(parseBool(tmp));
+
+    tmp = params_->get("setup", "profileTraceFile", false);
+    if (tmp != "")
+        setProfileTraceFile(tmp);
+
     tmp = params_->get("setup", "reportNaString", false);
     if (tmp != "")
         setReportNaString(tmp);
@@ -665,6 +710,16 @@ void OREAppInputParameters::loadParameters() {
         LOG("Observation Mode is " << observationModel());
     }
 
+    tmp = params_->get("setup", "storagePrecision", false);
+    if (tmp != "") {
+        setStoragePrecision(tmp);
+        LOG("Storage precision is " << storagePrecision());
+    }
+
+    tmp = params_->get("setup", "storagePrecisionValidation", false);
+    if (tmp != "")
+        setStoragePrecisionValidation(parseBool(tmp));
+
     tmp = params_->get("setup", "implyTodaysFixings", false);
     if (tmp != "")
         setImplyTodaysFixings(ore::data::parseBool(tmp));
@@ -1452,6 +1507,14 @@ void OREAppInputParameters::loadParameters() {
     if (tmp != "")
         setAmcTradeTypes(tmp);
 
+    tmp = params_->get("simulation", "amcPathCacheMemoryBudget", false);
+    if (tmp != "")
+        setAmcPathCacheMemoryBudget(parseInteger(tmp));
+
+    tmp = params_->get("simulation", "amcShareRegressionFactorisations", false);
+    if (tmp != "")
+        setAmcShareRegressionFactorisations(parseBool(tmp));
+
     setSimulationPricingEngine(pricingEngine());
     setExposureObservationModel(observationModel());
     setExposureBaseCurrency(baseCurrency());
@@ -1634,6 +1697,10 @@ void OREAppInputParameters::loadParameters() {
     if (tmp != "")
         setExposureProfilesByTrade(parseBool(tmp));
 
+    tmp = params_->get("xva", "streamingAggregation", false);
+    if (tmp != "")
+        setStreamingAggregation(parseBool(tmp));
+
     tmp = params_->get("xva", "exposureProfiles", false);
     if (tmp != "")
         setExposureProfiles(parseBool(tmp));
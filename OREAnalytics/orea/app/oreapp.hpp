@@ -96,6 +96,8 @@ protected:
                   const std::string& structuredLogFile = "", QuantLib::Size structuredLogRotationSize = 100 * 1024 * 1024);
     //! remove logs
     void closeLog();
+    //! write the profile trace and summary, if profiling is enabled in the inputs
+    void writeProfile();
 
     void initFromParams();
     void initFromInputs();
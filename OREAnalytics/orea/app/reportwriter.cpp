@@ -679,11 +679,11 @@ void ReportWriter::writeCashflowNpv(ore::data::Report& report, const ore::data::
     map<string, Real> npvMap;
     Date asof = Settings::instance().evaluationDate();
     for (Size i = 0; i < cashflowReport.rows(); ++i) {
-        string tradeId = QuantLib::ext::get<string>(cashflowReport.data(tradeIdColumn).at(i));
-        string tradeType = QuantLib::ext::get<string>(cashflowReport.data(tradeTypeColumn).at(i));
-        Date payDate = QuantLib::ext::get<Date>(cashflowReport.data(payDateColumn).at(i));
-        string ccy = QuantLib::ext::get<string>(cashflowReport.data(ccyColumn).at(i));
-        Real pv = QuantLib::ext::get<Real>(cashflowReport.data(pvColumn).at(i));
+        string tradeId = QuantLib::ext::get<string>(cashflowReport.value(tradeIdColumn, i));
+        string tradeType = QuantLib::ext::get<string>(cashflowReport.value(tradeTypeColumn, i));
+        Date payDate = QuantLib::ext::get<Date>(cashflowReport.value(payDateColumn, i));
+        string ccy = QuantLib::ext::get<string>(cashflowReport.value(ccyColumn, i));
+        Real pv = QuantLib::ext::get<Real>(cashflowReport.value(pvColumn, i));
         Real fx = 1.0;
 	// There shouldn't be entries in the cf report without ccy. We assume ccy = baseCcy in this case and log an error.
         if (ccy.empty()) {
@@ -1016,6 +1016,9 @@ void ReportWriter::writeXVA(ore::data::Report& report, const string& allocationM
                 .log();
         }
 
+        if (!postProcess->tradeLevelResults())
+            continue;
+
         for (auto& [tid, trade] : portfolio->trades()) {
 
             string nid = trade->envelope().nettingSetId();
@@ -1903,7 +1906,7 @@ void ReportWriter::writeCrifReport(const QuantLib::ext::shared_ptr<Report>& repo
     // Write individual CRIF records
     for (const auto& cr : crif) {
         
-        report->next().add(cr.tradeId).add(cr.portfolioId);
+        report->next().add(cr.tradeId).add(cr.portfolioId());
 
         if (hasNettingSetDetails) {
             map<string, string> crNettingSetDetailsMap = NettingSetDetails(cr.nettingSetDetails).mapRepresentation();
@@ -2190,10 +2193,15 @@ void ReportWriter::writeHistoricalScenarioDistributions(
 void ReportWriter::writeHistoricalScenarios(const QuantLib::ext::shared_ptr<HistoricalScenarioLoader>& hsloader,
                                             const QuantLib::ext::shared_ptr<ore::data::Report>& report) {
     // each scenario might have a different set of keys, so we collect the union of all keys
-    // and write them out (missing keys will be written as NA to the report)
+    // and write them out (missing keys will be written as NA to the report), scenarios loaded into
+    // a cube share the union of all keys already
     std::set<RiskFactorKey> allKeys;
-    for (const auto& s : hsloader->historicalScenarios())
-        allKeys.insert(s->keys().begin(), s->keys().end());
+    if (hsloader->scenarioCube()) {
+        allKeys.insert(hsloader->scenarioCube()->keys().begin(), hsloader->scenarioCube()->keys().end());
+    } else {
+        for (const auto& s : hsloader->historicalScenarios())
+            allKeys.insert(s->keys().begin(), s->keys().end());
+    }
     ScenarioWriter sw(nullptr, report, std::vector<RiskFactorKey>(allKeys.begin(), allKeys.end()));
     bool writeHeader = true;
     for (const auto& s : hsloader->historicalScenarios()) {
@@ -2413,14 +2421,14 @@ Real aggregateTradeFlow(const std::string& tradeId, const Date& d0, const Date&
 
     Real flow = 0.0;
     for (Size i = 0; i < cashFlowReport->rows(); ++i) {
-        string id = boost::get<string>(cashFlowReport->data(tradeIdColumn).at(i));
+        string id = boost::get<string>(cashFlowReport->value(tradeIdColumn, i));
 	if (id != tradeId)
 	    continue;
-	Date date = boost::get<Date>(cashFlowReport->data(dateColumn).at(i));
+	Date date = boost::get<Date>(cashFlowReport->value(dateColumn, i));
 	if (date <= d0 || date > d1)
 	    continue;
-	string ccy = boost::get<string>(cashFlowReport->data(ccyColumn).at(i));
-	Real amount = boost::get<Real>(cashFlowReport->data(amountColumn).at(i));
+	string ccy = boost::get<string>(cashFlowReport->value(ccyColumn, i));
+	Real amount = boost::get<Real>(cashFlowReport->value(amountColumn, i));
 	Real fx = 1.0;
 	if (ccy != baseCurrency)
 	    fx = market->fxRate(ccy + baseCurrency)->value();
@@ -2502,20 +2510,20 @@ void ReportWriter::writePnlReport(ore::data::Report& report,
 
     for (Size i = 0; i < t0NpvReport->rows(); ++i) {
         try {
-	    string tradeId = boost::get<string>(t0NpvReport->data(tradeIdColumn).at(i));
-	    string tradeId2 = boost::get<string>(t0NpvLaggedReport->data(tradeIdColumn).at(i));
-	    string tradeId3 = boost::get<string>(t1NpvLaggedReport->data(tradeIdColumn).at(i));
-	    string tradeId4 = boost::get<string>(t1NpvReport->data(tradeIdColumn).at(i));
+	    string tradeId = boost::get<string>(t0NpvReport->value(tradeIdColumn, i));
+	    string tradeId2 = boost::get<string>(t0NpvLaggedReport->value(tradeIdColumn, i));
+	    string tradeId3 = boost::get<string>(t1NpvLaggedReport->value(tradeIdColumn, i));
+	    string tradeId4 = boost::get<string>(t1NpvReport->value(tradeIdColumn, i));
 	    QL_REQUIRE(tradeId == tradeId2 && tradeId == tradeId3 && tradeId == tradeId4, "inconsistent ordering of NPV reports");
-	    string tradeType = boost::get<string>(t0NpvReport->data(tradeTypeColumn).at(i));
-	    Date maturityDate = boost::get<Date>(t0NpvReport->data(maturityDateColumn).at(i));
-            Real maturityTime = boost::get<Real>(t0NpvReport->data(maturityTimeColumn).at(i));
-	    string ccy = boost::get<string>(t0NpvReport->data(baseCcyColumn).at(i));
+	    string tradeType = boost::get<string>(t0NpvReport->value(tradeTypeColumn, i));
+	    Date maturityDate = boost::get<Date>(t0NpvReport->value(maturityDateColumn, i));
+            Real maturityTime = boost::get<Real>(t0NpvReport->value(maturityTimeColumn, i));
+	    string ccy = boost::get<string>(t0NpvReport->value(baseCcyColumn, i));
 	    QL_REQUIRE(ccy == baseCurrency, "inconsistent NPV and base currencies");
-            Real t0Npv = boost::get<Real>(t0NpvReport->data(npvBaseColumn).at(i));
-            Real t0NpvLagged = boost::get<Real>(t0NpvLaggedReport->data(npvBaseColumn).at(i));
-	    Real t1NpvLagged = boost::get<Real>(t1NpvLaggedReport->data(npvBaseColumn).at(i));
-	    Real t1Npv = boost::get<Real>(t1NpvReport->data(npvBaseColumn).at(i));
+            Real t0Npv = boost::get<Real>(t0NpvReport->value(npvBaseColumn, i));
+            Real t0NpvLagged = boost::get<Real>(t0NpvLaggedReport->value(npvBaseColumn, i));
+	    Real t1NpvLagged = boost::get<Real>(t1NpvLaggedReport->value(npvBaseColumn, i));
+	    Real t1Npv = boost::get<Real>(t1NpvReport->value(npvBaseColumn, i));
             
 	    Real hypotheticalCleanPnl = t0NpvLagged - t0Npv;
 	    Real periodFlow = aggregateTradeFlow(tradeId, startDate, endDate, t0CashFlowReport, market, baseCurrency);
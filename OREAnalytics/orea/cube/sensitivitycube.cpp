@@ -62,8 +62,10 @@ SensitivityCube::SensitivityCube(const QuantLib::ext::shared_ptr<NPVSensiCube>&
                                  const map<RiskFactorKey, QuantLib::Real>& targetShiftSizes,
                                  const map<RiskFactorKey, QuantLib::Real>& actualShiftSizes,
                                  const std::map<RiskFactorKey, ShiftScheme>& shiftSchemes)
-    : cube_(cube), scenarioDescriptions_(scenarioDescriptions), targetShiftSizes_(targetShiftSizes),
-      actualShiftSizes_(actualShiftSizes), shiftSchemes_(shiftSchemes) {
+    : cube_(cube), scenarioDescriptions_(scenarioDescriptions),
+      targetShiftSizes_(targetShiftSizes.begin(), targetShiftSizes.end()),
+      actualShiftSizes_(actualShiftSizes.begin(), actualShiftSizes.end()),
+      shiftSchemes_(shiftSchemes.begin(), shiftSchemes.end()) {
     initialise();
 }
 
@@ -72,8 +74,9 @@ SensitivityCube::SensitivityCube(const QuantLib::ext::shared_ptr<NPVSensiCube>&
                                  const map<RiskFactorKey, QuantLib::Real>& targetShiftSizes,
                                  const map<RiskFactorKey, QuantLib::Real>& actualShiftSizes,
                                  const std::map<RiskFactorKey, ShiftScheme>& shiftSchemes)
-    : cube_(cube), targetShiftSizes_(targetShiftSizes), actualShiftSizes_(actualShiftSizes),
-      shiftSchemes_(shiftSchemes) {
+    : cube_(cube), targetShiftSizes_(targetShiftSizes.begin(), targetShiftSizes.end()),
+      actualShiftSizes_(actualShiftSizes.begin(), actualShiftSizes.end()),
+      shiftSchemes_(shiftSchemes.begin(), shiftSchemes.end()) {
 
     // Populate scenarioDescriptions_ from string descriptions
     scenarioDescriptions_.reserve(scenarioDescriptions.size());
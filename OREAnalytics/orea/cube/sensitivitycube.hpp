@@ -31,6 +31,7 @@
 #include <ql/time/date.hpp>
 #include <ql/types.hpp>
 
+#include <unordered_map>
 #include <vector>
 
 #include <boost/bimap.hpp>
@@ -157,9 +158,10 @@ private:
 
     QuantLib::ext::shared_ptr<NPVSensiCube> cube_;
     std::vector<ShiftScenarioDescription> scenarioDescriptions_;
-    std::map<RiskFactorKey, QuantLib::Real> targetShiftSizes_;
-    std::map<RiskFactorKey, QuantLib::Real> actualShiftSizes_;
-    std::map<RiskFactorKey, ShiftScheme> shiftSchemes_;
+    // lookup only, hence hashed on the interned risk factor key
+    std::unordered_map<RiskFactorKey, QuantLib::Real> targetShiftSizes_;
+    std::unordered_map<RiskFactorKey, QuantLib::Real> actualShiftSizes_;
+    std::unordered_map<RiskFactorKey, ShiftScheme> shiftSchemes_;
 
     // Duplication between map keys below and these sets but trade-off
     // Means that we can return by reference in public inspector methods
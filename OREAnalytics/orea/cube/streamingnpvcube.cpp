@@ -0,0 +1,178 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <orea/cube/streamingnpvcube.hpp>
+
+#include <ql/errors.hpp>
+
+namespace ore {
+namespace analytics {
+
+namespace {
+QuantLib::ext::shared_ptr<NPVCube> createNettingSetCube(const QuantLib::Date& asof,
+                                                        const std::set<std::string>& nettingSetIds,
+                                                        const std::vector<QuantLib::Date>& dates, Size samples,
+                                                        Size depth) {
+    if (depth == 1)
+        return QuantLib::ext::make_shared<DoublePrecisionInMemoryCube>(asof, nettingSetIds, dates, samples, 0.0);
+    else
+        return QuantLib::ext::make_shared<DoublePrecisionInMemoryCubeN>(asof, nettingSetIds, dates, samples, depth,
+                                                                        0.0);
+}
+} // namespace
+
+StreamingNPVCube::StreamingNPVCube(const QuantLib::Date& asof, const std::set<std::string>& ids,
+                                   const std::vector<QuantLib::Date>& dates, Size samples, Size depth,
+                                   const std::map<std::string, std::string>& nettingSetMap)
+    : asof_(asof), dates_(dates), samples_(samples), depth_(depth) {
+
+    QL_REQUIRE(!ids.empty(), "StreamingNPVCube: no ids specified");
+    QL_REQUIRE(depth > 0, "StreamingNPVCube: depth must be > 0");
+
+    std::set<std::string> nettingSetIds;
+    for (auto const& id : ids) {
+        auto n = nettingSetMap.find(id);
+        QL_REQUIRE(n != nettingSetMap.end(), "StreamingNPVCube: no netting set given for id '" << id << "'");
+        idIdx_[id] = tradeNettingSetId_.size();
+        tradeNettingSetId_.push_back(n->second);
+        nettingSetIds.insert(n->second);
+    }
+
+    nettingSetCube_ = createNettingSetCube(asof, nettingSetIds, dates, samples, depth);
+
+    for (auto const& n : tradeNettingSetId_)
+        tradeNettingSetIndex_.push_back(nettingSetCube_->idsAndIndexes().at(n));
+
+    t0_.resize(ids.size() * depth, 0.0);
+    lastCell_.resize(ids.size() * depth, 0);
+    lastValue_.resize(ids.size() * depth, 0.0);
+}
+
+StreamingNPVCube::StreamingNPVCube(const std::vector<QuantLib::ext::shared_ptr<NPVCube>>& cubes) {
+
+    QL_REQUIRE(!cubes.empty(), "StreamingNPVCube: at least one cube must be given");
+
+    std::vector<QuantLib::ext::shared_ptr<StreamingNPVCube>> streamingCubes;
+    for (Size i = 0; i < cubes.size(); ++i) {
+        auto c = QuantLib::ext::dynamic_pointer_cast<StreamingNPVCube>(cubes[i]);
+        QL_REQUIRE(c, "StreamingNPVCube: cube #" << i << " is not a streaming cube");
+        QL_REQUIRE(c->numDates() == cubes[0]->numDates() && c->samples() == cubes[0]->samples() &&
+                       c->depth() == cubes[0]->depth(),
+                   "StreamingNPVCube: dimensions of cube #" << i << " do not match cube #0");
+        streamingCubes.push_back(c);
+    }
+
+    asof_ = cubes[0]->asof();
+    dates_ = cubes[0]->dates();
+    samples_ = cubes[0]->samples();
+    depth_ = cubes[0]->depth();
+
+    std::map<std::string, std::pair<Size, Size>> tradeSource;
+    std::set<std::string> nettingSetIds;
+    for (Size c = 0; c < streamingCubes.size(); ++c) {
+        for (auto const& [id, index] : streamingCubes[c]->idsAndIndexes()) {
+            QL_REQUIRE(tradeSource.insert(std::make_pair(id, std::make_pair(c, index))).second,
+                       "StreamingNPVCube: input cubes have duplicate id '" << id << "', this is not allowed");
+            nettingSetIds.insert(streamingCubes[c]->nettingSetId(index));
+        }
+    }
+
+    nettingSetCube_ = createNettingSetCube(asof_, nettingSetIds, dates_, samples_, depth_);
+
+    t0_.resize(tradeSource.size() * depth_, 0.0);
+    lastCell_.resize(tradeSource.size() * depth_, 0);
+    lastValue_.resize(tradeSource.size() * depth_, 0.0);
+
+    for (auto const& [id, source] : tradeSource) {
+        Size i = tradeNettingSetId_.size();
+        idIdx_[id] = i;
+        auto const& c = streamingCubes[source.first];
+        tradeNettingSetId_.push_back(c->nettingSetId(source.second));
+        tradeNettingSetIndex_.push_back(nettingSetCube_->idsAndIndexes().at(tradeNettingSetId_.back()));
+        for (Size d = 0; d < depth_; ++d)
+            t0_[i * depth_ + d] = c->getT0(source.second, d);
+    }
+
+    for (auto const& c : streamingCubes) {
+        auto const& source = c->nettingSetCube();
+        for (auto const& [nettingSetId, index] : source->idsAndIndexes()) {
+            Size target = nettingSetCube_->idsAndIndexes().at(nettingSetId);
+            for (Size d = 0; d < depth_; ++d)
+                nettingSetCube_->setT0(nettingSetCube_->getT0(target, d) + source->getT0(index, d), target, d);
+            for (Size j = 0; j < dates_.size(); ++j)
+                for (Size k = 0; k < samples_; ++k)
+                    for (Size d = 0; d < depth_; ++d)
+                        nettingSetCube_->set(nettingSetCube_->get(target, j, k, d) + source->get(index, j, k, d),
+                                             target, j, k, d);
+        }
+    }
+}
+
+void StreamingNPVCube::check(Size id, Size date, Size sample, Size depth) const {
+    QL_REQUIRE(id < idIdx_.size(), "StreamingNPVCube: id (" << id << ") out of range");
+    QL_REQUIRE(date < dates_.size(), "StreamingNPVCube: date (" << date << ") out of range");
+    QL_REQUIRE(sample < samples_, "StreamingNPVCube: sample (" << sample << ") out of range");
+    QL_REQUIRE(depth < depth_, "StreamingNPVCube: depth (" << depth << ") out of range");
+}
+
+Real StreamingNPVCube::getT0(Size id, Size depth) const {
+    check(id, 0, 0, depth);
+    return t0_[id * depth_ + depth];
+}
+
+void StreamingNPVCube::setT0(Real value, Size id, Size depth) {
+    check(id, 0, 0, depth);
+    Size n = tradeNettingSetIndex_[id];
+    Real& t0 = t0_[id * depth_ + depth];
+    nettingSetCube_->setT0(nettingSetCube_->getT0(n, depth) + value - t0, n, depth);
+    t0 = value;
+}
+
+Real StreamingNPVCube::get(Size id, Size date, Size sample, Size depth) const {
+    QL_FAIL("StreamingNPVCube: trade level values are not stored, use the netting set cube");
+}
+
+void StreamingNPVCube::set(Real value, Size id, Size date, Size sample, Size depth) {
+    check(id, date, sample, depth);
+    Size n = tradeNettingSetIndex_[id];
+    Size cell = date * samples_ + sample + 1;
+    Size pos = id * depth_ + depth;
+    Real delta = lastCell_[pos] == cell ? value - lastValue_[pos] : value;
+    lastCell_[pos] = cell;
+    lastValue_[pos] = value;
+    nettingSetCube_->set(nettingSetCube_->get(n, date, sample, depth) + delta, n, date, sample, depth);
+}
+
+void StreamingNPVCube::remove(Size id) {
+    QL_FAIL("StreamingNPVCube: can not remove id " << id << " since its values are already aggregated into netting set '"
+                                                   << nettingSetId(id) << "'");
+}
+
+void StreamingNPVCube::remove(Size id, Size sample) {
+    QL_FAIL("StreamingNPVCube: can not remove id " << id << ", sample " << sample
+                                                   << " since its values are already aggregated into netting set '"
+                                                   << nettingSetId(id) << "'");
+}
+
+const std::string& StreamingNPVCube::nettingSetId(Size id) const {
+    QL_REQUIRE(id < tradeNettingSetId_.size(), "StreamingNPVCube: id (" << id << ") out of range");
+    return tradeNettingSetId_[id];
+}
+
+} // namespace analytics
+} // namespace ore
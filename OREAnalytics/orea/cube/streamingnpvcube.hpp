@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file orea/cube/streamingnpvcube.hpp
+    \brief trade cube that aggregates values into netting sets as they are written
+    \ingroup cube
+*/
+
+#pragma once
+
+#include <orea/cube/inmemorycube.hpp>
+#include <orea/cube/npvcube.hpp>
+
+#include <map>
+#include <set>
+
+namespace ore {
+namespace analytics {
+
+using QuantLib::Real;
+using QuantLib::Size;
+
+//! NPV cube that streams trade values into netting set aggregates
+/*! The cube is indexed by trade ids like any other trade level cube, so that it can be filled by the valuation
+    engine and its calculators. Trade T0 values are stored, but values on the simulation dates are added to the
+    cell of the trade's netting set as they are set and are not kept at trade level. The memory footprint is
+    therefore driven by the number of netting sets instead of the number of trades.
+
+    Setting the same trade cell again replaces the previous contribution as long as no other cell of the trade was
+    set in between, which is the write pattern of the valuation calculators. get() and remove() are not available
+    for trade level values, so the valuation engine stops at the first trade error when it writes to this cube.
+
+    \ingroup cube
+*/
+class StreamingNPVCube : public NPVCube {
+public:
+    /*! ctor, \p nettingSetMap maps trade ids to netting set ids, it must contain all \p ids */
+    StreamingNPVCube(const QuantLib::Date& asof, const std::set<std::string>& ids,
+                     const std::vector<QuantLib::Date>& dates, Size samples, Size depth,
+                     const std::map<std::string, std::string>& nettingSetMap);
+
+    /*! ctor joining streaming cubes over disjoint sets of trades, the netting set values of trades in the same
+        netting set are added */
+    explicit StreamingNPVCube(const std::vector<QuantLib::ext::shared_ptr<NPVCube>>& cubes);
+
+    //! Return the length of each dimension
+    Size numIds() const override { return idIdx_.size(); }
+    Size numDates() const override { return dates_.size(); }
+    Size samples() const override { return samples_; }
+    Size depth() const override { return depth_; }
+
+    const std::map<std::string, Size>& idsAndIndexes() const override { return idIdx_; }
+    const std::vector<QuantLib::Date>& dates() const override { return dates_; }
+    QuantLib::Date asof() const override { return asof_; }
+
+    Real getT0(Size id, Size depth = 0) const override;
+    void setT0(Real value, Size id, Size depth = 0) override;
+
+    //! trade level values are not stored, this throws
+    Real get(Size id, Size date, Size sample, Size depth = 0) const override;
+    //! adds the value to the netting set of the trade
+    void set(Real value, Size id, Size date, Size sample, Size depth = 0) override;
+
+    //! aggregated values can not be split by trade, these throw
+    void remove(Size id) override;
+    void remove(Size id, Size sample) override;
+
+    //! aggregated values per netting set, ids are the netting set ids
+    const QuantLib::ext::shared_ptr<NPVCube>& nettingSetCube() const { return nettingSetCube_; }
+    //! netting set id of a trade
+    const std::string& nettingSetId(Size id) const;
+
+private:
+    void check(Size id, Size date, Size sample, Size depth) const;
+
+    QuantLib::Date asof_;
+    std::vector<QuantLib::Date> dates_;
+    Size samples_, depth_;
+    std::map<std::string, Size> idIdx_;
+    std::vector<std::string> tradeNettingSetId_;
+    std::vector<Size> tradeNettingSetIndex_;
+    std::vector<Real> t0_;
+    // last written cell (date * samples + sample + 1, 0 = none) and value per trade and depth
+    std::vector<Size> lastCell_;
+    std::vector<Real> lastValue_;
+    QuantLib::ext::shared_ptr<NPVCube> nettingSetCube_;
+};
+
+} // namespace analytics
+} // namespace ore
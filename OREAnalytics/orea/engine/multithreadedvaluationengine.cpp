@@ -21,16 +21,18 @@
 #include <orea/cube/inmemorycube.hpp>
 #include <orea/engine/multithreadedvaluationengine.hpp>
 #include <orea/engine/observationmode.hpp>
-#include <orea/scenario/clonedscenariogenerator.hpp>
+#include <orea/scenario/bufferedscenariogenerator.hpp>
 
 #include <ored/marketdata/clonedloader.hpp>
 #include <ored/marketdata/todaysmarket.hpp>
 #include <ored/portfolio/enginefactory.hpp>
 #include <ored/portfolio/trade.hpp>
 #include <ored/utilities/dategrid.hpp>
+#include <ored/utilities/profiler.hpp>
 
 #include <boost/timer/timer.hpp>
 
+#include <exception>
 #include <future>
 
 // #include <ctpl_stl.h>
@@ -108,6 +110,7 @@ void MultiThreadedValuationEngine::buildCube(
     const std::function<std::vector<QuantLib::ext::shared_ptr<ore::analytics::CounterpartyCalculator>>()>& cptyCalculators,
     bool mporStickyDate, bool dryRun) {
 
+    ORE_PROFILE_SCOPE("MultiThreadedValuationEngine::buildCube");
     boost::timer::cpu_timer timer;
 
     LOG("MultiThreadedValuationEngine::buildCube() was called");
@@ -203,18 +206,16 @@ void MultiThreadedValuationEngine::buildCube(
         LOG("Portfolio #" << i << " total avg pricing time : " << portfolioTotalAvgPricingTime[i] / 1E6 << " ms");
     }
 
-    // build scenario generators for each thread as clones of the original one
+    // build scenario generators for each thread reading from a buffer which is filled on this thread while the
+    // workers run, each worker needs all samples, the buffer holds at most scenarioBufferSamples of them
 
-    LOG("Cloning scenario generators for " << eff_nThreads << " threads...");
+    LOG("Build buffered scenario generators for " << eff_nThreads << " threads...");
+    constexpr Size scenarioBufferSamples = 32;
+    auto scenarioBuffer = QuantLib::ext::make_shared<ore::analytics::ScenarioBuffer>(
+        dateGrid_->dates(), nSamples_, eff_nThreads, scenarioBufferSamples);
     std::vector<QuantLib::ext::shared_ptr<ore::analytics::ScenarioGenerator>> scenarioGenerators;
-    auto tmp =
-        QuantLib::ext::make_shared<ore::analytics::ClonedScenarioGenerator>(scenarioGenerator_, dateGrid_->dates(), nSamples_);
-    scenarioGenerators.push_back(tmp);
-    DLOG("generator for thread 1 cloned.");
-    for (Size i = 1; i < eff_nThreads; ++i) {
-        scenarioGenerators.push_back(QuantLib::ext::make_shared<ore::analytics::ClonedScenarioGenerator>(*tmp));
-        DLOG("generator for thread " << (i + 1) << " cloned.");
-    }
+    for (Size i = 0; i < eff_nThreads; ++i)
+        scenarioGenerators.push_back(QuantLib::ext::make_shared<ore::analytics::BufferedScenarioGenerator>(scenarioBuffer, i));
 
     // build loaders for each thread as clones of the original one
 
@@ -263,13 +264,24 @@ void MultiThreadedValuationEngine::buildCube(
     for (Size i = 0; i < eff_nThreads; ++i) {
 
         auto job = [this, obsMode, dryRun, &calculators, &cptyCalculators, mporStickyDate, &portfoliosAsString,
-                    &scenarioGenerators, &loaders, &workerPricingStats, &progressIndicator](int id) -> resultType {
+                    &scenarioGenerators, &scenarioBuffer, &loaders, &workerPricingStats,
+                    &progressIndicator](int id) -> resultType {
+            // release the scenarios held for this thread when the job exits, also if we stopped early or failed,
+            // otherwise the scenario generation and the other workers would wait for this thread forever
+
+            struct ScenarioRelease {
+                ~ScenarioRelease() { buffer.finish(id); }
+                ore::analytics::ScenarioBuffer& buffer;
+                int id;
+            } scenarioRelease{*scenarioBuffer, id};
+
             // set thread local singletons
 
             QuantLib::Settings::instance().evaluationDate() = today_;
             ore::analytics::ObservationMode::instance().setMode(obsMode);
 
             LOG("Start thread " << id);
+            ORE_PROFILE_SCOPE("MultiThreadedValuationEngine::worker");
 
             int rc;
 
@@ -347,6 +359,10 @@ void MultiThreadedValuationEngine::buildCube(
 
                 ore::analytics::StructuredAnalyticsErrorMessage("Multithreaded Valuation Engine", "", e.what()).log();
                 rc = 1;
+            } catch (...) {
+                ore::analytics::StructuredAnalyticsErrorMessage("Multithreaded Valuation Engine", "",
+                                                                "unknown error").log();
+                rc = 1;
             }
 
             // exit
@@ -363,12 +379,25 @@ void MultiThreadedValuationEngine::buildCube(
         jobs.emplace_back(std::move(thread));
     }
 
+    // generate the scenarios for the workers, this must happen on this thread which owns the scenario generator
+
+    std::exception_ptr scenarioGenerationError;
+    try {
+        scenarioBuffer->produce(*scenarioGenerator_);
+    } catch (...) {
+        scenarioGenerationError = std::current_exception();
+        scenarioBuffer->abort();
+    }
+
     // check return codes from jobs
 
     // not needed if thread pool is used
     for (auto& t : jobs)
         t.join();
 
+    if (scenarioGenerationError)
+        std::rethrow_exception(scenarioGenerationError);
+
     for (Size i = 0; i < results.size(); ++i) {
         results[i].wait();
     }
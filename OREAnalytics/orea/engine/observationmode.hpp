@@ -42,7 +42,9 @@ private:
 
 public:
     //! Allowable mode mode
-    enum class Mode { None, Disable, Defer, Unregister };
+    /*! Graph disables notifications like Disable, but uses the ScenarioDependencyGraph of the sim market to
+        refresh only the term structures and trades that depend on changed quotes */
+    enum class Mode { None, Disable, Defer, Unregister, Graph };
 
     Mode mode() { return mode_; }
 
@@ -57,6 +59,8 @@ public:
             mode_ = Mode::Defer;
         else if (s == "Unregister")
             mode_ = Mode::Unregister;
+        else if (s == "Graph")
+            mode_ = Mode::Graph;
         else {
             QL_FAIL("Invalid ObserverMode string " << s);
         }
@@ -73,6 +73,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/numeric/ublas/operation.hpp>
 #include <boost/numeric/ublas/vector.hpp>
+#include <unordered_map>
 
 using namespace QuantLib;
 using namespace QuantExt;
@@ -315,7 +316,8 @@ void ParSensitivityAnalysis::computeParInstrumentSensitivities(const QuantLib::e
 
         // Since we are not using ValuationEngine we need to manually perform the trade updates here
         // TODO - explore means of utilising valuation engine
-        if (ObservationMode::instance().mode() == ObservationMode::Mode::Disable) {
+        if (ObservationMode::instance().mode() == ObservationMode::Mode::Disable ||
+            ObservationMode::instance().mode() == ObservationMode::Mode::Graph) {
             for (auto it : instruments_.parHelpers_)
                 it.second->deepUpdate();
             for (auto it : instruments_.parCaps_)
@@ -613,11 +615,18 @@ ParSensitivityConverter::ParSensitivityConverter(const ParSensitivityAnalysis::P
     }
 
     LOG("Populating Transposed Jacobi matrix");
+    std::unordered_map<RiskFactorKey, Size> parIndex, rawIndex;
+    for (auto const& k : parKeys_)
+        parIndex.emplace(k, parIndex.size());
+    for (auto const& k : rawKeys_)
+        rawIndex.emplace(k, rawIndex.size());
     for (auto const& p : parSensitivities) {
-        Size parIdx = std::distance(parKeys_.begin(), parKeys_.find(p.first.first));
-        Size rawIdx = std::distance(rawKeys_.begin(), rawKeys_.find(p.first.second));
-        QL_REQUIRE(parIdx < n_par, "internal error: parKey " << p.first.first << " not found in parKeys_");
-        QL_REQUIRE(rawIdx < n_raw, "internal error: rawKey " << p.first.second << " not found in parKeys_");
+        auto parIt = parIndex.find(p.first.first);
+        auto rawIt = rawIndex.find(p.first.second);
+        QL_REQUIRE(parIt != parIndex.end(), "internal error: parKey " << p.first.first << " not found in parKeys_");
+        QL_REQUIRE(rawIt != rawIndex.end(), "internal error: rawKey " << p.first.second << " not found in parKeys_");
+        Size parIdx = parIt->second;
+        Size rawIdx = rawIt->second;
         jacobi_transp(rawIdx, parIdx) = p.second;
         TLOG("Matrix entry [" << rawIdx << ", " << parIdx << "] ~ [raw:" << p.first.second << ", par:" << p.first.first
                               << "]: " << p.second);
@@ -649,8 +658,9 @@ ParSensitivityConverter::ParSensitivityConverter(const ParSensitivityAnalysis::P
 
     LOG("Invert Transposed Jacobi matrix");
     bool success = true;
+    SparseMatrix jacobi_transp_inv;
     try {
-        jacobi_transp_inv_ = blockMatrixInverse(jacobi_transp, blockIndices);
+        jacobi_transp_inv = blockMatrixInverse(jacobi_transp, blockIndices);
     } catch (const std::exception& e) {
         // something went wrong during the matrix inversion, so we run an extended analysis on the original matrix
         // to see whether there are zero or linearly dependent rows / columns
@@ -769,12 +779,17 @@ ParSensitivityConverter::ParSensitivityConverter(const ParSensitivityAnalysis::P
         success = false;
     }
     QL_REQUIRE(success, "Jacobi matrix inversion failed, see log file for more details.");
-    Real conditionNumber = modifiedMaxNorm(jacobi_transp) * modifiedMaxNorm(jacobi_transp_inv_);
+    Real conditionNumber = modifiedMaxNorm(jacobi_transp) * modifiedMaxNorm(jacobi_transp_inv);
     LOG("Inverse Jacobi done, condition number of Jacobi matrix is " << conditionNumber);
+    jacobiTranspInvCsr_ = QuantExt::CsrMatrix(jacobi_transp_inv);
+    LOG("Inverse Jacobi non-zero entries = " << jacobiTranspInvCsr_.nonZeros() << " ("
+                                             << 100.0 * static_cast<Real>(jacobiTranspInvCsr_.nonZeros()) /
+                                                    static_cast<Real>(n_par * n_raw)
+                                             << "%)");
     DLOG("Diagonal entries of Jacobi and inverse Jacobi:");
     DLOG("row/col              Jacobi             Inverse");
     for (Size j = 0; j < jacobi_transp.size1(); ++j) {
-        DLOG(right << setw(7) << j << setw(20) << jacobi_transp(j, j) << setw(20) << jacobi_transp_inv_(j, j));
+        DLOG(right << setw(7) << j << setw(20) << jacobi_transp(j, j) << setw(20) << jacobi_transp_inv(j, j));
     }
 }
 
@@ -784,10 +799,14 @@ ParSensitivityConverter::convertSensitivity(const boost::numeric::ublas::vector<
     DLOG("Start sensitivity conversion");
 
     Size dim = zeroSensitivities.size();
-    QL_REQUIRE(jacobi_transp_inv_.size1() == dim, "Size mismatch between Transoposed Jacobi inverse matrix ["
-                                                      << jacobi_transp_inv_.size1() << " x "
-                                                      << jacobi_transp_inv_.size2() << "] and zero sensitivity array ["
-                                                      << dim << "]");
+    QL_REQUIRE(jacobiTranspInvCsr_.rows() == dim, "Size mismatch between Transoposed Jacobi inverse matrix ["
+                                                      << jacobiTranspInvCsr_.rows() << " x "
+                                                      << jacobiTranspInvCsr_.columns()
+                                                      << "] and zero sensitivity array [" << dim << "]");
+
+    // nothing to convert, this also avoids taking the address of the first element of an empty vector below
+    if (dim == 0)
+        return zeroSensitivities;
 
     // Vector storing approximation for \frac{\partial V}{\partial z_i} for each zero factor z_i
     boost::numeric::ublas::vector<Real> zeroDerivs(dim);
@@ -795,7 +814,7 @@ ParSensitivityConverter::convertSensitivity(const boost::numeric::ublas::vector<
 
     // Vector initially storing approximation for \frac{\partial V}{\partial c_i} for each par factor c_i
     boost::numeric::ublas::vector<Real> parSensitivities(dim);
-    boost::numeric::ublas::axpy_prod(jacobi_transp_inv_, zeroDerivs, parSensitivities, true);
+    jacobiTranspInvCsr_.multiply(&zeroDerivs[0], &parSensitivities[0]);
 
     // Update parSensitivities vector to hold the first order approximation of the NPV change due to the configured
     // shift in each of the par factors c_i
@@ -806,6 +825,42 @@ ParSensitivityConverter::convertSensitivity(const boost::numeric::ublas::vector<
     return parSensitivities;
 }
 
+QuantExt::CsrMatrix ParSensitivityConverter::convertSensitivities(const QuantExt::CsrMatrix& zeroSensitivities,
+                                                                  const Size nThreads) const {
+
+    DLOG("Start batch sensitivity conversion for " << zeroSensitivities.rows() << " trades");
+
+    QL_REQUIRE(zeroSensitivities.columns() == jacobiTranspInvCsr_.columns(),
+               "Size mismatch between Jacobi inverse matrix [" << jacobiTranspInvCsr_.columns() << " x "
+                                                               << jacobiTranspInvCsr_.rows()
+                                                               << "] and zero sensitivity matrix ["
+                                                               << zeroSensitivities.rows() << " x "
+                                                               << zeroSensitivities.columns() << "]");
+
+    // Matrix storing approximation for \frac{\partial V}{\partial z_i} for each trade and zero factor z_i
+    std::vector<Real> zeroDerivs(zeroSensitivities.values());
+    for (Size k = 0; k < zeroDerivs.size(); ++k)
+        zeroDerivs[k] /= zeroShifts_[zeroSensitivities.columnIndices()[k]];
+    QuantExt::CsrMatrix zeroDerivsMatrix(zeroSensitivities.rows(), zeroSensitivities.columns(),
+                                         zeroSensitivities.rowPointers(), zeroSensitivities.columnIndices(),
+                                         std::move(zeroDerivs));
+
+    // Matrix storing approximation for \frac{\partial V}{\partial c_i} for each trade and par factor c_i, computed as
+    // the transpose of (J^T)^{-1} Z^T so that only the transposed inverse Jacobian has to be kept
+    QuantExt::CsrMatrix parDerivs =
+        QuantExt::multiply(jacobiTranspInvCsr_, zeroDerivsMatrix.transpose(), nThreads).transpose();
+
+    // Scale to the first order approximation of the NPV change due to the configured shift in the par factors
+    std::vector<Real> parSensitivities(parDerivs.values());
+    for (Size k = 0; k < parSensitivities.size(); ++k)
+        parSensitivities[k] *= parShifts_[parDerivs.columnIndices()[k]];
+
+    DLOG("Batch sensitivity conversion done");
+
+    return QuantExt::CsrMatrix(parDerivs.rows(), parDerivs.columns(), parDerivs.rowPointers(),
+                               parDerivs.columnIndices(), std::move(parSensitivities));
+}
+
 void ParSensitivityConverter::writeConversionMatrix(Report& report) const {
 
     // Report headers
@@ -814,17 +869,18 @@ void ParSensitivityConverter::writeConversionMatrix(Report& report) const {
     report.addColumn("dz/dc", double(), 12);
 
     // Write report contents i.e. entries where sparse matrix is non-zero
+    std::vector<RiskFactorKey> rawKeys(rawKeys_.begin(), rawKeys_.end());
     Size parIdx = 0;
     for (const auto& parKey : parKeys_) {
-        Size rawIdx = 0;
-        for (const auto& rawKey : rawKeys_) {
-            if (!close(jacobi_transp_inv_(parIdx, rawIdx), 0.0)) {
+        for (Size k = jacobiTranspInvCsr_.rowPointers()[parIdx]; k < jacobiTranspInvCsr_.rowPointers()[parIdx + 1];
+             ++k) {
+            Real value = jacobiTranspInvCsr_.values()[k];
+            if (!close(value, 0.0)) {
                 report.next();
-                report.add(to_string(rawKey));
+                report.add(to_string(rawKeys[jacobiTranspInvCsr_.columnIndices()[k]]));
                 report.add(to_string(parKey));
-                report.add(jacobi_transp_inv_(parIdx, rawIdx));
+                report.add(value);
             }
-            rawIdx++;
         }
         parIdx++;
     }
@@ -35,6 +35,8 @@
 #include <ored/portfolio/portfolio.hpp>
 #include <ored/report/report.hpp>
 
+#include <qle/math/csrmatrix.hpp>
+
 #include <ql/instruments/inflationcapfloor.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 
@@ -171,6 +173,10 @@ private:
       The number J of par instruments respectively zero shifts can differ between discount and index curves.
       The number of zero shifts matches the number of par instruments.
       The Jacobi matrix is therefore quadratic by construction.
+
+      The transposed Jacobi matrix is inverted once per curve block (see QuantExt::blockMatrixInverse) in the
+      constructor. The inverse is cached in CSR format, so that the conversion of a single trade is a sparse
+      matrix-vector product and the conversion of a whole portfolio is a single sparse matrix-matrix product.
  */
 class ParSensitivityConverter {
 public:
@@ -201,6 +207,15 @@ public:
     boost::numeric::ublas::vector<Real>
     convertSensitivity(const boost::numeric::ublas::vector<Real>& zeroSensitivities);
 
+    //! Takes a batch of zero sensitivities and returns the corresponding par sensitivities
+    /*! \param zeroSensitivities sparse matrix with one row per trade, the columns are ordered according to rawKeys()
+        \param nThreads          number of threads used to compute the rows of the result
+
+        \return sparse matrix with one row per trade, the columns are ordered according to parKeys()
+    */
+    QuantExt::CsrMatrix convertSensitivities(const QuantExt::CsrMatrix& zeroSensitivities,
+                                             const Size nThreads = 1) const;
+
     //! Write the inverse of the transposed Jacobian to the \p reportOut
     void writeConversionMatrix(ore::data::Report& reportOut) const;
 
@@ -209,7 +224,7 @@ public:
         for (const auto& parKey : parKeys_) {
             Size rawIdx = 0;
             for (const auto& rawKey : rawKeys_) {
-                results[{rawKey, parKey}] = jacobi_transp_inv_(parIdx, rawIdx);
+                results[{rawKey, parKey}] = jacobiTranspInvCsr_(parIdx, rawIdx);
                 rawIdx++;
             }
             parIdx++;
@@ -220,8 +235,8 @@ public:
 private:
     std::set<ore::analytics::RiskFactorKey> rawKeys_;
     std::set<ore::analytics::RiskFactorKey> parKeys_;
-    // transposed inverse Jacobian, i.e. the matrix we use for the zero-par conversion effectively
-    QuantLib::SparseMatrix jacobi_transp_inv_;
+    // transposed inverse Jacobian in CSR format (rows = par keys), i.e. the matrix we use for the zero-par conversion
+    QuantExt::CsrMatrix jacobiTranspInvCsr_;
     //! Vector of absolute zero shift sizes
     boost::numeric::ublas::vector<QuantLib::Real> zeroShifts_;
     //! Vector of absolute par shift sizes
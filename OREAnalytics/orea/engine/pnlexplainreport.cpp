@@ -185,9 +185,9 @@ void PnlExplainReport::closeReports(const QuantLib::ext::shared_ptr<MarketRiskRe
     QuantLib::ext::shared_ptr<InMemoryReport> report =
         QuantLib::ext::dynamic_pointer_cast<ore::data::InMemoryReport>(reports->reports().at(0));  
     
-    const vector<ore::data::Report::ReportType>& tradeIds = report->data(0);
-    for (Size j = 0; j < tradeIds.size(); j++) {
-        string tradeId = QuantLib::ext::get<std::string>(tradeIds[j]);
+    Size numTrades = report->rows();
+    for (Size j = 0; j < numTrades; j++) {
+        string tradeId = QuantLib::ext::get<std::string>(report->value(0, j));
         const auto& r = results_.find(tradeId);
         if (r == results_.end()) {
             StructuredAnalyticsWarningMessage("Pnl Explain", "Failed to generate Pnl Explain Records",
@@ -18,10 +18,12 @@
 */
 
 #include <orea/cube/npvcube.hpp>
+#include <orea/cube/streamingnpvcube.hpp>
 #include <orea/engine/cptycalculator.hpp>
 #include <orea/engine/observationmode.hpp>
 #include <orea/engine/valuationcalculator.hpp>
 #include <orea/engine/valuationengine.hpp>
+#include <orea/scenario/scenariosimmarket.hpp>
 #include <orea/simulation/simmarket.hpp>
 
 #include <ored/portfolio/optionwrapper.hpp>
@@ -30,6 +32,7 @@
 #include <ored/utilities/dategrid.hpp>
 #include <ored/utilities/log.hpp>
 #include <ored/utilities/parsers.hpp>
+#include <ored/utilities/profiler.hpp>
 #include <ored/utilities/progressbar.hpp>
 #include <ored/utilities/to_string.hpp>
 
@@ -47,6 +50,19 @@ using boost::timer::default_places;
 namespace ore {
 namespace analytics {
 
+namespace {
+// Trades with errors are removed from the output cube after the run. A streaming cube has added the trade's values to
+// its netting set already and can not remove them, so we stop at the first error instead.
+void checkTradeRemovable(const QuantLib::ext::shared_ptr<analytics::NPVCube>& outputCube, const string& tradeId,
+                         const string& error) {
+    QL_REQUIRE(!QuantLib::ext::dynamic_pointer_cast<StreamingNPVCube>(outputCube),
+               "ValuationEngine: trade '" << tradeId << "' failed (" << error
+                                          << "), it can not be removed from the streaming output cube since its values "
+                                             "are aggregated into its netting set. Fix or exclude the trade, or switch "
+                                             "off streamingAggregation.");
+}
+} // namespace
+
 ValuationEngine::ValuationEngine(const Date& today, const QuantLib::ext::shared_ptr<DateGrid>& dg,
                                  const QuantLib::ext::shared_ptr<SimMarket>& simMarket,
                                  const set<std::pair<string, QuantLib::ext::shared_ptr<ModelBuilder>>>& modelBuilders)
@@ -62,7 +78,7 @@ ValuationEngine::ValuationEngine(const Date& today, const QuantLib::ext::shared_
 void ValuationEngine::recalibrateModels() {
     ObservationMode::Mode om = ObservationMode::instance().mode();
     for (auto const& b : modelBuilders_) {
-        if (om == ObservationMode::Mode::Disable)
+        if (om == ObservationMode::Mode::Disable || om == ObservationMode::Mode::Graph)
             b.second->forceRecalculate();
         b.second->recalibrate();
     }
@@ -75,6 +91,8 @@ void ValuationEngine::buildCube(const QuantLib::ext::shared_ptr<data::Portfolio>
                                 QuantLib::ext::shared_ptr<analytics::NPVCube> outputCptyCube,
                                 vector<QuantLib::ext::shared_ptr<CounterpartyCalculator>> cptyCalculators, bool dryRun) {
 
+    ORE_PROFILE_SCOPE("ValuationEngine::buildCube");
+
     struct SimMarketResetter {
         SimMarketResetter(QuantLib::ext::shared_ptr<SimMarket> simMarket) : simMarket_(simMarket) {}
         ~SimMarketResetter() { simMarket_->reset(); }
@@ -144,6 +162,7 @@ void ValuationEngine::buildCube(const QuantLib::ext::shared_ptr<data::Portfolio>
             string expMsg = string("T0 valuation error: ") + e.what();
             StructuredTradeErrorMessage(tradeId, trade->tradeType(), "ScenarioValuation", expMsg.c_str()).log();
             tradeHasError[i] = true;
+            checkTradeRemovable(outputCube, tradeId, expMsg);
         }
 
         if (om == ObservationMode::Mode::Unregister) {
@@ -165,6 +184,17 @@ void ValuationEngine::buildCube(const QuantLib::ext::shared_ptr<data::Portfolio>
     }
     LOG("Total number of trades = " << portfolio->size());
 
+    // discover the trade dependencies while the instruments are calculated on the T0 market
+    dependencyGraph_ = nullptr;
+    if (om == ObservationMode::Mode::Graph) {
+        if (auto ssm = QuantLib::ext::dynamic_pointer_cast<ScenarioSimMarket>(simMarket_)) {
+            dependencyGraph_ = ssm->dependencyGraph();
+            dependencyGraph_->addTrades(trades);
+        } else {
+            WLOG("ValuationEngine: observation mode Graph requires a ScenarioSimMarket, all trades will be updated");
+        }
+    }
+
     if (!dates.empty() && dates.front() > simMarket_->asofDate()) {
         // the fixing manager is only required if sim dates contain future dates
         simMarket_->fixingManager()->initialise(portfolio, simMarket_);
@@ -178,6 +208,7 @@ void ValuationEngine::buildCube(const QuantLib::ext::shared_ptr<data::Portfolio>
     // e.g. MC convergence tests
     for (Size sample = 0; sample < (dryRun ? std::min<Size>(1, outputCube->samples()) : outputCube->samples());
          ++sample) {
+        ORE_PROFILE_SCOPE("ValuationEngine::sample");
         TLOG("ValuationEngine: apply scenario sample #" << sample);
 
         for (auto& [tradeId, trade] : portfolio->trades())
@@ -314,7 +345,8 @@ void ValuationEngine::runCalculators(bool isCloseOutDate, const std::map<std::st
         }
 
         // We can avoid checking mode here and always call updateQlInstruments()
-        if (om == ObservationMode::Mode::Disable || om == ObservationMode::Mode::Unregister)
+        if (om == ObservationMode::Mode::Disable || om == ObservationMode::Mode::Unregister ||
+            (om == ObservationMode::Mode::Graph && (dependencyGraph_ == nullptr || dependencyGraph_->isTradeDirty(j))))
             trade->instrument()->updateQlInstruments();
         try {
             for (auto& calc : calculators)
@@ -325,6 +357,7 @@ void ValuationEngine::runCalculators(bool isCloseOutDate, const std::map<std::st
                             ", sample = " + ore::data::to_string(sample) + ", label = " + label + ": " + e.what();
             StructuredTradeErrorMessage(trade->id(), trade->tradeType(), "ScenarioValuation", expMsg.c_str()).log();
             tradeHasError[j] = true;
+            checkTradeRemovable(outputCube, trade->id(), expMsg);
         }
     }
 }
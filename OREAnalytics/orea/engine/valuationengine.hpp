@@ -48,6 +48,7 @@ class NPVCube;
 class CounterpartyCalculator;
 class ValuationCalculator;
 class SimMarket;
+class ScenarioDependencyGraph;
 
 using std::set;
 
@@ -65,6 +66,9 @@ using std::set;
   In addition to storing the resulting NPVs it can be given any number of calculators
   that can store additional values in the cube.
 
+  In ObservationMode::Mode::Graph, only the trades that depend on changed market data are updated, using the
+  dependency graph of the ScenarioSimMarket.
+
   \ingroup simulation
 */
 class ValuationEngine : public ore::data::ProgressReporter {
@@ -127,6 +131,7 @@ private:
     QuantLib::ext::shared_ptr<ore::data::DateGrid> dg_;
     QuantLib::ext::shared_ptr<ore::analytics::SimMarket> simMarket_;
     set<std::pair<std::string, QuantLib::ext::shared_ptr<QuantExt::ModelBuilder>>> modelBuilders_;
+    QuantLib::ext::shared_ptr<ScenarioDependencyGraph> dependencyGraph_;
 };
 } // namespace analytics
 } // namespace ore
@@ -28,6 +28,7 @@
 
 #include <ored/report/inmemoryreport.hpp>
 #include <ored/scripting/engines/scriptedinstrumentpricingenginecg.hpp>
+#include <ored/utilities/profiler.hpp>
 #include <ored/utilities/to_string.hpp>
 
 #include <qle/ad/backwardderivatives.hpp>
@@ -98,6 +99,7 @@ XvaEngineCG::XvaEngineCG(const Size nThreads, const Date& asof,
     // Start Engine
 
     LOG("XvaEngineCG: started");
+    ORE_PROFILE_SCOPE("XvaEngineCG");
     boost::timer::cpu_timer timer;
 
     // Build T0 market
@@ -52,7 +52,8 @@ ZeroToParShiftConverter::ZeroToParShiftConverter(const ParSensitivityInstrumentB
     QL_REQUIRE(simMarket_ != nullptr, "ZeroToParShiftConverter: need a simmarket");
     simMarket_->reset();
 
-    if (ObservationMode::instance().mode() == ObservationMode::Mode::Disable) {
+    if (ObservationMode::instance().mode() == ObservationMode::Mode::Disable ||
+        ObservationMode::instance().mode() == ObservationMode::Mode::Graph) {
         for (auto it : instruments_.parHelpers_)
             it.second->deepUpdate();
         for (auto it : instruments_.parCaps_)
@@ -82,7 +83,8 @@ ZeroToParShiftConverter::parShifts(QuantLib::ext::shared_ptr<Scenario> scenario)
 
     market.market()->applyScenario(scenario);
     
-    if (ObservationMode::instance().mode() == ObservationMode::Mode::Disable) {
+    if (ObservationMode::instance().mode() == ObservationMode::Mode::Disable ||
+        ObservationMode::instance().mode() == ObservationMode::Mode::Graph) {
         for (auto it : instruments_.parHelpers_)
             it.second->deepUpdate();
         for (auto it : instruments_.parCaps_)
@@ -68,6 +68,7 @@
 #include <orea/cube/sensicube.hpp>
 #include <orea/cube/sensitivitycube.hpp>
 #include <orea/cube/sparsenpvcube.hpp>
+#include <orea/cube/streamingnpvcube.hpp>
 #include <orea/engine/amcvaluationengine.hpp>
 #include <orea/engine/bufferedsensitivitystream.hpp>
 #include <orea/engine/cptycalculator.hpp>
@@ -136,6 +137,7 @@
 #include <orea/saccrv/tradeparsers/swaptionparser.hpp>
 #include <orea/saccrv/tradeparsers/utils.hpp>
 #include <orea/scenario/aggregationscenariodata.hpp>
+#include <orea/scenario/bufferedscenariogenerator.hpp>
 #include <orea/scenario/clonedscenariogenerator.hpp>
 #include <orea/scenario/clonescenariofactory.hpp>
 #include <orea/scenario/crossassetmodelscenariogenerator.hpp>
@@ -147,7 +149,10 @@
 #include <orea/scenario/historicalscenarioloader.hpp>
 #include <orea/scenario/historicalscenarioreader.hpp>
 #include <orea/scenario/lgmscenariogenerator.hpp>
+#include <orea/scenario/riskfactornameregistry.hpp>
 #include <orea/scenario/scenario.hpp>
+#include <orea/scenario/scenariocube.hpp>
+#include <orea/scenario/scenariodependencygraph.hpp>
 #include <orea/scenario/scenariofactory.hpp>
 #include <orea/scenario/scenariofilter.hpp>
 #include <orea/scenario/scenariogenerator.hpp>
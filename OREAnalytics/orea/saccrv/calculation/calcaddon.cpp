@@ -36,7 +36,7 @@
 namespace ore {
 namespace analytics {
 
-SaccrvAddonCalculator::SaccrvAddonCalculator(SaccrvCalculationContext context)
+SaccrvAddonCalculator::SaccrvAddonCalculator(const SaccrvCalculationContext& context)
 : simplified_(context.simplified), oem_(context.OEM), counterpartyId_(context.counterpartyId), nettingsetId_(context.nettingsetId), isMargined_(context.isMargined), mporDays_(context.mporDays), hasIlliquidCollateral_(context.hasIlliquidCollateralOrOTCNotEasilyReplaced), applyMarginCallDisputes_(context.applyMarginCallDisputes), greaterThan5000Transactions_(context.greaterThan5000TransactionsNotCentrallyCleared), remarginFreq_(context.remarginFreq) {}
 
 double SaccrvAddonCalculator::calculate() {
@@ -77,7 +77,7 @@ double SaccrvAddonCalculator::calculate() {
 
 double SaccrvAddonCalculator::calculateIRDAddon(IRDData& irdData) {
     double totalAddon = 0.0;
-    auto supervisoryFactors = SaccrvConfigManager::getInstance()->getConfigurations().getSupervisoryFactors();
+    const SaccrvConfigurations& config = SaccrvConfigManager::getInstance()->getConfigurations();
 
     // Iterate over each currency in the IRD asset class
 
@@ -95,7 +95,7 @@ double SaccrvAddonCalculator::calculateIRDAddon(IRDData& irdData) {
             LOG("SACCRV: calculateIRDAddon - Adjusting supervisory factor based on trade characteristics");
             std::string tradeGroup = "IRD";
             std::string subClass = ""; // no subclass for IRD
-            supervisoryFactor = supervisoryFactors[tradeGroup][subClass].supervisory_factor;
+            supervisoryFactor = config.getSupervisoryFactor(tradeGroup, subClass).supervisory_factor;
         } else {
             supervisoryFactor = 0.005; // Default supervisory factor for IRD
         }
@@ -110,7 +110,7 @@ double SaccrvAddonCalculator::calculateIRDAddon(IRDData& irdData) {
             for (auto& trade : timeBucket.tradeData) {
                 int tradeIndex = &trade - &timeBucket.tradeData[0] + 1;
                 int totalTrades = timeBucket.tradeData.size();
-                LOG("SACCRV: calculateIRDAddon - Processing trade: " << tradeIndex << " of " << totalTrades << ", Trade ID: " << trade.trades.getId());
+                TLOG("SACCRV: calculateIRDAddon - Processing trade: " << tradeIndex << " of " << totalTrades << ", Trade ID: " << trade.trades.getId());
                 double maturityFactor = getMaturityFactor(trade.trades);
                 SingleTradeAddon tradeAddon(trade.trades, maturityFactor, simplified_);
                 tradeAddon.calculateAddon();
@@ -204,7 +204,7 @@ double SaccrvAddonCalculator::calculateFXAddon(FXData& fxData) {
 
 double SaccrvAddonCalculator::calculateCommodityAddon(CommodityData& commodityData) {
     double totalAddon = 0.0;
-    auto supervisoryFactors = SaccrvConfigManager::getInstance()->getConfigurations().getSupervisoryFactors();
+    const SaccrvConfigurations& config = SaccrvConfigManager::getInstance()->getConfigurations();
 
     // Iterating over hedging sets for commodities
     for (auto& hedgingSet : commodityData.hedgingSets) {
@@ -221,7 +221,7 @@ double SaccrvAddonCalculator::calculateCommodityAddon(CommodityData& commodityDa
             if (oem_) {
                 supervisoryFactor = 0.06; // Example factor for OEM
             } else {
-                supervisoryFactor = supervisoryFactors["Commodity"][commodityType.commodity].supervisory_factor;
+                supervisoryFactor = config.getSupervisoryFactor("Commodity", commodityType.commodity).supervisory_factor;
             }
 
             // Iterating over trades for a commodity type
@@ -273,7 +273,7 @@ double SaccrvAddonCalculator::calculateCommodityAddon(CommodityData& commodityDa
 
 double SaccrvAddonCalculator::calculateCreditAddon(CreditData& creditData) {
     double totalAddon = 0.0;
-    auto supervisoryFactors = SaccrvConfigManager::getInstance()->getConfigurations().getSupervisoryFactors();
+    const SaccrvConfigurations& config = SaccrvConfigManager::getInstance()->getConfigurations();
 
     // Maps to store the combined effective notional and add-on for each entity
     std::map<std::string, double> combinedEffectiveNotionals;
@@ -300,8 +300,8 @@ double SaccrvAddonCalculator::calculateCreditAddon(CreditData& creditData) {
 
     // Step 3: Calculate the add-on for each entity
     for (auto& refEntity : creditData.referenceEntities) {
-        double supervisoryFactor = supervisoryFactors["Credit"][refEntity.referenceEntity].supervisory_factor;
-        double correlation = supervisoryFactors["Credit"][refEntity.referenceEntity].correlation;
+        double supervisoryFactor = config.getSupervisoryFactor("Credit", refEntity.referenceEntity).supervisory_factor;
+        double correlation = config.getSupervisoryFactor("Credit", refEntity.referenceEntity).correlation;
         double entityEffectiveNotional = combinedEffectiveNotionals[refEntity.referenceEntity];
         entityAddOns[refEntity.referenceEntity] = entityEffectiveNotional * supervisoryFactor;
         refEntity.supervisoryCorel = correlation;
@@ -312,7 +312,7 @@ double SaccrvAddonCalculator::calculateCreditAddon(CreditData& creditData) {
     double systematicComponent = 0.0;
     double idiosyncraticComponent = 0.0;
     for (auto& addonPair : entityAddOns) {
-        double correlation = supervisoryFactors["Credit"][addonPair.first].correlation;
+        double correlation = config.getSupervisoryFactor("Credit", addonPair.first).correlation;
         systematicComponent += correlation * addonPair.second;
         idiosyncraticComponent += (1 - std::pow(correlation, 2)) * std::pow(addonPair.second, 2);
     }
@@ -336,7 +336,7 @@ double SaccrvAddonCalculator::calculateEquityAddon(EquityData& equityData) {
     std::vector<double> addons;
     std::vector<double> supervisoryCorrelations;
 
-    auto supervisoryFactors = SaccrvConfigManager::getInstance()->getConfigurations().getSupervisoryFactors();
+    const SaccrvConfigurations& config = SaccrvConfigManager::getInstance()->getConfigurations();
 
     // Iterate through reference entities for the equity asset class
     for (auto& refEntity : equityData.referenceEntities) {
@@ -364,11 +364,11 @@ double SaccrvAddonCalculator::calculateEquityAddon(EquityData& equityData) {
             supervisoryFactor = 0.32;
         } else {
             double factorMult = FactorMultiplierCalculator::CalculateFactorMult(refEntity.referenceEntity);
-            supervisoryFactor = factorMult * supervisoryFactors[assetClass][""].supervisory_factor; //TODO check no equity subclasses in superv table?
+            supervisoryFactor = factorMult * config.getSupervisoryFactor(assetClass, "").supervisory_factor; //TODO check no equity subclasses in superv table?
         }
 
         refEntity.addon *= supervisoryFactor;
-        double correlation = supervisoryFactors[assetClass][""].correlation; //TODO check
+        double correlation = config.getSupervisoryFactor(assetClass, "").correlation; //TODO check
         addons.push_back(refEntity.addon);
         supervisoryCorrelations.push_back(correlation);
 
@@ -394,7 +394,7 @@ double SaccrvAddonCalculator::calculateEquityAddon(EquityData& equityData) {
 
 double SaccrvAddonCalculator::calculateOtherExposureAddon(OtherExposureData& otherData) {
     double totalAddon = 0.0;
-    auto supervisoryFactors = SaccrvConfigManager::getInstance()->getConfigurations().getSupervisoryFactors();
+    const SaccrvConfigurations& config = SaccrvConfigManager::getInstance()->getConfigurations();
 
     // Iterate over each subclass in 'Other Exposure'
     for (auto& otherSubClass : otherData.otherSubClasses) {
@@ -454,7 +454,7 @@ double SaccrvAddonCalculator::aggregateAddonsWithCorrelation(const std::vector<d
 double SaccrvAddonCalculator::getMaturityFactor(const SaccrvTrades& trade) {
     double Ei = trade.getEi().value_or(1.0); // Default to 1 if Ei is not available
     double Si = trade.getSi().value_or(0.0); // Default to 0 if Si is not available
-    LOG("SACCRV: Ei: " << Ei << " Si: " << Si << " isMargined: " << isMargined_ << " mporDays: " << mporDays_ << " hasIlliquidCollateralOrOTCNotEasilyReplaced: " << hasIlliquidCollateral_ << " applyMarginCallDisputes: " << applyMarginCallDisputes_ << " greaterThan5000TransactionsNotCentrallyCleared: " << greaterThan5000Transactions_ << "");
+    TLOG("SACCRV: Ei: " << Ei << " Si: " << Si << " isMargined: " << isMargined_ << " mporDays: " << mporDays_ << " hasIlliquidCollateralOrOTCNotEasilyReplaced: " << hasIlliquidCollateral_ << " applyMarginCallDisputes: " << applyMarginCallDisputes_ << " greaterThan5000TransactionsNotCentrallyCleared: " << greaterThan5000Transactions_ << "");
     // Calculate the effective maturity as the maximum of (Ei - Si, 10 days), expressed in years
     double effectiveMaturity = std::max((Ei - Si), 10.0 / 250.0);
 
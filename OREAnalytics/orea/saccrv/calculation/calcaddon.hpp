@@ -34,7 +34,7 @@ namespace analytics {
 
 class SaccrvAddonCalculator {
 public:
-    SaccrvAddonCalculator(SaccrvCalculationContext context);
+    SaccrvAddonCalculator(const SaccrvCalculationContext& context);
 
     double calculate();
    
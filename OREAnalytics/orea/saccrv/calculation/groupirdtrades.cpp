@@ -90,7 +90,7 @@ void GroupIRDTrades::groupIRDTrades(const std::vector<SaccrvTrades>& groupTrades
                 tradeData.trades = trade;
                 // Add tradeData to the timeBucketNode
                 timeBucket_.tradeData.push_back(tradeData);
-                LOG("SACCRV GroupIRDTrades::groupIRDTrades - Added tradeData to the timeBucketNode ")
+                TLOG("SACCRV GroupIRDTrades::groupIRDTrades - Added tradeData to the timeBucketNode ")
             }
 
             // Add the timeBucketNode to the currency
@@ -126,7 +126,7 @@ std::map<int, std::vector<SaccrvTrades>> GroupIRDTrades::groupTradesByTimeBucket
                 WLOG("Ei value not found for IRD trade: " << trade.getId());
                 trade.setTimeBucket(0);
             }
-            LOG("SACCRV GroupIRDTrades::groupIRDTrades - trade.timeBucket set: " << trade.getTimeBucket())
+            TLOG("SACCRV GroupIRDTrades::groupIRDTrades - trade.timeBucket set: " << trade.getTimeBucket())
             groupedTrades[trade.getTimeBucket()].push_back(trade);
         }
     }
@@ -26,6 +26,7 @@
 #include <orea/saccrv/saccrvcalculationmanager.hpp>
 #include <orea/saccrv/calculation/handlebasisvol.hpp>
 #include <algorithm>
+#include <unordered_set>
 
 namespace ore {
 namespace analytics {
@@ -41,19 +42,15 @@ void GroupTradesManager::groupTrades(const std::vector<SaccrvTrades>& group_trad
         // auto saccrvCalcManager = SaccrvCalculationManager::getInstance();
         auto tradeCategorizer = std::make_unique<TradeCategorizer>();
 
-        std::vector<std::shared_ptr<SaccrvTrades>> group_trades_ptrs;
-        for (auto& trade : group_trades) {
-            group_trades_ptrs.push_back(std::make_shared<SaccrvTrades>(trade));
-        }
-        CategorizedTrades results = tradeCategorizer->handleBasisVol(group_trades_ptrs);
+        CategorizedTrades results = tradeCategorizer->handleBasisVol(group_trades);
+
+        // hash the categorised ids once, rather than searching tradeIdsAll for every trade below
+        const std::unordered_set<std::string> categorizedIds(results.tradeIdsAll.begin(), results.tradeIdsAll.end());
 
         std::vector<SaccrvTrades> trades_for_ids;
-        for (const auto& id : results.tradeIdsAll) {
-            auto it = std::find_if(group_trades.begin(), group_trades.end(), [&id](const SaccrvTrades& trade) {
-                return trade.getId() == id;
-            });
-            if (it != group_trades.end()) {
-                trades_for_ids.push_back(*it);
+        for (const auto& trade : group_trades) {
+            if (categorizedIds.count(trade.getId()) > 0) {
+                trades_for_ids.push_back(trade);
             }
         }
 
@@ -64,13 +61,12 @@ void GroupTradesManager::groupTrades(const std::vector<SaccrvTrades>& group_trad
             std::vector<SaccrvTrades> temp_trades;
 
             if (hedging_set == "normal_trades") {
-                std::copy_if(group_trades.begin(), group_trades.end(), std::back_inserter(temp_trades), [&results](const SaccrvTrades& trade) {
-                    return std::find(results.tradeIdsAll.begin(), results.tradeIdsAll.end(), trade.getId()) == results.tradeIdsAll.end();
-                    LOG("SACCRV: GroupTradesManager::groupTrades normal_trades trade id: " << trade.getId());
+                std::copy_if(group_trades.begin(), group_trades.end(), std::back_inserter(temp_trades), [&categorizedIds](const SaccrvTrades& trade) {
+                    return categorizedIds.count(trade.getId()) == 0;
                 });
             }
             else {
-                std::copy_if(group_trades.begin(), group_trades.end(), std::back_inserter(temp_trades), [&results, &hedging_set](const SaccrvTrades& trade) {
+                std::copy_if(group_trades.begin(), group_trades.end(), std::back_inserter(temp_trades), [&categorizedIds, &hedging_set](const SaccrvTrades& trade) {
                     // Calculate the hedging set based on the trade type
                     std::string trade_hedging_set;
                     if (trade.tradeType.rfind("Vol_", 0) == 0) {
@@ -81,8 +77,7 @@ void GroupTradesManager::groupTrades(const std::vector<SaccrvTrades>& group_trad
                         trade_hedging_set = "normal_trades";
                     }
 
-                    return std::find(results.tradeIdsAll.begin(), results.tradeIdsAll.end(), trade.getId()) != results.tradeIdsAll.end() && trade_hedging_set == hedging_set;
-                    LOG("SACCRV: GroupTradesManager::groupTrades hedging_set trade id: " << trade.getId());
+                    return categorizedIds.count(trade.getId()) > 0 && trade_hedging_set == hedging_set;
                 });
             } 
 
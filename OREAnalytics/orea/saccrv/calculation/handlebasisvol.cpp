@@ -26,18 +26,18 @@
 namespace ore {
 namespace analytics {
 
-CategorizedTrades TradeCategorizer::handleBasisVol(const std::vector<std::shared_ptr<SaccrvTrades>>& trades) {
+CategorizedTrades TradeCategorizer::handleBasisVol(const std::vector<SaccrvTrades>& trades) {
     CategorizedTrades categorizedTrades;
     std::map<std::string, std::vector<std::string>> basisTradeIds;
     std::set<std::string> basisHedgingSets;
 
     for (const auto& trade : trades) {
-        if (trade->tradeType == "Vol") {
-            categorizedTrades.tradeIds["Vol_" + trade->underlyingInstrument].push_back(trade->getId());
-        } else if (trade->tradeType == "Swap") {
-            if (isBasisSwap(*trade)) {
-                std::string setKey = trade->payLegRef + " " + trade->recLegRef;
-                basisTradeIds[setKey].push_back(trade->getId());
+        if (trade.tradeType == "Vol") {
+            categorizedTrades.tradeIds["Vol_" + trade.underlyingInstrument].push_back(trade.getId());
+        } else if (trade.tradeType == "Swap") {
+            if (isBasisSwap(trade)) {
+                std::string setKey = trade.payLegRef + " " + trade.recLegRef;
+                basisTradeIds[setKey].push_back(trade.getId());
             }
         }
     }
@@ -43,7 +43,7 @@ struct CategorizedTrades {
 
 class TradeCategorizer {
 public:
-    CategorizedTrades handleBasisVol(const std::vector<std::shared_ptr<SaccrvTrades>>& trades);
+    CategorizedTrades handleBasisVol(const std::vector<SaccrvTrades>& trades);
 
 private:
     bool isBasisSwap(const SaccrvTrades& trade);
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <stdexcept>
 #include <cmath> 
+#include <unordered_map>
 
 #include <orea/saccrv/calculation/runsaccrvcalcs.hpp>
 #include <orea/saccrv/saccrvcalculationmanager.hpp>
@@ -34,11 +35,12 @@
 #include <orea/saccrv/calculation/calcpfe.hpp>
 #include <orea/saccrv/calculation/calcrc.hpp>
 #include <orea/saccrv/calculation/calcmf.hpp>
+#include <ored/utilities/parallel.hpp>
 
 namespace ore {
 namespace analytics {
 
-RunSaccrvCalculations::RunSaccrvCalculations() {
+RunSaccrvCalculations::RunSaccrvCalculations(std::size_t nThreads) : nThreads_(nThreads) {
     calculationManager_ = SaccrvCalculationManager::getInstance();
 }
 
@@ -52,20 +54,14 @@ void RunSaccrvCalculations::runCalcs() {
     auto csaManager = SaccrvCsaManager::getInstance();
 
     // Fetch trade, collateral, CSA, and other necessary input data
-    auto trades = tradeInputManager->getTradeVector();
-    auto collaterals = collateralManager->getCollateralVector();
+    const auto& trades = tradeInputManager->getTradeVector();
+    const auto& collaterals = collateralManager->getCollateralVector();
     // csa are nettingsets with active CSA flag
     // VTODO - add new fields to the nettingset with active CSA including tradeGroups, hasIlliquidCollateral, applyMarginCallDisputes, greaterThan5000Transactions
-    auto csas = csaManager->getCsaVector();
-    // auto csas = vector<SaccrvCsa>();
+    const auto& csas = csaManager->getCsaVector();
     bool simplified = configManager->isSimplified();
     bool OEM = configManager->isOEM();
     bool ignoreMargin = configManager->shouldIgnoreMargin();
-    int mporDays = 0;
-    int remarginFreq = 0;
-  
-    std::string nettingsetId = "";
-    std::string unmargined_nettingsetId = "";
 
     // 1. Check if all trades are sold options
     auto trade_vol = tradeInputManager->getTradeVectorSize();
@@ -75,106 +71,111 @@ void RunSaccrvCalculations::runCalcs() {
         return; // EAD is zero
     }
 
-    // 2. Get unique counterparties from trades
+    // 2. Get unique counterparties from trades and bucket the trades and CSAs by counterparty in a single pass each
     auto counterparties = getUniqueCounterpartiesFromTrades(trades);
-    // Define filteredTrades and allMarginedTrades which collates all margined trades for a counterparty
-    std::vector<SaccrvTrades> filteredTrades;
-    // std::vector<SaccrvTrades> allMarginedTrades;
+    std::unordered_map<std::string, std::size_t> counterpartyIndex;
+    for (std::size_t i = 0; i < counterparties.size(); ++i)
+        counterpartyIndex[counterparties[i]] = i;
+
+    std::vector<std::vector<SaccrvTrades>> tradesByCounterparty(counterparties.size());
+    for (const auto& trade : trades)
+        tradesByCounterparty[counterpartyIndex.at(trade.getCounterparty())].push_back(trade);
+
+    std::vector<std::vector<const SaccrvCsa*>> csasByCounterparty(counterparties.size());
+    for (const auto& csa : csas) {
+        auto it = counterpartyIndex.find(csa.getCounterparty());
+        if (it != counterpartyIndex.end())
+            csasByCounterparty[it->second].push_back(&csa);
+    }
 
-    // 3. Loop over each counterparty
+    // 3. Create the counterparty objects up front, the counterparties are then processed independently of each other
     for (const auto& counterpartyId : counterparties) {
-        LOG("SACCRV: Looping over counterparties, current counterparty: " << counterpartyId);
-        // create counterparty object
         ore::analytics::Counterparty counterparty;
         counterparty.counterpartyId = counterpartyId;
-        // counterparty.nettingSets = {nettingsetId};
         calculationManager_->addCounterparty(counterparty);
+    }
 
- // 4. Select trades associated with current counterparty
-        auto tradesCpty = filterTradesByCounterparty(trades, counterpartyId);
-
-        // 5. Loop over each nettingset 
-        if (!csas.empty()) {
-            for (size_t i = 0; i < csas.size(); ++i) {
-                auto& csa = csas[i];
-                LOG("SACCRV: Looping over CSAs, current CSA: " << csa.getId());
-                // Get the id from the csa
-                nettingsetId = csa.getId();
-
-                // get mporDays for branching logic and for maturityFactor floor for margined transactions
-                mporDays = csa.getMporDays();
-                remarginFreq = csa.getRemarginFreq();
-                
-                // 6. If current counterparty is associated with current CSA 
-
-                if (counterpartyIsAssociatedWithCsa(counterpartyId, csa) && csa.isActive()) {
-                    // Select trades associated with CSA - collateralised
-                    LOG("SACCRV: Counterparty " << counterpartyId << " has collateralised nettingSet (active CSA): " << nettingsetId);
-                    filteredTrades = filterTradesByCsa(tradesCpty, csa);
-                    LOG("SACCRV: Selected trades associated with CSA: " << filteredTrades.size());
-
-                    // define context 
-                    SaccrvCalculationContext context_csa = createContext(counterpartyId, nettingsetId, filteredTrades, true, csa, simplified, collaterals, OEM, ignoreMargin);
-  
-                    // 7a. Calculate EAD for margined trades
-                    double EAD_margined = calculateEAD(context_csa);
-                    
-                    // 7b Calculate EAD as if unmargined trades
-                    unmargined_nettingsetId = nettingsetId + "_unmargined";
-                    SaccrvCalculationContext context_csa_unmargined_scenario = createContext(counterpartyId, unmargined_nettingsetId, filteredTrades, false, csa, simplified, collaterals, OEM, ignoreMargin);
-                    double EAD_unmargined = calculateEAD(context_csa_unmargined_scenario);
-
-                    // Use the minimum of the two EADs and update EAD
-                    double minEAD = std::min(EAD_margined, EAD_unmargined);
-                    calculationManager_->updateEAD(counterpartyId, nettingsetId, minEAD);
-                    // delete unmargined_nettingsetId as only needed for comparison purposes and will otherwise be a duplicate/inflate EAD
-                    calculationManager_->deleteNettingSet(counterpartyId, unmargined_nettingsetId);
-                    LOG("SACCRV: Updated EAD for Counterparty with min of margined and unmarginned trades: " << counterpartyId << " NettingSet: " << nettingsetId << " EAD: " << minEAD);
-                    
-                } else if (counterpartyIsAssociatedWithCsa(counterpartyId, csa) && !csa.isActive()) {
-                    // Select trades associated with a nettingset with an inactive CSA
-                    LOG("SACCRV: Counterparty " << counterpartyId << " has uncollateralised nettingSet (no active CSA): " << nettingsetId);
-                    filteredTrades = filterTradesByCsa(tradesCpty, csa);
-                    LOG("SACCRV: Selected trades associated with inactive CSA: " << filteredTrades.size());
-
-                    // define context 
-                    SaccrvCalculationContext context_no_active_csa = createContext(counterpartyId, nettingsetId, filteredTrades, false, SaccrvCsa(), simplified, collaterals, OEM, ignoreMargin);
-  
-                    // 7a. Calculate EAD for unmargined trades
-                    double EAD_no_active_csa = calculateEAD(context_no_active_csa);
-                    calculationManager_->updateEAD(counterpartyId, nettingsetId, EAD_no_active_csa);
-                    LOG("SACCRV: Updated EAD for Counterparty with uncollateralised nettingSet (unmargined trades, no active CSA): " << counterpartyId << " NettingSet: " << nettingsetId << " EAD: " << EAD_no_active_csa);
-                }
-            }
+    ore::data::runTasks(counterparties.size(), nThreads_, [&](const std::size_t i) {
+        runCounterpartyCalcs(counterparties[i], tradesByCounterparty[i], csasByCounterparty[i], collaterals, simplified,
+                             OEM, ignoreMargin);
+    });
 
-        } 
-        
-        // then process trades with no nettingset, where needed
-        std::vector<SaccrvTrades> filteredTrades = filterTradesWithNoNettingSets(tradesCpty);
-        if (!filteredTrades.empty()) {
-            // Handle the case where a trade has no nettingset
-            LOG("SACCRV: Trades found with no nettingset, processing EAD");
-            nettingsetId = "no_nettingSetTrades";
-            LOG("SACCRV: Selected trades with no nettingset: " << trades.size());
-            nettingsetId = "no_csa";
-
-            // create context
-            SaccrvCalculationContext context_no_csa = createContext(counterpartyId, nettingsetId, trades, false, SaccrvCsa(),simplified, collaterals, OEM, ignoreMargin);
-
-            // 7. Create netting set tree and calculate add-on, Calculate RC, PFE, and EAD for each set of trades
-            double EAD_no_csa = calculateEAD(context_no_csa);
-            calculationManager_->updateEAD(counterpartyId, nettingsetId, EAD_no_csa);
-            LOG("SACCRV: Updated EAD for trades with no nettingset: " << counterpartyId << " NettingSet: " << nettingsetId << " EAD: " << EAD_no_csa);
+    calculationManager_->sumNettingSetValuesToCounterparty();
+    calculationManager_->printCounterpartyCreditRiskExposureTree();
+    LOG("SACCRV: Summed values to counterparty");
+}
+
+void RunSaccrvCalculations::runCounterpartyCalcs(const std::string& counterpartyId,
+                                                 const std::vector<SaccrvTrades>& tradesCpty,
+                                                 const std::vector<const SaccrvCsa*>& csas,
+                                                 const std::vector<SaccrvCollateral>& collaterals, bool simplified,
+                                                 bool OEM, bool ignoreMargin) {
+    LOG("SACCRV: Looping over counterparties, current counterparty: " << counterpartyId);
+
+    // 4. Bucket the counterparty's trades by netting set
+    std::unordered_map<std::string, std::vector<SaccrvTrades>> tradesByNettingSet;
+    for (const auto& trade : tradesCpty)
+        tradesByNettingSet[trade.getNettingSet()].push_back(trade);
+    auto nettingSetTrades = [&tradesByNettingSet](const std::string& nettingsetId) {
+        auto it = tradesByNettingSet.find(nettingsetId);
+        return it == tradesByNettingSet.end() ? std::vector<SaccrvTrades>() : it->second;
+    };
+
+    // 5. Loop over each nettingset of the counterparty
+    for (const SaccrvCsa* csa : csas) {
+        LOG("SACCRV: Looping over CSAs, current CSA: " << csa->getId());
+        const std::string& nettingsetId = csa->getId();
+
+        if (csa->isActive()) {
+            // Select trades associated with CSA - collateralised
+            LOG("SACCRV: Counterparty " << counterpartyId << " has collateralised nettingSet (active CSA): " << nettingsetId);
+            std::vector<SaccrvTrades> filteredTrades = nettingSetTrades(nettingsetId);
+            LOG("SACCRV: Selected trades associated with CSA: " << filteredTrades.size());
+
+            // 7a. Calculate EAD for margined trades
+            double EAD_margined = calculateEAD(createContext(counterpartyId, nettingsetId, filteredTrades, true, *csa, simplified, collaterals, OEM, ignoreMargin));
+
+            // 7b Calculate EAD as if unmargined trades
+            std::string unmargined_nettingsetId = nettingsetId + "_unmargined";
+            double EAD_unmargined = calculateEAD(createContext(counterpartyId, unmargined_nettingsetId, std::move(filteredTrades), false, *csa, simplified, collaterals, OEM, ignoreMargin));
+
+            // Use the minimum of the two EADs and update EAD
+            double minEAD = std::min(EAD_margined, EAD_unmargined);
+            calculationManager_->updateEAD(counterpartyId, nettingsetId, minEAD);
+            // delete unmargined_nettingsetId as only needed for comparison purposes and will otherwise be a duplicate/inflate EAD
+            calculationManager_->deleteNettingSet(counterpartyId, unmargined_nettingsetId);
+            LOG("SACCRV: Updated EAD for Counterparty with min of margined and unmarginned trades: " << counterpartyId << " NettingSet: " << nettingsetId << " EAD: " << minEAD);
+
+        } else {
+            // Select trades associated with a nettingset with an inactive CSA
+            LOG("SACCRV: Counterparty " << counterpartyId << " has uncollateralised nettingSet (no active CSA): " << nettingsetId);
+            std::vector<SaccrvTrades> filteredTrades = nettingSetTrades(nettingsetId);
+            LOG("SACCRV: Selected trades associated with inactive CSA: " << filteredTrades.size());
+
+            // 7a. Calculate EAD for unmargined trades
+            double EAD_no_active_csa = calculateEAD(createContext(counterpartyId, nettingsetId, std::move(filteredTrades), false, SaccrvCsa(), simplified, collaterals, OEM, ignoreMargin));
+            calculationManager_->updateEAD(counterpartyId, nettingsetId, EAD_no_active_csa);
+            LOG("SACCRV: Updated EAD for Counterparty with uncollateralised nettingSet (unmargined trades, no active CSA): " << counterpartyId << " NettingSet: " << nettingsetId << " EAD: " << EAD_no_active_csa);
         }
+    }
 
-        calculationManager_->sumNettingSetValuesToCounterparty();
-        calculationManager_->printCounterpartyCreditRiskExposureTree();
-        LOG("SACCRV: Summed values to counterparty");
+    // then process trades with no nettingset, where needed
+    std::vector<SaccrvTrades> filteredTrades = nettingSetTrades("");
+    if (!filteredTrades.empty()) {
+        // Handle the case where a trade has no nettingset
+        LOG("SACCRV: Trades found with no nettingset, processing EAD");
+        LOG("SACCRV: Selected trades with no nettingset: " << filteredTrades.size());
+        std::string nettingsetId = "no_csa";
+
+        // 7. Create netting set tree and calculate add-on, Calculate RC, PFE, and EAD for each set of trades
+        double EAD_no_csa = calculateEAD(createContext(counterpartyId, nettingsetId, std::move(filteredTrades), false, SaccrvCsa(), simplified, collaterals, OEM, ignoreMargin));
+        calculationManager_->updateEAD(counterpartyId, nettingsetId, EAD_no_csa);
+        LOG("SACCRV: Updated EAD for trades with no nettingset: " << counterpartyId << " NettingSet: " << nettingsetId << " EAD: " << EAD_no_csa);
     }
 }
 
 
-double RunSaccrvCalculations::calculateEAD(SaccrvCalculationContext context) {
+double RunSaccrvCalculations::calculateEAD(const SaccrvCalculationContext& context) {
 
     calculationManager_->createSaccrvNettingSetTree(context.counterpartyId, context.nettingsetId, context.trades, context.isMargined);
     LOG("SACCRV: Created netting set tree for Counterparty: " << context.counterpartyId << " NettingSet: " << context.nettingsetId);
@@ -363,16 +364,15 @@ bool RunSaccrvCalculations::counterpartyIsAssociatedWithCsa(const std::string& c
 }
 
 
-SaccrvCalculationContext RunSaccrvCalculations::createContext(const std::string& counterpartyId, const std::string& nettingsetId, const std::vector<SaccrvTrades>& trades, bool isMargined, const SaccrvCsa& csa, bool simplified, const std::vector<SaccrvCollateral>& collaterals, bool OEM, bool ignoreMargin) {
+SaccrvCalculationContext RunSaccrvCalculations::createContext(const std::string& counterpartyId, const std::string& nettingsetId, std::vector<SaccrvTrades> trades, bool isMargined, const SaccrvCsa& csa, bool simplified, const std::vector<SaccrvCollateral>& collaterals, bool OEM, bool ignoreMargin) {
     SaccrvCalculationContext context;
     context.isMargined = isMargined;
     context.counterpartyId = counterpartyId;
     context.nettingsetId = nettingsetId;
-    context.trades = trades;
+    context.trades = std::move(trades);
     context.collaterals = collaterals;
     context.simplified = simplified;
     context.OEM = OEM;
-    context.collaterals = collaterals;
     context.ignoreMargin = ignoreMargin;
 
     if (!csa.isEmpty() || csa.isActive()) {
@@ -36,18 +36,24 @@ namespace analytics {
 class RunSaccrvCalculations {
 
 public:
-    RunSaccrvCalculations();
+    //! Counterparties are processed on up to \p nThreads threads
+    explicit RunSaccrvCalculations(std::size_t nThreads = 1);
     void runCalcs();
-    double calculateEAD(SaccrvCalculationContext context);
+    double calculateEAD(const SaccrvCalculationContext& context);
     std::vector<std::string> getUniqueCounterpartiesFromTrades(const std::vector<SaccrvTrades>& trades);
     std::vector<SaccrvTrades> filterTradesByCounterparty(const std::vector<SaccrvTrades>& trades, const std::string& counterpartyId);
     std::vector<SaccrvTrades> filterTradesWithNoNettingSet(const std::vector<SaccrvTrades>& trades);
     bool counterpartyIsAssociatedWithCsa(const std::string& counterpartyId, const SaccrvCsa& csa);
     bool allTradesAreSoldOptions(const std::vector<SaccrvTrades>& trades);
-    SaccrvCalculationContext createContext(const std::string& counterpartyId, const std::string& nettingsetId, const std::vector<SaccrvTrades>& trades, bool isMargined, const SaccrvCsa& csa, bool simplified, const std::vector<SaccrvCollateral>& collaterals, bool OEM, bool ignoreMargin);
+    SaccrvCalculationContext createContext(const std::string& counterpartyId, const std::string& nettingsetId, std::vector<SaccrvTrades> trades, bool isMargined, const SaccrvCsa& csa, bool simplified, const std::vector<SaccrvCollateral>& collaterals, bool OEM, bool ignoreMargin);
 
 private:
     SaccrvCalculationManager* calculationManager_; 
+    std::size_t nThreads_;
+    void runCounterpartyCalcs(const std::string& counterpartyId, const std::vector<SaccrvTrades>& tradesCpty,
+                              const std::vector<const SaccrvCsa*>& csas,
+                              const std::vector<SaccrvCollateral>& collaterals, bool simplified, bool OEM,
+                              bool ignoreMargin);
     std::vector<double> getMtmsForNettingSet(std::string counterpartyId, std::string nettingsetId);
     std::vector<SaccrvCollateral> filterCollateralsByCsa(const std::vector<SaccrvCollateral>& collaterals, const SaccrvCsa& csa);
     std::vector<SaccrvTrades> filterTradesByCsa(const std::vector<SaccrvTrades>& trades, const SaccrvCsa& csa);
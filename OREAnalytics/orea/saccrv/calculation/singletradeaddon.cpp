@@ -36,7 +36,7 @@ SingleTradeAddon::SingleTradeAddon(const SaccrvTrades& trade, double maturityFac
 }
 
 void SingleTradeAddon::calculateAddon() {
-    LOG("SACCRV: Calculating AddOn for trade: " << trade_.getId());
+    TLOG("SACCRV: Calculating AddOn for trade: " << trade_.getId());
     calculateAdjustedNotional();
     calculateSupervDelta();
     calculateEffectiveNotional();
@@ -84,17 +84,16 @@ void SingleTradeAddon::calculateAdjustedNotional() {
 
 
 void SingleTradeAddon::calculateSupervDelta() {
-    auto configManager = SaccrvConfigManager::getInstance();
-    auto supervisoryFactors = configManager->getConfigurations().getSupervisoryFactors();
-    std::string assetClass = trade_.getTradeGroup();
-    std::string subClass = trade_.getSubClass();
-    std::string buySell = trade_.getBuySell();
-    std::string optionType = trade_.getOptionType();
+    const SaccrvConfigurations& config = SaccrvConfigManager::getInstance()->getConfigurations();
+    const std::string& assetClass = trade_.getTradeGroup();
+    const std::string& subClass = trade_.getSubClass();
+    const std::string& buySell = trade_.getBuySell();
+    const std::string& optionType = trade_.getOptionType();
     double underlyingPrice = trade_.getUnderlyingPrice().value_or(1.0);
     double strikePrice = trade_.getStrikePrice().value_or(1.0);
     double Si = trade_.getSi().value_or(0.0);
     double Ei = trade_.getEi().value_or(1.0);
-    double supervVol = supervisoryFactors[assetClass][subClass].supervisory_option_volatility;
+    double supervVol = config.getSupervisoryFactor(assetClass, subClass).supervisory_option_volatility;
 
     if (simplified_) {
         supervDelta_ = (buySell == "Buy") ? 1.0 : -1.0;
@@ -179,7 +178,7 @@ double SingleTradeAddon::normalCDF(double value) {
 
 void SingleTradeAddon::calculateEffectiveNotional() {
     effectiveNotional_ = supervDelta_ * adjustedNotional_ * maturityFactor_;
-    LOG("SACCRV: Effective notional: " << effectiveNotional_ << " supervdelta: " << supervDelta_ << " adjusted notional: " << adjustedNotional_ << " maturity factor: " << maturityFactor_);
+    TLOG("SACCRV: Effective notional: " << effectiveNotional_ << " supervdelta: " << supervDelta_ << " adjusted notional: " << adjustedNotional_ << " maturity factor: " << maturityFactor_);
 }
 
 // class LongRiskFactorStrategy : public SupervDeltaStrategy {
@@ -50,7 +50,8 @@ public:
     }
 
 private:
-    SaccrvTrades trade_;
+    // the trade is referenced, it must outlive the add-on calculation
+    const SaccrvTrades& trade_;
     double adjustedNotional_;
     double maturityFactor_;
     double supervisoryFactor_;
@@ -51,9 +51,11 @@ SaccrvCalculationManager* SaccrvCalculationManager::getInstance() {
 void SaccrvCalculationManager::initialiseCounterpartyTree(const std::vector<Counterparty>& counterparties) {
     // Clear the existing data
     data_->counterparties.clear();
+    counterpartyIndex_.clear();
 
     // Populate the CounterpartyCreditRiskExposureTree with the input counterparties
     for (const auto& counterparty : counterparties) {
+        counterpartyIndex_[counterparty.counterpartyId] = data_->counterparties.size();
         data_->counterparties.push_back(counterparty);
     }
 }
@@ -68,9 +70,8 @@ void SaccrvCalculationManager::createSaccrvNettingSetTree(const std::string& cou
     LOG("SACCRV: Creating netting set tree for counterparty: " << counterpartyId << " netting set: " << nettingSetId);
 
     // Find the counterparty
-    auto counterpartyIt = std::find_if(data_->counterparties.begin(), data_->counterparties.end(),
-                                       [&counterpartyId](const Counterparty& c) { return c.counterpartyId == counterpartyId; });
-    if (counterpartyIt == data_->counterparties.end()) {
+    Counterparty* counterpartyIt = getCounterparty(counterpartyId);
+    if (counterpartyIt == nullptr) {
         LOG("SACCRV: Counterparty not found.");
         throw std::runtime_error("Counterparty not found.");
     }
@@ -107,42 +108,37 @@ void SaccrvCalculationManager::createSaccrvNettingSetTree(const std::string& cou
         // This lambda function captures the groupFXTrades instance by reference and calls the groupFXTrades method on it. It can be assigned to groupingFunc because it matches the signature of GroupingFuncType
         if (tradeGroup == "FX") {
             GroupFXTrades groupFXTrades;
-            std::vector<SaccrvTrades> tradesCopy = tradesForGroup;
-            groupingFunc = [&groupFXTrades](const std::vector<SaccrvTrades>& tradesCopy, const std::string& nettingSetId, const std::string& counterpartyId, const std::string& hedgingSetName) mutable {
-                groupFXTrades.groupFXTrades(tradesCopy, nettingSetId, counterpartyId,hedgingSetName);
+            groupingFunc = [&groupFXTrades](const std::vector<SaccrvTrades>& groupedTrades, const std::string& nettingSetId, const std::string& counterpartyId, const std::string& hedgingSetName) mutable {
+                groupFXTrades.groupFXTrades(groupedTrades, nettingSetId, counterpartyId,hedgingSetName);
             };
             LOG("SACCRV: Grouping FX trades");
         } else if (tradeGroup == "IRD") {
             GroupIRDTrades groupIRDTrades;
-            std::vector<SaccrvTrades> tradesCopy = tradesForGroup;
-            groupingFunc = [&groupIRDTrades](const std::vector<SaccrvTrades>& tradesCopy, const std::string& nettingSetId,  const std::string& counterpartyId,const std::string& hedgingSetName) mutable {
-                groupIRDTrades.groupIRDTrades(tradesCopy, nettingSetId, counterpartyId,hedgingSetName);
+            groupingFunc = [&groupIRDTrades](const std::vector<SaccrvTrades>& groupedTrades, const std::string& nettingSetId,  const std::string& counterpartyId,const std::string& hedgingSetName) mutable {
+                groupIRDTrades.groupIRDTrades(groupedTrades, nettingSetId, counterpartyId,hedgingSetName);
             };
             LOG("SACCRV: Grouping IRD trades");
         } else if (tradeGroup == "CreditSingle" || tradeGroup == "CreditIndex") {
             GroupCreditTrades groupCreditTrades;
-            std::vector<SaccrvTrades> tradesCopy = tradesForGroup;
-            groupingFunc = [&groupCreditTrades](const std::vector<SaccrvTrades>& tradesCopy, const std::string& nettingSetId,  const std::string& counterpartyId,const std::string& hedgingSetName) mutable {
-                groupCreditTrades.groupCreditTrades(tradesCopy, nettingSetId, counterpartyId,hedgingSetName);
+            groupingFunc = [&groupCreditTrades](const std::vector<SaccrvTrades>& groupedTrades, const std::string& nettingSetId,  const std::string& counterpartyId,const std::string& hedgingSetName) mutable {
+                groupCreditTrades.groupCreditTrades(groupedTrades, nettingSetId, counterpartyId,hedgingSetName);
             };
             LOG("SACCRV: Grouping Credit trades");
         } else if (tradeGroup == "Commodity") {
             GroupCommodityTrades groupCommodityTrades;
-            std::vector<SaccrvTrades> tradesCopy = tradesForGroup;
-            groupingFunc = [&groupCommodityTrades](const std::vector<SaccrvTrades>& tradesCopy, const std::string& nettingSetId, const std::string& counterpartyId,const std::string& hedgingSetName) mutable {
-                groupCommodityTrades.groupCommodityTrades(tradesCopy, nettingSetId, counterpartyId, hedgingSetName);
+            groupingFunc = [&groupCommodityTrades](const std::vector<SaccrvTrades>& groupedTrades, const std::string& nettingSetId, const std::string& counterpartyId,const std::string& hedgingSetName) mutable {
+                groupCommodityTrades.groupCommodityTrades(groupedTrades, nettingSetId, counterpartyId, hedgingSetName);
             };
             LOG("SACCRV: Grouping Commodity trades");
         } else {
             GroupOtherTrades groupOtherTrades;
-            std::vector<SaccrvTrades> tradesCopy = tradesForGroup;
-            groupingFunc = [&groupOtherTrades](const std::vector<SaccrvTrades>& tradesCopy, const std::string& nettingSetId,  const std::string& counterpartyId,const std::string& hedgingSetName) mutable {
-                groupOtherTrades.groupOtherTrades(tradesCopy, nettingSetId, counterpartyId, hedgingSetName);
+            groupingFunc = [&groupOtherTrades](const std::vector<SaccrvTrades>& groupedTrades, const std::string& nettingSetId,  const std::string& counterpartyId,const std::string& hedgingSetName) mutable {
+                groupOtherTrades.groupOtherTrades(groupedTrades, nettingSetId, counterpartyId, hedgingSetName);
             };
             LOG("SACCRV: Grouping Other trades");
         }
 
-        groupTradesManager.groupTrades({tradesForGroup}, groupingFunc,nettingSetId,counterpartyId);
+        groupTradesManager.groupTrades(tradesForGroup, groupingFunc,nettingSetId,counterpartyId);
         LOG("SACCRV: Grouped trades");
     }
 
@@ -301,7 +297,14 @@ int SaccrvCalculationManager::calculateTimeBucketForTrade(const TradeData& trade
 }
 
 Counterparty* SaccrvCalculationManager::getCounterparty(const std::string& counterpartyId) {
-    // Iterate over the list of counterparties
+    // Use the index if it is consistent with the tree, the counterparty vector is exposed by reference and may have
+    // been modified by the caller
+    auto idx = counterpartyIndex_.find(counterpartyId);
+    if (idx != counterpartyIndex_.end() && idx->second < data_->counterparties.size() &&
+        data_->counterparties[idx->second].counterpartyId == counterpartyId)
+        return &data_->counterparties[idx->second];
+
+    // Otherwise iterate over the list of counterparties
     for (auto& counterparty : data_->counterparties) {
         // If the ID of the current counterparty matches the input ID, return a pointer to this counterparty
         if (counterparty.counterpartyId == counterpartyId) {
@@ -313,6 +316,7 @@ Counterparty* SaccrvCalculationManager::getCounterparty(const std::string& count
 }
 
 void SaccrvCalculationManager::addCounterparty(Counterparty& counterparty) {
+    counterpartyIndex_[counterparty.counterpartyId] = data_->counterparties.size();
     data_->counterparties.push_back(counterparty);
 }
 
@@ -327,11 +331,11 @@ NettingSet* SaccrvCalculationManager::getNettingSet(const std::string& counterpa
     // Search for the netting set within the counterparty's netting sets
     for (NettingSet& nettingSet : counterparty->nettingSets) {
         if (nettingSet.id == nettingsetId) {
-            LOG("getNettingSet - Nettingset found:" << nettingsetId);
+            DLOG("getNettingSet - Nettingset found:" << nettingsetId);
             return &nettingSet; // Netting set found
         }
     }
-    LOG("getNettingSet - Nettingset NOT found:" << nettingsetId);
+    DLOG("getNettingSet - Nettingset NOT found:" << nettingsetId);
     return nullptr; //
 }
 void SaccrvCalculationManager::deleteNettingSet(const std::string& counterpartyId, const std::string& nettingsetId) {
@@ -26,6 +26,7 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <orea/saccrv/saccrvinputmanager.hpp>
 
 namespace ore {
@@ -265,6 +266,8 @@ private:
 
     std::shared_ptr<Counterparty> currentCounterparty_;
     std::shared_ptr<CounterpartyCreditRiskExposureTree> data_;
+    // position of each counterparty in data_->counterparties
+    std::unordered_map<std::string, std::size_t> counterpartyIndex_;
     void printIRD(const IRDData& ird);
     void printCommodity(const CommodityData& commodity);
     void printCredit(const CreditData& credit);
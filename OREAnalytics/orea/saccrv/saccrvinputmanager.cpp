@@ -61,10 +61,20 @@ std::string SaccrvConfigurations::getOutputFile() const {
     return outputFile;
 }
 
-std::map<std::string, std::map<std::string, SaccrvSupervisoryFactor>> SaccrvConfigurations::getSupervisoryFactors() const {
+const std::map<std::string, std::map<std::string, SaccrvSupervisoryFactor>>& SaccrvConfigurations::getSupervisoryFactors() const {
     return supervisoryFactors;
 }
 
+const SaccrvSupervisoryFactor& SaccrvConfigurations::getSupervisoryFactor(const std::string& assetClass,
+                                                                          const std::string& subClass) const {
+    static const SaccrvSupervisoryFactor none = {0.0, 0.0, 0.0};
+    auto a = supervisoryFactors.find(assetClass);
+    if (a == supervisoryFactors.end())
+        return none;
+    auto s = a->second.find(subClass);
+    return s == a->second.end() ? none : s->second;
+}
+
 std::vector<SaccrvCollateral> SaccrvConfigurations::getSaccrvCollateral() const {
     return saccrvCollateral;
 }
@@ -118,6 +128,10 @@ void SaccrvCsaManager::addSaccrvCsa(const SaccrvCsa& csaData) {
     csaVector.push_back(csaData);
 }
 
+void SaccrvCsaManager::clear() {
+    csaVector.clear();
+}
+
 const std::vector<SaccrvCsa>& SaccrvCsaManager::getCsaVector() const {
     return csaVector;
 }
@@ -204,6 +218,10 @@ void SaccrvTradesManager::updateSaccrvTradeType(const std::string& tradeId, cons
 }
 
 
+void SaccrvTradesManager::clear() {
+    tradeVector.clear();
+}
+
 const std::vector<SaccrvTrades>& SaccrvTradesManager::getTradeVector() const {
     return tradeVector;
 }
@@ -214,15 +232,15 @@ size_t SaccrvTradesManager::getTradeVectorSize() const {
 
 
 // Implementations for SaccrvTrades getters
-std::string SaccrvTrades::getTradeGroup() const {
+const std::string& SaccrvTrades::getTradeGroup() const {
     return tradeGroup;
 }
 
-std::string SaccrvTrades::getTradeType() const {
+const std::string& SaccrvTrades::getTradeType() const {
     return tradeType;
 }
 
-std::string SaccrvTrades::getSubClass() const {
+const std::string& SaccrvTrades::getSubClass() const {
     return subClass;
 }
 
@@ -234,7 +252,7 @@ std::optional<double> SaccrvTrades::getMtM() const {
     return mTm;
 }
 
-std::string SaccrvTrades::getCurrency() const {
+const std::string& SaccrvTrades::getCurrency() const {
     return currency;
 }
 
@@ -250,23 +268,23 @@ std::optional<double> SaccrvTrades::getTi() const {
     return Ti;
 }
 
-std::string SaccrvTrades::getBuySell() const {
+const std::string& SaccrvTrades::getBuySell() const {
     return buySell;
 }
 
-std::string SaccrvTrades::getId() const {
+const std::string& SaccrvTrades::getId() const {
     return id;
 }
 
-std::string SaccrvTrades::getCounterparty() const {
+const std::string& SaccrvTrades::getCounterparty() const {
     return counterparty;
 }
 
-std::string SaccrvTrades::getNettingSet() const {
+const std::string& SaccrvTrades::getNettingSet() const {
     return nettingSet;
 }
 
-std::string SaccrvTrades::getOptionType() const {
+const std::string& SaccrvTrades::getOptionType() const {
     return optionType;
 }
 
@@ -49,7 +49,10 @@ struct SaccrvConfigurations {
         // Getters
     std::map<std::string, bool> getAnalytics() const;
     std::string getOutputFile() const;
-    std::map<std::string, std::map<std::string, SaccrvSupervisoryFactor>> getSupervisoryFactors() const;
+    const std::map<std::string, std::map<std::string, SaccrvSupervisoryFactor>>& getSupervisoryFactors() const;
+    //! Supervisory factor of the given asset class and sub class, all fields are zero if there is none
+    const SaccrvSupervisoryFactor& getSupervisoryFactor(const std::string& assetClass,
+                                                        const std::string& subClass) const;
     boost::shared_ptr<NettingSetManager> getNettingSetManager() const;
     boost::shared_ptr<Portfolio> getSaccrvPortfolio() const;
     std::vector<SaccrvCollateral> getSaccrvCollateral() const;
@@ -90,6 +93,8 @@ private:
 public:
     static SaccrvCsaManager* getInstance();
     void addSaccrvCsa(const SaccrvCsa& csaData);
+    //! Remove all CSAs
+    void clear();
     const std::vector<SaccrvCsa>& getCsaVector() const;
     
 };
@@ -158,20 +163,20 @@ struct SaccrvTrades {
     SaccrvTrades(const double& mTm);
 
         // Getters
-    std::string getId() const;
-    std::string getTradeType() const;
-    std::string getTradeGroup() const;
-    std::string getSubClass() const;
+    const std::string& getId() const;
+    const std::string& getTradeType() const;
+    const std::string& getTradeGroup() const;
+    const std::string& getSubClass() const;
     std::optional<double> getNotional() const;
     std::optional<double> getMtM() const;
-    std::string getCurrency() const;
+    const std::string& getCurrency() const;
     std::optional<double> getSi() const;
     std::optional<double> getEi() const;
     std::optional<double> getTi() const;
-    std::string getBuySell() const;
-    std::string getCounterparty() const;
-    std::string getNettingSet() const;
-    std::string getOptionType() const;
+    const std::string& getBuySell() const;
+    const std::string& getCounterparty() const;
+    const std::string& getNettingSet() const;
+    const std::string& getOptionType() const;
     std::optional<double> getUnderlyingPrice() const;
     std::optional<double> getStrikePrice() const;
     int getQuantity() const;
@@ -271,6 +276,8 @@ public:
     void addSaccrvMtM(const std::string& tradeId, const double& mTm);
     void updateSaccrvTrade(const std::string& tradeId, const analytics::SaccrvTrades& updatedTrade);
     void updateSaccrvTradeType(const std::string& tradeId, const std::string& newTradeType);
+    //! Remove all trades
+    void clear();
     size_t getTradeVectorSize() const;
 
     // getters
@@ -27,6 +27,7 @@
 #include <ql/errors.hpp>
 #include <ql/types.hpp>
 #include <ql/patterns/observable.hpp>
+#include <ql/utilities/null.hpp>
 
 #include <fstream>
 #include <map>
@@ -101,13 +102,16 @@ private:
     Size dIndex_, sIndex_;
 };
 
-//! A concrete in memory implementation of AggregationScenarioData
-/*! \ingroup scenario
+//! A concrete in memory implementation of AggregationScenarioData storing the values as type T
+/*! The values of a key are stored contiguously, dates then samples. Values are converted to and from Real on set()
+    and get(), so that T = float halves the memory footprint at the cost of single precision storage.
+
+    \ingroup scenario
  */
-class InMemoryAggregationScenarioData : public AggregationScenarioData {
+template <typename T> class InMemoryAggregationScenarioDataBase : public AggregationScenarioData {
 public:
-    InMemoryAggregationScenarioData() : AggregationScenarioData(), dimDates_(0), dimSamples_(0) {}
-    InMemoryAggregationScenarioData(Size dimDates, Size dimSamples)
+    InMemoryAggregationScenarioDataBase() : AggregationScenarioData(), dimDates_(0), dimSamples_(0) {}
+    InMemoryAggregationScenarioDataBase(Size dimDates, Size dimSamples)
         : AggregationScenarioData(), dimDates_(dimDates), dimSamples_(dimSamples) {}
     Size dimDates() const override { return dimDates_; }
     Size dimSamples() const override { return dimSamples_; }
@@ -121,7 +125,8 @@ public:
     Real get(Size dateIndex, Size sampleIndex, const AggregationScenarioDataType& type,
              const string& qualifier = "") const override {
         check(dateIndex, sampleIndex, type, qualifier);
-        return data_.at(std::make_pair(type, qualifier))[dateIndex][sampleIndex];
+        T v = data_.at(std::make_pair(type, qualifier))[dateIndex * dimSamples_ + sampleIndex];
+        return v == QuantLib::Null<T>() ? QuantLib::Null<Real>() : static_cast<Real>(v);
     }
 
     std::vector<std::pair<AggregationScenarioDataType, std::string>> keys() const override {
@@ -137,9 +142,10 @@ public:
         auto key = std::make_pair(type, qualifier);
         auto it = data_.find(key);
         if (it == data_.end()) {
-            data_.insert(make_pair(key, vector<vector<Real>>(dimDates_, vector<Real>(dimSamples_, 0.0))));
+            it = data_.insert(make_pair(key, vector<T>(dimDates_ * dimSamples_, T(0.0)))).first;
         }
-        data_[key][dateIndex][sampleIndex] = value;
+        it->second[dateIndex * dimSamples_ + sampleIndex] =
+            value == QuantLib::Null<Real>() ? QuantLib::Null<T>() : static_cast<T>(value);
     }
 
 private:
@@ -151,9 +157,15 @@ private:
         return;
     }
     Size dimDates_, dimSamples_;
-    map<std::pair<AggregationScenarioDataType, string>, vector<vector<Real>>> data_;
+    map<std::pair<AggregationScenarioDataType, string>, vector<T>> data_;
 };
 
+//! In memory aggregation scenario data storing values in double precision
+using InMemoryAggregationScenarioData = InMemoryAggregationScenarioDataBase<double>;
+
+//! In memory aggregation scenario data storing values in single precision
+using SinglePrecisionInMemoryAggregationScenarioData = InMemoryAggregationScenarioDataBase<float>;
+
 inline std::ostream& operator<<(std::ostream& out, const AggregationScenarioDataType& t) {
     switch (t) {
     case AggregationScenarioDataType::IndexFixing:
@@ -0,0 +1,131 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <orea/scenario/bufferedscenariogenerator.hpp>
+
+#include <ored/utilities/log.hpp>
+
+#include <algorithm>
+
+namespace ore {
+namespace analytics {
+
+ScenarioBuffer::ScenarioBuffer(const std::vector<Date>& dates, const Size nSamples, const Size nConsumers,
+                               const Size capacity)
+    : dates_(dates), nSamples_(nSamples), capacity_(std::max<Size>(capacity, 1)), first_(0),
+      position_(nConsumers, 0), aborted_(false) {
+    QL_REQUIRE(!dates_.empty(), "ScenarioBuffer: no dates given");
+    QL_REQUIRE(nConsumers > 0, "ScenarioBuffer: no consumers given");
+}
+
+void ScenarioBuffer::produce(ScenarioGenerator& generator) {
+    DLOG("ScenarioBuffer: produce " << nSamples_ << " samples for " << dates_.size() << " dates, holding at most "
+                                    << capacity_ << " samples");
+    generator.reset();
+    for (Size i = 0; i < nSamples_; ++i) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            released_.wait(lock, [this] {
+                return aborted_ || samples_.size() < capacity_ ||
+                       *std::min_element(position_.begin(), position_.end()) == nSamples_;
+            });
+            if (aborted_ || *std::min_element(position_.begin(), position_.end()) == nSamples_) {
+                DLOG("ScenarioBuffer: stop production after " << i << " samples");
+                return;
+            }
+        }
+        // the generator is only used by this thread, so the scenarios are generated without holding the lock
+        std::vector<QuantLib::ext::shared_ptr<Scenario>> sample(dates_.size());
+        for (Size j = 0; j < dates_.size(); ++j)
+            sample[j] = generator.next(dates_[j])->clone();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            samples_.push_back(std::move(sample));
+        }
+        produced_.notify_all();
+    }
+}
+
+void ScenarioBuffer::abort() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        aborted_ = true;
+    }
+    produced_.notify_all();
+    released_.notify_all();
+}
+
+QuantLib::ext::shared_ptr<Scenario> ScenarioBuffer::scenario(const Size consumer, const Size sample,
+                                                             const Size dateIndex) {
+    QL_REQUIRE(sample < nSamples_, "ScenarioBuffer: sample " << sample << " out of range, have " << nSamples_);
+    QL_REQUIRE(dateIndex < dates_.size(),
+               "ScenarioBuffer: date index " << dateIndex << " out of range, have " << dates_.size());
+    std::unique_lock<std::mutex> lock(mutex_);
+    QL_REQUIRE(sample >= position_.at(consumer),
+               "ScenarioBuffer: consumer " << consumer << " requests sample " << sample << " after sample "
+                                           << position_[consumer] << ", samples must be read in increasing order");
+    if (sample > position_[consumer]) {
+        position_[consumer] = sample;
+        release();
+    }
+    produced_.wait(lock, [this, sample] { return aborted_ || sample < first_ + samples_.size(); });
+    QL_REQUIRE(!aborted_, "ScenarioBuffer: scenario generation was aborted");
+    return samples_[sample - first_][dateIndex];
+}
+
+void ScenarioBuffer::finish(const Size consumer) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        position_.at(consumer) = nSamples_;
+        release();
+    }
+    released_.notify_all();
+}
+
+void ScenarioBuffer::release() {
+    Size minPosition = *std::min_element(position_.begin(), position_.end());
+    bool released = false;
+    while (first_ < minPosition && !samples_.empty()) {
+        samples_.pop_front();
+        ++first_;
+        released = true;
+    }
+    if (released)
+        released_.notify_all();
+}
+
+BufferedScenarioGenerator::BufferedScenarioGenerator(const QuantLib::ext::shared_ptr<ScenarioBuffer>& buffer,
+                                                     const Size consumer)
+    : buffer_(buffer), consumer_(consumer) {
+    for (Size i = 0; i < buffer_->dates().size(); ++i)
+        dates_[buffer_->dates()[i]] = i;
+}
+
+QuantLib::ext::shared_ptr<Scenario> BufferedScenarioGenerator::next(const Date& d) {
+    if (d == buffer_->dates().front()) // new path
+        ++nSim_;
+    auto stepIdx = dates_.find(d);
+    QL_REQUIRE(stepIdx != dates_.end(), "BufferedScenarioGenerator::next(" << d << "): invalid date " << d);
+    QL_REQUIRE(nSim_ > 0, "BufferedScenarioGenerator::next(" << d << "): first date of the path expected");
+    return buffer_->scenario(consumer_, nSim_ - 1, stepIdx->second);
+}
+
+void BufferedScenarioGenerator::reset() { nSim_ = 0; }
+
+} // namespace analytics
+} // namespace ore
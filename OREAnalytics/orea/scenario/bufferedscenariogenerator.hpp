@@ -0,0 +1,92 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file scenario/bufferedscenariogenerator.hpp
+    \brief Scenarios generated on one thread and consumed by several threads
+    \ingroup scenario
+*/
+
+#pragma once
+
+#include <orea/scenario/scenariogenerator.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace ore {
+namespace analytics {
+
+//! Scenario buffer shared between a producing and several consuming threads
+/*! The producer runs the scenario generator sample by sample and publishes the scenarios of each completed sample.
+    The consumers read the samples in increasing order. A sample is released once all consumers have moved past it,
+    and the producer waits while capacity samples are held. So the memory is bounded by the distance between the
+    fastest and the slowest consumer, and the consumers start as soon as the first sample is available. The
+    scenarios are the ones of a single run of the generator, so the results do not depend on the number of
+    consumers. */
+class ScenarioBuffer {
+public:
+    ScenarioBuffer(const std::vector<Date>& dates, const Size nSamples, const Size nConsumers, const Size capacity);
+
+    //! generate the samples, returns early if all consumers finished, must be called on the generator's thread
+    void produce(ScenarioGenerator& generator);
+    //! stop the production, consumers waiting for a sample throw
+    void abort();
+
+    //! scenario for the given sample and date index, waits until the sample is produced
+    QuantLib::ext::shared_ptr<Scenario> scenario(const Size consumer, const Size sample, const Size dateIndex);
+    //! the consumer does not need any more samples
+    void finish(const Size consumer);
+
+    const std::vector<Date>& dates() const { return dates_; }
+
+private:
+    // release the samples all consumers have moved past, requires the lock
+    void release();
+
+    std::vector<Date> dates_;
+    Size nSamples_, capacity_;
+
+    std::mutex mutex_;
+    std::condition_variable produced_, released_;
+    // the samples first_, first_ + 1, ... that are still needed
+    std::deque<std::vector<QuantLib::ext::shared_ptr<Scenario>>> samples_;
+    Size first_;
+    // the sample each consumer reads, nSamples_ once it has finished
+    std::vector<Size> position_;
+    bool aborted_;
+};
+
+//! Scenario generator of one consumer of a ScenarioBuffer
+class BufferedScenarioGenerator : public ScenarioGenerator {
+public:
+    BufferedScenarioGenerator(const QuantLib::ext::shared_ptr<ScenarioBuffer>& buffer, const Size consumer);
+    QuantLib::ext::shared_ptr<Scenario> next(const Date& d) override;
+    //! only valid before the first sample was released by the buffer
+    void reset() override;
+
+private:
+    QuantLib::ext::shared_ptr<ScenarioBuffer> buffer_;
+    Size consumer_;
+    std::map<Date, Size> dates_;
+    Size nSim_ = 0;
+};
+
+} // namespace analytics
+} // namespace ore
@@ -263,18 +263,42 @@ QuantLib::ext::shared_ptr<Scenario> HistoricalScenarioGenerator::next(const Date
     QL_REQUIRE(d >= baseScenario_->asof(), "Cannot generate a scenario in the past");
     QuantLib::ext::shared_ptr<Scenario> scen = scenarioFactory_->buildScenario(d, true, std::string(), 1.0);
 
+    // historical scenarios stored in a cube are read by key index instead of key lookups
+    auto c1 = QuantLib::ext::dynamic_pointer_cast<ScenarioCubeView>(s1);
+    auto c2 = QuantLib::ext::dynamic_pointer_cast<ScenarioCubeView>(s2);
+    const ScenarioCube* cube = c1 && c2 && c1->cube() == c2->cube() ? c1->cube().get() : nullptr;
+    const auto& baseKeys = baseScenario_->keys();
+    if (cube != nullptr && (cubeKeyIndex_.size() != baseKeys.size() ||
+                            cubeKeyIndexSource_ != std::make_pair(baseScenario_.get(), cube))) {
+        cubeKeyIndex_.resize(baseKeys.size());
+        for (Size j = 0; j < baseKeys.size(); ++j)
+            cubeKeyIndex_[j] = cube->keyIndex(baseKeys[j]);
+        cubeKeyIndexSource_ = std::make_pair(baseScenario_.get(), cube);
+    }
+
     // loop over all keys
-    calculationDetails_.resize(baseScenario_->keys().size());
+    calculationDetails_.resize(baseKeys.size());
     Size calcDetailsCounter = 0;
-    for (auto const& key : baseScenario_->keys()) {
+    for (Size j = 0; j < baseKeys.size(); ++j) {
+        const RiskFactorKey& key = baseKeys[j];
         Real base = baseScenario_->get(key);
+        Real h1 = Null<Real>(), h2 = Null<Real>();
+        if (cube != nullptr) {
+            if (Size k = cubeKeyIndex_[j]; k != Null<Size>()) {
+                h1 = cube->get(k, c1->index());
+                h2 = cube->get(k, c2->index());
+            }
+        } else if (s1->has(key) && s2->has(key)) {
+            h1 = s1->get(key);
+            h2 = s2->get(key);
+        }
         Real v1 = 1.0, v2 = 1.0;
-        if (!s1->has(key) || !s2->has(key)) {
+        if (h1 == Null<Real>() || h2 == Null<Real>()) {
             DLOG("Missing key in historical scenario (" << io::iso_date(s1->asof()) << "," << io::iso_date(s2->asof())
                                                         << "): " << key << " => no move in this factor");
         } else {
-            v1 = adjustedPrice(key, s1->asof(), s1->get(key));
-            v2 = adjustedPrice(key, s2->asof(), s2->get(key));
+            v1 = adjustedPrice(key, s1->asof(), h1);
+            v2 = adjustedPrice(key, s2->asof(), h2);
         }
         Real value = 0.0;
 
@@ -508,14 +532,15 @@ QuantLib::ext::shared_ptr<HistoricalScenarioGenerator> buildHistoricalScenarioGe
     const QuantLib::ext::shared_ptr<ore::data::AdjustmentFactors>& adjFactors, const TimePeriod& period,
     Calendar calendar, Size mporDays,
     const QuantLib::ext::shared_ptr<ScenarioSimMarketParameters>& simParams,
-    const QuantLib::ext::shared_ptr<TodaysMarketParameters>& marketParams, const bool overlapping) {
+    const QuantLib::ext::shared_ptr<TodaysMarketParameters>& marketParams, const bool overlapping,
+    const bool singlePrecision) {
 
     hsr->load(simParams, marketParams);
 
     auto scenarioFactory = QuantLib::ext::make_shared<SimpleScenarioFactory>(true);
 
     QuantLib::ext::shared_ptr<HistoricalScenarioLoader> scenarioLoader = QuantLib::ext::make_shared<HistoricalScenarioLoader>(
-        hsr, period.startDates().front(), period.endDates().front(), calendar);
+        hsr, period.startDates().front(), period.endDates().front(), calendar, singlePrecision);
 
     // Create the historical scenario generator
     return QuantLib::ext::make_shared<HistoricalScenarioGenerator>(scenarioLoader, scenarioFactory, calendar, adjFactors,
@@ -526,7 +551,7 @@ QuantLib::ext::shared_ptr<HistoricalScenarioGenerator> buildHistoricalScenarioGe
     const QuantLib::ext::shared_ptr<HistoricalScenarioReader>& hsr,
     const QuantLib::ext::shared_ptr<ore::data::AdjustmentFactors>& adjFactors, const std::set<QuantLib::Date>& dates,
     const QuantLib::ext::shared_ptr<ScenarioSimMarketParameters>& simParams,
-    const QuantLib::ext::shared_ptr<TodaysMarketParameters>& marketParams) {
+    const QuantLib::ext::shared_ptr<TodaysMarketParameters>& marketParams, const bool singlePrecision) {
 
     hsr->load(simParams, marketParams);
 
@@ -534,7 +559,7 @@ QuantLib::ext::shared_ptr<HistoricalScenarioGenerator> buildHistoricalScenarioGe
 
     QuantLib::ext::shared_ptr<HistoricalScenarioLoader> scenarioLoader =
         QuantLib::ext::make_shared<HistoricalScenarioLoader>(
-        hsr, dates);
+        hsr, dates, singlePrecision);
 
     // Create the historical scenario generator
     return QuantLib::ext::make_shared<HistoricalScenarioGenerator>(scenarioLoader, scenarioFactory, 
@@ -225,6 +225,9 @@ private:
     bool overlapping_ = true;
     ReturnConfiguration returnConfiguration_;
     std::string labelPrefix_;
+    // cube key index per base scenario key, for the base scenario and cube it was built for
+    std::vector<QuantLib::Size> cubeKeyIndex_;
+    std::pair<const Scenario*, const ScenarioCube*> cubeKeyIndexSource_ = {nullptr, nullptr};
 };
 
 //! Historical scenario generator generating random scenarios, for testing purposes
@@ -305,13 +308,13 @@ QuantLib::ext::shared_ptr<HistoricalScenarioGenerator> buildHistoricalScenarioGe
     Calendar calendar, Size mporDays,
     const QuantLib::ext::shared_ptr<ScenarioSimMarketParameters>& simParams,
     const QuantLib::ext::shared_ptr<TodaysMarketParameters>& marketParam,
-    const bool overlapping = true);
+    const bool overlapping = true, const bool singlePrecision = false);
 
 QuantLib::ext::shared_ptr<HistoricalScenarioGenerator> buildHistoricalScenarioGenerator(
     const QuantLib::ext::shared_ptr<HistoricalScenarioReader>& hsr,
     const QuantLib::ext::shared_ptr<ore::data::AdjustmentFactors>& adjFactors, const std::set<QuantLib::Date>& dates,
     const QuantLib::ext::shared_ptr<ScenarioSimMarketParameters>& simParams,
-    const QuantLib::ext::shared_ptr<TodaysMarketParameters>& marketParam);
+    const QuantLib::ext::shared_ptr<TodaysMarketParameters>& marketParam, const bool singlePrecision = false);
 
 } // namespace analytics
 } // namespace ore
@@ -32,7 +32,10 @@ namespace analytics {
 QuantLib::ext::shared_ptr<Scenario> HistoricalScenarioLoader::getHistoricalScenario(const QuantLib::Date& date) const {
     QL_REQUIRE(historicalScenarios_.size() > 0, "No Historical Scenarios Loaded");
 
-    auto it = std::find(dates_.begin(), dates_.end(), date);
+    // the dates are ascending unless set otherwise by the caller
+    auto it = std::lower_bound(dates_.begin(), dates_.end(), date);
+    if (it == dates_.end() || *it != date)
+        it = std::find(dates_.begin(), dates_.end(), date);
     QL_REQUIRE(it != dates_.end(), "HistoricalScenarioLoader can't find an index for date " << date);
 
     Size index = std::distance(dates_.begin(), it);
@@ -41,10 +44,15 @@ QuantLib::ext::shared_ptr<Scenario> HistoricalScenarioLoader::getHistoricalScena
 
 HistoricalScenarioLoader::HistoricalScenarioLoader(const QuantLib::ext::shared_ptr<HistoricalScenarioReader>& scenarioReader,
                                                    const Date& startDate, const Date& endDate,
-                                                   const Calendar& calendar) {
+                                                   const Calendar& calendar, const bool singlePrecision) {
 
     QL_REQUIRE(scenarioReader, "The historical scenario loader must be provided with a valid scenario reader");
 
+    if (singlePrecision)
+        scenarioCube_ = QuantLib::ext::make_shared<SinglePrecisionScenarioCube>();
+    else
+        scenarioCube_ = QuantLib::ext::make_shared<DoublePrecisionScenarioCube>();
+
     LOG("Loading historical scenarios from " << startDate << " to " << endDate);
 
     // Variable used to ensure that scenarios from scenario reader are ordered ascending
@@ -81,7 +89,7 @@ HistoricalScenarioLoader::HistoricalScenarioLoader(const QuantLib::ext::shared_p
         if (d <= endDate) {
             // create scenario and store it
             DLOG("Loading scenario for date " << iso_date(d));
-            historicalScenarios_.push_back(scenarioReader->scenario());
+            scenarioCube_->add(*scenarioReader->scenario());
             dates_.push_back(d);
 
             // Advance the request date
@@ -92,12 +100,20 @@ HistoricalScenarioLoader::HistoricalScenarioLoader(const QuantLib::ext::shared_p
         }
     }
 
-    LOG("Loaded " << historicalScenarios_.size() << " from " << startDate << " to " << endDate);
+    historicalScenarios_ = scenarioViews(scenarioCube_);
+
+    LOG("Loaded " << historicalScenarios_.size() << " from " << startDate << " to " << endDate << " for "
+                  << scenarioCube_->numKeys() << " risk factors");
 }
 
 HistoricalScenarioLoader::HistoricalScenarioLoader(
     const boost::shared_ptr<HistoricalScenarioReader>& scenarioReader,
-    const std::set<Date>& dates) {
+    const std::set<Date>& dates, const bool singlePrecision) {
+    if (singlePrecision)
+        scenarioCube_ = QuantLib::ext::make_shared<SinglePrecisionScenarioCube>();
+    else
+        scenarioCube_ = QuantLib::ext::make_shared<DoublePrecisionScenarioCube>();
+    scenarioCube_->reserve(dates.size());
     while (scenarioReader->next()) {
         Date scenarioDate = scenarioReader->date();
 
@@ -105,12 +121,13 @@ HistoricalScenarioLoader::HistoricalScenarioLoader(
         if (it == dates.end())
             continue;
         else {
-            historicalScenarios_.push_back(scenarioReader->scenario());
-            dates_.push_back(scenarioDate);            
+            scenarioCube_->add(*scenarioReader->scenario());
+            dates_.push_back(scenarioDate);
         }
         if (dates_.size() == dates.size())
             break;
-    }    
+    }
+    historicalScenarios_ = scenarioViews(scenarioCube_);
 }
 
 HistoricalScenarioLoader::HistoricalScenarioLoader(
@@ -28,6 +28,7 @@
 #include <orea/scenario/scenario.hpp>
 #include <orea/scenario/scenariofactory.hpp>
 #include <orea/scenario/historicalscenarioreader.hpp>
+#include <orea/scenario/scenariocube.hpp>
 #include <ql/time/calendar.hpp>
 #include <vector>
 
@@ -43,6 +44,8 @@ public:
     /*! Constructor that loads scenarios, read from \p scenarioReader, between \p startDate
         and \p endDate.
 
+        The scenarios are stored in a ScenarioCube, historicalScenarios() returns views on the cube.
+
         \warning The scenarios coming from \p scenarioReader must be in ascending order. If not,
                  an exception is thrown.
     */
@@ -54,14 +57,19 @@ public:
         //! The last date to load a scenario for
         const QuantLib::Date& endDate,
         //! Calendar to use when advancing dates
-        const QuantLib::Calendar& calendar);
+        const QuantLib::Calendar& calendar,
+        //! Store the scenario values in single precision
+        const bool singlePrecision = false);
 
-     /*! Constructor that loads scenarios, read from \p scenarioReader, for given dates */
+     /*! Constructor that loads scenarios, read from \p scenarioReader, for given dates, the scenarios are stored
+         in a ScenarioCube */
     HistoricalScenarioLoader(
         //! A scenario reader that feeds the loader with scenarios
         const boost::shared_ptr<HistoricalScenarioReader>& scenarioReader,
         //! The first date to load a a scenario for
-        const std::set<QuantLib::Date>& dates);
+        const std::set<QuantLib::Date>& dates,
+        //! Store the scenario values in single precision
+        const bool singlePrecision = false);
 
      /*! Constructor that loads scenarios from a vector */
     HistoricalScenarioLoader(
@@ -84,11 +92,14 @@ public:
     std::vector<QuantLib::Date>& dates() { return dates_; }
     //! The historical scenario dates
     const std::vector<QuantLib::Date>& dates() const { return dates_; }
+    //! The cube holding the scenarios, null if the scenarios were not loaded from a reader
+    const QuantLib::ext::shared_ptr<ScenarioCube>& scenarioCube() const { return scenarioCube_; }
 
 protected:
     // to be populated by derived classes
     std::vector<QuantLib::ext::shared_ptr<ore::analytics::Scenario>> historicalScenarios_;
     std::vector<QuantLib::Date> dates_;
+    QuantLib::ext::shared_ptr<ScenarioCube> scenarioCube_;
 };
 
 } // namespace analytics
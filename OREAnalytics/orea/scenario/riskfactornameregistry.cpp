@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <orea/scenario/riskfactornameregistry.hpp>
+
+#include <ql/errors.hpp>
+
+#include <limits>
+
+namespace ore {
+namespace analytics {
+
+RiskFactorNameRegistry::RiskFactorNameRegistry() {
+    names_.push_back(std::string());
+    ids_[std::string()] = 0;
+}
+
+std::uint32_t RiskFactorNameRegistry::id(const std::string& name) {
+    // keys are usually constructed in loops over the index for a fixed name, so we keep the last lookup per thread
+    thread_local std::string lastName;
+    thread_local std::uint32_t lastId = 0;
+    if (name == lastName)
+        return lastId;
+
+    std::uint32_t result;
+    {
+        boost::shared_lock<boost::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            result = it->second;
+            lastName = name;
+            lastId = result;
+            return result;
+        }
+    }
+
+    boost::unique_lock<boost::shared_mutex> lock(mutex_);
+    // another thread might have registered the name in the meantime
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        result = it->second;
+    } else {
+        QL_REQUIRE(names_.size() < std::numeric_limits<std::uint32_t>::max(),
+                   "RiskFactorNameRegistry: maximum number of risk factor names exceeded");
+        result = static_cast<std::uint32_t>(names_.size());
+        names_.push_back(name);
+        ids_[name] = result;
+    }
+    lastName = name;
+    lastId = result;
+    return result;
+}
+
+const std::string& RiskFactorNameRegistry::name(std::uint32_t id) const {
+    boost::shared_lock<boost::shared_mutex> lock(mutex_);
+    QL_REQUIRE(id < names_.size(), "RiskFactorNameRegistry: id " << id << " not known");
+    return names_[id];
+}
+
+std::size_t RiskFactorNameRegistry::size() const {
+    boost::shared_lock<boost::shared_mutex> lock(mutex_);
+    return names_.size();
+}
+
+} // namespace analytics
+} // namespace ore
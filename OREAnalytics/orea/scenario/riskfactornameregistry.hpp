@@ -0,0 +1,73 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file scenario/riskfactornameregistry.hpp
+    \brief global interning of risk factor key names
+    \ingroup scenario
+*/
+
+#pragma once
+
+#include <ql/patterns/singleton.hpp>
+
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+namespace ore {
+namespace analytics {
+
+//! Risk factor name registry
+/*! Maps risk factor key names to 32-bit ids. Ids are assigned in order of first registration and are never
+    released, so that an id obtained once stays valid for the lifetime of the process. The empty name is
+    always registered with id 0.
+
+    The registry is shared between sessions and threads, lookups take a shared lock, registration of a new
+    name takes a unique lock.
+
+    \ingroup scenario
+*/
+class RiskFactorNameRegistry
+    : public QuantLib::Singleton<RiskFactorNameRegistry, std::integral_constant<bool, true>> {
+    friend class QuantLib::Singleton<RiskFactorNameRegistry, std::integral_constant<bool, true>>;
+
+public:
+    //! return the id for the given name, registers the name if it is not known yet
+    std::uint32_t id(const std::string& name);
+
+    //! return the name for the given id, throws if the id is not known
+    const std::string& name(std::uint32_t id) const;
+
+    //! number of registered names
+    std::size_t size() const;
+
+private:
+    RiskFactorNameRegistry();
+
+    // deque, so that references to names remain valid when new names are registered
+    std::deque<std::string> names_;
+    std::unordered_map<std::string, std::uint32_t> ids_;
+    mutable boost::shared_mutex mutex_;
+};
+
+} // namespace analytics
+} // namespace ore
@@ -30,9 +30,9 @@ namespace analytics {
 
 std::size_t hash_value(const RiskFactorKey& k) {
     std::size_t seed = 0;
-    boost::hash_combine(seed, k.keytype);
-    boost::hash_combine(seed, k.name);
-    boost::hash_combine(seed, k.index);
+    boost::hash_combine(seed, k.packed());
+    if (k.index > 0xFFFFFF)
+        boost::hash_combine(seed, k.index);
     return seed;
 }
 
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <orea/scenario/riskfactornameregistry.hpp>
+
 #include <ored/utilities/serializationdate.hpp>
 
 #include <ql/shared_ptr.hpp>
@@ -32,6 +34,7 @@
 #include <ql/types.hpp>
 
 #include <boost/functional/hash.hpp>
+#include <cstdint>
 #include <map>
 #include <unordered_map>
 #include <vector>
@@ -44,7 +47,11 @@ using QuantLib::Size;
 using std::string;
 
 //! Data types stored in the scenario class
-/*! \ingroup scenario
+/*! The key name is interned in the RiskFactorNameRegistry on construction, so that equality checks, hashing
+    and comparisons of keys with equal names do not need to compare strings. The name must therefore not be
+    modified after construction of the key.
+
+    \ingroup scenario
  */
 class RiskFactorKey {
 public:
@@ -81,10 +88,10 @@ public:
     };
 
     //! Constructor
-    RiskFactorKey() : keytype(KeyType::None), name(""), index(0) {}
+    RiskFactorKey() : keytype(KeyType::None), name(""), index(0), nameId_(0) {}
     //! Constructor
     RiskFactorKey(const KeyType& iKeytype, const string& iName, const Size& iIndex = 0)
-        : keytype(iKeytype), name(iName), index(iIndex) {}
+        : keytype(iKeytype), name(iName), index(iIndex), nameId_(RiskFactorNameRegistry::instance().id(iName)) {}
 
     //! Key type
     KeyType keytype;
@@ -96,23 +103,44 @@ public:
     //! Index
     Size index;
 
+    //! Id of the key name in the RiskFactorNameRegistry
+    std::uint32_t nameId() const { return nameId_; }
+
+    /*! Key packed into 64 bits: key type (8 bits), name id (32 bits), index (24 bits). Indices beyond
+        2^24 are truncated, so the packed value is suitable for hashing, but not as a unique identifier. */
+    std::uint64_t packed() const {
+        return (static_cast<std::uint64_t>(keytype) << 56) | (static_cast<std::uint64_t>(nameId_) << 24) |
+               (static_cast<std::uint64_t>(index) & 0xFFFFFF);
+    }
+
 private:
+    std::uint32_t nameId_;
+
     friend class boost::serialization::access;
     template <class Archive> void serialize(Archive& ar, const unsigned int) {
         ar& keytype;
         ar& name;
         ar& index;
+        if (Archive::is_loading::value)
+            nameId_ = RiskFactorNameRegistry::instance().id(name);
     }
 };
 
 std::size_t hash_value(const RiskFactorKey& k);
 
+/*! The ordering is lexicographic in (keytype, name, index) as before the introduction of the name ids, so that
+    the iteration order of containers and hence the output is not affected by the registration order of names.
+    The string comparison is only done if the name ids differ. */
 inline bool operator<(const RiskFactorKey& lhs, const RiskFactorKey& rhs) {
-    return std::tie(lhs.keytype, lhs.name, lhs.index) < std::tie(rhs.keytype, rhs.name, rhs.index);
+    if (lhs.keytype != rhs.keytype)
+        return lhs.keytype < rhs.keytype;
+    if (lhs.nameId() != rhs.nameId())
+        return lhs.name < rhs.name;
+    return lhs.index < rhs.index;
 }
 
 inline bool operator==(const RiskFactorKey& lhs, const RiskFactorKey& rhs) {
-    return lhs.keytype == rhs.keytype && lhs.name == rhs.name && lhs.index == rhs.index;
+    return lhs.keytype == rhs.keytype && lhs.nameId() == rhs.nameId() && lhs.index == rhs.index;
 }
 
 inline bool operator>(const RiskFactorKey& lhs, const RiskFactorKey& rhs) { return rhs < lhs; }
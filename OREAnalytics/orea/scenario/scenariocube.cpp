@@ -0,0 +1,113 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <orea/scenario/scenariocube.hpp>
+
+#include <boost/make_shared.hpp>
+
+namespace ore {
+namespace analytics {
+
+const std::vector<RiskFactorKey>& ScenarioCube::keys() const {
+    static const std::vector<RiskFactorKey> empty;
+    return sharedData_ == nullptr ? empty : sharedData_->keys;
+}
+
+Size ScenarioCube::keyIndex(const RiskFactorKey& key) const {
+    if (sharedData_ == nullptr)
+        return QuantLib::Null<Size>();
+    auto i = sharedData_->keyIndex.find(key);
+    return i == sharedData_->keyIndex.end() ? QuantLib::Null<Size>() : i->second;
+}
+
+bool ScenarioCube::addScenario(const Scenario& scenario, std::vector<Size>& keyIndices) {
+    auto simple = dynamic_cast<const SimpleScenario*>(&scenario);
+    if (sharedData_ == nullptr)
+        sharedData_ = simple != nullptr ? simple->sharedData() : QuantLib::ext::make_shared<SimpleScenario::SharedData>();
+
+    asof_.push_back(scenario.asof());
+    label_.push_back(scenario.label());
+    numeraire_.push_back(scenario.getNumeraire());
+    isAbsolute_.push_back(scenario.isAbsolute());
+
+    if (simple != nullptr && simple->sharedData() == sharedData_)
+        return true;
+
+    const auto& keys = scenario.keys();
+    keyIndices.resize(keys.size());
+    for (Size i = 0; i < keys.size(); ++i) {
+        if (auto k = sharedData_->keyIndex.find(keys[i]); k != sharedData_->keyIndex.end()) {
+            keyIndices[i] = k->second;
+        } else {
+            keyIndices[i] = sharedData_->keyIndex[keys[i]] = sharedData_->keys.size();
+            sharedData_->keys.push_back(keys[i]);
+            boost::hash_combine(sharedData_->keysHash, keys[i]);
+        }
+    }
+    for (const auto& c : scenario.coordinates())
+        sharedData_->coordinates.insert(c);
+    return false;
+}
+
+ScenarioCubeView::ScenarioCubeView(const QuantLib::ext::shared_ptr<const ScenarioCube>& cube, Size index)
+    : cube_(cube), index_(index) {
+    QL_REQUIRE(cube_ != nullptr, "ScenarioCubeView: no cube given");
+    QL_REQUIRE(index_ < cube_->numScenarios(), "ScenarioCubeView: scenario index " << index_ << " out of range, cube has "
+                                                                                    << cube_->numScenarios()
+                                                                                    << " scenarios");
+    asof_ = cube_->asof(index_);
+    label_ = cube_->label(index_);
+    numeraire_ = cube_->numeraire(index_);
+    isAbsolute_ = cube_->isAbsolute(index_);
+}
+
+bool ScenarioCubeView::has(const RiskFactorKey& key) const {
+    Size k = cube_->keyIndex(key);
+    return k != QuantLib::Null<Size>() && cube_->get(k, index_) != QuantLib::Null<Real>();
+}
+
+void ScenarioCubeView::add(const RiskFactorKey& key, Real) {
+    QL_FAIL("ScenarioCubeView is read-only, can not add key " << key << ", use clone() to get a modifiable scenario");
+}
+
+Real ScenarioCubeView::get(const RiskFactorKey& key) const {
+    Size k = cube_->keyIndex(key);
+    QL_REQUIRE(k != QuantLib::Null<Size>(), "ScenarioCubeView does not provide data for key " << key);
+    return cube_->get(k, index_);
+}
+
+QuantLib::ext::shared_ptr<Scenario> ScenarioCubeView::clone() const {
+    auto scenario = QuantLib::ext::make_shared<SimpleScenario>(asof_, label_, numeraire_, cube_->sharedData());
+    scenario->setAbsolute(isAbsolute_);
+    const auto& keys = cube_->keys();
+    for (Size k = 0; k < keys.size(); ++k)
+        scenario->add(keys[k], cube_->get(k, index_));
+    return scenario;
+}
+
+std::vector<QuantLib::ext::shared_ptr<Scenario>>
+scenarioViews(const QuantLib::ext::shared_ptr<const ScenarioCube>& cube) {
+    std::vector<QuantLib::ext::shared_ptr<Scenario>> result;
+    result.reserve(cube->numScenarios());
+    for (Size s = 0; s < cube->numScenarios(); ++s)
+        result.push_back(QuantLib::ext::make_shared<ScenarioCubeView>(cube, s));
+    return result;
+}
+
+} // namespace analytics
+} // namespace ore
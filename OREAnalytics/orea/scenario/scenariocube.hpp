@@ -0,0 +1,199 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file scenario/scenariocube.hpp
+    \brief Dense storage of scenarios sharing one risk factor key layout
+    \ingroup scenario
+*/
+
+#pragma once
+
+#include <orea/scenario/simplescenario.hpp>
+
+#include <ql/errors.hpp>
+#include <ql/utilities/null.hpp>
+
+#include <vector>
+
+namespace ore {
+namespace analytics {
+
+//! Dense storage of scenarios sharing one risk factor key layout
+/*! The cube holds one value per risk factor key and scenario. The key layout is a SimpleScenario::SharedData
+    block, so a cube filled from SimpleScenarios that share their data block (as produced by a SimpleScenarioFactory
+    using a common shared data block) adopts that block and copies the scenario data without key lookups. Keys
+    that a scenario does not provide are stored as null values.
+
+    Scenarios are read back through ScenarioCubeView, a read-only Scenario implementation that refers to one column
+    of the cube. The cube itself is not modified by the views, so it can be shared across threads once filled.
+
+    \ingroup scenario
+*/
+class ScenarioCube {
+public:
+    //! if sharedData is not provided, the cube adopts the data block of the first SimpleScenario added
+    explicit ScenarioCube(const QuantLib::ext::shared_ptr<SimpleScenario::SharedData>& sharedData = nullptr)
+        : sharedData_(sharedData) {}
+    virtual ~ScenarioCube() {}
+
+    //! Append a scenario, extending the key layout if necessary, returns the scenario index
+    virtual Size add(const Scenario& scenario) = 0;
+    //! Value for key index k in scenario s, null if the scenario does not provide a value
+    virtual Real get(Size k, Size s) const = 0;
+    //! Reserve space for n scenarios
+    virtual void reserve(Size n) = 0;
+
+    //! Number of scenarios
+    Size numScenarios() const { return asof_.size(); }
+    //! Number of keys in the layout
+    Size numKeys() const { return sharedData_ == nullptr ? 0 : sharedData_->keys.size(); }
+    //! Risk factor keys of the layout
+    const std::vector<RiskFactorKey>& keys() const;
+    //! Index of the key in the layout, null if the key is not in the layout
+    Size keyIndex(const RiskFactorKey& key) const;
+    //! Shared key layout
+    const QuantLib::ext::shared_ptr<SimpleScenario::SharedData>& sharedData() const { return sharedData_; }
+
+    //! Scenario meta data
+    //@{
+    const Date& asof(Size s) const { return asof_.at(s); }
+    const std::string& label(Size s) const { return label_.at(s); }
+    Real numeraire(Size s) const { return numeraire_.at(s); }
+    bool isAbsolute(Size s) const { return isAbsolute_.at(s); }
+    //@}
+
+protected:
+    /*! adds the meta data of the scenario and sets up the layout if necessary, returns true if the scenario is a
+        SimpleScenario sharing the layout, otherwise keyIndices holds the layout index for each of its keys */
+    bool addScenario(const Scenario& scenario, std::vector<Size>& keyIndices);
+
+    QuantLib::ext::shared_ptr<SimpleScenario::SharedData> sharedData_;
+    std::vector<Date> asof_;
+    std::vector<std::string> label_;
+    std::vector<Real> numeraire_;
+    std::vector<bool> isAbsolute_;
+};
+
+//! Scenario cube storing the values as type T
+template <typename T> class ScenarioCubeBase : public ScenarioCube {
+public:
+    explicit ScenarioCubeBase(const QuantLib::ext::shared_ptr<SimpleScenario::SharedData>& sharedData = nullptr)
+        : ScenarioCube(sharedData) {}
+
+    Size add(const Scenario& scenario) override {
+        std::vector<Size> keyIndices;
+        bool shared = addScenario(scenario, keyIndices);
+        data_.emplace_back(numKeys(), QuantLib::Null<T>());
+        auto& column = data_.back();
+        if (shared) {
+            const auto& data = static_cast<const SimpleScenario&>(scenario).data();
+            for (Size k = 0; k < data.size(); ++k)
+                column[k] = toT(data[k]);
+        } else {
+            const auto& keys = scenario.keys();
+            for (Size i = 0; i < keys.size(); ++i)
+                column[keyIndices[i]] = toT(scenario.get(keys[i]));
+        }
+        return data_.size() - 1;
+    }
+
+    Real get(Size k, Size s) const override {
+        QL_REQUIRE(s < data_.size(), "ScenarioCube::get(): scenario index " << s << " out of range");
+        const auto& column = data_[s];
+        if (k >= column.size() || column[k] == QuantLib::Null<T>())
+            return QuantLib::Null<Real>();
+        return static_cast<Real>(column[k]);
+    }
+
+    void reserve(Size n) override {
+        data_.reserve(n);
+        asof_.reserve(n);
+        label_.reserve(n);
+        numeraire_.reserve(n);
+        isAbsolute_.reserve(n);
+    }
+
+private:
+    static T toT(Real v) { return v == QuantLib::Null<Real>() ? QuantLib::Null<T>() : static_cast<T>(v); }
+
+    // one column per scenario, a column is shorter than the layout if keys were added later
+    std::vector<std::vector<T>> data_;
+};
+
+//! Scenario cube storing values in single precision
+using SinglePrecisionScenarioCube = ScenarioCubeBase<float>;
+
+//! Scenario cube storing values in double precision
+using DoublePrecisionScenarioCube = ScenarioCubeBase<double>;
+
+//! Read-only view on one scenario of a ScenarioCube
+/*! The keys of the view are the keys of the cube layout. Since the layout is the union of the keys of all scenarios
+    added to the cube, has() checks that this scenario provides a value for the key, and get() returns null for a
+    key in the layout without a value. The meta data can be changed on the view, the values can not, clone() returns
+    a SimpleScenario sharing the layout of the cube.
+
+    \ingroup scenario
+*/
+class ScenarioCubeView : public Scenario {
+public:
+    ScenarioCubeView(const QuantLib::ext::shared_ptr<const ScenarioCube>& cube, Size index);
+
+    const Date& asof() const override { return asof_; }
+    void setAsof(const Date& d) override { asof_ = d; }
+
+    const std::string& label() const override { return label_; }
+    void label(const string& s) override { label_ = s; }
+
+    Real getNumeraire() const override { return numeraire_; }
+    void setNumeraire(Real n) override { numeraire_ = n; }
+
+    bool isAbsolute() const override { return isAbsolute_; }
+    void setAbsolute(const bool b) override { isAbsolute_ = b; }
+
+    const std::map<std::pair<RiskFactorKey::KeyType, std::string>, std::vector<std::vector<Real>>>&
+    coordinates() const override {
+        return cube_->sharedData()->coordinates;
+    }
+
+    std::size_t keysHash() const override { return cube_->sharedData()->keysHash; }
+
+    bool has(const RiskFactorKey& key) const override;
+    const std::vector<RiskFactorKey>& keys() const override { return cube_->keys(); }
+    void add(const RiskFactorKey& key, Real value) override;
+    Real get(const RiskFactorKey& key) const override;
+
+    QuantLib::ext::shared_ptr<Scenario> clone() const override;
+
+    //! The cube and the scenario index the view refers to
+    const QuantLib::ext::shared_ptr<const ScenarioCube>& cube() const { return cube_; }
+    Size index() const { return index_; }
+
+private:
+    QuantLib::ext::shared_ptr<const ScenarioCube> cube_;
+    Size index_;
+    Date asof_;
+    std::string label_;
+    Real numeraire_;
+    bool isAbsolute_;
+};
+
+//! Views on all scenarios of the cube
+std::vector<QuantLib::ext::shared_ptr<Scenario>> scenarioViews(const QuantLib::ext::shared_ptr<const ScenarioCube>& cube);
+
+} // namespace analytics
+} // namespace ore
@@ -0,0 +1,240 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <orea/scenario/scenariodependencygraph.hpp>
+
+#include <ored/utilities/log.hpp>
+
+#include <ql/instrument.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/settings.hpp>
+#include <ql/utilities/null.hpp>
+
+#include <algorithm>
+
+using namespace QuantLib;
+
+namespace ore {
+namespace analytics {
+
+namespace {
+
+class ProbeObserver : public Observer {
+public:
+    void update() override { notified = true; }
+    bool notified = false;
+};
+
+Real quoteValue(const QuantLib::ext::shared_ptr<SimpleQuote>& q) { return q->isValid() ? q->value() : Null<Real>(); }
+
+} // namespace
+
+ScenarioDependencyGraph::ScenarioDependencyGraph(
+    const std::map<RiskFactorKey, QuantLib::ext::shared_ptr<SimpleQuote>>& simData,
+    const std::set<QuantLib::ext::shared_ptr<TermStructure>>& termStructures)
+    : termStructures_(termStructures.begin(), termStructures.end()) {
+
+    // group the quotes into nodes, one per key type and name, and pick a valid quote per node as the probe
+
+    std::map<std::pair<RiskFactorKey::KeyType, std::string>, Size> nodeIndex;
+    for (auto const& [key, quote] : simData) {
+        auto n = nodeIndex.insert(std::make_pair(std::make_pair(key.keytype, key.name), nodeNames_.size()));
+        if (n.second) {
+            nodeNames_.push_back(n.first->first);
+            probeQuote_.push_back(Null<Size>());
+        }
+        Size node = n.first->second;
+        if (probeQuote_[node] == Null<Size>() && quote->isValid())
+            probeQuote_[node] = quotes_.size();
+        quotes_.push_back(quote);
+        quoteNode_.push_back(node);
+    }
+    values_.resize(quotes_.size(), Null<Real>());
+    dirtyNodes_.resize(nodeNames_.size(), true);
+
+    // lazy term structures must forward the probe notifications even if they are not calculated
+
+    std::vector<std::vector<QuantLib::ext::shared_ptr<Observable>>> dependents;
+    for (auto const& ts : termStructures_) {
+        if (auto l = QuantLib::ext::dynamic_pointer_cast<LazyObject>(ts))
+            l->alwaysForwardNotifications();
+        dependents.push_back({ts});
+    }
+
+    auto tsNodes = discover(dependents, std::function<void(Size)>());
+    nodeTermStructures_.resize(nodeNames_.size());
+    for (Size i = 0; i < tsNodes.size(); ++i) {
+        if (tsNodes[i].empty())
+            alwaysDirtyTermStructures_.push_back(i);
+        for (auto n : tsNodes[i])
+            nodeTermStructures_[n].push_back(i);
+    }
+
+    DLOG("ScenarioDependencyGraph: " << nodeNames_.size() << " nodes for " << quotes_.size() << " quotes, "
+                                     << termStructures_.size() << " term structures of which "
+                                     << alwaysDirtyTermStructures_.size() << " do not depend on any node");
+}
+
+std::vector<std::vector<Size>> ScenarioDependencyGraph::discover(
+    const std::vector<std::vector<QuantLib::ext::shared_ptr<Observable>>>& dependents,
+    const std::function<void(Size)>& recalculate) const {
+
+    QL_REQUIRE(ObservableSettings::instance().updatesEnabled(),
+               "ScenarioDependencyGraph: observer notifications must be enabled to discover dependencies");
+
+    std::vector<QuantLib::ext::shared_ptr<ProbeObserver>> observers;
+    for (auto const& d : dependents) {
+        auto o = QuantLib::ext::make_shared<ProbeObserver>();
+        for (auto const& obs : d)
+            if (obs)
+                o->registerWith(obs);
+        observers.push_back(o);
+    }
+
+    std::vector<std::vector<Size>> result(dependents.size());
+    for (Size n = 0; n < nodeNames_.size(); ++n) {
+        if (probeQuote_[n] == Null<Size>())
+            continue;
+        auto const& q = quotes_[probeQuote_[n]];
+        Real v = q->value();
+        q->setValue(v == 0.0 ? 1E-4 : v * (1.0 + 1E-4));
+        q->setValue(v);
+        for (Size i = 0; i < observers.size(); ++i) {
+            if (observers[i]->notified) {
+                result[i].push_back(n);
+                observers[i]->notified = false;
+                if (recalculate)
+                    recalculate(i);
+            }
+        }
+    }
+    return result;
+}
+
+void ScenarioDependencyGraph::addTrades(const std::map<std::string, QuantLib::ext::shared_ptr<ore::data::Trade>>& trades) {
+
+    std::vector<std::vector<QuantLib::ext::shared_ptr<Instrument>>> instruments;
+    std::vector<std::vector<QuantLib::ext::shared_ptr<Observable>>> dependents;
+    for (auto const& [tradeId, trade] : trades) {
+        std::vector<QuantLib::ext::shared_ptr<Instrument>> inst;
+        if (auto const& w = trade->instrument()) {
+            if (w->qlInstrument())
+                inst.push_back(w->qlInstrument());
+            for (auto const& a : w->additionalInstruments())
+                if (a)
+                    inst.push_back(a);
+        }
+        dependents.push_back(std::vector<QuantLib::ext::shared_ptr<Observable>>(inst.begin(), inst.end()));
+        instruments.push_back(inst);
+    }
+
+    // the instruments only forward the probe notifications if they are calculated, so we calculate them before
+    // the first and after each probe that reached them, a trade that fails to calculate is always dirty
+
+    std::vector<bool> failed(instruments.size(), false);
+    auto calculate = [&instruments, &failed](Size i) {
+        try {
+            for (auto const& inst : instruments[i])
+                inst->NPV();
+        } catch (const std::exception&) {
+            failed[i] = true;
+        }
+    };
+    for (Size i = 0; i < instruments.size(); ++i)
+        calculate(i);
+
+    tradeNodes_ = discover(dependents, calculate);
+    tradeDate_ = Settings::instance().evaluationDate();
+
+    Size alwaysDirty = 0;
+    for (Size i = 0; i < tradeNodes_.size(); ++i) {
+        if (failed[i])
+            tradeNodes_[i].clear();
+        if (tradeNodes_[i].empty())
+            ++alwaysDirty;
+    }
+
+    DLOG("ScenarioDependencyGraph: added " << tradeNodes_.size() << " trades on " << io::iso_date(tradeDate_)
+                                           << ", " << alwaysDirty << " of them are always updated");
+}
+
+void ScenarioDependencyGraph::beginUpdate() {
+    for (Size i = 0; i < quotes_.size(); ++i)
+        values_[i] = quoteValue(quotes_[i]);
+    beginDate_ = Settings::instance().evaluationDate();
+}
+
+void ScenarioDependencyGraph::endUpdate(const Date& d) {
+    date_ = Settings::instance().evaluationDate();
+    allDirty_ = date_ != beginDate_ || d != date_;
+    std::fill(dirtyNodes_.begin(), dirtyNodes_.end(), false);
+    for (Size i = 0; i < quotes_.size(); ++i) {
+        if (quoteValue(quotes_[i]) != values_[i]) {
+            Size n = quoteNode_[i];
+            dirtyNodes_[n] = true;
+            // we do not know the dependents of a node without a probe
+            if (probeQuote_[n] == Null<Size>())
+                allDirty_ = true;
+        }
+    }
+}
+
+void ScenarioDependencyGraph::refreshTermStructures() const {
+    // term structures might be wrappers around nested termstructures that need to be updated as well,
+    // therefore we call deepUpdate(), as in MarketImpl::refresh()
+    if (allDirty_) {
+        for (auto const& ts : termStructures_)
+            ts->deepUpdate();
+        return;
+    }
+    std::vector<bool> refresh(termStructures_.size(), false);
+    for (auto i : alwaysDirtyTermStructures_)
+        refresh[i] = true;
+    for (Size n = 0; n < dirtyNodes_.size(); ++n) {
+        if (dirtyNodes_[n]) {
+            for (auto i : nodeTermStructures_[n])
+                refresh[i] = true;
+        }
+    }
+    for (Size i = 0; i < termStructures_.size(); ++i)
+        if (refresh[i])
+            termStructures_[i]->deepUpdate();
+}
+
+bool ScenarioDependencyGraph::isTradeDirty(Size i) const {
+    if (allDirty_ || date_ != tradeDate_ || i >= tradeNodes_.size() || tradeNodes_[i].empty())
+        return true;
+    for (auto n : tradeNodes_[i])
+        if (dirtyNodes_[n])
+            return true;
+    return false;
+}
+
+Size ScenarioDependencyGraph::numberOfDirtyNodes() const {
+    return std::count(dirtyNodes_.begin(), dirtyNodes_.end(), true);
+}
+
+const std::vector<Size>& ScenarioDependencyGraph::tradeNodes(Size i) const {
+    QL_REQUIRE(i < tradeNodes_.size(), "ScenarioDependencyGraph::tradeNodes(): index " << i << " out of range, have "
+                                                                                        << tradeNodes_.size()
+                                                                                        << " trades");
+    return tradeNodes_[i];
+}
+
+} // namespace analytics
+} // namespace ore
@@ -0,0 +1,108 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file scenario/scenariodependencygraph.hpp
+    \brief Dependency graph from sim market quotes to term structures and trades
+    \ingroup scenario
+*/
+
+#pragma once
+
+#include <orea/scenario/scenario.hpp>
+#include <ored/portfolio/trade.hpp>
+
+#include <ql/quotes/simplequote.hpp>
+#include <ql/termstructure.hpp>
+#include <ql/time/date.hpp>
+
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ore {
+namespace analytics {
+
+//! Dependency graph from sim market quotes to term structures and trades
+/*! The graph is used in ObservationMode::Mode::Graph. The sim market quotes are grouped into nodes, one per risk
+    factor key type and name. The edges from the nodes to the term structures of the sim market and to the trades of
+    a portfolio are discovered once by perturbing one quote per node with observer notifications enabled and
+    recording which term structures and trade instruments are notified.
+
+    A scenario update is bracketed by beginUpdate() and endUpdate(). In between, the sim market applies the scenario
+    with observer notifications disabled. endUpdate() compares the quotes to their values at beginUpdate() and marks
+    the nodes of changed quotes dirty. Only the term structures and trades depending on a dirty node then need to be
+    updated. Everything is dirty if the evaluation date changed, and trades are only tracked on the evaluation date on
+    which their dependencies were discovered. Term structures and trades that were not reached by any probe are
+    treated as always dirty.
+
+    \ingroup scenario
+*/
+class ScenarioDependencyGraph {
+public:
+    //! Groups the quotes into nodes and discovers the dependencies of the term structures, updates must be enabled
+    ScenarioDependencyGraph(const std::map<RiskFactorKey, QuantLib::ext::shared_ptr<QuantLib::SimpleQuote>>& simData,
+                            const std::set<QuantLib::ext::shared_ptr<QuantLib::TermStructure>>& termStructures);
+
+    /*! Discover the dependencies of the trades' instruments on the current evaluation date, updates must be enabled.
+        The trades are identified by their position in the map in what follows. */
+    void addTrades(const std::map<std::string, QuantLib::ext::shared_ptr<ore::data::Trade>>& trades);
+
+    //! Record the current quote values and evaluation date
+    void beginUpdate();
+    //! Mark the nodes whose quotes changed since beginUpdate() dirty, everything is dirty if the date changed
+    void endUpdate(const QuantLib::Date& d);
+
+    //! Call deepUpdate() on the term structures depending on a dirty node
+    void refreshTermStructures() const;
+    //! Does the i-th trade depend on a dirty node?
+    bool isTradeDirty(QuantLib::Size i) const;
+
+    QuantLib::Size numberOfNodes() const { return nodeNames_.size(); }
+    QuantLib::Size numberOfDirtyNodes() const;
+    //! Nodes the i-th trade depends on, empty if the trade is always dirty
+    const std::vector<QuantLib::Size>& tradeNodes(QuantLib::Size i) const;
+
+private:
+    /*! perturb one quote per node and return, for each dependent, the nodes whose probe notified one of its
+        observables; recalculate is called for each notified dependent after each probe */
+    std::vector<std::vector<QuantLib::Size>>
+    discover(const std::vector<std::vector<QuantLib::ext::shared_ptr<QuantLib::Observable>>>& dependents,
+             const std::function<void(QuantLib::Size)>& recalculate) const;
+
+    std::vector<std::pair<RiskFactorKey::KeyType, std::string>> nodeNames_;
+    std::vector<QuantLib::ext::shared_ptr<QuantLib::SimpleQuote>> quotes_;
+    std::vector<QuantLib::Size> quoteNode_;
+    std::vector<QuantLib::Size> probeQuote_;
+    std::vector<QuantLib::Real> values_;
+
+    std::vector<QuantLib::ext::shared_ptr<QuantLib::TermStructure>> termStructures_;
+    std::vector<std::vector<QuantLib::Size>> nodeTermStructures_;
+    std::vector<QuantLib::Size> alwaysDirtyTermStructures_;
+
+    std::vector<std::vector<QuantLib::Size>> tradeNodes_;
+    QuantLib::Date tradeDate_;
+
+    std::vector<bool> dirtyNodes_;
+    bool allDirty_ = true;
+    QuantLib::Date date_, beginDate_;
+};
+
+} // namespace analytics
+} // namespace ore
@@ -3093,12 +3093,26 @@ void ScenarioSimMarket::applyScenario(const QuantLib::ext::shared_ptr<Scenario>&
     }
 }
 
+const QuantLib::ext::shared_ptr<ScenarioDependencyGraph>& ScenarioSimMarket::dependencyGraph() {
+    if (dependencyGraph_ == nullptr) {
+        // populates the set of term structures to refresh
+        refresh();
+        dependencyGraph_ =
+            QuantLib::ext::make_shared<ScenarioDependencyGraph>(simData_, refreshTs_[Market::defaultConfiguration]);
+    }
+    return dependencyGraph_;
+}
+
 void ScenarioSimMarket::preUpdate() {
     ObservationMode::Mode om = ObservationMode::instance().mode();
     if (om == ObservationMode::Mode::Disable)
         ObservableSettings::instance().disableUpdates(false);
     else if (om == ObservationMode::Mode::Defer)
         ObservableSettings::instance().disableUpdates(true);
+    else if (om == ObservationMode::Mode::Graph) {
+        dependencyGraph()->beginUpdate();
+        ObservableSettings::instance().disableUpdates(false);
+    }
 }
 
 void ScenarioSimMarket::updateDate(const Date& d) {
@@ -3136,6 +3150,10 @@ void ScenarioSimMarket::postUpdate(const Date& d, bool withFixings) {
         ObservableSettings::instance().enableUpdates();
     } else if (om == ObservationMode::Mode::Defer) {
         ObservableSettings::instance().enableUpdates();
+    } else if (om == ObservationMode::Mode::Graph) {
+        dependencyGraph()->endUpdate(d);
+        dependencyGraph()->refreshTermStructures();
+        ObservableSettings::instance().enableUpdates();
     }
 
     // Apply fixings as historical fixings. Must do this before we populate ASD
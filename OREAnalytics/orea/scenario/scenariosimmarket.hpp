@@ -27,6 +27,7 @@
 #include <orea/scenario/scenario.hpp>
 #include <orea/scenario/scenariogenerator.hpp>
 #include <orea/scenario/scenariosimmarketparameters.hpp>
+#include <orea/scenario/scenariodependencygraph.hpp>
 #include <orea/simulation/simmarket.hpp>
 #include <ored/configuration/conventions.hpp>
 #include <ored/configuration/curveconfigurations.hpp>
@@ -65,6 +66,9 @@ public:
   instances with identical key structure in their data.
 
   If allowPartialScenarios is true, the check that all simData_ is touched by a scenario is disabled.
+
+  In ObservationMode::Mode::Graph, scenarios are applied with observer notifications disabled and only the term
+  structures depending on changed quotes are refreshed, see ScenarioDependencyGraph.
  */
 class ScenarioSimMarket : public analytics::SimMarket {
 public:
@@ -142,6 +146,10 @@ public:
 
     void applyScenario(const QuantLib::ext::shared_ptr<Scenario>& scenario);
 
+    /*! Dependency graph from the sim data quotes to the term structures of this market, built on first use.
+        Observer notifications must be enabled when it is built. */
+    const QuantLib::ext::shared_ptr<ScenarioDependencyGraph>& dependencyGraph();
+
 protected:
     
 
@@ -197,6 +205,8 @@ protected:
 
     mutable QuantLib::ext::shared_ptr<Scenario> currentScenario_;
     QuantLib::ext::shared_ptr<Scenario> offsetScenario_;
+
+    QuantLib::ext::shared_ptr<ScenarioDependencyGraph> dependencyGraph_;
 };
 } // namespace analytics
 } // namespace ore
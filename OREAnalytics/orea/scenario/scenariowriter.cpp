@@ -73,9 +73,12 @@ QuantLib::ext::shared_ptr<Scenario> ScenarioWriter::next(const Date& d) {
 
 void ScenarioWriter::writeScenario(const QuantLib::ext::shared_ptr<Scenario>& s, const bool writeHeader) {
     const Date d = s->asof();
-    // take a copy of the keys here to ensure the order is preserved
-    keys_ = s->keys();
-    std::sort(keys_.begin(), keys_.end());
+    // take a copy of the keys here to ensure the order is preserved, scenarios sharing a key layout reuse the copy
+    if (s->keysHash() == 0 || s->keysHash() != keysHash_ || s->keys().size() != keys_.size()) {
+        keys_ = s->keys();
+        std::sort(keys_.begin(), keys_.end());
+        keysHash_ = s->keysHash();
+    }
     if (fp_) {
         if (writeHeader) {
             QL_REQUIRE(keys_.size() > 0, "No keys in scenario");
@@ -91,8 +94,13 @@ void ScenarioWriter::writeScenario(const QuantLib::ext::shared_ptr<Scenario>& s,
             i_++;
 
         fprintf(fp_, "%s%c%zu%c%.8f", to_string(d).c_str(), sep_, i_, sep_, s->getNumeraire());
-        for (auto k : keys_)
-            fprintf(fp_, "%c%.8f", sep_, s->get(k));
+        for (auto k : keys_) {
+            // keys missing in the scenario are written as empty fields, as the report below writes them as null
+            if (s->has(k))
+                fprintf(fp_, "%c%.8f", sep_, s->get(k));
+            else
+                fprintf(fp_, "%c", sep_);
+        }
         fprintf(fp_, "\n");
         fflush(fp_);
     }
@@ -125,5 +133,13 @@ void ScenarioWriter::writeScenario(const QuantLib::ext::shared_ptr<Scenario>& s,
     }
 }
 
+void ScenarioWriter::writeScenarios(const QuantLib::ext::shared_ptr<const ScenarioCube>& cube) {
+    bool writeHeader = i_ == 0;
+    for (Size s = 0; s < cube->numScenarios(); ++s) {
+        writeScenario(QuantLib::ext::make_shared<ScenarioCubeView>(cube, s), writeHeader);
+        writeHeader = false;
+    }
+}
+
 } // namespace analytics
 } // namespace ore
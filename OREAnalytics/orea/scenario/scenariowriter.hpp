@@ -25,6 +25,7 @@
 #pragma once
 
 #include <orea/scenario/scenario.hpp>
+#include <orea/scenario/scenariocube.hpp>
 #include <orea/scenario/scenariogenerator.hpp>
 #include <ored/report/report.hpp>
 
@@ -55,6 +56,9 @@ public:
     //! Write a single scenario
     void writeScenario(const QuantLib::ext::shared_ptr<Scenario>& s, const bool writeHeader);
 
+    //! Write all scenarios of a cube, the header is written if nothing was written before
+    void writeScenarios(const QuantLib::ext::shared_ptr<const ScenarioCube>& cube);
+
     //! Reset the generator so calls to next() return the first scenario.
     virtual void reset() override;
 
@@ -66,6 +70,7 @@ private:
 
     QuantLib::ext::shared_ptr<ScenarioGenerator> src_;
     std::vector<RiskFactorKey> keys_;
+    std::size_t keysHash_ = 0;
     QuantLib::ext::shared_ptr<ore::data::Report> report_;
     FILE* fp_;
     Date firstDate_;
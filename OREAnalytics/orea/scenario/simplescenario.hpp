@@ -36,7 +36,7 @@ class SimpleScenario : public Scenario {
 public:
     struct SharedData {
         std::vector<RiskFactorKey> keys;
-        std::map<RiskFactorKey, std::size_t> keyIndex;
+        std::unordered_map<RiskFactorKey, std::size_t> keyIndex;
         std::map<std::pair<RiskFactorKey::KeyType, std::string>, std::vector<std::vector<Real>>> coordinates;
         std::size_t keysHash = 0;
     };
@@ -38,54 +38,162 @@ namespace analytics {
 auto isSimmParameter = [](const ore::analytics::CrifRecord& x) { return x.isSimmParameter(); };
 auto isNotSimmParameter = std::not_fn(isSimmParameter);
 
+namespace {
+CrifRecordRange recordRange(const std::vector<const CrifRecord*>& records) {
+    return CrifRecordRange(boost::make_indirect_iterator(records.cbegin()),
+                           boost::make_indirect_iterator(records.cend()));
+}
+const std::vector<const CrifRecord*> emptyRecords;
+const std::set<std::string> emptyQualifiers;
+} // namespace
+
+Crif::Crif(const Crif& other)
+    : type_(other.type_), records_(other.records_), portfolioIds_(other.portfolioIds_),
+      nettingSetDetails_(other.nettingSetDetails_) {
+    // The amount ccy index holds pointers into the record set, it is rebuilt on our own copies when needed
+}
+
+Crif::Crif(Crif&& other)
+    : type_(other.type_), records_(std::move(other.records_)),
+      diffAmountCurrenciesIndex_(std::move(other.diffAmountCurrenciesIndex_)),
+      amountCcyIndexValid_(other.amountCcyIndexValid_), portfolioIds_(std::move(other.portfolioIds_)),
+      nettingSetDetails_(std::move(other.nettingSetDetails_)) {
+    other.invalidateIndex();
+    other.invalidateAmountCcyIndex();
+}
+
+Crif& Crif::operator=(const Crif& other) {
+    if (this != &other) {
+        type_ = other.type_;
+        records_ = other.records_;
+        portfolioIds_ = other.portfolioIds_;
+        nettingSetDetails_ = other.nettingSetDetails_;
+        invalidateAmountCcyIndex();
+        invalidateIndex();
+    }
+    return *this;
+}
+
+Crif& Crif::operator=(Crif&& other) {
+    if (this != &other) {
+        type_ = other.type_;
+        records_ = std::move(other.records_);
+        diffAmountCurrenciesIndex_ = std::move(other.diffAmountCurrenciesIndex_);
+        amountCcyIndexValid_ = other.amountCcyIndexValid_;
+        portfolioIds_ = std::move(other.portfolioIds_);
+        nettingSetDetails_ = std::move(other.nettingSetDetails_);
+        invalidateIndex();
+        other.invalidateIndex();
+        other.invalidateAmountCcyIndex();
+    }
+    return *this;
+}
+
+void Crif::clear() {
+    records_.clear();
+    invalidateAmountCcyIndex();
+    invalidateIndex();
+}
+
+void Crif::invalidateAmountCcyIndex() {
+    diffAmountCurrenciesIndex_.clear();
+    amountCcyIndexValid_ = false;
+}
+
+std::map<CrifRecord::SimmAmountCcyKey, const CrifRecord*>& Crif::amountCcyIndex() {
+    if (!amountCcyIndexValid_) {
+        diffAmountCurrenciesIndex_.clear();
+        for (const auto& r : records_)
+            diffAmountCurrenciesIndex_[r.getSimmAmountCcyKey()] = &r;
+        amountCcyIndexValid_ = true;
+    }
+    return diffAmountCurrenciesIndex_;
+}
+
+void Crif::invalidateIndex() {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    index_.reset();
+}
+
+const Crif::Index& Crif::index() const {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    if (!index_) {
+        // Records are visited in set order, so every index entry preserves the order of the record set
+        auto index = QuantLib::ext::make_shared<Index>();
+        for (const auto& r : records_) {
+            auto& node = index->nodes[std::make_tuple(r.nettingSetDetails, r.productClass, r.riskType)];
+            node.records.push_back(&r);
+            node.qualifiers.insert(r.qualifier);
+            node.byQualifier[r.qualifier].push_back(&r);
+            node.byBucket[r.bucket].push_back(&r);
+            node.byQualifierAndBucket[std::make_pair(r.qualifier, r.bucket)].push_back(&r);
+            index->byRiskType[r.riskType].push_back(&r);
+            index->productClasses[r.nettingSetDetails].insert(r.productClass);
+        }
+        index_ = index;
+    }
+    return *index_;
+}
+
+const Crif::IndexNode* Crif::indexNode(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
+                                       const CrifRecord::RiskType rt) const {
+    const auto& nodes = index().nodes;
+    auto it = nodes.find(std::make_tuple(nsd, pc, rt));
+    return it == nodes.end() ? nullptr : &it->second;
+}
+
 void Crif::addRecord(const CrifRecord& record, bool aggregateDifferentAmountCurrencies, bool sortFxVolQualifer) {
+    addRecord(CrifRecord(record), aggregateDifferentAmountCurrencies, sortFxVolQualifer);
+}
+
+void Crif::addRecord(CrifRecord&& record, bool aggregateDifferentAmountCurrencies, bool sortFxVolQualifer) {
     if (record.type() == CrifRecord::RecordType::FRTB) {
-        addFrtbCrifRecord(record, aggregateDifferentAmountCurrencies, sortFxVolQualifer);
+        addFrtbCrifRecord(std::move(record), aggregateDifferentAmountCurrencies, sortFxVolQualifer);
     } else if (record.type() == CrifRecord::RecordType::SIMM && !record.isSimmParameter()) {
-        addSimmCrifRecord(record, aggregateDifferentAmountCurrencies, sortFxVolQualifer);
+        addSimmCrifRecord(std::move(record), aggregateDifferentAmountCurrencies, sortFxVolQualifer);
     } else {
-        addSimmParameterRecord(record);
+        addSimmParameterRecord(std::move(record));
     }
 }
 
-void Crif::addFrtbCrifRecord(const CrifRecord& record, bool aggregateDifferentAmountCurrencies,
-                             bool sortFxVolQualifer) {
+void Crif::addFrtbCrifRecord(CrifRecord&& record, bool aggregateDifferentAmountCurrencies, bool sortFxVolQualifer) {
     QL_REQUIRE(type_ == CrifType::Empty || type_ == CrifType::Frtb, "Can not add a FRTB crif record to a SIMM Crif");
     if (type_ == CrifType::Empty) {
         type_ = CrifType::Frtb;
     }
-    insertCrifRecord(record, aggregateDifferentAmountCurrencies);
+    insertCrifRecord(std::move(record), aggregateDifferentAmountCurrencies);
 }
 
-void Crif::addSimmCrifRecord(const CrifRecord& record, bool aggregateDifferentAmountCurrencies,
-                             bool sortFxVolQualifer) {
+void Crif::addSimmCrifRecord(CrifRecord&& record, bool aggregateDifferentAmountCurrencies, bool sortFxVolQualifer) {
     QL_REQUIRE(type_ == CrifType::Empty || type_ == CrifType::Simm, "Can not add a Simm crif record to a Frtb Crif");
     if (type_ == CrifType::Empty) {
         type_ = CrifType::Simm;
     }
-    auto recordToAdd = record;
-    if (sortFxVolQualifer && recordToAdd.riskType == CrifRecord::RiskType::FXVol) {
-        auto ccy_1 = recordToAdd.qualifier.substr(0, 3);
-        auto ccy_2 = recordToAdd.qualifier.substr(3);
+    if (sortFxVolQualifer && record.riskType == CrifRecord::RiskType::FXVol) {
+        auto ccy_1 = record.qualifier.substr(0, 3);
+        auto ccy_2 = record.qualifier.substr(3);
         if (ccy_1 > ccy_2)
             ccy_1.swap(ccy_2);
-        recordToAdd.qualifier = ccy_1 + ccy_2;
+        record.qualifier = ccy_1 + ccy_2;
     }
-    insertCrifRecord(recordToAdd, aggregateDifferentAmountCurrencies);
+    insertCrifRecord(std::move(record), aggregateDifferentAmountCurrencies);
 }
 
-void Crif::insertCrifRecord(const CrifRecord& record, bool aggregateDifferentAmountCurrencies) {
+void Crif::insertCrifRecord(CrifRecord&& record, bool aggregateDifferentAmountCurrencies) {
 
+    // the amount ccy index is only built if it is actually used, since it is about as large as the records
     auto it = aggregateDifferentAmountCurrencies ? records_.end() : records_.find(record);
     auto itDiffAmountCcy = aggregateDifferentAmountCurrencies
-                               ? diffAmountCurrenciesIndex_.find(record.getSimmAmountCcyKey())
+                               ? amountCcyIndex().find(record.getSimmAmountCcyKey())
                                : diffAmountCurrenciesIndex_.end();
 
     if (it == records_.end() && itDiffAmountCcy == diffAmountCurrenciesIndex_.end()) {
-        auto recordIt = records_.insert(record);
-        diffAmountCurrenciesIndex_[record.getSimmAmountCcyKey()] = &(*(recordIt.first));
-        portfolioIds_.insert(record.portfolioId);
-        nettingSetDetails_.insert(record.nettingSetDetails);
+        auto recordIt = records_.insert(std::move(record)).first;
+        if (amountCcyIndexValid_)
+            diffAmountCurrenciesIndex_[recordIt->getSimmAmountCcyKey()] = &(*recordIt);
+        portfolioIds_.insert(recordIt->portfolioId());
+        nettingSetDetails_.insert(recordIt->nettingSetDetails);
+        invalidateIndex();
     } else if (it != records_.end()) {
         updateAmountExistingRecord(it, record);
     } else {
@@ -93,12 +201,13 @@ void Crif::insertCrifRecord(const CrifRecord& record, bool aggregateDifferentAmo
     }
 }
 
-void Crif::addSimmParameterRecord(const CrifRecord& record) {
+void Crif::addSimmParameterRecord(CrifRecord&& record) {
     auto it = records_.find(record);
     if (it == records_.end()) {
-        CrifRecord newRecord = record;
-        records_.insert(newRecord);
-        diffAmountCurrenciesIndex_[record.getSimmAmountCcyKey()] = &newRecord;
+        auto recordIt = records_.insert(std::move(record)).first;
+        if (amountCcyIndexValid_)
+            diffAmountCurrenciesIndex_[recordIt->getSimmAmountCcyKey()] = &(*recordIt);
+        invalidateIndex();
     } else if (it->riskType == CrifRecord::RiskType::AddOnFixedAmount) {
         updateAmountExistingRecord(it, record);
     } else if (it->riskType == CrifRecord::RiskType::AddOnNotionalFactor ||
@@ -187,7 +296,7 @@ Crif Crif::simmParameters() const {
     Crif results;
     for (const auto& record : records_) {
         if (record.isSimmParameter()) {
-            results.addSimmParameterRecord(record);
+            results.addSimmParameterRecord(CrifRecord(record));
         }
     }
     return results;
@@ -195,10 +304,8 @@ Crif Crif::simmParameters() const {
 //! Find first element
 std::set<CrifRecord>::const_iterator Crif::findBy(const NettingSetDetails nsd, CrifRecord::ProductClass pc,
                                                   const CrifRecord::RiskType rt, const std::string& qualifier) const {
-    return std::find_if(records_.begin(), records_.end(), [&nsd, &pc, &rt, &qualifier](const CrifRecord& record) {
-        return record.nettingSetDetails == nsd && record.productClass == pc && record.riskType == rt &&
-               record.qualifier == qualifier;
-    });
+    auto records = filterByQualifier(nsd, pc, rt, qualifier);
+    return records.empty() ? records_.end() : records_.find(records.front());
 };
 
 Crif Crif::filterNonZeroAmount(double threshold, std::string alwaysIncludeFxRiskCcy) const {
@@ -224,56 +331,50 @@ Crif Crif::filterNonZeroAmount(double threshold, std::string alwaysIncludeFxRisk
     return results;
 }
 
-std::set<std::string> Crif::qualifiersBy(const NettingSetDetails nsd, CrifRecord::ProductClass pc,
-                                         const CrifRecord::RiskType rt) const {
-    auto res = records_ | boost::adaptors::filtered([&nsd, &pc, &rt](const CrifRecord& record) {
-                   return record.nettingSetDetails == nsd && record.productClass == pc && record.riskType == rt;
-               }) |
-               boost::adaptors::transformed([](const CrifRecord& record) { return record.qualifier; });
-    return boost::copy_range<std::set<std::string>>(res);
+const std::set<std::string>& Crif::qualifiersBy(const NettingSetDetails nsd, CrifRecord::ProductClass pc,
+                                                const CrifRecord::RiskType rt) const {
+    auto node = indexNode(nsd, pc, rt);
+    return node ? node->qualifiers : emptyQualifiers;
 }
 
-std::vector<CrifRecord> Crif::filterByQualifierAndBucket(const NettingSetDetails& nsd,
-                                                         const CrifRecord::ProductClass pc,
-                                                         const CrifRecord::RiskType rt, const std::string& qualifier,
-                                                         const std::string& bucket) const {
-    return boost::copy_range<std::vector<CrifRecord>>(
-        records_ | boost::adaptors::filtered([&nsd, &pc, &rt, &qualifier, &bucket](const CrifRecord& record) {
-            return record.nettingSetDetails == nsd && record.productClass == pc && record.riskType == rt &&
-                   record.qualifier == qualifier && record.bucket == bucket;
-        }));
+CrifRecordRange Crif::filterByQualifierAndBucket(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
+                                                 const CrifRecord::RiskType rt, const std::string& qualifier,
+                                                 const std::string& bucket) const {
+    auto node = indexNode(nsd, pc, rt);
+    if (!node)
+        return recordRange(emptyRecords);
+    auto it = node->byQualifierAndBucket.find(std::make_pair(qualifier, bucket));
+    return recordRange(it == node->byQualifierAndBucket.end() ? emptyRecords : it->second);
 }
 
-std::vector<CrifRecord> Crif::filterByQualifier(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
-                                                const CrifRecord::RiskType rt, const std::string& qualifier) const {
-
-    return boost::copy_range<std::vector<CrifRecord>>(
-        records_ | boost::adaptors::filtered([&nsd, &pc, &rt, &qualifier](const CrifRecord& record) {
-            return record.nettingSetDetails == nsd && record.productClass == pc && record.riskType == rt &&
-                   record.qualifier == qualifier;
-        }));
+CrifRecordRange Crif::filterByQualifier(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
+                                        const CrifRecord::RiskType rt, const std::string& qualifier) const {
+    auto node = indexNode(nsd, pc, rt);
+    if (!node)
+        return recordRange(emptyRecords);
+    auto it = node->byQualifier.find(qualifier);
+    return recordRange(it == node->byQualifier.end() ? emptyRecords : it->second);
 }
 
-std::vector<CrifRecord> Crif::filterByBucket(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
-                                             const CrifRecord::RiskType rt, const std::string& bucket) const {
-    return boost::copy_range<std::vector<CrifRecord>>(
-        records_ | boost::adaptors::filtered([&nsd, &pc, &rt, &bucket](const CrifRecord& record) {
-            return record.nettingSetDetails == nsd && record.productClass == pc && record.riskType == rt &&
-                   record.bucket == bucket;
-        }));
+CrifRecordRange Crif::filterByBucket(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
+                                     const CrifRecord::RiskType rt, const std::string& bucket) const {
+    auto node = indexNode(nsd, pc, rt);
+    if (!node)
+        return recordRange(emptyRecords);
+    auto it = node->byBucket.find(bucket);
+    return recordRange(it == node->byBucket.end() ? emptyRecords : it->second);
 }
 
-std::vector<CrifRecord> Crif::filterBy(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
-                                       const CrifRecord::RiskType rt) const {
-    return boost::copy_range<std::vector<CrifRecord>>(
-        records_ | boost::adaptors::filtered([&nsd, &pc, &rt](const CrifRecord& record) {
-            return record.nettingSetDetails == nsd && record.productClass == pc && record.riskType == rt;
-        }));
+CrifRecordRange Crif::filterBy(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
+                               const CrifRecord::RiskType rt) const {
+    auto node = indexNode(nsd, pc, rt);
+    return recordRange(node ? node->records : emptyRecords);
 }
 
-std::vector<CrifRecord> Crif::filterBy(const CrifRecord::RiskType rt) const {
-    return boost::copy_range<std::vector<CrifRecord>>(
-        records_ | boost::adaptors::filtered([&rt](const CrifRecord& record) { return record.riskType == rt; }));
+CrifRecordRange Crif::filterBy(const CrifRecord::RiskType rt) const {
+    const auto& byRiskType = index().byRiskType;
+    auto it = byRiskType.find(rt);
+    return recordRange(it == byRiskType.end() ? emptyRecords : it->second);
 }
 
 std::vector<CrifRecord> Crif::filterByTradeId(const std::string& id) const {
@@ -288,8 +389,8 @@ std::set<std::string> Crif::tradeIds() const {
 
 //! deletes all existing simmParameter and replaces them with the new one
 void Crif::setSimmParameters(const Crif& crif) {
-    auto backup = records_;
-    records_.clear();
+    auto backup = std::move(records_);
+    clear();
     for (auto& r : backup) {
         if (!r.isSimmParameter()) {
             addRecord(r);
@@ -297,14 +398,14 @@ void Crif::setSimmParameters(const Crif& crif) {
     }
     for (const auto& r : crif) {
         if (r.isSimmParameter()) {
-            addSimmParameterRecord(r);
+            addSimmParameterRecord(CrifRecord(r));
         }
     }
 }
 
 void Crif::setCrifRecords(const Crif& crif) {
-    auto backup = records_;
-    records_.clear();
+    auto backup = std::move(records_);
+    clear();
     for (auto& r : backup) {
         if (r.isSimmParameter()) {
             addRecord(r);
@@ -322,21 +423,14 @@ const std::set<std::string>& Crif::portfolioIds() const { return portfolioIds_;
 const std::set<NettingSetDetails>& Crif::nettingSetDetails() const { return nettingSetDetails_; }
 
 std::set<CrifRecord::ProductClass> Crif::ProductClassesByNettingSetDetails(const NettingSetDetails nsd) const {
-    std::set<CrifRecord::ProductClass> keys;
-    for (const auto& record : records_) {
-        if (record.nettingSetDetails == nsd) {
-            keys.insert(record.productClass);
-        }
-    }
-    return keys;
+    const auto& productClasses = index().productClasses;
+    auto it = productClasses.find(nsd);
+    return it == productClasses.end() ? std::set<CrifRecord::ProductClass>() : it->second;
 }
 
 size_t Crif::countMatching(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
                            const CrifRecord::RiskType rt, const std::string& qualifier) const {
-    return std::count_if(records_.begin(), records_.end(), [&nsd, &pc, &rt, &qualifier](const CrifRecord& record) {
-        return record.nettingSetDetails == nsd && record.productClass == pc && record.riskType == rt &&
-               record.qualifier == qualifier;
-    });
+    return filterByQualifier(nsd, pc, rt, qualifier).size();
 }
 
 bool Crif::hasNettingSetDetails() const {
@@ -372,9 +466,11 @@ void Crif::fillAmountUsd(const QuantLib::ext::shared_ptr<ore::data::Market> mark
                 cr.amountUsd = cr.amount * usdSpot;
             }
         }
-        results.insert(cr);
+        results.insert(std::move(cr));
     }
-    records_ = results;
+    records_ = std::move(results);
+    invalidateAmountCcyIndex();
+    invalidateIndex();
 }
 
 } // namespace analytics
@@ -25,6 +25,11 @@
 #include <ored/report/report.hpp>
 #include <ored/marketdata/market.hpp>
 
+#include <boost/iterator/indirect_iterator.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <mutex>
+
 namespace ore {
 namespace analytics {
 
@@ -32,17 +37,28 @@ struct crifRecordIsSimmParameter {
     bool operator()(const CrifRecord& x) { return x.isSimmParameter(); }
 };
 
+/*! Non-owning view on a subset of the records of a Crif, in the order of the underlying record set. The view is
+    invalidated when records are added to or removed from the Crif.
+*/
+typedef boost::iterator_range<boost::indirect_iterator<std::vector<const CrifRecord*>::const_iterator>>
+    CrifRecordRange;
+
 class Crif {
 public:
     enum class CrifType { Empty, Frtb, Simm };
     Crif() = default;
+    Crif(const Crif& other);
+    Crif(Crif&& other);
+    Crif& operator=(const Crif& other);
+    Crif& operator=(Crif&& other);
 
     CrifType type() const { return type_; }
 
     void addRecord(const CrifRecord& record, bool aggregateDifferentAmountCurrencies = false, bool sortFxVolQualifer = true);
+    void addRecord(CrifRecord&& record, bool aggregateDifferentAmountCurrencies = false, bool sortFxVolQualifer = true);
     void addRecords(const Crif& crif, bool aggregateDifferentAmountCurrencies = false, bool sortFxVolQualfier = true);
 
-    void clear() { records_.clear(); }
+    void clear();
 
     std::set<CrifRecord>::const_iterator begin() const { return records_.cbegin(); }
     std::set<CrifRecord>::const_iterator end() const { return records_.cend(); }
@@ -94,43 +110,84 @@ public:
 
     std::set<CrifRecord::ProductClass> ProductClassesByNettingSetDetails(const NettingSetDetails nsd) const;
     
-    std::set<std::string> qualifiersBy(const NettingSetDetails nsd, CrifRecord::ProductClass pc,
-                                       const CrifRecord::RiskType rt) const;
-
-    std::vector<CrifRecord> filterByQualifierAndBucket(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
-                                                       const CrifRecord::RiskType rt, const std::string& qualifier,
-                                                       const std::string& bucket) const;
-    
-    std::vector<CrifRecord> filterByQualifier(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
-                                              const CrifRecord::RiskType rt, const std::string& qualifier) const;
-
-    std::vector<CrifRecord> filterByBucket(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
-                                           const CrifRecord::RiskType rt, const std::string& bucket) const;
-
-    std::vector<CrifRecord> filterBy(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
-                                     const CrifRecord::RiskType rt) const;
-    std::vector<CrifRecord> filterBy(const CrifRecord::RiskType rt) const;
+    //! Qualifiers of the given combination, the reference is served from the index, see the filterBy methods below
+    const std::set<std::string>& qualifiersBy(const NettingSetDetails nsd, CrifRecord::ProductClass pc,
+                                              const CrifRecord::RiskType rt) const;
+
+    /*! The filterBy methods below are served from an index over (netting set details, product class, risk type),
+        and qualifier and bucket within those, that is built on first use. They return views on the records and
+        no copies.
+
+        \warning A returned range is only valid as long as the Crif is alive and unchanged. Adding records,
+                 clearing, assigning to or moving from the Crif discards the index the range refers to, so the
+                 range must not be used afterwards. Call the filter method again to get the records after a
+                 change, or copy the range, e.g. into a std::vector<CrifRecord>, if the records are needed
+                 across changes.
+    */
+    CrifRecordRange filterByQualifierAndBucket(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
+                                               const CrifRecord::RiskType rt, const std::string& qualifier,
+                                               const std::string& bucket) const;
+
+    CrifRecordRange filterByQualifier(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
+                                      const CrifRecord::RiskType rt, const std::string& qualifier) const;
+
+    CrifRecordRange filterByBucket(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
+                                   const CrifRecord::RiskType rt, const std::string& bucket) const;
+
+    CrifRecordRange filterBy(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
+                             const CrifRecord::RiskType rt) const;
+    CrifRecordRange filterBy(const CrifRecord::RiskType rt) const;
     std::vector<CrifRecord> filterByTradeId(const std::string& id) const;
     std::set<std::string> tradeIds() const;
 
 private:
-    void insertCrifRecord(const CrifRecord& record, bool aggregateDifferentAmountCurrencies = false);
-    void addFrtbCrifRecord(const CrifRecord& record, bool aggregateDifferentAmountCurrencies = false, bool sortFxVolQualifer =true);
-    void addSimmCrifRecord(const CrifRecord& record, bool aggregateDifferentAmountCurrencies = false, bool sortFxVolQualifer =true);
-    void addSimmParameterRecord(const CrifRecord& record);
+    //! Records of one (netting set details, product class, risk type) combination
+    struct IndexNode {
+        std::vector<const CrifRecord*> records;
+        std::set<std::string> qualifiers;
+        std::map<std::string, std::vector<const CrifRecord*>> byQualifier;
+        std::map<std::string, std::vector<const CrifRecord*>> byBucket;
+        std::map<std::pair<std::string, std::string>, std::vector<const CrifRecord*>> byQualifierAndBucket;
+    };
+
+    struct Index {
+        std::map<std::tuple<NettingSetDetails, CrifRecord::ProductClass, CrifRecord::RiskType>, IndexNode> nodes;
+        std::map<CrifRecord::RiskType, std::vector<const CrifRecord*>> byRiskType;
+        std::map<NettingSetDetails, std::set<CrifRecord::ProductClass>> productClasses;
+    };
+
+    //! Return the record index, building it if the records have changed since the last call
+    const Index& index() const;
+    const IndexNode* indexNode(const NettingSetDetails& nsd, const CrifRecord::ProductClass pc,
+                               const CrifRecord::RiskType rt) const;
+    //! Called whenever records are inserted or removed
+    void invalidateIndex();
+    //! Return the amount ccy index, building it if it is not valid
+    std::map<CrifRecord::SimmAmountCcyKey, const CrifRecord*>& amountCcyIndex();
+    void invalidateAmountCcyIndex();
+
+    void insertCrifRecord(CrifRecord&& record, bool aggregateDifferentAmountCurrencies = false);
+    void addFrtbCrifRecord(CrifRecord&& record, bool aggregateDifferentAmountCurrencies = false, bool sortFxVolQualifer =true);
+    void addSimmCrifRecord(CrifRecord&& record, bool aggregateDifferentAmountCurrencies = false, bool sortFxVolQualifer =true);
+    void addSimmParameterRecord(CrifRecord&& record);
     void updateAmountExistingRecord(std::set<CrifRecord>::iterator& it, const CrifRecord& record);
     void updateAmountExistingRecord(std::map<CrifRecord::SimmAmountCcyKey, const CrifRecord*>::iterator& it, const CrifRecord& record);
 
 
     CrifType type_ = CrifType::Empty;
     std::set<CrifRecord> records_;
+    /*! Index used to aggregate records with different amount currencies, only built and maintained once records are
+        added with aggregateDifferentAmountCurrencies = true */
     std::map<CrifRecord::SimmAmountCcyKey, const CrifRecord*> diffAmountCurrenciesIndex_;
+    bool amountCcyIndexValid_ = false;
 
     //SIMM members
     //! Set of portfolio IDs that have been loaded
     std::set<std::string> portfolioIds_;
     std::set<ore::data::NettingSetDetails> nettingSetDetails_;
-    
+
+    mutable QuantLib::ext::shared_ptr<Index> index_;
+    mutable std::mutex indexMutex_;
 };
 
 
@@ -104,7 +104,7 @@ void CrifLoader::addRecordToCrif(Crif& crif, CrifRecord&& recordToAdd) const {
         recordToAdd.tradeId = "";
     }
     if (add) {
-        crif.addRecord(recordToAdd);
+        crif.addRecord(std::move(recordToAdd));
     } else {
         QL_FAIL("Risk type string " << recordToAdd.riskType << " does not correspond to a valid SimmConfiguration::RiskType");
     }
@@ -332,9 +332,32 @@ void StringStreamCrifLoader::processHeader(const vector<string>& headers) {
             }
         }
     }
+
+    // dense lookup of the file column by field index used when processing the lines
+    columnPositions_.clear();
+    for (const auto& [field, columnPos] : columnIndex_) {
+        if (field >= columnPositions_.size())
+            columnPositions_.resize(field + 1, QuantLib::Null<Size>());
+        columnPositions_[field] = columnPos;
+    }
+}
+
+const string& StringStreamCrifLoader::canonicalLabel(std::map<RiskType, std::map<string, string>>& labels,
+                                                     const RiskType rt, const bool label1, const string& label) {
+    auto l = labels.find(rt);
+    if (l == labels.end()) {
+        // the last label matching case-insensitively wins, as in the original per line loop over the labels
+        l = labels.insert(std::make_pair(rt, std::map<string, string>())).first;
+        for (const string& c : label1 ? configuration_->labels1(rt) : configuration_->labels2(rt))
+            l->second[boost::to_lower_copy(c)] = c;
+    }
+    if (l->second.empty())
+        return label;
+    auto c = l->second.find(boost::to_lower_copy(label));
+    return c == l->second.end() ? label : c->second;
 }
 
-bool StringStreamCrifLoader::process(const vector<string>& entries, Size maxIndex, Size currentLine, Crif& result) {
+bool StringStreamCrifLoader::process(vector<string>& entries, Size maxIndex, Size currentLine, Crif& result) {
     CrifRecord cr;
     // Return early if there are not enough entries in the line
     if (entries.size() <= maxIndex) {
@@ -345,45 +368,59 @@ bool StringStreamCrifLoader::process(const vector<string>& entries, Size maxInde
 
     // Try to create and add a CRIF record
     // There could still be issues here so we surround with try..catch to allow processing to continue
-    auto loadOptionalString = [&entries, this](int column) {
-        return columnIndex_.count(column) == 0 ? "" : entries[columnIndex_[column]];
+    // The entries are consumed, i.e. the strings are moved into the record instead of being copied
+    auto column = [this](Size field) {
+        return field < columnPositions_.size() ? columnPositions_[field] : QuantLib::Null<Size>();
+    };
+    auto loadOptionalString = [&entries, &column](Size field) {
+        Size c = column(field);
+        return c == QuantLib::Null<Size>() ? string() : std::move(entries[c]);
     };
-    auto loadOptionalReal = [&entries, this](int column) -> QuantLib::Real{
-        if (columnIndex_.count(column) == 0) {
+    auto loadRequiredString = [&entries, &column](Size field) { return std::move(entries[column(field)]); };
+    auto loadOptionalReal = [&entries, &column, this](Size field) -> QuantLib::Real {
+        Size c = column(field);
+        if (c == QuantLib::Null<Size>()) {
             return QuantLib::Null<QuantLib::Real>();
-        } else{
-            const std::string& value = entries[columnIndex_[column]];
-
-            return value.empty() || value == nullString_ ? QuantLib::Null<QuantLib::Real>()
-                                                         : parseReal(value);
-        } 
+        } else {
+            const std::string& value = entries[c];
+            return value.empty() || value == nullString_ ? QuantLib::Null<QuantLib::Real>() : parseReal(value);
+        }
     };
 
-    string tradeId, tradeType, imModel;
+    string tradeId, tradeType;
     try {
+        // Store additional data that matches the defined additional headers in the additional fields map, this
+        // is done first, since the additional headers might refer to columns that are consumed below
+        for (auto& additionalField : additionalHeadersIndexMap_) {
+            Size c = column(additionalField.first);
+            if (c != QuantLib::Null<Size>() && !entries[c].empty())
+                cr.additionalFields[*additionalField.second.begin()] = entries[c];
+        }
+
         tradeId = loadOptionalString(0);
         tradeType = loadOptionalString(15);
-        imModel = loadOptionalString(16);
 
         cr.tradeId = tradeId;
         cr.tradeType = tradeType;
-        cr.imModel = imModel;
-        cr.portfolioId = columnIndex_.count(1) == 0 ? "DummyPortfolio" : entries[columnIndex_.at(1)];
+        cr.imModel = loadOptionalString(16);
+        string portfolioId = column(1) == QuantLib::Null<Size>() ? string("DummyPortfolio") : loadRequiredString(1);
         cr.productClass = parseProductClass(loadOptionalString(2));
-        cr.riskType = parseRiskType(entries[columnIndex_.at(3)]);
+        cr.riskType = parseRiskType(entries[column(3)]);
         
         // Qualifier - There are many other possible qualifier values, but we only do case-insensitive checks
         // for those with standardised values, i.e. currencies or ccy pairs
-        cr.qualifier = entries[columnIndex_.at(4)];
+        cr.qualifier = loadRequiredString(4);
         if ((cr.riskType == RiskType::IRCurve || cr.riskType == RiskType::IRVol || cr.riskType == RiskType::FX) &&
             cr.qualifier.size() == 3) {
-            string ccyUpper = boost::to_upper_copy(cr.qualifier);
 
             // If ccy is already valid, do nothing. Otherwise, replace with all uppercase equivalent.
             // FIXME: Minor currencies will fail to get spotted here, though it is not likely that we will have
             // a qualifier in a minor ccy?
-            if (!checkCurrency(cr.qualifier) && checkCurrency(ccyUpper))
-                cr.qualifier = ccyUpper;
+            if (!checkCurrency(cr.qualifier)) {
+                string ccyUpper = boost::to_upper_copy(cr.qualifier);
+                if (checkCurrency(ccyUpper))
+                    cr.qualifier = ccyUpper;
+            }
         } else if (cr.riskType == RiskType::FXVol && (cr.qualifier.size() == 6 || cr.qualifier.size() == 7)) {
 
             // Remove delimiters between the two currencies
@@ -398,45 +435,37 @@ bool StringStreamCrifLoader::process(const vector<string>& entries, Size maxInde
         }
 
         // Bucket - Hardcoded "Residual" for case-insensitive check since this is currently the only non-numeric value
-        cr.bucket = entries[columnIndex_.at(5)];
-        if (boost::to_lower_copy(cr.bucket) == "residual")
+        cr.bucket = loadRequiredString(5);
+        if (boost::iequals(cr.bucket, "residual"))
             cr.bucket = "Residual";
 
-        // Label1
-        cr.label1 = entries[columnIndex_.at(6)];
-        if (configuration_->isValidRiskType(cr.riskType)) {
-            for (const string& l : configuration_->labels1(cr.riskType)) {
-                if (boost::to_lower_copy(cr.label1) == boost::to_lower_copy(l))
-                    cr.label1 = l;
-            }
-        }
-        // Label2
-        cr.label2 = entries[columnIndex_.at(7)];
+        // Label1 and Label2, the labels defined in the configuration are matched case-insensitively
+        cr.label1 = loadRequiredString(6);
+        cr.label2 = loadRequiredString(7);
         if (configuration_->isValidRiskType(cr.riskType)) {
-            for (const string& l : configuration_->labels2(cr.riskType)) {
-                if (boost::to_lower_copy(cr.label2) == boost::to_lower_copy(l))
-                    cr.label2 = l;
-            }
+            cr.label1 = canonicalLabel(labels1_, cr.riskType, true, cr.label1);
+            cr.label2 = canonicalLabel(labels2_, cr.riskType, false, cr.label2);
         }
 
         // We populate these 'required' values using loadOptional*, but they will have been validated already in processHeader,
         // and missing amountUsd (but with valid amount and amountCurrency) values populated later on in the analytics
 
         cr.amountCurrency = loadOptionalString(8);
-        string amountCcyUpper = boost::to_upper_copy(cr.amountCurrency);
-        if (!amountCcyUpper.empty() && !checkCurrency(cr.amountCurrency) && checkCurrency(amountCcyUpper))
-            cr.amountCurrency = amountCcyUpper;
+        if (!cr.amountCurrency.empty() && !checkCurrency(cr.amountCurrency)) {
+            string amountCcyUpper = boost::to_upper_copy(cr.amountCurrency);
+            if (checkCurrency(amountCcyUpper))
+                cr.amountCurrency = amountCcyUpper;
+        }
 
         cr.amount = loadOptionalReal(9);
         cr.amountUsd = loadOptionalReal(10);
 
         // Populate netting set details
-        cr.agreementType = loadOptionalString(11);
-        cr.callType = loadOptionalString(12);
-        cr.initialMarginType = loadOptionalString(13);
-        cr.legalEntityId = loadOptionalString(14);
-        cr.nettingSetDetails = NettingSetDetails(cr.portfolioId, cr. agreementType, cr.callType, cr.initialMarginType,
-                                                 cr.legalEntityId);
+        string agreementType = loadOptionalString(11);
+        string callType = loadOptionalString(12);
+        string initialMarginType = loadOptionalString(13);
+        string legalEntityId = loadOptionalString(14);
+        cr.nettingSetDetails = NettingSetDetails(portfolioId, agreementType, callType, initialMarginType, legalEntityId);
         cr.postRegulations = loadOptionalString(17);
         cr.collectRegulations = loadOptionalString(18);
         cr.endDate = loadOptionalString(19);
@@ -448,18 +477,12 @@ bool StringStreamCrifLoader::process(const vector<string>& entries, Size maxInde
         cr.bb_rw = loadOptionalString(25);
 
         // Check the IM model
-        try {
-            cr.imModel = to_string(parseIMModel(cr.imModel));
-        } catch (...) {
-            // If we cannot convert to a valid im_model, then it was either provided blank
-            // or is simply not a valid value
-        }
-
-        // Store additional data that matches the defined additional headers in the additional fields map
-        for (auto& additionalField : additionalHeadersIndexMap_) {
-            std::string value = loadOptionalString(additionalField.first);
-            if (!value.empty())
-                cr.additionalFields[*additionalField.second.begin()] = value;
+        if (!cr.imModel.empty()) {
+            try {
+                cr.imModel = to_string(parseIMModel(cr.imModel));
+            } catch (...) {
+                // If we cannot convert to a valid im_model, then it is simply not a valid value
+            }
         }
 
         // Add the CRIF record to the net records
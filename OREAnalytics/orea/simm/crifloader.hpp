@@ -119,6 +119,9 @@ protected:
     */
     std::map<QuantLib::Size, QuantLib::Size> columnIndex_;
 
+    //! The same as columnIndex_ as a dense vector with Null<Size>() for missing columns
+    std::vector<QuantLib::Size> columnPositions_;
+
 
     std::map<QuantLib::Size, std::set<std::string>> additionalHeadersIndexMap_;
 
@@ -126,9 +129,17 @@ protected:
     void processHeader(const std::vector<std::string>& headers);
 
     /*! Process a line of a CRIF file and return true if valid line
-        or false if an invalid line
+        or false if an invalid line. The entries are moved into the CRIF record.
+    */
+    bool process(std::vector<std::string>& entries, QuantLib::Size maxIndex, QuantLib::Size currentLine, Crif& result);
+
+    /*! Return the label from the SIMM configuration matching the given label case-insensitively, or the given label
+        if there is no such label. The lower case labels per risk type are cached in \p labels.
     */
-    bool process(const std::vector<std::string>& entries, QuantLib::Size maxIndex, QuantLib::Size currentLine, Crif& result);
+    const std::string& canonicalLabel(std::map<CrifRecord::RiskType, std::map<std::string, std::string>>& labels,
+                                      const CrifRecord::RiskType rt, const bool label1, const std::string& label);
+    std::map<CrifRecord::RiskType, std::map<std::string, std::string>> labels1_, labels2_;
+
     char eol_;
     char delim_;
     char quoteChar_;
@@ -165,7 +165,7 @@ std::vector<std::set<std::string>> CrifRecord::additionalHeaders = {};
 ostream& operator<<(ostream& out, const CrifRecord& cr) {
     const NettingSetDetails& n = cr.nettingSetDetails;
     if (n.empty()) {
-        out << "[" << cr.tradeId << ", " << cr.portfolioId << ", " << cr.productClass << ", " << cr.riskType
+        out << "[" << cr.tradeId << ", " << cr.portfolioId() << ", " << cr.productClass << ", " << cr.riskType
             << ", " << cr.qualifier << ", " << cr.bucket << ", " << cr.label1 << ", " << cr.label2 << ", "
             << cr.amountCurrency << ", " << cr.amount << ", " << cr.amountUsd;
     } else {
@@ -133,7 +133,6 @@ struct CrifRecord {
 
     // required data
     std::string tradeId;
-    std::string portfolioId;
     ProductClass productClass = ProductClass::Empty;
     RiskType riskType = RiskType::Notional;
     std::string qualifier;
@@ -150,11 +149,8 @@ struct CrifRecord {
 
     // optional data
     std::string tradeType;
-    std::string agreementType;
-    std::string callType;
-    std::string initialMarginType;
-    std::string legalEntityId;
-    NettingSetDetails nettingSetDetails; // consists of the above: agreementType ... legalEntityId
+    // portfolio id, agreement type, call type, initial margin type and legal entity id, see the accessors below
+    NettingSetDetails nettingSetDetails;
     mutable std::string imModel;
     mutable std::string collectRegulations;
     mutable std::string postRegulations;
@@ -180,8 +176,7 @@ struct CrifRecord {
                std::string amountCurrency, QuantLib::Real amount, QuantLib::Real amountUsd, std::string imModel = "",
                std::string collectRegulations = "", std::string postRegulations = "", std::string endDate = "",
                std::map<std::string, std::string> extraFields = {})
-        : tradeId(tradeId), portfolioId(nettingSetDetails.nettingSetId()),
-          productClass(productClass), riskType(riskType), qualifier(qualifier),
+        : tradeId(tradeId), productClass(productClass), riskType(riskType), qualifier(qualifier),
           bucket(bucket), label1(label1), label2(label2), amountCurrency(amountCurrency), amount(amount),
           amountUsd(amountUsd), tradeType(tradeType), nettingSetDetails(nettingSetDetails), imModel(imModel),
           collectRegulations(collectRegulations), postRegulations(postRegulations), endDate(endDate) {
@@ -192,6 +187,12 @@ struct CrifRecord {
 
     RecordType type() const;
 
+    const std::string& portfolioId() const { return nettingSetDetails.nettingSetId(); }
+    const std::string& agreementType() const { return nettingSetDetails.agreementType(); }
+    const std::string& callType() const { return nettingSetDetails.callType(); }
+    const std::string& initialMarginType() const { return nettingSetDetails.initialMarginType(); }
+    const std::string& legalEntityId() const { return nettingSetDetails.legalEntityId(); }
+
     bool hasAmountCcy() const { return !amountCurrency.empty(); }
     bool hasAmount() const { return amount != QuantLib::Null<QuantLib::Real>(); }
     bool hasAmountUsd() const { return amountUsd != QuantLib::Null<QuantLib::Real>(); }
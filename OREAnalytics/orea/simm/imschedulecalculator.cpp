@@ -25,6 +25,7 @@
 
 #include <ored/portfolio/structuredtradewarning.hpp>
 #include <ored/utilities/log.hpp>
+#include <ored/utilities/parallel.hpp>
 #include <ored/utilities/to_string.hpp>
 #include <ored/utilities/parsers.hpp>
 
@@ -44,9 +45,11 @@ using ore::data::checkCurrency;
 using ore::data::NettingSetDetails;
 using ore::data::parseDate;
 using ore::data::parseBool;
+using ore::data::runTasks;
 using ore::data::to_string;
 using QuantLib::Real;
 using QuantLib::Null;
+using QuantLib::Size;
 
 namespace ore {
 namespace analytics {
@@ -56,7 +59,8 @@ IMScheduleCalculator::IMScheduleCalculator(const Crif& crif, const string& calcu
                                            const bool determineWinningRegulations, const bool enforceIMRegulations,
                                            const bool quiet,
                                            const map<SimmSide, set<NettingSetDetails>>& hasSEC,
-                                           const map<SimmSide, set<NettingSetDetails>>& hasCFTC)
+                                           const map<SimmSide, set<NettingSetDetails>>& hasCFTC,
+                                           const QuantLib::Size nThreads)
     : crif_(crif), calculationCcy_(calculationCcy), market_(market), quiet_(quiet),
       hasSEC_(hasSEC), hasCFTC_(hasCFTC) {
 
@@ -104,68 +108,88 @@ IMScheduleCalculator::IMScheduleCalculator(const Crif& crif, const string& calcu
     for (const auto& crifRecord : crif_)
         collectTradeData(crifRecord, enforceIMRegulations);
 
-    // Remove (or modify) trades with incomplete data
-    for (auto& sv : nettingSetRegTradeData_) {
-        const SimmSide& side = sv.first;
+    // The side-nettingSet-regulation combinations, each of them only touches its own trade data and results
+    struct Task {
+        SimmSide side;
+        const NettingSetDetails* nsd;
+        const string* regulation;
+        map<string, IMScheduleTradeData>* tradeData;
+    };
+    vector<Task> tasks;
+    bool needsUsdSpot = false;
+    for (auto& [side, nettingSetTradeData] : nettingSetRegTradeData_) {
+        for (auto& [nsd, regulationTradeData] : nettingSetTradeData) {
+            for (auto& [regulation, tradeDataMap] : regulationTradeData) {
+                tasks.push_back({side, &nsd, &regulation, &tradeDataMap});
+                for (auto& td : tradeDataMap)
+                    needsUsdSpot = needsUsdSpot || !td.second.missingNotionalData();
+            }
+        }
+    }
 
-        for (auto& nv : sv.second) {
-            const NettingSetDetails& nsd = nv.first;
+    // Convert some trade data values into calculation currency
+    const Real usdSpot =
+        needsUsdSpot && calculationCcy_ != "USD" ? market_->fxRate(calculationCcy_ + "USD")->value() : 1.0;
 
-            for (auto& rv : nv.second) {
-                const string& regulation = rv.first;
-                auto& tradeDataMap = rv.second;
-
-                // Remove (or modify) trades with incomplete Schedule data
-                set<string> tradesToRemove;
-                for (auto& td : tradeDataMap) {
-                    if (td.second.incomplete()) {
-                        auto subFields = map<string, string>({{"tradeId", td.first}});
-                        // If missing PV, assume PV = 0
-                        if (td.second.missingPVData()) {
-                            td.second.presentValue = 0.0;
-                            td.second.presentValueUsd = 0.0;
-                            td.second.presentValueCcy = td.second.notionalCcy;
-                        }
-                        // If missing Notional, do not process the trade
-                        if (td.second.missingNotionalData()) {
-                            ore::analytics::StructuredAnalyticsWarningMessage(
-                                "IMSchedule", "Incomplete CRIF trade data",
-                                "Missing Notional data. The trade will not be processed.", subFields)
-                                .log();
-                            tradesToRemove.insert(td.first);
-                        }
-                    }
-                }
+    if (nThreads > 1 && tasks.size() > 1)
+        LOG("IMScheduleCalculator: Processing " << tasks.size() << " side, netting set and regulation combinations"
+                                                << " using " << nThreads << " threads");
 
-                for (const string& tid : tradesToRemove) {
-                    tradeDataMap.erase(tid);
-                    tradeIds_.at(side).at(nsd).at(regulation).erase(tid);
+    // Remove (or modify) trades with incomplete data
+    runTasks(tasks.size(), nThreads, [this, &tasks, &today, &dayCounter, usdSpot](Size i) {
+        const SimmSide& side = tasks[i].side;
+        const NettingSetDetails& nsd = *tasks[i].nsd;
+        const string& regulation = *tasks[i].regulation;
+        auto& tradeDataMap = *tasks[i].tradeData;
+
+        // Remove (or modify) trades with incomplete Schedule data
+        set<string> tradesToRemove;
+        for (auto& td : tradeDataMap) {
+            if (td.second.incomplete()) {
+                auto subFields = map<string, string>({{"tradeId", td.first}});
+                // If missing PV, assume PV = 0
+                if (td.second.missingPVData()) {
+                    td.second.presentValue = 0.0;
+                    td.second.presentValueUsd = 0.0;
+                    td.second.presentValueCcy = td.second.notionalCcy;
                 }
-
-                // Calculate Schedule data for each trade data obj
-                for (auto& td : tradeDataMap) {
-                    IMScheduleTradeData& tradeData = td.second;
-
-                    // Calculate gross IM for each IM Schedule trade
-                    tradeData.maturity = dayCounter.yearFraction(today, tradeData.endDate);
-                    tradeData.label = label(tradeData.productClass, tradeData.maturity);
-                    tradeData.labelString = labelString(tradeData.label);
-                    tradeData.multiplier = multiplier(tradeData.label);
-                    tradeData.grossMarginUsd = tradeData.multiplier * tradeData.notionalUsd;
-
-                    // Convert some trade data values into calculation currency
-                    const Real usdSpot = calculationCcy_ != "USD" ? market_->fxRate(calculationCcy_ + "USD")->value() : 1.0;
-                    tradeData.notionalCalc = tradeData.notionalUsd / usdSpot;
-                    tradeData.presentValueCalc = tradeData.presentValueUsd / usdSpot;
-                    tradeData.grossMarginCalc = tradeData.grossMarginUsd / usdSpot;
-                    if (side == SimmSide::Call)
-                        tradeData.collectRegulations = regulation;
-                    if (side == SimmSide::Post)
-                        tradeData.postRegulations = regulation;
+                // If missing Notional, do not process the trade
+                if (td.second.missingNotionalData()) {
+                    ore::analytics::StructuredAnalyticsWarningMessage(
+                        "IMSchedule", "Incomplete CRIF trade data",
+                        "Missing Notional data. The trade will not be processed.", subFields)
+                        .log();
+                    tradesToRemove.insert(td.first);
                 }
             }
         }
-    }
+
+        for (const string& tid : tradesToRemove) {
+            tradeDataMap.erase(tid);
+            tradeIds_.at(side).at(nsd).at(regulation).erase(tid);
+        }
+
+        // Calculate Schedule data for each trade data obj
+        for (auto& td : tradeDataMap) {
+            IMScheduleTradeData& tradeData = td.second;
+
+            // Calculate gross IM for each IM Schedule trade
+            tradeData.maturity = dayCounter.yearFraction(today, tradeData.endDate);
+            tradeData.label = label(tradeData.productClass, tradeData.maturity);
+            tradeData.labelString = labelString(tradeData.label);
+            tradeData.multiplier = multiplier(tradeData.label);
+            tradeData.grossMarginUsd = tradeData.multiplier * tradeData.notionalUsd;
+
+            // Convert some trade data values into calculation currency
+            tradeData.notionalCalc = tradeData.notionalUsd / usdSpot;
+            tradeData.presentValueCalc = tradeData.presentValueUsd / usdSpot;
+            tradeData.grossMarginCalc = tradeData.grossMarginUsd / usdSpot;
+            if (side == SimmSide::Call)
+                tradeData.collectRegulations = regulation;
+            if (side == SimmSide::Post)
+                tradeData.postRegulations = regulation;
+        }
+    });
 
     // Some additional processing depending on the regulations applicable to each netting set
     for (auto& sv : nettingSetRegTradeData_) {
@@ -207,20 +231,22 @@ IMScheduleCalculator::IMScheduleCalculator(const Crif& crif, const string& calcu
         }
     }
 
-    // Calculate the higher level margins
+    // Calculate the higher level margins, the combinations may have changed because of the SEC / CFTC handling
     LOG("IMScheduleCalculator: Populating higher level results")
-    for (const auto& sv : nettingSetRegTradeData_) {
-        const SimmSide side = sv.first;
-
-        for (const auto& nv : sv.second) {
-            const NettingSetDetails& nsd = nv.first;
-
-            for (const auto& rv : nv.second) {
-                const string& regulation = rv.first;
-                populateResults(nsd, regulation, side);
+    tasks.clear();
+    for (auto& [side, nettingSetTradeData] : nettingSetRegTradeData_) {
+        for (auto& [nsd, regulationTradeData] : nettingSetTradeData) {
+            for (auto& [regulation, tradeDataMap] : regulationTradeData) {
+                tasks.push_back({side, &nsd, &regulation, &tradeDataMap});
+                // Create the results entries up front, so that the tasks only look them up. There is no entry
+                // without trade data, populateResults() fails for such a combination.
+                if (!tradeDataMap.empty())
+                    imScheduleResults_[side][nsd][regulation];
             }
         }
     }
+    runTasks(tasks.size(), nThreads,
+             [this, &tasks](Size i) { populateResults(*tasks[i].nsd, *tasks[i].regulation, tasks[i].side); });
 
     if (determineWinningRegulations) {
         LOG("IMScheduleCalculator: Determining winning regulations");
@@ -579,7 +605,9 @@ void IMScheduleCalculator::add(const SimmSide& side, const NettingSetDetails& ns
                                const Real& netRC, const Real& ngr, const Real& scheduleIM) {
     
     QuantLib::Real netToGrossRatio = ngr != Null<Real>() && close_enough(ngr, 0.0) ? 0.0 : ngr;
-    imScheduleResults_[side][nsd][regulation].add(pc, calcCcy, grossIM, grossRC, netRC, netToGrossRatio, scheduleIM);
+    // The entry is created in the constructor, we only look it up since this may run concurrently
+    imScheduleResults_.at(side).at(nsd).at(regulation).add(pc, calcCcy, grossIM, grossRC, netRC, netToGrossRatio,
+                                                          scheduleIM);
 }
 
 } // namespace analytics
@@ -107,7 +107,10 @@ public:
               endDate(QuantLib::Date()), calculationCcy(""), collectRegulations(""), postRegulations("") {}
     };
 
-    //! Construct the IMScheduleCalculator from a container of netted CRIF records.
+    /*! Construct the IMScheduleCalculator from a container of netted CRIF records. If \p nThreads is greater than
+        one, the trade data and results of the (side, netting set, regulation) combinations are processed
+        concurrently on up to \p nThreads threads.
+    */
     IMScheduleCalculator(const Crif& crif, const std::string& calculationCcy = "USD",
                          const QuantLib::ext::shared_ptr<ore::data::Market> market = nullptr,
                          const bool determineWinningRegulations = true, const bool enforceIMRegulations = false,
@@ -115,7 +118,8 @@ public:
                          const std::map<SimmSide, std::set<NettingSetDetails>>& hasSEC =
                              std::map<SimmSide, std::set<NettingSetDetails>>(),
                          const std::map<SimmSide, std::set<NettingSetDetails>>& hasCFTC =
-                             std::map<SimmSide, std::set<NettingSetDetails>>());
+                             std::map<SimmSide, std::set<NettingSetDetails>>(),
+                         const QuantLib::Size nThreads = 1);
 
     //! Give back the set of portfolio IDs and trade IDs for which we have IM results
     //const std::set<std::string>& tradeIds() const { return tradeIds_; }
@@ -218,7 +222,7 @@ private:
         // clang-format on
     });
 
-    QuantLib::Real multiplier(const IMScheduleLabel& label) { return multiplierMap_[label]; }
+    QuantLib::Real multiplier(const IMScheduleLabel& label) const { return multiplierMap_.at(label); }
 
     //! Collect trade data as defined by the CRIF records
     void collectTradeData(const CrifRecord& cr, const bool enforceIMRegulations);
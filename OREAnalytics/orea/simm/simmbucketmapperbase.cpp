@@ -87,6 +87,8 @@ QuantLib::Date BucketMapping::validFromDate() const {
 
 string SimmBucketMapperBase::bucket(const RiskType& riskType, const string& qualifier) const {
 
+    std::lock_guard<std::mutex> lock(mutex_);
+
     auto key = std::make_pair(riskType, qualifier);
     if (auto b = cache_.find(key); b != cache_.end())
         return b->second;
@@ -324,7 +326,10 @@ XMLNode* SimmBucketMapperBase::toXML(ore::data::XMLDocument& doc) const {
 void SimmBucketMapperBase::addMapping(const RiskType& riskType, const string& qualifier, const string& bucket,
                                       const string& validFrom, const string& validTo, bool fallback) {
 
-    cache_.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.clear();
+    }
 
     // Possibly map to non-vol counterpart for lookup
     RiskType rt = riskType;
@@ -387,6 +392,7 @@ void SimmBucketMapperBase::checkRiskType(const RiskType& riskType) const {
 }
 
 void SimmBucketMapperBase::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
     cache_.clear();
     // Clear the bucket mapper and add back the commodity mappings
     bucketMapping_.clear();
@@ -30,6 +30,7 @@
 #include <ored/portfolio/referencedata.hpp>
 
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -128,6 +129,9 @@ private:
     QuantLib::ext::shared_ptr<SimmBasicNameMapper> nameMapper_;
 
     mutable std::set<FailedMapping> failedMappings_;
+
+    //! Guards the cache and the failed mappings, bucket() is called concurrently by a multi-threaded SIMM calculation
+    mutable std::mutex mutex_;
 };
 
 } // namespace analytics
@@ -27,6 +27,7 @@
 #include <numeric>
 #include <ored/portfolio/structuredtradewarning.hpp>
 #include <ored/utilities/log.hpp>
+#include <ored/utilities/parallel.hpp>
 #include <ored/utilities/to_string.hpp>
 #include <ored/utilities/parsers.hpp>
 #include <ql/math/comparison.hpp>
@@ -49,8 +50,10 @@ using ore::data::NettingSetDetails;
 using ore::data::Market;
 using ore::data::to_string;
 using ore::data::parseBool;
+using ore::data::runTasks;
 using QuantLib::close_enough;
 using QuantLib::Real;
+using QuantLib::Size;
 
 namespace ore {
 namespace analytics {
@@ -63,16 +66,84 @@ typedef CrifRecord::RiskType RiskType;
 typedef SimmConfiguration::Regulation Regulation;
 typedef SimmConfiguration::SimmSide SimmSide;
 
+namespace {
+
+// Risk types whose net sensitivities feed the margin of a (product class, risk class) component
+bool hasRiskClass(const RiskType& rt) {
+    switch (rt) {
+    case RiskType::Commodity:
+    case RiskType::CommodityVol:
+    case RiskType::CreditQ:
+    case RiskType::CreditVol:
+    case RiskType::BaseCorr:
+    case RiskType::CreditNonQ:
+    case RiskType::CreditVolNonQ:
+    case RiskType::Equity:
+    case RiskType::EquityVol:
+    case RiskType::FX:
+    case RiskType::FXVol:
+    case RiskType::Inflation:
+    case RiskType::InflationVol:
+    case RiskType::IRCurve:
+    case RiskType::IRVol:
+    case RiskType::XCcyBasis:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//! Copy of the entries of some netting sets in a (side, netting set) container, used to undo what-if updates
+template <class T> class NettingSetEntries {
+public:
+    typedef map<SimmSide, map<NettingSetDetails, T>> Container;
+
+    NettingSetEntries(const Container& container, const set<NettingSetDetails>& nettingSets)
+        : nettingSets_(nettingSets) {
+        for (const auto& [side, entries] : container) {
+            auto& saved = entries_[side];
+            for (const auto& nsd : nettingSets) {
+                auto it = entries.find(nsd);
+                if (it != entries.end())
+                    saved.insert(*it);
+            }
+        }
+    }
+
+    //! Restore the saved entries, entries and sides that did not exist when the copy was taken are removed
+    void restore(Container& container) const {
+        for (auto it = container.begin(); it != container.end();) {
+            if (entries_.count(it->first) == 0)
+                it = container.erase(it);
+            else
+                ++it;
+        }
+        for (const auto& [side, saved] : entries_) {
+            auto& entries = container[side];
+            for (const auto& nsd : nettingSets_)
+                entries.erase(nsd);
+            entries.insert(saved.begin(), saved.end());
+        }
+    }
+
+private:
+    set<NettingSetDetails> nettingSets_;
+    Container entries_;
+};
+
+} // namespace
+
 SimmCalculator::SimmCalculator(const ore::analytics::Crif& crif,
                                const QuantLib::ext::shared_ptr<SimmConfiguration>& simmConfiguration,
                                const string& calculationCcyCall, const string& calculationCcyPost,
                                const string& resultCcy, const QuantLib::ext::shared_ptr<Market> market,
                                const bool determineWinningRegulations, const bool enforceIMRegulations,
                                const bool quiet, const map<SimmSide, set<NettingSetDetails>>& hasSEC,
-                               const map<SimmSide, set<NettingSetDetails>>& hasCFTC)
+                               const map<SimmSide, set<NettingSetDetails>>& hasCFTC, const QuantLib::Size nThreads)
     : simmConfiguration_(simmConfiguration), calculationCcyCall_(calculationCcyCall),
       calculationCcyPost_(calculationCcyPost), resultCcy_(resultCcy.empty() ? calculationCcyCall_ : resultCcy),
-      market_(market), quiet_(quiet), hasSEC_(hasSEC), hasCFTC_(hasCFTC) {
+      market_(market), quiet_(quiet), determineWinningRegulations_(determineWinningRegulations),
+      enforceIMRegulations_(enforceIMRegulations), hasSEC_(hasSEC), hasCFTC_(hasCFTC), nThreads_(nThreads) {
 
     QL_REQUIRE(checkCurrency(calculationCcyCall_), "SIMM Calculator: The Call side calculation currency ("
                                                    << calculationCcyCall_ << ") must be a valid ISO currency code");
@@ -98,31 +169,10 @@ SimmCalculator::SimmCalculator(const ore::analytics::Crif& crif,
 
 
         // Check for each netting set whether post/collect regs are populated at all
-        if (collectRegsIsEmpty_.find(cr.nettingSetDetails) == collectRegsIsEmpty_.end()) {
-            collectRegsIsEmpty_[cr.nettingSetDetails] = cr.collectRegulations.empty();
-        } else if (collectRegsIsEmpty_.at(cr.nettingSetDetails) && !cr.collectRegulations.empty()) {
-            collectRegsIsEmpty_.at(cr.nettingSetDetails) = false;
-        }
-        if (postRegsIsEmpty_.find(cr.nettingSetDetails) == postRegsIsEmpty_.end()) {
-            postRegsIsEmpty_[cr.nettingSetDetails] = cr.postRegulations.empty();
-        } else if (postRegsIsEmpty_.at(cr.nettingSetDetails) && !cr.postRegulations.empty()) {
-            postRegsIsEmpty_.at(cr.nettingSetDetails) = false;
-        }
+        updateRegsIsEmpty(cr);
 
         // Make sure we have CRIF amount denominated in the result ccy
-        CrifRecord newCrifRecord = cr;
-        
-        if (cr.requiresAmountUsd() && resultCcy_ == "USD" && cr.hasAmountUsd()) {
-            newCrifRecord.amountResultCcy = newCrifRecord.amountUsd;
-        } else if(cr.requiresAmountUsd()) {
-            // ProductClassMultiplier and AddOnNotionalFactor  don't have a currency and dont need to be converted,
-            // we use the amount
-            const Real fxSpot = market_->fxRate(newCrifRecord.amountCurrency + resultCcy_)->value();
-            newCrifRecord.amountResultCcy = fxSpot * newCrifRecord.amount;
-        }
-        newCrifRecord.resultCurrency = resultCcy_;
-
-        crif_.addRecord(newCrifRecord);
+        crif_.addRecord(resultCcyRecord(cr));
     }
 
     // If there are no CRIF records to process
@@ -186,10 +236,16 @@ SimmCalculator::SimmCalculator(const ore::analytics::Crif& crif,
         }
     }
 
-    // Calculate SIMM call and post for each regulation under each netting set
+    // Collect the side-nettingSet-regulation combinations for which we calculate SIMM
+    struct Task {
+        SimmSide side;
+        const NettingSetDetails* nsd;
+        const string* regulation;
+        const Crif* crif;
+    };
+    std::vector<Task> tasks;
     for (const auto& [side, nettingSetRegulationCrifMap] : regSensitivities_) {
         for (const auto& [nsd, regulationCrifMap] : nettingSetRegulationCrifMap) {
-            // Calculate SIMM for particular side-nettingSet-regulation combination
             for (const auto& [regulation, crif] : regulationCrifMap) {
                 bool hasFixedAddOn = false;
                 for (const auto& sp : crif) {
@@ -199,50 +255,46 @@ SimmCalculator::SimmCalculator(const ore::analytics::Crif& crif,
                     }
                 }
                 if (crif.hasCrifRecords() || hasFixedAddOn)
-                    calculateRegulationSimm(crif, nsd, regulation, side);
+                    tasks.push_back({side, &nsd, &regulation, &crif});
             }
         }
     }
 
+    // Calculate SIMM call and post for each regulation under each netting set
+    if (nThreads_ <= 1 || tasks.size() <= 1) {
+        for (const auto& t : tasks)
+            calculateRegulationSimm(*t.crif, *t.nsd, *t.regulation, t.side);
+    } else {
+        if (!quiet_) {
+            LOG("SimmCalculator: Calculating component margins of " << tasks.size()
+                                                                    << " side, netting set and regulation combinations"
+                                                                    << " using " << nThreads_ << " threads");
+        }
+        // Create the container entries up front, the tasks then only look up and write to their own entries
+        for (const auto& t : tasks) {
+            componentSensitivities_[t.side][*t.nsd][*t.regulation];
+            addOnSensitivities_[t.side][*t.nsd][*t.regulation];
+            componentResults_[t.side][*t.nsd][*t.regulation];
+        }
+        runTasks(tasks.size(), nThreads_, [this, &tasks](Size i) {
+            calculateComponentMargins(*tasks[i].crif, *tasks[i].nsd, *tasks[i].regulation, tasks[i].side);
+        });
+        // Aggregating touches the results shared between combinations and records the SIMM parameters, this is
+        // cheap compared to the component margins and done in the same order as in the sequential calculation
+        for (const auto& t : tasks)
+            aggregateRegulationSimm(t.side, *t.nsd, *t.regulation, true);
+    }
+
     // Determine winning call and post regulations
     if (determineWinningRegulations) {
         if (!quiet_) {
             LOG("SimmCalculator: Determining winning regulations");
         }
 
-        for (auto sv : simmResults_) {
-            const SimmSide side = sv.first;
-
+        for (const auto& [side, nettingSetResults] : simmResults_) {
             // Determine winning (call and post) regulation for each netting set
-            for (const auto& kv : sv.second) {
-
-                // Collect margin amounts and determine the highest margin amount
-                Real winningMargin = std::numeric_limits<Real>::min();
-                map<string, Real> nettingSetMargins;
-                std::vector<Real> margins;
-                for (const auto& regSimmResults : kv.second) {
-                    const Real& im = regSimmResults.second.get(ProductClass::All, RiskClass::All, MarginType::All, "All");
-                    nettingSetMargins[regSimmResults.first] = im;
-                    if (im > winningMargin)
-                        winningMargin = im;
-                }
-
-                // Determine winning regulations, i.e. regulations under which we find the highest margin amount
-                std::vector<string> winningRegulations;
-                for (const auto& kv : nettingSetMargins) {
-                    if (close_enough(kv.second, winningMargin))
-                        winningRegulations.push_back(kv.first);
-                }
-
-                // In the case of multiple winning regulations, pick one based on the priority in the list
-                //const Regulation winningRegulation = oreplus::analytics::getWinningRegulation(winningRegulations);
-                string winningRegulation = winningRegulations.size() > 1
-                                               ? to_string(getWinningRegulation(winningRegulations))
-                                               : winningRegulations.at(0);
-
-                // Populate internal list of winning regulators
-                winningRegulations_[side][kv.first] = to_string(winningRegulation);
-            }
+            for (const auto& [nsd, regulationResults] : nettingSetResults)
+                calculateWinningRegulation(side, nsd);
         }
 
         populateFinalResults();
@@ -253,128 +305,434 @@ const void SimmCalculator::calculateRegulationSimm(const Crif& crif,
                                                    const NettingSetDetails& nettingSetDetails, const string& regulation,
                                                    const SimmSide& side) {
 
+    // Make sure the component container entries of the combination exist
+    componentSensitivities_[side][nettingSetDetails][regulation];
+    addOnSensitivities_[side][nettingSetDetails][regulation];
+    componentResults_[side][nettingSetDetails][regulation];
+    calculateComponentMargins(crif, nettingSetDetails, regulation, side);
+
+    // Calculate the higher level margins and the additional margin
+    aggregateRegulationSimm(side, nettingSetDetails, regulation, true);
+}
+
+void SimmCalculator::calculateComponentMargins(const Crif& crif, const NettingSetDetails& nettingSetDetails,
+                                               const string& regulation, const SimmSide& side) {
+
     if (!quiet_) {
         LOG("SimmCalculator: Calculating SIMM " << side << " for portfolio [" << nettingSetDetails << "], regulation "
                                                 << regulation);
     }
-    // Loop over portfolios and product classes
-   for(const auto  productClass : crif.ProductClassesByNettingSetDetails(nettingSetDetails)){
+    // Split the netted records into (product class, risk class) components and the records feeding the
+    // additional margin, so that each margin calculation below only scans the records it needs
+    auto& components = componentSensitivities_.at(side).at(nettingSetDetails).at(regulation);
+    auto& addOns = addOnSensitivities_.at(side).at(nettingSetDetails).at(regulation);
+    components.clear();
+    addOns.clear();
+    for (const auto& cr : crif) {
+        if (cr.nettingSetDetails != nettingSetDetails)
+            continue;
+        if (hasRiskClass(cr.riskType))
+            components[make_pair(cr.productClass, SimmConfiguration::riskTypeToRiskClass(cr.riskType))].addRecord(cr);
+        else
+            addOns.addRecord(cr);
+    }
+
+    auto& results = componentResults_.at(side).at(nettingSetDetails).at(regulation);
+    results.clear();
+    for (const auto& [key, netRecords] : components) {
         if (!quiet_) {
-            LOG("SimmCalculator: Calculating SIMM for product class " << productClass);
+            LOG("SimmCalculator: Calculating SIMM for product class " << key.first << " and risk class "
+                                                                      << key.second);
         }
+        results[key] = componentMargin(nettingSetDetails, key.first, key.second, netRecords, side);
+    }
+}
+
+Real SimmCalculator::usdToResultCcyFx() const {
+    std::lock_guard<std::mutex> lock(marketMutex_);
+    return market_->fxRate("USD" + resultCcy_)->value();
+}
 
-        // Delta margin components
-        RiskClass rc = RiskClass::InterestRate;
-        MarginType mt = MarginType::Delta;
-        auto p = irDeltaMargin(nettingSetDetails, productClass, crif, side);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::FX;
-        p = margin(nettingSetDetails, productClass, RiskType::FX, crif, side);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::CreditQualifying;
-        p = margin(nettingSetDetails, productClass, RiskType::CreditQ, crif, side);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::CreditNonQualifying;
-        p = margin(nettingSetDetails, productClass, RiskType::CreditNonQ, crif, side);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::Equity;
-        p = margin(nettingSetDetails, productClass, RiskType::Equity, crif, side);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::Commodity;
-        p = margin(nettingSetDetails, productClass, RiskType::Commodity, crif, side);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        // Vega margin components
-        mt = MarginType::Vega;
-        rc = RiskClass::InterestRate;
-        p = irVegaMargin(nettingSetDetails, productClass, crif, side);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::FX;
-        p = margin(nettingSetDetails, productClass, RiskType::FXVol, crif, side);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::CreditQualifying;
-        p = margin(nettingSetDetails, productClass, RiskType::CreditVol, crif, side);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::CreditNonQualifying;
-        p = margin(nettingSetDetails, productClass, RiskType::CreditVolNonQ, crif, side);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::Equity;
-        p = margin(nettingSetDetails, productClass, RiskType::EquityVol, crif, side);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::Commodity;
-        p = margin(nettingSetDetails, productClass, RiskType::CommodityVol, crif, side);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        // Curvature margin components for sides call and post
-        mt = MarginType::Curvature;
-        rc = RiskClass::InterestRate;
-
-        p = irCurvatureMargin(nettingSetDetails, productClass, side, crif);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::FX;
-        p = curvatureMargin(nettingSetDetails, productClass, RiskType::FXVol, side, crif, false);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::CreditQualifying;
-        p = curvatureMargin(nettingSetDetails, productClass, RiskType::CreditVol, side, crif);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::CreditNonQualifying;
-        p = curvatureMargin(nettingSetDetails, productClass, RiskType::CreditVolNonQ, side, crif);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::Equity;
-        p = curvatureMargin(nettingSetDetails, productClass, RiskType::EquityVol, side, crif, false);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
-
-        rc = RiskClass::Commodity;
-        p = curvatureMargin(nettingSetDetails, productClass, RiskType::CommodityVol, side, crif, false);
-        if (p.second)
-            add(nettingSetDetails, regulation, productClass, rc, mt, p.first, side);
+SimmResults SimmCalculator::componentMargin(const NettingSetDetails& nettingSetDetails, const ProductClass& pc,
+                                            const RiskClass& rc, const Crif& crif, const SimmSide& side) const {
 
+    const string& calculationCcy = side == SimmSide::Call ? calculationCcyCall_ : calculationCcyPost_;
+    SimmResults results(resultCcy_, calculationCcy);
+
+    auto addMargin = [&results, &pc, &rc, &calculationCcy, this](const MarginType& mt,
+                                                                 const pair<map<string, Real>, bool>& p) {
+        if (p.second) {
+            for (const auto& [bucket, im] : p.first)
+                results.add(pc, rc, mt, bucket, im, resultCcy_, calculationCcy, true);
+        }
+    };
+
+    switch (rc) {
+    case RiskClass::InterestRate:
+        addMargin(MarginType::Delta, irDeltaMargin(nettingSetDetails, pc, crif, side));
+        addMargin(MarginType::Vega, irVegaMargin(nettingSetDetails, pc, crif, side));
+        addMargin(MarginType::Curvature, irCurvatureMargin(nettingSetDetails, pc, side, crif));
+        break;
+    case RiskClass::FX:
+        addMargin(MarginType::Delta, margin(nettingSetDetails, pc, RiskType::FX, crif, side));
+        addMargin(MarginType::Vega, margin(nettingSetDetails, pc, RiskType::FXVol, crif, side));
+        addMargin(MarginType::Curvature, curvatureMargin(nettingSetDetails, pc, RiskType::FXVol, side, crif, false));
+        break;
+    case RiskClass::CreditQualifying:
+        addMargin(MarginType::Delta, margin(nettingSetDetails, pc, RiskType::CreditQ, crif, side));
+        addMargin(MarginType::Vega, margin(nettingSetDetails, pc, RiskType::CreditVol, crif, side));
+        addMargin(MarginType::Curvature, curvatureMargin(nettingSetDetails, pc, RiskType::CreditVol, side, crif));
         // Base correlation margin components. This risk type came later so need to check
         // first if it is valid under the configuration
-        if (simmConfiguration_->isValidRiskType(RiskType::BaseCorr)) {
-            p = margin(nettingSetDetails, productClass, RiskType::BaseCorr, crif, side);
-            if (p.second)
-                add(nettingSetDetails, regulation, productClass, RiskClass::CreditQualifying, MarginType::BaseCorr,
-                    p.first, side);
+        if (simmConfiguration_->isValidRiskType(RiskType::BaseCorr))
+            addMargin(MarginType::BaseCorr, margin(nettingSetDetails, pc, RiskType::BaseCorr, crif, side));
+        break;
+    case RiskClass::CreditNonQualifying:
+        addMargin(MarginType::Delta, margin(nettingSetDetails, pc, RiskType::CreditNonQ, crif, side));
+        addMargin(MarginType::Vega, margin(nettingSetDetails, pc, RiskType::CreditVolNonQ, crif, side));
+        addMargin(MarginType::Curvature,
+                  curvatureMargin(nettingSetDetails, pc, RiskType::CreditVolNonQ, side, crif));
+        break;
+    case RiskClass::Equity:
+        addMargin(MarginType::Delta, margin(nettingSetDetails, pc, RiskType::Equity, crif, side));
+        addMargin(MarginType::Vega, margin(nettingSetDetails, pc, RiskType::EquityVol, crif, side));
+        addMargin(MarginType::Curvature,
+                  curvatureMargin(nettingSetDetails, pc, RiskType::EquityVol, side, crif, false));
+        break;
+    case RiskClass::Commodity:
+        addMargin(MarginType::Delta, margin(nettingSetDetails, pc, RiskType::Commodity, crif, side));
+        addMargin(MarginType::Vega, margin(nettingSetDetails, pc, RiskType::CommodityVol, crif, side));
+        addMargin(MarginType::Curvature,
+                  curvatureMargin(nettingSetDetails, pc, RiskType::CommodityVol, side, crif, false));
+        break;
+    default:
+        QL_FAIL("SimmCalculator: Unexpected risk class " << rc);
+    }
+
+    return results;
+}
+
+void SimmCalculator::aggregateRegulationSimm(const SimmSide& side, const NettingSetDetails& nettingSetDetails,
+                                             const string& regulation, const bool recordSimmParameters) {
+
+    const auto& components = componentResults_[side][nettingSetDetails][regulation];
+    const auto& addOns = addOnSensitivities_[side][nettingSetDetails][regulation];
+
+    auto& regulationResults = simmResults_[side][nettingSetDetails];
+    regulationResults.erase(regulation);
+
+    bool hasFixedAddOn = false;
+    for (const auto& sp : addOns) {
+        if (sp.riskType == RiskType::AddOnFixedAmount) {
+            hasFixedAddOn = true;
+            break;
         }
     }
+    if (components.empty() && !addOns.hasCrifRecords() && !hasFixedAddOn) {
+        if (regulationResults.empty())
+            simmResults_[side].erase(nettingSetDetails);
+        return;
+    }
+
+    // Margins at the (product class, risk class, margin type) level
+    for (const auto& [key, results] : components) {
+        for (const auto& [k, im] : results.data())
+            add(nettingSetDetails, regulation, std::get<0>(k), std::get<1>(k), std::get<2>(k), std::get<3>(k), im,
+                side);
+    }
 
     // Calculate the higher level margins
     populateResults(side, nettingSetDetails, regulation);
 
     // For each portfolio, calculate the additional margin
-    calcAddMargin(side, nettingSetDetails, regulation, crif);
+    calcAddMargin(side, nettingSetDetails, regulation, addOns, recordSimmParameters);
+}
+
+void SimmCalculator::calculateWinningRegulation(const SimmSide& side, const NettingSetDetails& nettingSetDetails) {
+
+    const auto& regulationResults = simmResults_.at(side).at(nettingSetDetails);
+
+    // Collect margin amounts and determine the highest margin amount
+    Real winningMargin = std::numeric_limits<Real>::min();
+    map<string, Real> nettingSetMargins;
+    for (const auto& regSimmResults : regulationResults) {
+        const Real& im = regSimmResults.second.get(ProductClass::All, RiskClass::All, MarginType::All, "All");
+        nettingSetMargins[regSimmResults.first] = im;
+        if (im > winningMargin)
+            winningMargin = im;
+    }
+
+    // Determine winning regulations, i.e. regulations under which we find the highest margin amount
+    std::vector<string> winningRegulations;
+    for (const auto& kv : nettingSetMargins) {
+        if (close_enough(kv.second, winningMargin))
+            winningRegulations.push_back(kv.first);
+    }
+
+    // In the case of multiple winning regulations, pick one based on the priority in the list
+    string winningRegulation = winningRegulations.size() > 1
+                                   ? to_string(getWinningRegulation(winningRegulations))
+                                   : winningRegulations.at(0);
+
+    // Populate internal list of winning regulators
+    winningRegulations_[side][nettingSetDetails] = winningRegulation;
+}
+
+void SimmCalculator::addRecords(const Crif& crif) { updateRecords(crif, 1.0, true); }
+
+void SimmCalculator::removeRecords(const Crif& crif) { updateRecords(crif, -1.0, true); }
+
+Real SimmCalculator::incrementalMargin(const Crif& crif, const SimmSide& side,
+                                       const NettingSetDetails& nettingSetDetails) {
+
+    // The initial margin is the margin under the winning regulation, i.e. the highest margin over the regulations
+    auto im = [this, &side, &nettingSetDetails]() {
+        Real result = 0.0;
+        auto it = simmResults_.find(side);
+        if (it == simmResults_.end())
+            return result;
+        auto jt = it->second.find(nettingSetDetails);
+        if (jt == it->second.end())
+            return result;
+        for (const auto& [regulation, results] : jt->second) {
+            if (results.has(ProductClass::All, RiskClass::All, MarginType::All, "All"))
+                result = max(result, results.get(ProductClass::All, RiskClass::All, MarginType::All, "All"));
+        }
+        return result;
+    };
+
+    // The what-if update only touches the entries of the netting sets in crif, so these are saved and restored
+    // afterwards instead of backing the records out again, which would not reproduce the original state exactly
+    set<NettingSetDetails> nettingSets;
+    for (const CrifRecord& cr : crif)
+        nettingSets.insert(cr.nettingSetDetails);
+    NettingSetEntries<map<string, map<ComponentKey, Crif>>> componentSensitivities(componentSensitivities_,
+                                                                                    nettingSets);
+    NettingSetEntries<map<string, map<ComponentKey, SimmResults>>> componentResults(componentResults_, nettingSets);
+    NettingSetEntries<map<string, Crif>> addOnSensitivities(addOnSensitivities_, nettingSets);
+    NettingSetEntries<map<string, SimmResults>> simmResults(simmResults_, nettingSets);
+
+    const Real baseMargin = im();
+    updateRecords(crif, 1.0, false);
+    const Real whatIfMargin = im();
+
+    componentSensitivities.restore(componentSensitivities_);
+    componentResults.restore(componentResults_);
+    addOnSensitivities.restore(addOnSensitivities_);
+    simmResults.restore(simmResults_);
+
+    return whatIfMargin - baseMargin;
+}
+
+void SimmCalculator::updateRecords(const Crif& crif, const Real sign, const bool finalise) {
+
+    // The (product class, risk class) components touched by the update, an empty set still flags a change in the
+    // additional margin records
+    //       side,              netting set details,                   regulation
+    map<SimmSide, map<NettingSetDetails, map<string, set<ComponentKey>>>> affected;
+
+    // Trade IDs with removed records, they are dropped below if no records are left for them
+    //       side,              netting set details,                   regulation
+    map<SimmSide, map<NettingSetDetails, map<string, set<string>>>> removedTradeIds;
+
+    // ProductClassMultiplier and AddOnNotionalFactor records are not netted, so they can not be backed out again
+    if (sign < 0.0) {
+        for (const CrifRecord& cr : crif) {
+            QL_REQUIRE(cr.riskType != RiskType::ProductClassMultiplier &&
+                           cr.riskType != RiskType::AddOnNotionalFactor,
+                       "SimmCalculator: Can not remove CRIF records with risk type " << cr.riskType);
+        }
+    }
+
+    auto hasRegulation = [this](const SimmSide& side, const NettingSetDetails& nsd, const string& r) {
+        auto it = componentSensitivities_.find(side);
+        if (it != componentSensitivities_.end() && it->second.count(nsd) > 0 && it->second.at(nsd).count(r) > 0)
+            return true;
+        auto jt = addOnSensitivities_.find(side);
+        return jt != addOnSensitivities_.end() && jt->second.count(nsd) > 0 && jt->second.at(nsd).count(r) > 0;
+    };
+
+    // The regulations under which a record is included given the regulations currently in its netting set
+    auto regulations = [this, &hasRegulation](const CrifRecord& cr, const SimmSide& side) {
+        const NettingSetDetails& nsd = cr.nettingSetDetails;
+        set<string> regs = recordRegulations(cr, side, enforceIMRegulations_);
+
+        // CFTC records are included in the SEC calculation as well, see the constructor
+        if (regs.count("CFTC") > 0 && regs.count("SEC") == 0 &&
+            (hasRegulation(side, nsd, "SEC") || (hasSEC_[side].count(nsd) > 0 && hasCFTC_[side].count(nsd) > 0)))
+            regs.insert("SEC");
+
+        // "Unspecified" sensitivities are excluded if there are other regulations
+        if (regs.count("Unspecified") > 0 && regs.size() > 1)
+            regs.erase("Unspecified");
+
+        return regs;
+    };
+
+    for (const CrifRecord& cr : crif) {
+        if (cr.riskType == RiskType::Empty || cr.imModel == "Schedule")
+            continue;
+
+        if (finalise && sign > 0.0)
+            updateRegsIsEmpty(cr);
+
+        CrifRecord record = resultCcyRecord(cr);
+        if (record.amount != QuantLib::Null<Real>())
+            record.amount *= sign;
+        if (record.amountUsd != QuantLib::Null<Real>())
+            record.amountUsd *= sign;
+        if (record.amountResultCcy != QuantLib::Null<Real>())
+            record.amountResultCcy *= sign;
+        if (finalise)
+            crif_.addRecord(record);
+
+        // Net record at portfolio level, as in Crif::aggregate()
+        record.tradeId = "";
+        record.collectRegulations.clear();
+        record.postRegulations.clear();
+
+        const NettingSetDetails& nsd = cr.nettingSetDetails;
+        for (const auto& side : {SimmSide::Call, SimmSide::Post}) {
+            set<string> regs = regulations(cr, side);
+
+            // If the record brings SEC into a netting set with CFTC records, the CFTC records already included
+            // are part of the SEC calculation as well, see the constructor
+            if (regs.count("SEC") > 0 && !hasRegulation(side, nsd, "SEC") && hasRegulation(side, nsd, "CFTC")) {
+                auto& secComponents = affected[side][nsd]["SEC"];
+                auto& regulationSensitivities = componentSensitivities_[side][nsd];
+                auto it = regulationSensitivities.find("CFTC");
+                if (it != regulationSensitivities.end()) {
+                    auto& secSensitivities = regulationSensitivities["SEC"];
+                    for (const auto& [key, sensitivities] : it->second) {
+                        secSensitivities[key].addRecords(sensitivities, true);
+                        secComponents.insert(key);
+                    }
+                }
+                auto& addOns = addOnSensitivities_[side][nsd];
+                auto jt = addOns.find("CFTC");
+                if (jt != addOns.end())
+                    addOns["SEC"].addRecords(jt->second);
+            }
+
+            for (const string& r : regs) {
+                if (finalise && !cr.isSimmParameter()) {
+                    if (sign > 0.0)
+                        tradeIds_[side][nsd][r].insert(cr.tradeId);
+                    else
+                        removedTradeIds[side][nsd][r].insert(cr.tradeId);
+                }
+                auto& components = affected[side][nsd][r];
+                if (hasRiskClass(record.riskType)) {
+                    ComponentKey key(record.productClass, SimmConfiguration::riskTypeToRiskClass(record.riskType));
+                    // Ignore amountCcy when netting, see splitCrifByRegulationsAndPortfolios
+                    componentSensitivities_[side][nsd][r][key].addRecord(record, true);
+                    components.insert(key);
+                } else {
+                    addOnSensitivities_[side][nsd][r].addRecord(record);
+                }
+            }
+        }
+    }
+
+    // A trade ID is only dropped from a regulation once none of its records under that regulation are left
+    for (const auto& [side, nettingSetTradeIds] : removedTradeIds) {
+        for (const auto& [nsd, regulationTradeIds] : nettingSetTradeIds) {
+            for (const auto& [regulation, tids] : regulationTradeIds) {
+                for (const string& tid : tids) {
+                    bool remaining = false;
+                    for (const CrifRecord& cr : crif_.filterByTradeId(tid)) {
+                        if (cr.nettingSetDetails == nsd && !cr.isSimmParameter() &&
+                            cr.amountResultCcy != QuantLib::Null<Real>() && !close_enough(cr.amountResultCcy, 0.0) &&
+                            regulations(cr, side).count(regulation) > 0) {
+                            remaining = true;
+                            break;
+                        }
+                    }
+                    if (!remaining)
+                        tradeIds_[side][nsd][regulation].erase(tid);
+                }
+            }
+        }
+    }
+
+    for (const auto& [side, nettingSetComponents] : affected) {
+        for (const auto& [nsd, regulationComponents] : nettingSetComponents) {
+            for (const auto& [regulation, keys] : regulationComponents) {
+                if (!quiet_) {
+                    DLOG("SimmCalculator: Updating SIMM " << side << " for portfolio [" << nsd << "], regulation "
+                                                          << regulation << " and " << keys.size() << " components");
+                }
+                auto& sensitivities = componentSensitivities_[side][nsd][regulation];
+                auto& results = componentResults_[side][nsd][regulation];
+                for (const auto& key : keys) {
+                    auto it = sensitivities.find(key);
+                    // Drop records that have been netted out completely
+                    if (sign < 0.0)
+                        it->second = it->second.filterNonZeroAmount();
+                    if (it->second.empty()) {
+                        sensitivities.erase(it);
+                        results.erase(key);
+                    } else {
+                        results[key] = componentMargin(nsd, key.first, key.second, it->second, side);
+                    }
+                }
+                if (sign < 0.0) {
+                    auto& addOns = addOnSensitivities_[side][nsd][regulation];
+                    addOns = addOns.filterNonZeroAmount();
+                }
+                aggregateRegulationSimm(side, nsd, regulation, false);
+            }
+
+            // If the netting set now has "Unspecified" plus other regulations, the "Unspecified" sensis are excluded
+            auto it = simmResults_.find(side);
+            if (it != simmResults_.end() && it->second.count(nsd) > 0) {
+                auto& regulationResults = it->second.at(nsd);
+                if (regulationResults.count("Unspecified") > 0 && regulationResults.size() > 1) {
+                    regulationResults.erase("Unspecified");
+                    componentSensitivities_[side][nsd].erase("Unspecified");
+                    componentResults_[side][nsd].erase("Unspecified");
+                    addOnSensitivities_[side][nsd].erase("Unspecified");
+                }
+                if (finalise && determineWinningRegulations_)
+                    calculateWinningRegulation(side, nsd);
+            } else if (finalise && determineWinningRegulations_) {
+                winningRegulations_[side].erase(nsd);
+                finalSimmResults_[side].erase(nsd);
+            }
+        }
+    }
+
+    if (finalise && determineWinningRegulations_)
+        populateFinalResults();
+}
+
+void SimmCalculator::updateRegsIsEmpty(const CrifRecord& cr) {
+    if (collectRegsIsEmpty_.find(cr.nettingSetDetails) == collectRegsIsEmpty_.end()) {
+        collectRegsIsEmpty_[cr.nettingSetDetails] = cr.collectRegulations.empty();
+    } else if (collectRegsIsEmpty_.at(cr.nettingSetDetails) && !cr.collectRegulations.empty()) {
+        collectRegsIsEmpty_.at(cr.nettingSetDetails) = false;
+    }
+    if (postRegsIsEmpty_.find(cr.nettingSetDetails) == postRegsIsEmpty_.end()) {
+        postRegsIsEmpty_[cr.nettingSetDetails] = cr.postRegulations.empty();
+    } else if (postRegsIsEmpty_.at(cr.nettingSetDetails) && !cr.postRegulations.empty()) {
+        postRegsIsEmpty_.at(cr.nettingSetDetails) = false;
+    }
+}
+
+CrifRecord SimmCalculator::resultCcyRecord(const CrifRecord& cr) const {
+    CrifRecord newCrifRecord = cr;
+
+    if (cr.requiresAmountUsd() && resultCcy_ == "USD" && cr.hasAmountUsd()) {
+        newCrifRecord.amountResultCcy = newCrifRecord.amountUsd;
+    } else if(cr.requiresAmountUsd()) {
+        // ProductClassMultiplier and AddOnNotionalFactor  don't have a currency and dont need to be converted,
+        // we use the amount
+        const Real fxSpot = market_->fxRate(newCrifRecord.amountCurrency + resultCcy_)->value();
+        newCrifRecord.amountResultCcy = fxSpot * newCrifRecord.amount;
+    }
+    newCrifRecord.resultCurrency = resultCcy_;
+
+    return newCrifRecord;
 }
 
 const string& SimmCalculator::winningRegulations(const SimmSide& side, const NettingSetDetails& nettingSetDetails) const {
@@ -501,7 +859,7 @@ pair<map<string, Real>, bool> SimmCalculator::irDeltaMargin(const NettingSetDeta
         // Divide by the concentration risk threshold
         Real concThreshold = simmConfiguration_->concentrationThreshold(RiskType::IRCurve, qualifier);
         if (resultCcy_ != "USD")
-            concThreshold *= market_->fxRate("USD" + resultCcy_)->value();
+            concThreshold *= usdToResultCcyFx();
         concentrationRisk[qualifier] /= concThreshold;
         // Final concentration risk amount
         concentrationRisk[qualifier] = max(1.0, sqrt(std::abs(concentrationRisk[qualifier])));
@@ -656,7 +1014,7 @@ pair<map<string, Real>, bool> SimmCalculator::irVegaMargin(const NettingSetDetai
         // Divide by the concentration risk threshold
         Real concThreshold = simmConfiguration_->concentrationThreshold(RiskType::IRVol, qualifier);
         if (resultCcy_ != "USD")
-            concThreshold *= market_->fxRate("USD" + resultCcy_)->value();
+            concThreshold *= usdToResultCcyFx();
         concentrationRisk[qualifier] /= concThreshold;
 
         // Final concentration risk amount
@@ -957,7 +1315,7 @@ pair<map<string, Real>, bool> SimmCalculator::margin(const NettingSetDetails& ne
             // Divide by the concentration risk threshold
             Real concThreshold = simmConfiguration_->concentrationThreshold(rt, qualifier);
             if (resultCcy_ != "USD")
-                concThreshold *= market_->fxRate("USD" + resultCcy_)->value();
+                concThreshold *= usdToResultCcyFx();
             concentrationRisk[qualifier] /= concThreshold;
             // Final concentration risk amount
             concentrationRisk[qualifier] = max(1.0, sqrt(std::abs(concentrationRisk[qualifier])));
@@ -1235,7 +1593,7 @@ SimmCalculator::curvatureMargin(const NettingSetDetails& nettingSetDetails, cons
 }
 
 void SimmCalculator::calcAddMargin(const SimmSide& side, const NettingSetDetails& nettingSetDetails,
-                                   const string& regulation, const Crif& crif) {
+                                   const string& regulation, const Crif& crif, const bool recordSimmParameters) {
 
     // Reference to SIMM results for this portfolio
     auto& results = simmResults_[side][nettingSetDetails][regulation];
@@ -1273,12 +1631,14 @@ void SimmCalculator::calcAddMargin(const SimmSide& side, const NettingSetDetails
             // Add to aggregation at portfolio level
             add(nettingSetDetails, regulation, ProductClass::All, RiskClass::All, MarginType::All, "All", pcmMargin, side,
                 overwrite);
-            CrifRecord spRecord = it;
-            if (side == SimmSide::Call)
-                spRecord.collectRegulations = regulation;
-            else
-                spRecord.postRegulations = regulation;
-            simmParameters_.addRecord(spRecord);
+            if (recordSimmParameters) {
+                CrifRecord spRecord = it;
+                if (side == SimmSide::Call)
+                    spRecord.collectRegulations = regulation;
+                else
+                    spRecord.postRegulations = regulation;
+                simmParameters_.addRecord(spRecord);
+            }
         }
     }
 
@@ -1299,12 +1659,14 @@ void SimmCalculator::calcAddMargin(const SimmSide& side, const NettingSetDetails
         // Add to aggregation at portfolio level
         add(nettingSetDetails, regulation, ProductClass::All, RiskClass::All, MarginType::All, "All", fixedMargin, side,
             overwrite);
-        CrifRecord spRecord = it;
-        if (side == SimmSide::Call)
-            spRecord.collectRegulations = regulation;
-        else
-            spRecord.postRegulations = regulation;
-        simmParameters_.addRecord(spRecord);
+        if (recordSimmParameters) {
+            CrifRecord spRecord = it;
+            if (side == SimmSide::Call)
+                spRecord.collectRegulations = regulation;
+            else
+                spRecord.postRegulations = regulation;
+            simmParameters_.addRecord(spRecord);
+        }
     }
 
     // Third, add percentage of notional amounts IM, using "AddOnNotionalFactor"
@@ -1339,12 +1701,14 @@ void SimmCalculator::calcAddMargin(const SimmSide& side, const NettingSetDetails
             add(nettingSetDetails, regulation, ProductClass::All, RiskClass::All, MarginType::All, "All",
                 notionalFactorMargin,
                 side, overwrite);
-            CrifRecord spRecord = it;
-            if (side == SimmSide::Call)
-                spRecord.collectRegulations = regulation;
-            else
-                spRecord.postRegulations = regulation;
-            simmParameters_.addRecord(spRecord);
+            if (recordSimmParameters) {
+                CrifRecord spRecord = it;
+                if (side == SimmSide::Call)
+                    spRecord.collectRegulations = regulation;
+                else
+                    spRecord.postRegulations = regulation;
+                simmParameters_.addRecord(spRecord);
+            }
         }
     }
 }
@@ -1623,40 +1987,50 @@ void SimmCalculator::splitCrifByRegulationsAndPortfolios(const Crif& crif, const
         for (const auto& side : {SimmSide::Call, SimmSide::Post}) {
             const NettingSetDetails& nettingSetDetails = crifRecord.nettingSetDetails;
 
-            bool collectRegsIsEmpty = false;
-            bool postRegsIsEmpty = false;
-            if (collectRegsIsEmpty_.find(crifRecord.nettingSetDetails) != collectRegsIsEmpty_.end())
-                collectRegsIsEmpty = collectRegsIsEmpty_.at(crifRecord.nettingSetDetails);
-            if (postRegsIsEmpty_.find(crifRecord.nettingSetDetails) != postRegsIsEmpty_.end())
-                postRegsIsEmpty = postRegsIsEmpty_.at(crifRecord.nettingSetDetails);
-
-            string regsString;
-            if (enforceIMRegulations)
-                regsString = side == SimmSide::Call ? crifRecord.collectRegulations : crifRecord.postRegulations;
-            set<string> regs = parseRegulationString(regsString);
+            set<string> regs = recordRegulations(crifRecord, side, enforceIMRegulations);
 
             auto newCrifRecord = crifRecord;
             newCrifRecord.collectRegulations.clear();
             newCrifRecord.postRegulations.clear();
             for (const string& r : regs) {
-                if (r == "Excluded" ||
-                    (r == "Unspecified" && enforceIMRegulations && !(collectRegsIsEmpty && postRegsIsEmpty))) {
-                    continue;
-                } else if (r != "Excluded") {
-                    // Keep a record of trade IDs for each regulation
-                    if (!newCrifRecord.isSimmParameter())
-                        tradeIds_[side][nettingSetDetails][r].insert(newCrifRecord.tradeId);
-                    // We make sure to ignore amountCcy when aggregating the records, since we will only be using
-                    // amountResultCcy, and we may have CRIF records that are equal everywhere except for the amountCcy,
-                    // and this will fail in the case of Risk_XCcyBasis and Risk_Inflation.
-                    const bool onDiffAmountCcy = true;
-                    regSensitivities_[side][nettingSetDetails][r].addRecord(newCrifRecord, onDiffAmountCcy);
-                }
+                // Keep a record of trade IDs for each regulation
+                if (!newCrifRecord.isSimmParameter())
+                    tradeIds_[side][nettingSetDetails][r].insert(newCrifRecord.tradeId);
+                // We make sure to ignore amountCcy when aggregating the records, since we will only be using
+                // amountResultCcy, and we may have CRIF records that are equal everywhere except for the amountCcy,
+                // and this will fail in the case of Risk_XCcyBasis and Risk_Inflation.
+                const bool onDiffAmountCcy = true;
+                regSensitivities_[side][nettingSetDetails][r].addRecord(newCrifRecord, onDiffAmountCcy);
             }
         }
     }
 }
 
+set<string> SimmCalculator::recordRegulations(const CrifRecord& crifRecord, const SimmSide& side,
+                                             const bool enforceIMRegulations) const {
+    bool collectRegsIsEmpty = false;
+    bool postRegsIsEmpty = false;
+    if (collectRegsIsEmpty_.find(crifRecord.nettingSetDetails) != collectRegsIsEmpty_.end())
+        collectRegsIsEmpty = collectRegsIsEmpty_.at(crifRecord.nettingSetDetails);
+    if (postRegsIsEmpty_.find(crifRecord.nettingSetDetails) != postRegsIsEmpty_.end())
+        postRegsIsEmpty = postRegsIsEmpty_.at(crifRecord.nettingSetDetails);
+
+    string regsString;
+    if (enforceIMRegulations)
+        regsString = side == SimmSide::Call ? crifRecord.collectRegulations : crifRecord.postRegulations;
+    set<string> regs = parseRegulationString(regsString);
+
+    for (auto it = regs.begin(); it != regs.end();) {
+        if (*it == "Excluded" ||
+            (*it == "Unspecified" && enforceIMRegulations && !(collectRegsIsEmpty && postRegsIsEmpty)))
+            it = regs.erase(it);
+        else
+            ++it;
+    }
+
+    return regs;
+}
+
 Real SimmCalculator::lambda(Real theta) const {
     // Use boost inverse normal here as opposed to QL. Using QL inverse normal
     // will cause the ISDA SIMM unit tests to fail
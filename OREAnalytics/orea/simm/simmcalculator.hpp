@@ -29,6 +29,7 @@
 #include <ored/marketdata/market.hpp>
 
 #include <map>
+#include <mutex>
 
 namespace ore {
 namespace analytics {
@@ -45,6 +46,11 @@ public:
         \p calculationCcy is not USD then the \p usdSpot parameter must be used to
         give the FX spot rate between USD and the \p calculationCcy. This spot rate is
         interpreted as the number of USD per unit of \p calculationCcy.
+
+        If \p nThreads is greater than one, the (product class, risk class) component margins of the (side, netting
+        set, regulation) combinations are calculated concurrently on up to \p nThreads threads. The higher level
+        results are then aggregated sequentially in the usual order, so that the results do not depend on the
+        number of threads.
     */
     SimmCalculator(const ore::analytics::Crif& crif,
                    const QuantLib::ext::shared_ptr<SimmConfiguration>& simmConfiguration,
@@ -57,7 +63,8 @@ public:
                    const std::map<SimmSide, std::set<NettingSetDetails>>& hasSEC =
                        std::map<SimmSide, std::set<NettingSetDetails>>(),
                    const std::map<SimmSide, std::set<NettingSetDetails>>& hasCFTC =
-                       std::map<SimmSide, std::set<NettingSetDetails>>());
+                       std::map<SimmSide, std::set<NettingSetDetails>>(),
+                   const QuantLib::Size nThreads = 1);
 
     //! Calculates SIMM for a given regulation under a given netting set
     const void calculateRegulationSimm(const ore::analytics::Crif& crif, const ore::data::NettingSetDetails& nsd,
@@ -108,13 +115,49 @@ public:
     */
     void populateFinalResults(const std::map<SimmSide, std::map<ore::data::NettingSetDetails, std::string>>& winningRegulations);
 
+    /*! Add CRIF records, e.g. those of a what-if trade, to the calculation. The records are netted into the cached
+        (product class, risk class) components and only the components that are hit by \p crif are recalculated.
+        The higher level aggregates and the winning regulations of the affected netting sets are then rebuilt from
+        the cached component margins.
+    */
+    void addRecords(const ore::analytics::Crif& crif);
+
+    /*! Remove CRIF records that were previously included in the calculation, the counterpart of addRecords.
+
+        \warning ProductClassMultiplier and AddOnNotionalFactor records can not be removed since they are not
+                 additive
+    */
+    void removeRecords(const ore::analytics::Crif& crif);
+
+    /*! Return the change in the initial margin, i.e. the margin under the winning regulation, for the given
+        \p side and netting set that results from adding the records in \p crif. The calculator is left in its
+        original state.
+    */
+    QuantLib::Real incrementalMargin(const ore::analytics::Crif& crif, const SimmSide& side,
+                                     const ore::data::NettingSetDetails& nettingSetDetails);
+
 private:
+    typedef std::pair<CrifRecord::ProductClass, SimmConfiguration::RiskClass> ComponentKey;
+
     //! All the net sensitivities passed in for the calculation
     ore::analytics::Crif crif_;
 
     //! Net sentivities at the regulation level within each netting set
     std::map<SimmSide, std::map<ore::data::NettingSetDetails, std::map<std::string, Crif>>> regSensitivities_;
 
+    /*! Net sensitivities and margin results for each (product class, risk class) component of a regulation,
+        cached so that addRecords and removeRecords only need to recalculate the components they touch
+    */
+    //       side,              netting set details,                   regulation
+    std::map<SimmSide, std::map<ore::data::NettingSetDetails, std::map<std::string, std::map<ComponentKey, Crif>>>>
+        componentSensitivities_;
+    std::map<SimmSide,
+             std::map<ore::data::NettingSetDetails, std::map<std::string, std::map<ComponentKey, SimmResults>>>>
+        componentResults_;
+
+    //! Net SIMM parameter and notional records of a regulation, i.e. the inputs to the additional margin
+    std::map<SimmSide, std::map<ore::data::NettingSetDetails, std::map<std::string, Crif>>> addOnSensitivities_;
+
     //! Record of SIMM parameters that were used in the calculation
     ore::analytics::Crif simmParameters_;
 
@@ -133,8 +176,16 @@ private:
     //! If true, no logging is written out
     bool quiet_;
 
+    bool determineWinningRegulations_, enforceIMRegulations_;
+
     std::map<SimmSide, std::set<NettingSetDetails>> hasSEC_, hasCFTC_;
 
+    //! Number of threads used to calculate the component margins in the constructor
+    QuantLib::Size nThreads_;
+
+    //! Serialises the market FX lookups of concurrently calculated component margins
+    mutable std::mutex marketMutex_;
+
     //! For each netting set, whether all CRIF records' collect regulations are empty
     std::map<ore::data::NettingSetDetails, bool> collectRegsIsEmpty_;
 
@@ -196,8 +247,31 @@ private:
                     const CrifRecord::RiskType& rt, const SimmSide& side, const ore::analytics::Crif& netRecords,
                     bool rfLabels = true) const;
 
+    /*! Split the netted records of the given regulation under the given netting set into their (product class,
+        risk class) components and add-on records and calculate the component margins. The combination's entries
+        of the component containers must exist. Only these entries are written to, so that calls for different
+        combinations can run concurrently.
+    */
+    void calculateComponentMargins(const ore::analytics::Crif& crif, const ore::data::NettingSetDetails& nsd,
+                                   const string& regulation, const SimmSide& side);
+
+    //! FX rate converting USD amounts to the result currency
+    QuantLib::Real usdToResultCcyFx() const;
+
+    //! Calculate the delta, vega, curvature and base correlation margin of a (product class, risk class) component
+    SimmResults componentMargin(const ore::data::NettingSetDetails& nettingSetDetails,
+                                const CrifRecord::ProductClass& pc, const SimmConfiguration::RiskClass& rc,
+                                const ore::analytics::Crif& netRecords, const SimmSide& side) const;
+
+    /*! Rebuild the SIMM results of the given regulation under the given netting set from the cached component
+        margins and the add-on records
+    */
+    void aggregateRegulationSimm(const SimmSide& side, const ore::data::NettingSetDetails& nsd,
+                                 const string& regulation, const bool recordSimmParameters);
+
     //! Calculate the additional initial margin for the portfolio ID and regulation
-    void calcAddMargin(const SimmSide& side, const ore::data::NettingSetDetails& nsd, const string& regulation, const ore::analytics::Crif& netRecords);
+    void calcAddMargin(const SimmSide& side, const ore::data::NettingSetDetails& nsd, const string& regulation,
+                       const ore::analytics::Crif& netRecords, const bool recordSimmParameters = true);
 
     /*! Populate the results structure with the higher level results after the IMs have been
         calculated at the (product class, risk class, margin type) level for the given
@@ -210,6 +284,26 @@ private:
     */
     void populateFinalResults();
 
+    //! Determine the regulation with the highest initial margin for the given netting set
+    void calculateWinningRegulation(const SimmSide& side, const ore::data::NettingSetDetails& nettingSetDetails);
+
+    /*! Net the records in \p crif into the cached components with the given \p sign, recalculate the affected
+        components and rebuild the affected regulations' results. If \p finalise is true, trade IDs, winning
+        regulations and final results are updated as well, otherwise only the cached components and the regulation
+        results of the affected netting sets are changed.
+    */
+    void updateRecords(const ore::analytics::Crif& crif, const QuantLib::Real sign, const bool finalise);
+
+    //! Update collectRegsIsEmpty_ and postRegsIsEmpty_ with the regulations of the given record
+    void updateRegsIsEmpty(const CrifRecord& crifRecord);
+
+    //! Convert the CRIF record amount to the result currency
+    CrifRecord resultCcyRecord(const CrifRecord& crifRecord) const;
+
+    //! Regulations under which a CRIF record is included on the given side
+    std::set<std::string> recordRegulations(const CrifRecord& crifRecord, const SimmSide& side,
+                                            const bool enforceIMRegulations) const;
+
     /*! Add a margin result to either call or post results container depending on the
         \p side parameter.
 
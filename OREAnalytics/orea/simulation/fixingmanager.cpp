@@ -59,7 +59,7 @@ Date nextValidFixingDate(Date d, const QuantLib::ext::shared_ptr<Index>& index,
     QL_FAIL("no valid fixing date found for index " << index->name() << " within gap from " << io::iso_date(d));
 }
 
-FixingManager::FixingManager(Date today) : today_(today), fixingsEnd_(today), modifiedFixingHistory_(false) {}
+FixingManager::FixingManager(Date today) : today_(today), fixingsEnd_(today) {}
 
 //! Initialise the manager-
 
@@ -132,11 +132,18 @@ void FixingManager::update(Date d) {
 
 //! Reset fixings to t0 (today)
 void FixingManager::reset() {
-    if (modifiedFixingHistory_) {
-        for (auto& kv : fixingCache_)
-            IndexManager::instance().setHistory(kv.first->name(), kv.second);
-        modifiedFixingHistory_ = false;
+    // overwrite the simulated fixings of this path with the historical ones, or with null where there were none
+    const TimeSeries<Real> noHistory;
+    std::vector<Real> values;
+    for (auto const& [index, dates] : pathFixings_) {
+        auto h = fixingCache_.find(index);
+        const TimeSeries<Real>& history = h == fixingCache_.end() ? noHistory : h->second;
+        values.clear();
+        for (auto const& d : dates)
+            values.push_back(history[d]);
+        index->addFixings(dates.begin(), dates.end(), values.begin(), true);
     }
+    pathFixings_.clear();
     fixingsEnd_ = today_;
 }
 
@@ -190,15 +197,18 @@ void FixingManager::applyFixings(Date start, Date end) {
                 if (d >= fixStart && d < fixEnd) {
                     // Fixing dates include the valuation grid dates which might not be valid fixing dates (BMA/SIFMA)
                     bool valid = m.first->isValidFixingDate(d);
-                    if (valid) {
+                    if (valid)
                         history[d] = currentFixing;
-                        modifiedFixingHistory_ = true;
-                    }
                 }
                 if (d >= fixEnd)
                     break;
             }
-            m.first->addFixings(history, true);
+            if (!history.empty()) {
+                m.first->addFixings(history, true);
+                auto& pathFixings = pathFixings_[m.first];
+                for (auto const& f : history)
+                    pathFixings.insert(f.first);
+            }
         }
     }
 }
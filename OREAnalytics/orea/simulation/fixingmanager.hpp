@@ -53,6 +53,9 @@ struct IndexComparator {
   When stepping between simulation dated t_(n-1) and t_(n) and update a fixing t with t_(n-1) < t < t(n) than the fixing
   from t(n) will be backfilled. There is currently no interpolation of fixings.
 
+  The historical fixings as of today are cached on initialisation. The simulated fixings written on a path are tracked
+  per index and date, so that reset() only rewrites these dates with their historical fixings (or removes them).
+
   \ingroup simulation
  */
 class FixingManager {
@@ -67,7 +70,7 @@ public:
     //! Update fixings to date d
     void update(Date d);
 
-    //! Reset fixings to t0 (today)
+    //! Reset fixings to t0 (today), restores the historical fixings on the dates updated since the last reset
     void reset();
 
     //! Cashflow handler type definitions
@@ -78,12 +81,14 @@ private:
     void applyFixings(Date start, Date end);
 
     Date today_, fixingsEnd_;
-    bool modifiedFixingHistory_;
 
     using FixingCache = std::map<QuantLib::ext::shared_ptr<Index>, TimeSeries<Real>, detail::IndexComparator>;
 
     FixingMap fixingMap_;
+    // historical fixings as of today
     FixingCache fixingCache_;
+    // fixing dates per index written since the last reset
+    FixingMap pathFixings_;
 };
 
 } // namespace analytics
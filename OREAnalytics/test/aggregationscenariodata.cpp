@@ -22,6 +22,8 @@
 #include <oret/toplevelfixture.hpp>
 #include <test/oreatoplevelfixture.hpp>
 
+#include <limits>
+
 using namespace ore::analytics;
 using namespace boost::unit_test_framework;
 
@@ -66,6 +68,35 @@ BOOST_AUTO_TEST_CASE(testInMemoryAggregationScenarioData) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testSinglePrecisionInMemoryAggregationScenarioData) {
+    SinglePrecisionInMemoryAggregationScenarioData data(3, 5);
+
+    for (Size i = 0; i < 3; ++i) {
+        for (Size j = 0; j < 5; ++j) {
+            data.set(i, j, 0.0001 * i + 0.01 * j, AggregationScenarioDataType::IndexFixing, "OIS_EUR");
+            data.set(i, j, 1.0 + i + 0.1 * j, AggregationScenarioDataType::Numeraire);
+        }
+    }
+    data.set(2, 4, QuantLib::Null<Real>(), AggregationScenarioDataType::FXSpot, "EURUSD");
+
+    BOOST_CHECK(data.has(AggregationScenarioDataType::Numeraire));
+    BOOST_CHECK_EQUAL(data.keys().size(), 3);
+    BOOST_CHECK_EQUAL(data.get(2, 4, AggregationScenarioDataType::FXSpot, "EURUSD"), QuantLib::Null<Real>());
+    BOOST_CHECK_EQUAL(data.get(0, 0, AggregationScenarioDataType::FXSpot, "EURUSD"), 0.0);
+
+    // single precision storage, the relative error is bounded by the float epsilon
+    Real tol = 100.0 * std::numeric_limits<float>::epsilon();
+
+    for (Size i = 0; i < 3; ++i) {
+        for (Size j = 0; j < 5; ++j) {
+            BOOST_CHECK_SMALL(data.get(i, j, AggregationScenarioDataType::IndexFixing, "OIS_EUR") -
+                                  (0.0001 * i + 0.01 * j),
+                              1E-8);
+            BOOST_CHECK_CLOSE(data.get(i, j, AggregationScenarioDataType::Numeraire), 1.0 + i + 0.1 * j, tol);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
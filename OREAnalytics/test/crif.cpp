@@ -0,0 +1,159 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <orea/simm/crif.hpp>
+#include <oret/toplevelfixture.hpp>
+#include <test/oreatoplevelfixture.hpp>
+
+using namespace ore::analytics;
+using namespace boost::unit_test_framework;
+using ore::data::NettingSetDetails;
+using QuantLib::Real;
+using QuantLib::Size;
+
+namespace {
+
+typedef CrifRecord::ProductClass ProductClass;
+typedef CrifRecord::RiskType RiskType;
+
+const NettingSetDetails nettingSetA("CPTY_A");
+const NettingSetDetails nettingSetB("CPTY_B");
+
+CrifRecord record(const std::string& tradeId, const NettingSetDetails& nsd, const RiskType& rt,
+                  const std::string& qualifier, const std::string& bucket, const std::string& label1, Real amount) {
+    return CrifRecord(tradeId, "Swap", nsd, ProductClass::RatesFX, rt, qualifier, bucket, label1, "", "USD", amount,
+                      amount, "SIMM");
+}
+
+Crif testCrif() {
+    Crif crif;
+    crif.addRecord(record("T1", nettingSetA, RiskType::IRCurve, "USD", "1", "2y", 100.0));
+    crif.addRecord(record("T1", nettingSetA, RiskType::IRCurve, "USD", "1", "5y", 200.0));
+    crif.addRecord(record("T2", nettingSetA, RiskType::IRCurve, "EUR", "1", "2y", 300.0));
+    crif.addRecord(record("T2", nettingSetA, RiskType::IRCurve, "JPY", "3", "2y", 400.0));
+    crif.addRecord(record("T3", nettingSetA, RiskType::FX, "EUR", "", "", 500.0));
+    crif.addRecord(record("T4", nettingSetB, RiskType::IRCurve, "USD", "1", "2y", 600.0));
+    return crif;
+}
+
+// Copy the records of a range, checking that they are in the order of the underlying record set
+std::vector<CrifRecord> records(const CrifRecordRange& range) {
+    std::vector<CrifRecord> result(range.begin(), range.end());
+    for (Size i = 1; i < result.size(); ++i)
+        BOOST_CHECK(result[i - 1] < result[i]);
+    return result;
+}
+
+Real totalAmount(const CrifRecordRange& range) {
+    Real result = 0.0;
+    for (const auto& r : range)
+        result += r.amount;
+    return result;
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(OREAnalyticsTestSuite, ore::test::OreaTopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(CrifTest)
+
+BOOST_AUTO_TEST_CASE(testFilters) {
+
+    BOOST_TEST_MESSAGE("Testing the Crif filter methods...");
+
+    Crif crif = testCrif();
+
+    auto ir = records(crif.filterBy(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve));
+    BOOST_REQUIRE_EQUAL(ir.size(), 4);
+    for (const auto& r : ir) {
+        BOOST_CHECK(r.nettingSetDetails == nettingSetA);
+        BOOST_CHECK(r.riskType == RiskType::IRCurve);
+    }
+
+    BOOST_CHECK_EQUAL(records(crif.filterBy(RiskType::IRCurve)).size(), 5);
+    BOOST_CHECK_EQUAL(records(crif.filterBy(RiskType::FX)).size(), 1);
+    BOOST_CHECK(crif.filterBy(RiskType::IRVol).empty());
+    BOOST_CHECK(crif.filterBy(nettingSetB, ProductClass::RatesFX, RiskType::FX).empty());
+
+    BOOST_CHECK_EQUAL(totalAmount(crif.filterByQualifier(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve, "USD")),
+                      300.0);
+    BOOST_CHECK(crif.filterByQualifier(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve, "GBP").empty());
+
+    BOOST_CHECK_EQUAL(totalAmount(crif.filterByBucket(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve, "1")),
+                      600.0);
+    BOOST_CHECK_EQUAL(totalAmount(crif.filterByBucket(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve, "3")),
+                      400.0);
+
+    BOOST_CHECK_EQUAL(totalAmount(crif.filterByQualifierAndBucket(nettingSetA, ProductClass::RatesFX,
+                                                                  RiskType::IRCurve, "EUR", "1")),
+                      300.0);
+    BOOST_CHECK(
+        crif.filterByQualifierAndBucket(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve, "JPY", "1").empty());
+
+    std::set<std::string> qualifiers = {"EUR", "JPY", "USD"};
+    BOOST_CHECK(crif.qualifiersBy(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve) == qualifiers);
+    BOOST_CHECK(crif.qualifiersBy(nettingSetB, ProductClass::RatesFX, RiskType::FX).empty());
+
+    auto it = crif.findBy(nettingSetA, ProductClass::RatesFX, RiskType::FX, "EUR");
+    BOOST_REQUIRE(it != crif.end());
+    BOOST_CHECK_EQUAL(it->tradeId, "T3");
+    BOOST_CHECK(crif.findBy(nettingSetA, ProductClass::RatesFX, RiskType::FX, "GBP") == crif.end());
+}
+
+BOOST_AUTO_TEST_CASE(testFiltersAfterInsert) {
+
+    BOOST_TEST_MESSAGE("Testing the Crif filter methods after records are added...");
+
+    Crif crif = testCrif();
+    BOOST_CHECK_EQUAL(records(crif.filterBy(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve)).size(), 4);
+    BOOST_CHECK(crif.filterBy(nettingSetA, ProductClass::RatesFX, RiskType::IRVol).empty());
+
+    // New records are picked up by the filters called after the insert
+    crif.addRecord(record("T5", nettingSetA, RiskType::IRCurve, "USD", "1", "10y", 700.0));
+    crif.addRecord(record("T5", nettingSetA, RiskType::IRVol, "USD", "1", "1y", 800.0));
+    auto ir = records(crif.filterBy(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve));
+    BOOST_CHECK_EQUAL(ir.size(), 5);
+    BOOST_CHECK_EQUAL(totalAmount(crif.filterByQualifier(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve, "USD")),
+                      1000.0);
+    BOOST_CHECK_EQUAL(totalAmount(crif.filterBy(nettingSetA, ProductClass::RatesFX, RiskType::IRVol)), 800.0);
+    BOOST_CHECK_EQUAL(records(crif.filterBy(RiskType::IRCurve)).size(), 6);
+
+    // Netting into an existing record updates its amount
+    crif.addRecord(record("T1", nettingSetA, RiskType::IRCurve, "USD", "1", "2y", 50.0));
+    BOOST_CHECK_EQUAL(records(crif.filterBy(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve)).size(), 5);
+    BOOST_CHECK_EQUAL(totalAmount(crif.filterByQualifier(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve, "USD")),
+                      1050.0);
+
+    // Copies have their own index
+    Crif copy = crif;
+    copy.addRecord(record("T6", nettingSetA, RiskType::IRCurve, "USD", "1", "30y", 900.0));
+    BOOST_CHECK_EQUAL(totalAmount(copy.filterByQualifier(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve, "USD")),
+                      1950.0);
+    BOOST_CHECK_EQUAL(totalAmount(crif.filterByQualifier(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve, "USD")),
+                      1050.0);
+
+    // Clearing empties the filters
+    crif.clear();
+    BOOST_CHECK(crif.filterBy(nettingSetA, ProductClass::RatesFX, RiskType::IRCurve).empty());
+    BOOST_CHECK(crif.filterBy(RiskType::IRCurve).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -23,6 +23,7 @@
 #include <orea/cube/cube_io.hpp>
 #include <orea/cube/npvcube.hpp>
 #include <orea/cube/jaggedcube.hpp>
+#include <orea/cube/streamingnpvcube.hpp>
 #include <orea/engine/filteredsensitivitystream.hpp>
 #include <orea/engine/observationmode.hpp>
 #include <orea/engine/parametricvar.hpp>
@@ -540,6 +541,79 @@ BOOST_AUTO_TEST_CASE(testDoublePrecisionJaggedCube) {
     IndexManager::instance().clearHistories();
 }
 
+BOOST_AUTO_TEST_CASE(testStreamingNPVCube) {
+
+    Date today = Date(15, December, 2016);
+    vector<Date> dates = {Date(15, December, 2017), Date(15, December, 2018)};
+    std::map<string, string> nettingSetMap = {{"t1", "A"}, {"t2", "A"}, {"t3", "B"}, {"t4", "B"}};
+    Size samples = 3, depth = 2;
+
+    // reference values per trade
+    auto value = [](Size i, Size j, Size k, Size d) { return 100.0 * i + 10.0 * j + k + 0.5 * d; };
+
+    StreamingNPVCube cube(today, {"t1", "t2", "t3", "t4"}, dates, samples, depth, nettingSetMap);
+    BOOST_CHECK_EQUAL(cube.numIds(), 4);
+    BOOST_CHECK_EQUAL(cube.nettingSetCube()->numIds(), 2);
+
+    for (Size i = 0; i < 4; ++i) {
+        cube.setT0(1.0, i);
+        cube.setT0(i + 1.0, i);
+        for (Size k = 0; k < samples; ++k) {
+            for (Size j = 0; j < dates.size(); ++j) {
+                for (Size d = 0; d < depth; ++d) {
+                    // a second write to the same cell replaces the first one
+                    cube.set(-1.0, i, j, k, d);
+                    cube.set(value(i, j, k, d), i, j, k, d);
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_EQUAL(cube.getT0(2), 3.0);
+    BOOST_CHECK_THROW(cube.get(0, 0, 0), std::exception);
+    BOOST_CHECK_THROW(cube.remove(0), std::exception);
+    BOOST_CHECK_THROW(cube.set(1.0, 4, 0, 0), std::exception);
+
+    auto checkNettingSets = [&](const StreamingNPVCube& c) {
+        auto nettingSetCube = c.nettingSetCube();
+        Size a = nettingSetCube->idsAndIndexes().at("A"), b = nettingSetCube->idsAndIndexes().at("B");
+        BOOST_CHECK_CLOSE(nettingSetCube->getT0(a), 3.0, 1E-12);
+        BOOST_CHECK_CLOSE(nettingSetCube->getT0(b), 7.0, 1E-12);
+        for (Size j = 0; j < dates.size(); ++j) {
+            for (Size k = 0; k < samples; ++k) {
+                for (Size d = 0; d < depth; ++d) {
+                    BOOST_CHECK_CLOSE(nettingSetCube->get(a, j, k, d), value(0, j, k, d) + value(1, j, k, d), 1E-12);
+                    BOOST_CHECK_CLOSE(nettingSetCube->get(b, j, k, d), value(2, j, k, d) + value(3, j, k, d), 1E-12);
+                }
+            }
+        }
+    };
+
+    checkNettingSets(cube);
+
+    // the same values written to two cubes over disjoint trades and joined afterwards
+    auto cube1 = QuantLib::ext::make_shared<StreamingNPVCube>(today, std::set<string>{"t1", "t3"}, dates, samples,
+                                                              depth, nettingSetMap);
+    auto cube2 = QuantLib::ext::make_shared<StreamingNPVCube>(today, std::set<string>{"t2", "t4"}, dates, samples,
+                                                              depth, nettingSetMap);
+    for (auto const& c : {cube1, cube2}) {
+        for (auto const& [id, pos] : c->idsAndIndexes()) {
+            Size i = cube.idsAndIndexes().at(id);
+            c->setT0(i + 1.0, pos);
+            for (Size k = 0; k < samples; ++k)
+                for (Size j = 0; j < dates.size(); ++j)
+                    for (Size d = 0; d < depth; ++d)
+                        c->set(value(i, j, k, d), pos, j, k, d);
+        }
+    }
+
+    StreamingNPVCube joint(std::vector<QuantLib::ext::shared_ptr<NPVCube>>{cube1, cube2});
+    BOOST_CHECK_EQUAL(joint.numIds(), 4);
+    BOOST_CHECK_EQUAL(joint.getT0(joint.idsAndIndexes().at("t4")), 4.0);
+    BOOST_CHECK_EQUAL(joint.nettingSetId(joint.idsAndIndexes().at("t3")), "B");
+    checkNettingSets(joint);
+}
+
 string writeCube(const QuantLib::ext::shared_ptr<NPVCube>& cube, Size bufferSize) {
     auto report = QuantLib::ext::make_shared<InMemoryReport>(bufferSize);
     ReportWriter().writeCube(*report, cube);
@@ -583,6 +657,57 @@ BOOST_AUTO_TEST_CASE(testInMemoryReportBuffer) {
     diffFiles(filename_0, filename_100000);
 }
 
+// Test typed access to the values of an InMemoryReport across spilled segments
+BOOST_AUTO_TEST_CASE(testInMemoryReportValues) {
+
+    Size n = 25;
+    Date d0(15, March, 2024);
+    auto fill = [n, d0](InMemoryReport& report) {
+        report.addColumn("Id", Size())
+            .addColumn("Value", Real(), 6)
+            .addColumn("Name", string())
+            .addColumn("Date", Date())
+            .addColumn("Tenor", Period());
+        for (Size i = 0; i < n; ++i) {
+            report.next()
+                .add(i)
+                .add(0.5 * i)
+                .add(string(i % 3 == 0 ? "A" : "B"))
+                .add(i % 4 == 0 ? Date() : d0 + i)
+                .add(Period(i, Months));
+        }
+        report.end();
+    };
+
+    InMemoryReport unbuffered(0), buffered(7);
+    fill(unbuffered);
+    fill(buffered);
+
+    BOOST_REQUIRE_EQUAL(unbuffered.rows(), n);
+    BOOST_REQUIRE_EQUAL(buffered.rows(), n);
+    // read in reverse order to force the spilled segments to be reloaded
+    for (Size k = n; k > 0; --k) {
+        Size i = k - 1;
+        for (auto const* r : {&unbuffered, &buffered}) {
+            BOOST_CHECK_EQUAL(boost::get<Size>(r->value(0, i)), i);
+            BOOST_CHECK_EQUAL(boost::get<Real>(r->value(1, i)), 0.5 * i);
+            BOOST_CHECK_EQUAL(boost::get<string>(r->value(2, i)), i % 3 == 0 ? "A" : "B");
+            BOOST_CHECK_EQUAL(boost::get<Date>(r->value(3, i)), i % 4 == 0 ? Date() : d0 + i);
+            BOOST_CHECK_EQUAL(boost::get<Period>(r->value(4, i)), Period(i, Months));
+        }
+    }
+    BOOST_CHECK_EQUAL(buffered.data(2).size(), n);
+    BOOST_CHECK_THROW(buffered.value(0, n), QuantLib::Error);
+
+    // combining a buffered report into another one preserves the rows
+    InMemoryReport combined(10);
+    fill(combined);
+    combined.add(buffered);
+    BOOST_REQUIRE_EQUAL(combined.rows(), 2 * n);
+    for (Size i = 0; i < n; ++i)
+        BOOST_CHECK_EQUAL(boost::get<string>(combined.value(2, n + i)), boost::get<string>(buffered.value(2, i)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include "testmarket.hpp"
+#include "testportfolio.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <orea/simulation/fixingmanager.hpp>
+#include <ored/portfolio/enginedata.hpp>
+#include <ored/portfolio/enginefactory.hpp>
+#include <ored/portfolio/portfolio.hpp>
+#include <oret/toplevelfixture.hpp>
+#include <test/oreatoplevelfixture.hpp>
+
+#include <ql/cashflows/floatingratecoupon.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/settings.hpp>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+using namespace ore::data;
+using namespace ore::analytics;
+
+namespace {
+
+Real fixing(const QuantLib::ext::shared_ptr<Index>& index, const Date& d) {
+    const TimeSeries<Real> history = IndexManager::instance().getHistory(index->name());
+    return history[d];
+}
+
+// Check that the fixings of the index are the given historical ones, null entries count as missing
+void checkHistory(const QuantLib::ext::shared_ptr<Index>& index, const TimeSeries<Real>& expected) {
+    const TimeSeries<Real> history = IndexManager::instance().getHistory(index->name());
+    for (auto const& [d, v] : expected)
+        BOOST_CHECK_EQUAL(history[d], v);
+    for (auto const& [d, v] : history) {
+        if (v != Null<Real>())
+            BOOST_CHECK_MESSAGE(expected[d] == v, "unexpected fixing " << v << " on " << io::iso_date(d));
+    }
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(OREAnalyticsTestSuite, ore::test::OreaTopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(FixingManagerTest)
+
+BOOST_AUTO_TEST_CASE(testResetRestoresHistoricalFixings) {
+
+    BOOST_TEST_MESSAGE("Testing that the fixing manager reset restores the historical fixings...");
+
+    SavedSettings backup;
+    Date today = Date(14, April, 2016);
+    Settings::instance().evaluationDate() = today;
+
+    QuantLib::ext::shared_ptr<Market> market = QuantLib::ext::make_shared<testsuite::TestMarket>(today);
+    QuantLib::ext::shared_ptr<EngineData> data = QuantLib::ext::make_shared<EngineData>();
+    data->model("Swap") = "DiscountedCashflows";
+    data->engine("Swap") = "DiscountingSwapEngine";
+    QuantLib::ext::shared_ptr<EngineFactory> factory = QuantLib::ext::make_shared<EngineFactory>(data, market);
+
+    QuantLib::ext::shared_ptr<Portfolio> portfolio = QuantLib::ext::make_shared<Portfolio>();
+    portfolio->add(testsuite::buildSwap("SWAP", "EUR", true, 1000000.0, 0, 5, 0.02, 0.00, "1Y", "30/360", "6M",
+                                        "A360", "EUR-EURIBOR-6M"));
+    portfolio->build(factory);
+    BOOST_REQUIRE_EQUAL(portfolio->size(), 1);
+
+    // future fixing dates of the floating leg
+    std::vector<Date> fixingDates;
+    for (auto const& c : portfolio->get("SWAP")->legs().front()) {
+        auto frc = QuantLib::ext::dynamic_pointer_cast<FloatingRateCoupon>(c);
+        if (frc && frc->fixingDate() > today)
+            fixingDates.push_back(frc->fixingDate());
+    }
+    BOOST_REQUIRE(fixingDates.size() >= 3);
+
+    // historical fixings before today and, as a known value, on the first future fixing date
+    QuantLib::ext::shared_ptr<Index> index = *market->iborIndex("EUR-EURIBOR-6M");
+    index->addFixing(Date(7, April, 2016), 0.0011);
+    index->addFixing(Date(12, April, 2016), 0.0012);
+    index->addFixing(fixingDates[0], 0.1234);
+    const TimeSeries<Real> historical = IndexManager::instance().getHistory(index->name());
+
+    FixingManager fixingManager(today);
+    fixingManager.initialise(portfolio, market);
+
+    for (Size path = 0; path < 2; ++path) {
+        fixingManager.update(fixingDates[0] - 1);
+        checkHistory(index, historical);
+
+        fixingManager.update(fixingDates[1] + 1);
+        BOOST_CHECK(fixing(index, fixingDates[0]) != 0.1234);
+        BOOST_CHECK(fixing(index, fixingDates[1]) != Null<Real>());
+        BOOST_CHECK(fixing(index, fixingDates[2]) == Null<Real>());
+        BOOST_CHECK_EQUAL(fixing(index, Date(12, April, 2016)), 0.0012);
+
+        // the historical fixing is restored and the simulated one is removed
+        fixingManager.reset();
+        checkHistory(index, historical);
+        BOOST_CHECK_EQUAL(fixing(index, fixingDates[0]), 0.1234);
+        BOOST_CHECK(fixing(index, fixingDates[1]) == Null<Real>());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
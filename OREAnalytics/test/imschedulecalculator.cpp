@@ -0,0 +1,126 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <orea/simm/imschedulecalculator.hpp>
+#include <oret/toplevelfixture.hpp>
+#include <test/oreatoplevelfixture.hpp>
+
+#include <ql/settings.hpp>
+
+using namespace ore::analytics;
+using namespace boost::unit_test_framework;
+using ore::data::NettingSetDetails;
+using QuantLib::Real;
+using QuantLib::Size;
+
+namespace {
+
+typedef SimmConfiguration::SimmSide SimmSide;
+typedef CrifRecord::ProductClass ProductClass;
+typedef CrifRecord::RiskType RiskType;
+
+CrifRecord scheduleRecord(const std::string& tradeId, const NettingSetDetails& nsd, ProductClass productClass,
+                          RiskType riskType, Real amount, const std::string& regulations,
+                          const std::string& endDate) {
+    return CrifRecord(tradeId, "Swap", nsd, productClass, riskType, "", "", "", "", "USD", amount, amount,
+                      "Schedule", regulations, regulations, endDate);
+}
+
+QuantLib::ext::shared_ptr<IMScheduleCalculator> imScheduleCalculator(const Crif& crif, Size nThreads) {
+    const std::map<SimmSide, std::set<NettingSetDetails>> none = {{SimmSide::Call, {}}, {SimmSide::Post, {}}};
+    return QuantLib::ext::make_shared<IMScheduleCalculator>(crif, "USD", nullptr, true, true, true, none, none,
+                                                            nThreads);
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(OREAnalyticsTestSuite, ore::test::OreaTopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(IMScheduleCalculatorTest)
+
+BOOST_AUTO_TEST_CASE(testMultiThreaded) {
+
+    BOOST_TEST_MESSAGE("Testing that an IM Schedule calculation on several threads matches the single threaded one...");
+
+    QuantLib::Settings::instance().evaluationDate() = QuantLib::Date(14, QuantLib::April, 2016);
+
+    // several netting sets and regulations, so that there are more (side, netting set, regulation) combinations
+    // than threads, the last trade of each combination has no notional and is dropped
+    Crif crif;
+    const std::vector<std::pair<ProductClass, std::string>> trades = {{ProductClass::Rates, "2017-04-14"},
+                                                                      {ProductClass::Rates, "2026-04-14"},
+                                                                      {ProductClass::Credit, "2019-04-14"},
+                                                                      {ProductClass::FX, "2018-04-14"}};
+    for (const std::string& id : {"CPTY_A", "CPTY_B", "CPTY_C"}) {
+        const NettingSetDetails nsd(id);
+        for (const std::string& regulations : {"SEC", "CFTC", "EMIR"}) {
+            for (Size k = 0; k < trades.size(); ++k) {
+                const std::string tradeId = id + "_" + regulations + "_" + std::to_string(k);
+                const auto& [productClass, endDate] = trades[k];
+                crif.addRecord(scheduleRecord(tradeId, nsd, productClass, RiskType::PV, 1000.0 * (k + 1) - 2500.0,
+                                              regulations, endDate));
+                if (k + 1 < trades.size())
+                    crif.addRecord(scheduleRecord(tradeId, nsd, productClass, RiskType::Notional,
+                                                  1.0E6 * (k + 1), regulations, endDate));
+            }
+        }
+    }
+
+    auto calculator = imScheduleCalculator(crif, 1);
+    for (Size nThreads : {2, 4, 16}) {
+        BOOST_TEST_MESSAGE("Checking " << nThreads << " threads");
+        auto mtCalculator = imScheduleCalculator(crif, nThreads);
+        BOOST_CHECK(mtCalculator->winningRegulations() == calculator->winningRegulations());
+        BOOST_CHECK(mtCalculator->finalTradeIds() == calculator->finalTradeIds());
+
+        const auto& results = mtCalculator->imScheduleSummaryResults();
+        const auto& expected = calculator->imScheduleSummaryResults();
+        BOOST_REQUIRE_EQUAL(results.size(), expected.size());
+        for (const auto& [side, nettingSetResults] : expected) {
+            for (const auto& [nsd, regulationResults] : nettingSetResults) {
+                for (const auto& [regulation, imResults] : regulationResults) {
+                    const auto& data = results.at(side).at(nsd).at(regulation).data();
+                    BOOST_REQUIRE_EQUAL(data.size(), imResults.data().size());
+                    for (const auto& [pc, im] : imResults.data()) {
+                        BOOST_REQUIRE(data.count(pc) > 0);
+                        BOOST_CHECK_EQUAL(data.at(pc).grossIM, im.grossIM);
+                        BOOST_CHECK_EQUAL(data.at(pc).grossRC, im.grossRC);
+                        BOOST_CHECK_EQUAL(data.at(pc).netRC, im.netRC);
+                        BOOST_CHECK_EQUAL(data.at(pc).NGR, im.NGR);
+                        BOOST_CHECK_EQUAL(data.at(pc).scheduleIM, im.scheduleIM);
+                    }
+                }
+            }
+        }
+
+        const auto& tradeResults = mtCalculator->imScheduleTradeResults();
+        BOOST_REQUIRE_EQUAL(tradeResults.size(), calculator->imScheduleTradeResults().size());
+        for (const auto& [tradeId, tradeData] : calculator->imScheduleTradeResults()) {
+            BOOST_REQUIRE(tradeResults.count(tradeId) > 0);
+            BOOST_REQUIRE_EQUAL(tradeResults.at(tradeId).size(), tradeData.size());
+            for (Size k = 0; k < tradeData.size(); ++k)
+                BOOST_CHECK_EQUAL(tradeResults.at(tradeId)[k].grossMarginCalc, tradeData[k].grossMarginCalc);
+        }
+    }
+    BOOST_CHECK(calculator->imScheduleTradeResults().count("CPTY_A_SEC_3") == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
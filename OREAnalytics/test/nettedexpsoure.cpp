@@ -21,6 +21,7 @@
 #include <boost/timer/timer.hpp>
 #include <orea/cube/inmemorycube.hpp>
 #include <orea/cube/npvcube.hpp>
+#include <orea/cube/streamingnpvcube.hpp>
 
 #include <orea/engine/valuationcalculator.hpp>
 #include <orea/engine/valuationengine.hpp>
@@ -699,5 +700,70 @@ BOOST_AUTO_TEST_CASE(NettedExposureCalculatorTest) {
     }
 }
 
+// NPV calculator that fails for one trade on the simulation dates
+class FailingNPVCalculator : public NPVCalculator {
+public:
+    FailingNPVCalculator(const string& baseCcyCode, const string& failingTradeId)
+        : NPVCalculator(baseCcyCode), failingTradeId_(failingTradeId) {}
+
+    void calculate(const QuantLib::ext::shared_ptr<Trade>& trade, Size tradeIndex,
+                   const QuantLib::ext::shared_ptr<SimMarket>& simMarket, QuantLib::ext::shared_ptr<NPVCube>& outputCube,
+                   QuantLib::ext::shared_ptr<NPVCube>& outputCubeNettingSet, const Date& date, Size dateIndex,
+                   Size sample, bool isCloseOut = false) override {
+        QL_REQUIRE(trade->id() != failingTradeId_, "simulated pricing error");
+        NPVCalculator::calculate(trade, tradeIndex, simMarket, outputCube, outputCubeNettingSet, date, dateIndex,
+                                 sample, isCloseOut);
+    }
+
+private:
+    string failingTradeId_;
+};
+
+BOOST_AUTO_TEST_CASE(testStreamingCubeWithFailingTrade) {
+
+    BOOST_TEST_MESSAGE("Testing that a failing trade stops a valuation into a streaming cube...");
+
+    SavedSettings backup;
+    Date today = Date(14, April, 2016);
+    Settings::instance().evaluationDate() = today;
+
+    QuantLib::ext::shared_ptr<DateGrid> dateGrid = QuantLib::ext::make_shared<DateGrid>("5,1M");
+    Size samples = 2;
+    QuantLib::ext::shared_ptr<Market> initMarket = QuantLib::ext::make_shared<TestMarket>(today);
+    QuantLib::ext::shared_ptr<CrossAssetModel> model = buildCrossAssetModel(initMarket);
+    QuantLib::ext::shared_ptr<analytics::ScenarioSimMarket> simMarket =
+        buildScenarioSimMarket(dateGrid, initMarket, model, samples);
+
+    QuantLib::ext::shared_ptr<EngineData> data = QuantLib::ext::make_shared<EngineData>();
+    data->model("Swap") = "DiscountedCashflows";
+    data->engine("Swap") = "DiscountingSwapEngine";
+    QuantLib::ext::shared_ptr<EngineFactory> factory = QuantLib::ext::make_shared<EngineFactory>(data, simMarket);
+    QuantLib::ext::shared_ptr<Portfolio> portfolio = buildPortfolio(2, factory);
+
+    vector<QuantLib::ext::shared_ptr<ValuationCalculator>> calculators = {
+        QuantLib::ext::make_shared<FailingNPVCalculator>("EUR", "Trade_2")};
+    ValuationEngine valEngine(today, dateGrid, simMarket);
+
+    // a trade level cube keeps the other trades and zeroes the failed one
+    QuantLib::ext::shared_ptr<NPVCube> cube = QuantLib::ext::make_shared<DoublePrecisionInMemoryCube>(
+        today, portfolio->ids(), dateGrid->valuationDates(), samples);
+    BOOST_CHECK_NO_THROW(valEngine.buildCube(portfolio, cube, calculators));
+    Size failed = cube->idsAndIndexes().at("Trade_2");
+    Size valid = cube->idsAndIndexes().at("Trade_1");
+    bool validHasValues = false;
+    for (Size j = 0; j < cube->numDates(); ++j) {
+        for (Size k = 0; k < samples; ++k) {
+            BOOST_CHECK_EQUAL(cube->get(failed, j, k), 0.0);
+            validHasValues = validHasValues || cube->get(valid, j, k) != 0.0;
+        }
+    }
+    BOOST_CHECK(validHasValues);
+
+    // a streaming cube has the failed trade's values in its netting set already, the run stops at the error
+    QuantLib::ext::shared_ptr<NPVCube> streamingCube = QuantLib::ext::make_shared<StreamingNPVCube>(
+        today, portfolio->ids(), dateGrid->valuationDates(), samples, 1, portfolio->nettingSetMap());
+    BOOST_CHECK_THROW(valEngine.buildCube(portfolio, streamingCube, calculators), QuantLib::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
@@ -433,6 +433,23 @@ BOOST_AUTO_TEST_CASE(testDefer) {
     simulation("10,1Y", true);
 }
 
+BOOST_AUTO_TEST_CASE(testGraph) {
+    ObservationMode::instance().setMode(ObservationMode::Mode::Graph);
+    setConventions();
+
+    BOOST_TEST_MESSAGE("Testing Observation Mode Graph, Long Grid, No Fixing Checks");
+    simulation("11,1Y", false);
+
+    BOOST_TEST_MESSAGE("Testing Observation Mode Graph, Long Grid, With Fixing Checks");
+    simulation("11,1Y", true);
+
+    BOOST_TEST_MESSAGE("Testing Observation Mode Graph, Short Grid, No Fixing Checks");
+    simulation("10,1Y", false);
+
+    BOOST_TEST_MESSAGE("Testing Observation Mode Graph, Short Grid, With Fixing Checks");
+    simulation("10,1Y", true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
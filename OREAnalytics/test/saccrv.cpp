@@ -0,0 +1,202 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <orea/saccrv/calculation/runsaccrvcalcs.hpp>
+#include <orea/saccrv/saccrvcalculationmanager.hpp>
+#include <orea/saccrv/saccrvinputmanager.hpp>
+#include <oret/toplevelfixture.hpp>
+#include <test/oreatoplevelfixture.hpp>
+
+using namespace ore::analytics;
+using namespace boost::unit_test_framework;
+using QuantLib::Size;
+
+namespace {
+
+SaccrvTrades irSwap(const std::string& id, const std::string& counterparty, const std::string& nettingSet,
+                    double mtm, double maturity) {
+    SaccrvTrades trade(id, "Swap");
+    trade.setTradeGroup("IRD");
+    trade.setCurrency("EUR");
+    trade.setCounterparty(counterparty);
+    trade.setNettingSet(nettingSet);
+    trade.setBuySell("Buy");
+    trade.setNotional(1.0E6);
+    trade.setMtM(mtm);
+    trade.setSi(0.0);
+    trade.setEi(maturity);
+    trade.setPayLegRef("EUR-EURIBOR-6M");
+    trade.setRecLegRef("EUR-EURIBOR-6M");
+    return trade;
+}
+
+SaccrvCsa csa(const std::string& id, const std::string& counterparty, bool active) {
+    SaccrvCsa result;
+    result.id = id;
+    result.counterparty = counterparty;
+    result.active = active;
+    result.mporDays = active ? 10 : 0;
+    return result;
+}
+
+/* Three counterparties: CPTY_A with an inactive CSA and two trades without netting set, CPTY_B with an active CSA
+   and CPTY_C with a trade without netting set only. */
+void setUpInputs() {
+    SaccrvConfigurations config;
+    config.supervisoryFactors["IRD"][""] = {0.005, 1.0, 0.5};
+    SaccrvConfigManager::getInstance()->setConfigurations(config);
+    SaccrvConfigManager::getInstance()->setSimplified(false);
+    SaccrvConfigManager::getInstance()->setOEM(false);
+    SaccrvConfigManager::getInstance()->setIgnoreMargin(false);
+
+    auto tradesManager = SaccrvTradesManager::getInstance();
+    tradesManager->clear();
+    tradesManager->addSaccrvTrade(irSwap("A1", "CPTY_A", "NS_A", 100.0, 5.0));
+    tradesManager->addSaccrvTrade(irSwap("A2", "CPTY_A", "", 30.0, 2.0));
+    tradesManager->addSaccrvTrade(irSwap("A3", "CPTY_A", "", -10.0, 7.0));
+    tradesManager->addSaccrvTrade(irSwap("B1", "CPTY_B", "NS_B", 200.0, 3.0));
+    tradesManager->addSaccrvTrade(irSwap("B2", "CPTY_B", "NS_B", -50.0, 10.0));
+    tradesManager->addSaccrvTrade(irSwap("C1", "CPTY_C", "", 70.0, 0.5));
+
+    auto csaManager = SaccrvCsaManager::getInstance();
+    csaManager->clear();
+    csaManager->addSaccrvCsa(csa("NS_A", "CPTY_A", false));
+    csaManager->addSaccrvCsa(csa("NS_B", "CPTY_B", true));
+
+    SaccrvCalculationManager::getInstance()->initialiseCounterpartyTree({});
+}
+
+std::vector<Counterparty> runCalcs(std::size_t nThreads) {
+    setUpInputs();
+    RunSaccrvCalculations(nThreads).runCalcs();
+    return SaccrvCalculationManager::getInstance()->getCounterparties();
+}
+
+Size nTrades(const NettingSet& nettingSet) {
+    Size n = 0;
+    for (const auto& currency : nettingSet.assetClasses.ird.currencies) {
+        for (const auto& timeBucket : currency.timeBuckets)
+            n += timeBucket.tradeData.size();
+    }
+    return n;
+}
+
+const Counterparty& counterparty(const std::vector<Counterparty>& counterparties, const std::string& id) {
+    for (const auto& c : counterparties) {
+        if (c.counterpartyId == id)
+            return c;
+    }
+    BOOST_FAIL("counterparty " << id << " not found");
+    return counterparties.front();
+}
+
+const NettingSet* nettingSet(const Counterparty& counterparty, const std::string& id) {
+    for (const auto& ns : counterparty.nettingSets) {
+        if (ns.id == id)
+            return &ns;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(OREAnalyticsTestSuite, ore::test::OreaTopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(SaccrvTest)
+
+BOOST_AUTO_TEST_CASE(testTradesWithoutNettingSet) {
+
+    BOOST_TEST_MESSAGE("Testing that only the trades without netting set enter the SA-CCR no_csa netting set...");
+
+    std::vector<Counterparty> counterparties = runCalcs(1);
+    BOOST_REQUIRE_EQUAL(counterparties.size(), 3);
+
+    // CPTY_A has A2 and A3 without netting set, CPTY_C has C1 only
+    const NettingSet* a = nettingSet(counterparty(counterparties, "CPTY_A"), "no_csa");
+    BOOST_REQUIRE(a);
+    BOOST_CHECK_EQUAL(nTrades(*a), 2);
+    BOOST_CHECK_CLOSE(a->replacementCost.v, 20.0, 1.0E-10);
+
+    const NettingSet* c = nettingSet(counterparty(counterparties, "CPTY_C"), "no_csa");
+    BOOST_REQUIRE(c);
+    BOOST_CHECK_EQUAL(nTrades(*c), 1);
+    BOOST_CHECK_CLOSE(c->replacementCost.v, 70.0, 1.0E-10);
+
+    const Counterparty& b = counterparty(counterparties, "CPTY_B");
+    BOOST_CHECK(nettingSet(b, "no_csa") == nullptr);
+    BOOST_CHECK(nettingSet(b, "NS_B_unmargined") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(testCounterpartyTotals) {
+
+    BOOST_TEST_MESSAGE("Testing that the SA-CCR counterparty values are the sums over their netting sets...");
+
+    std::vector<Counterparty> counterparties = runCalcs(1);
+    BOOST_REQUIRE_EQUAL(counterparties.size(), 3);
+
+    for (const auto& c : counterparties) {
+        BOOST_TEST_MESSAGE("Checking counterparty " << c.counterpartyId);
+        BOOST_REQUIRE(!c.nettingSets.empty());
+        double addOn = 0.0, ead = 0.0, pfe = 0.0, rc = 0.0, v = 0.0;
+        for (const auto& ns : c.nettingSets) {
+            addOn += ns.addOn;
+            ead += ns.ead;
+            pfe += ns.pfe;
+            rc += ns.replacementCost.rc;
+            v += ns.replacementCost.v;
+        }
+        BOOST_CHECK(ead > 0.0);
+        BOOST_CHECK_CLOSE(c.addOn, addOn, 1.0E-10);
+        BOOST_CHECK_CLOSE(c.ead, ead, 1.0E-10);
+        BOOST_CHECK_CLOSE(c.pfe, pfe, 1.0E-10);
+        BOOST_CHECK_CLOSE(c.replacementCost.rc, rc, 1.0E-10);
+        BOOST_CHECK_CLOSE(c.replacementCost.v, v, 1.0E-10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testMultiThreaded) {
+
+    BOOST_TEST_MESSAGE("Testing that SA-CCR on several threads matches the single threaded calculation...");
+
+    const std::vector<Counterparty> expected = runCalcs(1);
+    for (std::size_t nThreads : {2, 4}) {
+        BOOST_TEST_MESSAGE("Checking " << nThreads << " threads");
+        const std::vector<Counterparty> counterparties = runCalcs(nThreads);
+        BOOST_REQUIRE_EQUAL(counterparties.size(), expected.size());
+        for (Size i = 0; i < expected.size(); ++i) {
+            const Counterparty& c = counterparties[i];
+            const Counterparty& e = expected[i];
+            BOOST_CHECK_EQUAL(c.counterpartyId, e.counterpartyId);
+            BOOST_CHECK_EQUAL(c.addOn, e.addOn);
+            BOOST_CHECK_EQUAL(c.ead, e.ead);
+            BOOST_CHECK_EQUAL(c.pfe, e.pfe);
+            BOOST_CHECK_EQUAL(c.replacementCost.rc, e.replacementCost.rc);
+            BOOST_REQUIRE_EQUAL(c.nettingSets.size(), e.nettingSets.size());
+            for (Size j = 0; j < e.nettingSets.size(); ++j) {
+                BOOST_CHECK_EQUAL(c.nettingSets[j].id, e.nettingSets[j].id);
+                BOOST_CHECK_EQUAL(c.nettingSets[j].ead, e.nettingSets[j].ead);
+                BOOST_CHECK_EQUAL(nTrades(c.nettingSets[j]), nTrades(e.nettingSets[j]));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
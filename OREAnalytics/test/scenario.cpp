@@ -9,6 +9,10 @@ All rights reserved.
 #include <orea/scenario/simplescenario.hpp>
 #include <orea/scenario/simplescenariofactory.hpp>
 #include <orea/scenario/csvscenariogenerator.hpp>
+#include <orea/scenario/bufferedscenariogenerator.hpp>
+#include <orea/scenario/scenariocube.hpp>
+
+#include <thread>
 
 using namespace boost::unit_test_framework;
 using namespace QuantLib;
@@ -34,6 +38,39 @@ private:
 
 BOOST_FIXTURE_TEST_SUITE(OREAnalyticsTestSuite, ore::test::TopLevelFixture)
 
+BOOST_AUTO_TEST_SUITE(RiskFactorKeyTest)
+
+BOOST_AUTO_TEST_CASE(testRiskFactorKeyInterning) {
+
+    BOOST_TEST_MESSAGE("Testing risk factor key name interning...");
+
+    // register the names in reverse lexicographic order, the key ordering must not depend on this
+    RiskFactorKey usd(RiskFactorKey::KeyType::DiscountCurve, "USD", 1);
+    RiskFactorKey eur(RiskFactorKey::KeyType::DiscountCurve, "EUR", 2);
+    RiskFactorKey eur2(RiskFactorKey::KeyType::DiscountCurve, std::string("EU") + "R", 2);
+
+    BOOST_CHECK_EQUAL(eur.nameId(), eur2.nameId());
+    BOOST_CHECK_NE(eur.nameId(), usd.nameId());
+    BOOST_CHECK_EQUAL(RiskFactorNameRegistry::instance().name(eur.nameId()), "EUR");
+    BOOST_CHECK_EQUAL(RiskFactorKey().nameId(), 0);
+
+    BOOST_CHECK(eur == eur2);
+    BOOST_CHECK(eur != usd);
+    BOOST_CHECK_EQUAL(eur.packed(), eur2.packed());
+    BOOST_CHECK_EQUAL(hash_value(eur), hash_value(eur2));
+
+    BOOST_CHECK(eur < usd);
+    BOOST_CHECK(RiskFactorKey(RiskFactorKey::KeyType::DiscountCurve, "EUR", 1) < eur);
+    BOOST_CHECK(usd < RiskFactorKey(RiskFactorKey::KeyType::IndexCurve, "AAA", 0));
+
+    std::ostringstream out;
+    out << eur;
+    BOOST_CHECK_EQUAL(out.str(), "DiscountCurve/EUR/2");
+    BOOST_CHECK(parseRiskFactorKey(out.str()) == eur);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE(CSVScenarioGeneratorTest)
 
 BOOST_AUTO_TEST_CASE(testCSVScenarioGenerator) {
@@ -89,4 +126,125 @@ BOOST_AUTO_TEST_CASE(testCSVScenarioGenerator) {
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(BufferedScenarioGeneratorTest)
+
+BOOST_AUTO_TEST_CASE(testBufferedScenarioGenerator) {
+
+    BOOST_TEST_MESSAGE("Testing buffered scenario generator with several consuming threads...");
+
+    std::vector<Date> dates = {Date(21, Dec, 2016), Date(21, Dec, 2017), Date(21, Dec, 2018)};
+    Size nSamples = 20;
+    RiskFactorKey key(RiskFactorKey::KeyType::FXSpot, "CHF");
+
+    auto tsg = QuantLib::ext::make_shared<TestScenarioGenerator>();
+    for (Size i = 0; i < nSamples; ++i) {
+        for (Size j = 0; j < dates.size(); ++j) {
+            auto scenario = QuantLib::ext::make_shared<SimpleScenario>(dates[j]);
+            scenario->add(key, static_cast<Real>(100 * i + j));
+            tsg->addScenario(scenario);
+        }
+    }
+
+    // a buffer holding two samples read by three consumers, the last one stops after the first sample
+    Size nConsumers = 3;
+    auto buffer = QuantLib::ext::make_shared<ScenarioBuffer>(dates, nSamples, nConsumers, 2);
+    std::vector<std::vector<Real>> values(nConsumers);
+    std::vector<std::thread> consumers;
+    for (Size c = 0; c < nConsumers; ++c) {
+        consumers.emplace_back([&buffer, &values, &dates, &key, nSamples, nConsumers, c]() {
+            BufferedScenarioGenerator generator(buffer, c);
+            Size samples = c == nConsumers - 1 ? 1 : nSamples;
+            for (Size i = 0; i < samples; ++i) {
+                for (auto const& d : dates)
+                    values[c].push_back(generator.next(d)->get(key));
+            }
+            buffer->finish(c);
+        });
+    }
+    buffer->produce(*tsg);
+    for (auto& t : consumers)
+        t.join();
+
+    for (Size c = 0; c < nConsumers; ++c) {
+        Size samples = c == nConsumers - 1 ? 1 : nSamples;
+        BOOST_REQUIRE_EQUAL(values[c].size(), samples * dates.size());
+        for (Size i = 0; i < samples; ++i) {
+            for (Size j = 0; j < dates.size(); ++j)
+                BOOST_CHECK_EQUAL(values[c][i * dates.size() + j], static_cast<Real>(100 * i + j));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(ScenarioCubeTest)
+
+BOOST_AUTO_TEST_CASE(testScenarioCube) {
+
+    BOOST_TEST_MESSAGE("Testing scenario cube and scenario views...");
+
+    RiskFactorKey chf(RiskFactorKey::KeyType::FXSpot, "CHF");
+    RiskFactorKey gbp(RiskFactorKey::KeyType::FXSpot, "GBP");
+    RiskFactorKey usd(RiskFactorKey::KeyType::FXSpot, "USD");
+
+    // two scenarios sharing their layout, the second one adds a key
+    SimpleScenarioFactory factory(true);
+    auto s1 = factory.buildScenario(Date(1, Jan, 2020), true, "s1", 1.0);
+    s1->add(chf, 1.1);
+    s1->add(gbp, 1.2);
+    auto s2 = factory.buildScenario(Date(2, Jan, 2020), true, "s2", 2.0);
+    s2->add(chf, 2.1);
+    s2->add(gbp, 2.2);
+    s2->add(usd, 2.3);
+
+    // a scenario with its own layout and a subset of the keys
+    auto s3 = QuantLib::ext::make_shared<SimpleScenario>(Date(3, Jan, 2020), "s3", 3.0);
+    s3->add(usd, 3.3);
+
+    for (bool singlePrecision : {false, true}) {
+        QuantLib::ext::shared_ptr<ScenarioCube> cube;
+        if (singlePrecision)
+            cube = QuantLib::ext::make_shared<SinglePrecisionScenarioCube>();
+        else
+            cube = QuantLib::ext::make_shared<DoublePrecisionScenarioCube>();
+        cube->add(*s1);
+        cube->add(*s2);
+        cube->add(*s3);
+        BOOST_CHECK(cube->sharedData() == QuantLib::ext::static_pointer_cast<SimpleScenario>(s1)->sharedData());
+        BOOST_REQUIRE_EQUAL(cube->numScenarios(), 3);
+        BOOST_REQUIRE_EQUAL(cube->numKeys(), 3);
+
+        Real tol = singlePrecision ? 1E-6 : 1E-14;
+        auto views = scenarioViews(cube);
+        BOOST_REQUIRE_EQUAL(views.size(), 3);
+        std::vector<QuantLib::ext::shared_ptr<Scenario>> scenarios = {s1, s2, s3};
+        std::vector<RiskFactorKey> keys = {chf, gbp, usd};
+        std::vector<std::vector<Real>> expected = {
+            {1.1, 1.2, Null<Real>()}, {2.1, 2.2, 2.3}, {Null<Real>(), Null<Real>(), 3.3}};
+        for (Size s = 0; s < 3; ++s) {
+            BOOST_CHECK_EQUAL(views[s]->asof(), scenarios[s]->asof());
+            BOOST_CHECK_EQUAL(views[s]->label(), scenarios[s]->label());
+            BOOST_CHECK_EQUAL(views[s]->getNumeraire(), scenarios[s]->getNumeraire());
+            for (Size k = 0; k < keys.size(); ++k) {
+                bool has = expected[s][k] != Null<Real>();
+                BOOST_CHECK_EQUAL(views[s]->has(keys[k]), has);
+                if (has)
+                    BOOST_CHECK_CLOSE(views[s]->get(keys[k]), expected[s][k], tol);
+                else
+                    BOOST_CHECK(views[s]->get(keys[k]) == Null<Real>());
+            }
+        }
+
+        // views are read-only, clones are modifiable
+        BOOST_CHECK_THROW(views[0]->add(chf, 0.0), QuantLib::Error);
+        auto clone = views[2]->clone();
+        clone->add(chf, 3.1);
+        BOOST_CHECK_EQUAL(clone->get(chf), 3.1);
+        BOOST_CHECK_CLOSE(clone->get(usd), 3.3, tol);
+        BOOST_CHECK(!views[2]->has(chf));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
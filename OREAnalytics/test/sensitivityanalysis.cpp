@@ -842,6 +842,11 @@ BOOST_AUTO_TEST_CASE(testPortfolioSensitivityUnregisterObs) {
     testPortfolioSensitivity(ObservationMode::Mode::Unregister);
 }
 
+BOOST_AUTO_TEST_CASE(testPortfolioSensitivityGraphObs) {
+    BOOST_TEST_MESSAGE("Testing Portfolio sensitivity (Graph observation mode)");
+    testPortfolioSensitivity(ObservationMode::Mode::Graph);
+}
+
 void test1dShifts(bool granular) {
     BOOST_TEST_MESSAGE("Testing 1d shifts " << (granular ? "granular" : "sparse"));
 
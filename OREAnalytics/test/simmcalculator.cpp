@@ -0,0 +1,244 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <orea/simm/simmbucketmapperbase.hpp>
+#include <orea/simm/simmcalculator.hpp>
+#include <orea/simm/utilities.hpp>
+#include <oret/toplevelfixture.hpp>
+#include <test/oreatoplevelfixture.hpp>
+
+using namespace ore::analytics;
+using namespace boost::unit_test_framework;
+using ore::data::NettingSetDetails;
+using QuantLib::Real;
+
+namespace {
+
+typedef SimmConfiguration::SimmSide SimmSide;
+typedef std::map<SimmSide, std::map<NettingSetDetails, std::map<std::string, SimmResults>>> Results;
+
+const NettingSetDetails nettingSet("CPTY_A");
+
+CrifRecord irRecord(const std::string& tradeId, const std::string& tenor, Real amount,
+                    const std::string& regulations, const NettingSetDetails& nsd = nettingSet) {
+    return CrifRecord(tradeId, "Swap", nsd, CrifRecord::ProductClass::RatesFX, CrifRecord::RiskType::IRCurve,
+                      "USD", "1", tenor, "Libor3m", "USD", amount, amount, "SIMM", regulations, regulations);
+}
+
+CrifRecord fxRecord(const std::string& tradeId, const std::string& ccy, Real amount, const std::string& regulations,
+                    const NettingSetDetails& nsd = nettingSet) {
+    return CrifRecord(tradeId, "FxForward", nsd, CrifRecord::ProductClass::RatesFX, CrifRecord::RiskType::FX,
+                      ccy, "", "", "", "USD", amount, amount, "SIMM", regulations, regulations);
+}
+
+Crif crif(const std::vector<CrifRecord>& records) {
+    Crif result;
+    for (const auto& r : records)
+        result.addRecord(r);
+    return result;
+}
+
+QuantLib::ext::shared_ptr<SimmCalculator> simmCalculator(const Crif& crif, QuantLib::Size nThreads = 1) {
+    auto simmConfiguration =
+        buildSimmConfiguration("2.6", QuantLib::ext::make_shared<SimmBucketMapperBase>());
+    return QuantLib::ext::make_shared<SimmCalculator>(crif, simmConfiguration, "USD", "USD", "USD", nullptr, true,
+                                                      true, true, std::map<SimmSide, std::set<NettingSetDetails>>(),
+                                                      std::map<SimmSide, std::set<NettingSetDetails>>(), nThreads);
+}
+
+// Check that the results hold the same margins as the expected results, exactly or up to rounding
+void checkResults(const Results& results, const Results& expected, bool exact) {
+    BOOST_REQUIRE_EQUAL(results.size(), expected.size());
+    for (const auto& [side, nettingSetResults] : expected) {
+        BOOST_REQUIRE(results.count(side) > 0);
+        BOOST_REQUIRE_EQUAL(results.at(side).size(), nettingSetResults.size());
+        for (const auto& [nsd, regulationResults] : nettingSetResults) {
+            BOOST_REQUIRE(results.at(side).count(nsd) > 0);
+            const auto& actualRegulationResults = results.at(side).at(nsd);
+            BOOST_REQUIRE_EQUAL(actualRegulationResults.size(), regulationResults.size());
+            for (const auto& [regulation, simmResults] : regulationResults) {
+                BOOST_TEST_MESSAGE("Checking " << side << " results of regulation " << regulation);
+                BOOST_REQUIRE(actualRegulationResults.count(regulation) > 0);
+                const auto& data = actualRegulationResults.at(regulation).data();
+                BOOST_REQUIRE_EQUAL(data.size(), simmResults.data().size());
+                for (const auto& [key, im] : simmResults.data()) {
+                    auto it = data.find(key);
+                    BOOST_REQUIRE(it != data.end());
+                    if (exact)
+                        BOOST_CHECK_EQUAL(it->second, im);
+                    else
+                        BOOST_CHECK_SMALL(it->second - im, 1.0E-6);
+                }
+            }
+        }
+    }
+}
+
+Real initialMargin(const SimmCalculator& calculator, const SimmSide& side) {
+    const auto& finalResults = calculator.finalSimmResults();
+    return finalResults.at(side).at(nettingSet).second.get(CrifRecord::ProductClass::All,
+                                                           SimmConfiguration::RiskClass::All,
+                                                           SimmConfiguration::MarginType::All, "All");
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(OREAnalyticsTestSuite, ore::test::OreaTopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(SimmCalculatorTest)
+
+BOOST_AUTO_TEST_CASE(testAddAndRemoveRecords) {
+
+    BOOST_TEST_MESSAGE("Testing that removing added CRIF records restores the SIMM results...");
+
+    Crif base = crif({irRecord("T1", "2y", 10000.0, "SEC"), irRecord("T1", "10y", -4000.0, "SEC"),
+                      fxRecord("T2", "EUR", 50000.0, "SEC")});
+    Crif whatIf = crif({irRecord("T3", "5y", 20000.0, "SEC"), fxRecord("T3", "JPY", 30000.0, "SEC")});
+    Crif all = base;
+    all.addRecords(whatIf);
+
+    auto calculator = simmCalculator(base);
+    const Results baseResults = calculator->simmResults();
+    const auto baseWinningRegulations = calculator->winningRegulations();
+    const auto baseTradeIds = calculator->finalTradeIds();
+
+    // Adding the records matches a full calculation on all records
+    calculator->addRecords(whatIf);
+    auto fullCalculator = simmCalculator(all);
+    checkResults(calculator->simmResults(), fullCalculator->simmResults(), false);
+    BOOST_CHECK(calculator->finalTradeIds() == fullCalculator->finalTradeIds());
+
+    // Removing them again gives back the original results
+    calculator->removeRecords(whatIf);
+    checkResults(calculator->simmResults(), baseResults, true);
+    BOOST_CHECK(calculator->winningRegulations() == baseWinningRegulations);
+    BOOST_CHECK(calculator->finalTradeIds() == baseTradeIds);
+}
+
+BOOST_AUTO_TEST_CASE(testRemoveRecordsKeepsTradeIds) {
+
+    BOOST_TEST_MESSAGE("Testing that a trade ID is kept while the trade has records left...");
+
+    Crif base = crif({irRecord("T1", "2y", 10000.0, "SEC"), fxRecord("T2", "EUR", 50000.0, "SEC")});
+    auto calculator = simmCalculator(base);
+
+    calculator->addRecords(crif({irRecord("T3", "5y", 20000.0, "SEC"), fxRecord("T3", "JPY", 30000.0, "SEC")}));
+    BOOST_CHECK(calculator->finalTradeIds().at(SimmSide::Call).count("T3") > 0);
+
+    calculator->removeRecords(crif({fxRecord("T3", "JPY", 30000.0, "SEC")}));
+    BOOST_CHECK(calculator->finalTradeIds().at(SimmSide::Call).count("T3") > 0);
+    BOOST_CHECK(calculator->finalTradeIds().at(SimmSide::Post).count("T3") > 0);
+
+    calculator->removeRecords(crif({irRecord("T3", "5y", 20000.0, "SEC")}));
+    BOOST_CHECK(calculator->finalTradeIds().at(SimmSide::Call).count("T3") == 0);
+    BOOST_CHECK(calculator->finalTradeIds().at(SimmSide::Post).count("T3") == 0);
+    BOOST_CHECK(calculator->finalTradeIds().at(SimmSide::Call).count("T1") > 0);
+}
+
+BOOST_AUTO_TEST_CASE(testIncrementalMargin) {
+
+    BOOST_TEST_MESSAGE("Testing that the incremental margin leaves the SIMM results unchanged...");
+
+    Crif base = crif({irRecord("T1", "2y", 10000.0, "SEC"), irRecord("T1", "10y", -4000.0, "SEC"),
+                      fxRecord("T2", "EUR", 50000.0, "SEC")});
+    // The what-if records hit risk factors of the base records, so backing them out would not be exact
+    Crif whatIf = crif({irRecord("T3", "2y", -3333.3, "SEC"), fxRecord("T3", "EUR", 1234.5, "SEC"),
+                        fxRecord("T3", "JPY", 30000.0, "SEC")});
+    Crif all = base;
+    all.addRecords(whatIf);
+
+    auto calculator = simmCalculator(base);
+    const Results baseResults = calculator->simmResults();
+    const auto baseFinalResults = calculator->finalSimmResults();
+    const auto baseTradeIds = calculator->finalTradeIds();
+
+    Real incrementalMargin = calculator->incrementalMargin(whatIf, SimmSide::Call, nettingSet);
+
+    checkResults(calculator->simmResults(), baseResults, true);
+    BOOST_CHECK(calculator->finalTradeIds() == baseTradeIds);
+    BOOST_CHECK_EQUAL(initialMargin(*calculator, SimmSide::Call), baseFinalResults.at(SimmSide::Call)
+                                                                      .at(nettingSet)
+                                                                      .second.get(CrifRecord::ProductClass::All,
+                                                                                  SimmConfiguration::RiskClass::All,
+                                                                                  SimmConfiguration::MarginType::All,
+                                                                                  "All"));
+
+    auto fullCalculator = simmCalculator(all);
+    BOOST_CHECK_SMALL(incrementalMargin - (initialMargin(*fullCalculator, SimmSide::Call) -
+                                           initialMargin(*calculator, SimmSide::Call)),
+                      1.0E-6);
+
+    // A second call gives the same answer
+    BOOST_CHECK_EQUAL(calculator->incrementalMargin(whatIf, SimmSide::Call, nettingSet), incrementalMargin);
+}
+
+BOOST_AUTO_TEST_CASE(testAddSecRecordsToCftcNettingSet) {
+
+    BOOST_TEST_MESSAGE("Testing that CFTC records are included in SEC when SEC records are added...");
+
+    Crif base = crif({irRecord("T1", "2y", 10000.0, "CFTC"), fxRecord("T2", "EUR", 50000.0, "CFTC")});
+    Crif whatIf = crif({irRecord("T3", "5y", 20000.0, "SEC")});
+    Crif all = base;
+    all.addRecords(whatIf);
+
+    auto calculator = simmCalculator(base);
+    calculator->addRecords(whatIf);
+    auto fullCalculator = simmCalculator(all);
+    BOOST_CHECK(fullCalculator->simmResults().at(SimmSide::Call).at(nettingSet).count("SEC") > 0);
+    checkResults(calculator->simmResults(), fullCalculator->simmResults(), false);
+}
+
+BOOST_AUTO_TEST_CASE(testMultiThreaded) {
+
+    BOOST_TEST_MESSAGE("Testing that a SIMM calculation on several threads matches the single threaded one...");
+
+    // several netting sets and regulations, so that there are more (side, netting set, regulation) combinations
+    // than threads
+    std::vector<CrifRecord> records;
+    for (const std::string& id : {"CPTY_A", "CPTY_B", "CPTY_C"}) {
+        const NettingSetDetails nsd(id);
+        for (const std::string& regulations : {"SEC", "CFTC", "EMIR"}) {
+            const std::string tradeId = id + "_" + regulations;
+            records.push_back(irRecord(tradeId, "2y", 10000.0, regulations, nsd));
+            records.push_back(irRecord(tradeId, "10y", -4000.0, regulations, nsd));
+            records.push_back(fxRecord(tradeId, "EUR", 50000.0, regulations, nsd));
+            records.push_back(fxRecord(tradeId, "JPY", -20000.0, regulations, nsd));
+        }
+    }
+    Crif all = crif(records);
+
+    auto calculator = simmCalculator(all);
+    for (QuantLib::Size nThreads : {2, 4, 16}) {
+        BOOST_TEST_MESSAGE("Checking " << nThreads << " threads");
+        auto mtCalculator = simmCalculator(all, nThreads);
+        checkResults(mtCalculator->simmResults(), calculator->simmResults(), true);
+        BOOST_CHECK(mtCalculator->winningRegulations() == calculator->winningRegulations());
+        BOOST_CHECK(mtCalculator->finalTradeIds() == calculator->finalTradeIds());
+        for (const auto& side : {SimmSide::Call, SimmSide::Post}) {
+            for (const auto& [nsd, result] : calculator->finalSimmResults().at(side)) {
+                BOOST_CHECK_EQUAL(mtCalculator->finalSimmResults().at(side).at(nsd).first, result.first);
+                BOOST_CHECK(mtCalculator->finalSimmResults().at(side).at(nsd).second.data() == result.second.data());
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -44,6 +44,7 @@
 #include <ored/utilities/indexparser.hpp>
 #include <ored/utilities/indexnametranslator.hpp>
 #include <ored/utilities/log.hpp>
+#include <ored/utilities/profiler.hpp>
 #include <ored/utilities/to_string.hpp>
 #include <qle/indexes/dividendmanager.hpp>
 #include <qle/indexes/equityindex.hpp>
@@ -100,6 +101,8 @@ struct Count {
 
 void TodaysMarket::initialise(const Date& asof) {
 
+    ORE_PROFILE_SCOPE("TodaysMarket::initialise");
+
     std::map<std::string, boost::timer::nanosecond_type> timings;
     std::map<std::string, Count> counts;
     boost::timer::cpu_timer timer;
@@ -267,6 +270,8 @@ void TodaysMarket::buildNode(const std::string& configuration, Node& node) const
     if (node.built)
         return;
 
+    ORE_PROFILE_SCOPE("TodaysMarket::buildNode", Profiler::enabled() ? ore::data::to_string(node.obj) : std::string());
+
     if (node.curveSpec == nullptr) {
 
         // not spec-based node, this can only be a SwapIndexCurve
@@ -400,7 +400,9 @@
 #include <ored/utilities/log.hpp>
 #include <ored/utilities/marketdata.hpp>
 #include <ored/utilities/osutils.hpp>
+#include <ored/utilities/parallel.hpp>
 #include <ored/utilities/parsers.hpp>
+#include <ored/utilities/profiler.hpp>
 #include <ored/utilities/progressbar.hpp>
 #include <ored/utilities/serializationdate.hpp>
 #include <ored/utilities/serializationdaycounter.hpp>
@@ -40,7 +40,7 @@ namespace data {
  *  When the engine() method is called the CachingEngineBuilder first
  *  looks in it's cache to see if it has an engine or coupon pricer for this key already
  *  if so it is returned, otherwise a new engine or coupon pricer is created, stored and
- *  returned.
+ *  returned. The cache is guarded by the builder's mutex, so trades can be built concurrently.
  *
  *  The first template argument is the cache key type (e.g. a std::string)
  *  The second template argument is PricingEngine or FloatingRateCouponPricer
@@ -61,17 +61,21 @@ public:
 
     //! Return a PricingEngine or a FloatingRateCouponPricer
     QuantLib::ext::shared_ptr<U> engine(Args... params) {
+        // the cache is shared by all threads building trades, so each engine is built once per key
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         T key = keyImpl(params...);
-        if (engines_.find(key) == engines_.end()) {
-            // build first (in case it throws)
-            QuantLib::ext::shared_ptr<U> engine = engineImpl(params...);
-            // then add to map
-            engines_[key] = engine;
+        auto e = engines_.find(key);
+        if (e == engines_.end()) {
+            // build first (in case it throws), then add to map
+            e = engines_.emplace(key, engineImpl(params...)).first;
         }
-        return engines_[key];
+        return e->second;
     }
 
-    void reset() override { engines_.clear(); }
+    void reset() override {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        engines_.clear();
+    }
 
 protected:
     virtual T keyImpl(Args...) = 0;
@@ -80,6 +80,9 @@ ScriptedTradeEngineBuilder::engine(const std::string& id, const ScriptedTrade& s
                                    const QuantLib::ext::shared_ptr<ReferenceDataManager>& referenceData,
                                    const IborFallbackConfig& iborFallbackConfig) {
 
+    // the builder state is populated below, callers reading it afterwards hold the lock as well
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     const std::vector<ScriptedTradeEventData>& events = scriptedTrade.events();
     const std::vector<ScriptedTradeValueTypeData>& numbers = scriptedTrade.numbers();
     const std::vector<ScriptedTradeValueTypeData>& indices = scriptedTrade.indices();
@@ -249,6 +249,7 @@ LGMGridSwaptionEngineBuilder::engineImpl(const string& id, const string& key, co
     Size ny = parseInteger(engineParameter("ny"));
     Real sx = parseReal(engineParameter("sx"));
     Size nx = parseInteger(engineParameter("nx"));
+    auto method = parseLgmConvolutionSolverMethod(engineParameter("ConvolutionMethod", {}, false, "Direct"));
 
     // Build engine
     DLOG("Build engine (configuration " << configuration(MarketContext::pricing) << ")");
@@ -261,7 +262,7 @@ LGMGridSwaptionEngineBuilder::engineImpl(const string& id, const string& key, co
         yts = Handle<YieldTermStructure>(QuantLib::ext::make_shared<ZeroSpreadedTermStructure>(
             yts, market_->securitySpread(securitySpread, configuration(MarketContext::pricing))));
     return QuantLib::ext::make_shared<QuantExt::NumericLgmMultiLegOptionEngine>(
-        lgm, sy, ny, sx, nx, yts, isAmerican ? parseInteger(modelParameter("ExerciseTimeStepsPerYear")) : 0);
+        lgm, sy, ny, sx, nx, yts, isAmerican ? parseInteger(modelParameter("ExerciseTimeStepsPerYear")) : 0, method);
 }
 
 QuantLib::ext::shared_ptr<PricingEngine>
@@ -188,6 +188,8 @@ EngineFactory::EngineFactory(const QuantLib::ext::shared_ptr<EngineData>& engine
 }
 
 void EngineFactory::registerBuilder(const QuantLib::ext::shared_ptr<EngineBuilder>& builder, const bool allowOverwrite) {
+    boost::unique_lock<boost::shared_mutex> lock(mutex_);
+    builderCache_.clear();
     const string& modelName = builder->model();
     const string& engineName = builder->engine();
     auto key = make_tuple(modelName, engineName, builder->tradeTypes());
@@ -199,14 +201,22 @@ void EngineFactory::registerBuilder(const QuantLib::ext::shared_ptr<EngineBuilde
                                                                << ") - this is an internal error.");
 }
 
-QuantLib::ext::shared_ptr<EngineBuilder> EngineFactory::builder(const string& tradeType) {
+std::pair<QuantLib::ext::shared_ptr<EngineBuilder>, string> EngineFactory::findBuilder(const string& tradeType) {
     // Check that we have a model/engine for tradetype
     QL_REQUIRE(engineData_->hasProduct(tradeType),
                "No Pricing Engine configuration was provided for trade type " << tradeType);
 
-    // Find a builder for the model/engine/tradeType
     const string& model = engineData_->model(tradeType);
     const string& engine = engineData_->engine(tradeType);
+    auto cacheKey = std::make_tuple(model, engine, tradeType);
+    {
+        boost::shared_lock<boost::shared_mutex> lock(mutex_);
+        if (auto c = builderCache_.find(cacheKey); c != builderCache_.end())
+            return c->second;
+    }
+
+    // Find a builder for the model/engine/tradeType
+    boost::unique_lock<boost::shared_mutex> lock(mutex_);
     typedef pair<tuple<string, string, set<string>>, QuantLib::ext::shared_ptr<EngineBuilder>> map_type;
     auto pred = [&model, &engine, &tradeType](const map_type& v) -> bool {
         const set<string>& types = std::get<2>(v.first);
@@ -223,13 +233,48 @@ QuantLib::ext::shared_ptr<EngineBuilder> EngineFactory::builder(const string& tr
     if(auto db = QuantLib::ext::dynamic_pointer_cast<DelegatingEngineBuilder>(builder))
 	effectiveTradeType = db->effectiveTradeType();
 
-    builder->init(market_, configurations_, engineData_->modelParameters(effectiveTradeType),
-                  engineData_->engineParameters(effectiveTradeType), engineData_->globalParameters());
+    return builderCache_[cacheKey] = std::make_pair(builder, effectiveTradeType);
+}
+
+QuantLib::ext::shared_ptr<EngineBuilder> EngineFactory::builder(const string& tradeType) {
+    auto [builder, effectiveTradeType] = findBuilder(tradeType);
+
+    // Only (re-)initialise the builder if the parameters changed. So a builder in use by another thread is not
+    // written to, unless trade types sharing the builder have different parameters, see consistentBuilderParameters().
+    std::lock_guard<std::recursive_mutex> lock(builder->mutex());
+    const auto& modelParameters = engineData_->modelParameters(effectiveTradeType);
+    const auto& engineParameters = engineData_->engineParameters(effectiveTradeType);
+    if (!builder->initialised(market_, configurations_, modelParameters, engineParameters,
+                              engineData_->globalParameters()))
+        builder->init(market_, configurations_, modelParameters, engineParameters, engineData_->globalParameters());
 
     return builder;
 }
 
+bool EngineFactory::consistentBuilderParameters(const std::set<std::string>& tradeTypes) {
+    std::map<EngineBuilder*, string> effectiveTradeTypes;
+    for (auto const& tradeType : tradeTypes) {
+        std::pair<QuantLib::ext::shared_ptr<EngineBuilder>, string> b;
+        try {
+            b = findBuilder(tradeType);
+        } catch (const std::exception&) {
+            continue;
+        }
+        auto [e, inserted] = effectiveTradeTypes.insert(std::make_pair(b.first.get(), b.second));
+        if (!inserted && e->second != b.second &&
+            (engineData_->modelParameters(e->second) != engineData_->modelParameters(b.second) ||
+             engineData_->engineParameters(e->second) != engineData_->engineParameters(b.second))) {
+            DLOG("EngineFactory: trade types " << e->second << " and " << b.second << " share engine builder "
+                                               << b.first->model() << "/" << b.first->engine()
+                                               << " with different parameters");
+            return false;
+        }
+    }
+    return true;
+}
+
 void EngineFactory::registerLegBuilder(const QuantLib::ext::shared_ptr<LegBuilder>& legBuilder, const bool allowOverwrite) {
+    boost::unique_lock<boost::shared_mutex> lock(mutex_);
     if (allowOverwrite)
         legBuilders_.erase(legBuilder->legType());
     QL_REQUIRE(legBuilders_.insert(make_pair(legBuilder->legType(), legBuilder)).second,
@@ -238,6 +283,7 @@ void EngineFactory::registerLegBuilder(const QuantLib::ext::shared_ptr<LegBuilde
 }
 
 QuantLib::ext::shared_ptr<LegBuilder> EngineFactory::legBuilder(const string& legType) {
+    boost::shared_lock<boost::shared_mutex> lock(mutex_);
     auto it = legBuilders_.find(legType);
     QL_REQUIRE(it != legBuilders_.end(), "No LegBuilder for " << legType);
     return it->second;
@@ -245,6 +291,7 @@ QuantLib::ext::shared_ptr<LegBuilder> EngineFactory::legBuilder(const string& le
 
 set<std::pair<string, QuantLib::ext::shared_ptr<QuantExt::ModelBuilder>>> EngineFactory::modelBuilders() const {
     set<std::pair<string, QuantLib::ext::shared_ptr<QuantExt::ModelBuilder>>> res;
+    boost::shared_lock<boost::shared_mutex> lock(mutex_);
     for (auto const& b : builders_) {
         res.insert(b.second->modelBuilders().begin(), b.second->modelBuilders().end());
     }
@@ -36,7 +36,11 @@
 
 #include <ql/shared_ptr.hpp>
 
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
 #include <map>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -137,8 +141,22 @@ public:
         modelParameters_ = modelParameters;
         engineParameters_ = engineParameters;
         globalParameters_ = globalParameters;
+        initialised_ = true;
+    }
+
+    //! Check if init() was called with the given market, configurations and parameters
+    bool initialised(const QuantLib::ext::shared_ptr<Market>& market, const map<MarketContext, string>& configurations,
+                     const map<string, string>& modelParameters, const map<string, string>& engineParameters,
+                     const std::map<std::string, std::string>& globalParameters) const {
+        return initialised_ && market_ == market && configurations_ == configurations &&
+               modelParameters_ == modelParameters && engineParameters_ == engineParameters &&
+               globalParameters_ == globalParameters;
     }
 
+    /*! Mutex guarding the state of the builder when trades are built concurrently. It is held while engines are
+        built, see CachingEngineBuilder, and by callers reading results of an engine() call from the builder. */
+    std::recursive_mutex& mutex() const { return mutex_; }
+
     //! return model builders
     const set<std::pair<string, QuantLib::ext::shared_ptr<QuantExt::ModelBuilder>>>& modelBuilders() const { return modelBuilders_; }
 
@@ -159,6 +177,8 @@ protected:
     map<string, string> engineParameters_;
     std::map<std::string, std::string> globalParameters_;
     set<std::pair<string, QuantLib::ext::shared_ptr<QuantExt::ModelBuilder>>> modelBuilders_;
+    bool initialised_ = false;
+    mutable std::recursive_mutex mutex_;
 };
 
 //! Delegating Engine Builder
@@ -269,6 +289,11 @@ public:
      */
     QuantLib::ext::shared_ptr<EngineBuilder> builder(const string& tradeType);
 
+    /*! Check that trade types sharing an engine builder use the same model and engine parameters. If this is the
+        case, trades of these types can be built concurrently, otherwise builder() re-initialises the shared builder
+        for each trade type. Trade types without configuration or builder are ignored. */
+    bool consistentBuilderParameters(const std::set<std::string>& tradeTypes);
+
     //! Register a leg builder with the factory
     void registerLegBuilder(const QuantLib::ext::shared_ptr<LegBuilder>& legBuilder, const bool allowOverwrite = false);
 
@@ -284,8 +309,10 @@ public:
 
     //! Clear all builders
     void clear() {
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
         builders_.clear();
         legBuilders_.clear();
+        builderCache_.clear();
     }
 
     //! return model builders
@@ -299,6 +326,13 @@ private:
     map<string, QuantLib::ext::shared_ptr<LegBuilder>> legBuilders_;
     QuantLib::ext::shared_ptr<ReferenceDataManager> referenceData_;
     IborFallbackConfig iborFallbackConfig_;
+
+    // find the builder and the effective trade type for a trade type, the result is cached
+    std::pair<QuantLib::ext::shared_ptr<EngineBuilder>, string> findBuilder(const string& tradeType);
+    // cache for findBuilder() keyed by model, engine and trade type
+    map<tuple<string, string, string>, std::pair<QuantLib::ext::shared_ptr<EngineBuilder>, string>> builderCache_;
+    // guards the builder maps and the cache, trades may be built concurrently
+    mutable boost::shared_mutex mutex_;
 };
 
 //! Leg builder
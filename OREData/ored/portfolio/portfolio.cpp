@@ -25,10 +25,15 @@
 #include <ored/portfolio/swap.hpp>
 #include <ored/portfolio/swaption.hpp>
 #include <ored/utilities/log.hpp>
+#include <ored/utilities/parallel.hpp>
+#include <ored/utilities/profiler.hpp>
 #include <ored/utilities/xmlutils.hpp>
 #include <ql/errors.hpp>
 #include <ql/time/date.hpp>
 
+#include <exception>
+#include <functional>
+
 using namespace QuantLib;
 using namespace std;
 
@@ -49,48 +54,84 @@ void Portfolio::reset() {
 }
 
 void Portfolio::fromXML(XMLNode* node) {
+    ORE_PROFILE_SCOPE("Portfolio::fromXML");
     XMLUtils::checkNode(node, "Portfolio");
     vector<XMLNode*> nodes = XMLUtils::getChildrenNodes(node, "Trade");
-    for (Size i = 0; i < nodes.size(); i++) {
-        string tradeType = XMLUtils::getChildValue(nodes[i], "TradeType", true);
 
-        // Get the id attribute
-        string id = XMLUtils::getAttribute(nodes[i], "id");
-        QL_REQUIRE(id != "", "No id attribute in Trade Node");
-        DLOG("Parsing trade id:" << id);
-        
+    // Deserialise the trade nodes, possibly on several threads. Each node writes into its own slot only, and the
+    // trades are added below in the order of the document, so the outcome does not depend on the scheduling.
+    struct ParsedTrade {
+        string tradeType, id;
         QuantLib::ext::shared_ptr<Trade> trade;
-        bool failedToLoad = true;
+        string error;
+        std::exception_ptr fatal;
+    };
+    vector<ParsedTrade> parsed(nodes.size());
+
+    auto parse = [&nodes, &parsed](Size i) {
+        ParsedTrade& p = parsed[i];
+        try {
+            p.tradeType = XMLUtils::getChildValue(nodes[i], "TradeType", true);
+            // Get the id attribute
+            p.id = XMLUtils::getAttribute(nodes[i], "id");
+            QL_REQUIRE(p.id != "", "No id attribute in Trade Node");
+        } catch (...) {
+            p.fatal = std::current_exception();
+            return;
+        }
+        DLOG("Parsing trade id:" << p.id);
         try {
-            trade = TradeFactory::instance().build(tradeType);
+            auto trade = TradeFactory::instance().build(p.tradeType);
             trade->fromXML(nodes[i]);
-            trade->id() = id;
-            add(trade);
-            DLOG("Added Trade " << id << " (" << trade->id() << ")"
-                                << " type:" << tradeType);
-            failedToLoad = false;
+            trade->id() = p.id;
+            p.trade = trade;
         } catch (std::exception& ex) {
-            StructuredTradeErrorMessage(id, tradeType, "Error parsing Trade XML", ex.what()).log();
+            p.error = ex.what();
         }
+    };
+
+    if (nThreads_ > 1)
+        DLOG("Parsing " << nodes.size() << " trade nodes using " << nThreads_ << " threads");
+    // parsing does not read fixings, so the index histories are not copied to the worker threads
+    runTasks(nodes.size(), nThreads_, parse, false);
+
+    for (Size i = 0; i < nodes.size(); i++) {
+        ParsedTrade& p = parsed[i];
+        if (p.fatal)
+            std::rethrow_exception(p.fatal);
+
+        bool failedToLoad = true;
+        if (p.trade) {
+            try {
+                add(p.trade);
+                DLOG("Added Trade " << p.id << " (" << p.trade->id() << ")"
+                                    << " type:" << p.tradeType);
+                failedToLoad = false;
+            } catch (std::exception& ex) {
+                p.error = ex.what();
+            }
+        }
+        if (failedToLoad)
+            StructuredTradeErrorMessage(p.id, p.tradeType, "Error parsing Trade XML", p.error).log();
 
         // If trade loading failed, then insert a dummy trade with same id and envelope
         if (failedToLoad && buildFailedTrades_) {
             try {
-                trade = TradeFactory::instance().build("Failed");
+                auto trade = TradeFactory::instance().build("Failed");
                 // this loads only type, id and envelope, but type will be set to the original trade's type
                 trade->fromXML(nodes[i]);
                 // create a dummy trade of type "Dummy"
                 QuantLib::ext::shared_ptr<FailedTrade> failedTrade = QuantLib::ext::make_shared<FailedTrade>();
                 // copy id and envelope
-                failedTrade->id() = id;
-                failedTrade->setUnderlyingTradeType(tradeType);
+                failedTrade->id() = p.id;
+                failedTrade->setUnderlyingTradeType(p.tradeType);
                 failedTrade->setEnvelope(trade->envelope());
                 // and add it to the portfolio
                 add(failedTrade);
                 WLOG("Added trade id " << failedTrade->id() << " type " << failedTrade->tradeType()
                                        << " for original trade type " << trade->tradeType());
             } catch (std::exception& ex) {
-                StructuredTradeErrorMessage(id, tradeType, "Error parsing type and envelope", ex.what()).log();
+                StructuredTradeErrorMessage(p.id, p.tradeType, "Error parsing type and envelope", ex.what()).log();
             }
         }
     }
@@ -121,22 +162,53 @@ void Portfolio::removeMatured(const Date& asof) {
 }
 
 void Portfolio::build(const QuantLib::ext::shared_ptr<EngineFactory>& engineFactory, const std::string& context,
-                      const bool emitStructuredError) {
+                      const bool emitStructuredError, const Size nThreads) {
+    ORE_PROFILE_SCOPE("Portfolio::build", context);
     LOG("Building Portfolio of size " << trades_.size() << " for context = '" << context << "'");
-    auto trade = trades_.begin();
     Size initialSize = trades_.size();
     Size failedTrades = 0;
-    while (trade != trades_.end()) {
-        auto [ft, success] = buildTrade((*trade).second, engineFactory, context, ignoreTradeBuildFail(),
-                                        buildFailedTrades(), emitStructuredError);
+
+    Size effThreads = std::min(nThreads, trades_.size());
+#if !defined(QL_ENABLE_SESSIONS) || !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+    if (effThreads > 1) {
+        DLOG("Building trades sequentially, a concurrent build requires QL_ENABLE_SESSIONS and "
+             "QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN");
+        effThreads = 1;
+    }
+#endif
+    if (effThreads > 1) {
+        std::set<std::string> tradeTypes;
+        for (auto const& [id, t] : trades_)
+            tradeTypes.insert(t->tradeType());
+        if (!engineFactory->consistentBuilderParameters(tradeTypes)) {
+            DLOG("Building trades sequentially, engine builders are shared by trade types with different parameters");
+            effThreads = 1;
+        } else {
+            DLOG("Building trades using " << effThreads << " threads");
+        }
+    }
+
+    // each trade writes its build result into its own slot, the portfolio is updated afterwards in the trade order
+    std::vector<std::map<std::string, QuantLib::ext::shared_ptr<Trade>>::iterator> trades;
+    trades.reserve(trades_.size());
+    for (auto t = trades_.begin(); t != trades_.end(); ++t)
+        trades.push_back(t);
+    std::vector<std::pair<QuantLib::ext::shared_ptr<Trade>, bool>> results(trades.size());
+    runTasks(trades.size(), effThreads, [&](Size i) {
+        ORE_PROFILE_SCOPE("Trade::build", Profiler::enabled() ? trades[i]->second->tradeType() : std::string());
+        results[i] = buildTrade(trades[i]->second, engineFactory, context, ignoreTradeBuildFail(), buildFailedTrades(),
+                                emitStructuredError);
+    });
+
+    for (Size i = 0; i < trades.size(); ++i) {
+        auto& [ft, success] = results[i];
         if (success) {
-            ++trade;
+            continue;
         } else if (ft) {
-            (*trade).second = ft;
+            trades[i]->second = ft;
             ++failedTrades;
-            ++trade;
         } else {
-            trade = trades_.erase(trade);
+            trades_.erase(trades[i]);
         }
     }
     LOG("Built Portfolio. Initial size = " << initialSize << ", size now " << trades_.size() << ", built "
@@ -43,9 +43,10 @@ class ReferenceDataManager;
 */
 class Portfolio : public XMLSerializable {
 public:
-    //! Default constructor
-    explicit Portfolio(bool buildFailedTrades = true, bool ignoreTradeBuildFail = false)
-        : buildFailedTrades_(buildFailedTrades), ignoreTradeBuildFail_(ignoreTradeBuildFail) {}
+    /*! Default constructor, trade nodes are deserialised on \p nThreads threads in fromXML(), the trades are added
+        in the order of the document in any case */
+    explicit Portfolio(bool buildFailedTrades = true, bool ignoreTradeBuildFail = false, QuantLib::Size nThreads = 1)
+        : buildFailedTrades_(buildFailedTrades), ignoreTradeBuildFail_(ignoreTradeBuildFail), nThreads_(nThreads) {}
 
     //! Add a trade to the portfolio
     void add(const QuantLib::ext::shared_ptr<Trade>& trade);
@@ -80,9 +81,20 @@ public:
     //! Remove matured trades from portfolio for a given date, each removal is logged with an Alert
     void removeMatured(const QuantLib::Date& asof);
 
-    //! Call build on all trades in the portfolio, the context is included in error messages
+    /*! Call build on all trades in the portfolio, the context is included in error messages
+
+        If \p nThreads is greater than one, the trades are built concurrently against the same engine factory and
+        market. This requires a QuantLib build with QL_ENABLE_SESSIONS, so that each worker thread has its own
+        evaluation date and fixings, which are copied from the calling thread, and with
+        QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN, since the trades register with shared market objects. The market
+        must be fully built, i.e. not built lazily on request. Otherwise, or if trade types sharing an engine builder
+        have different engine parameters, the trades are built sequentially.
+
+        \note The ORE analytics always build their portfolios sequentially, since their markets can be built lazily.
+              The concurrent build is available to applications which manage their markets themselves.
+    */
     void build(const QuantLib::ext::shared_ptr<EngineFactory>&, const std::string& context = "unspecified",
-               const bool emitStructuredError = true);
+               const bool emitStructuredError = true, const QuantLib::Size nThreads = 1);
 
     //! Calculates the maturity of the portfolio
     QuantLib::Date maturity() const;
@@ -114,6 +126,9 @@ public:
     //! Keep trade in the portfolio even after build fail
     bool ignoreTradeBuildFail() const { return ignoreTradeBuildFail_; }
 
+    //! Number of threads used to deserialise trades
+    QuantLib::Size nThreads() const { return nThreads_; }
+
     /*! Return the fixings that will be requested in order to price every Trade in this Portfolio given
         the \p settlementDate. The map key is the ORE name of the index and the map value is the set of fixing dates.
 
@@ -131,6 +146,7 @@ public:
 
 private:
     bool buildFailedTrades_, ignoreTradeBuildFail_;
+    QuantLib::Size nThreads_;
     std::map<std::string, QuantLib::ext::shared_ptr<Trade>> trades_;
     std::map<AssetClass, std::set<std::string>> underlyingIndicesCache_;
 };
@@ -45,18 +45,29 @@ void ScriptedTrade::build(const QuantLib::ext::shared_ptr<EngineFactory>& engine
     auto builder = QuantLib::ext::dynamic_pointer_cast<ScriptedTradeEngineBuilder>(engineFactory->builder("ScriptedTrade"));
 
     QL_REQUIRE(builder, "no builder found for ScriptedTrade");
-    auto engine = builder->engine(id(), *this, engineFactory->referenceData(), engineFactory->iborFallbackConfig());
 
-    simmProductClass_ = builder->simmProductClass();
-    scheduleProductClass_ = builder->scheduleProductClass();
+    // the builder holds the results of the last engine() call, read them under its lock
+    QuantLib::ext::shared_ptr<QuantExt::ScriptedInstrument::engine> engine;
+    Date lastRelevantDate;
+    std::map<std::string, std::set<Date>> fixings;
+    std::string sensitivityTemplate;
+    {
+        std::lock_guard<std::recursive_mutex> lock(builder->mutex());
+        engine = builder->engine(id(), *this, engineFactory->referenceData(), engineFactory->iborFallbackConfig());
+        simmProductClass_ = builder->simmProductClass();
+        scheduleProductClass_ = builder->scheduleProductClass();
+        npvCurrency_ = builder->npvCurrency();
+        lastRelevantDate = builder->lastRelevantDate();
+        fixings = builder->fixings();
+        sensitivityTemplate = builder->sensitivityTemplate();
+    }
 
     setIsdaTaxonomyFields();
 
-    auto qleInstr = QuantLib::ext::make_shared<ScriptedInstrument>(builder->lastRelevantDate());
+    auto qleInstr = QuantLib::ext::make_shared<ScriptedInstrument>(lastRelevantDate);
     qleInstr->setPricingEngine(engine);
 
-    npvCurrency_ = builder->npvCurrency();
-    maturity_ = builder->lastRelevantDate();
+    maturity_ = lastRelevantDate;
     notional_ = Null<Real>(); // is handled by override of notional()
     notionalCurrency_ = "";   // is handled by override of notionalCurrency()
     legs_.clear();
@@ -72,7 +83,7 @@ void ScriptedTrade::build(const QuantLib::ext::shared_ptr<EngineFactory>& engine
     instrument_ = QuantLib::ext::make_shared<VanillaInstrument>(qleInstr, 1.0, additionalInstruments, additionalMultipliers);
     
     // add required fixings
-    for (auto const& f : builder->fixings()) {
+    for (auto const& f : fixings) {
         for (auto const& d : f.second) {
             IndexInfo info(f.first);
             if (info.isInf()) {
@@ -92,7 +103,7 @@ void ScriptedTrade::build(const QuantLib::ext::shared_ptr<EngineFactory>& engine
     }
 
     // set sensitivity template
-    setSensitivityTemplate(builder->sensitivityTemplate());
+    setSensitivityTemplate(sensitivityTemplate);
 }
 
 void ScriptedTrade::build(const QuantLib::ext::shared_ptr<EngineFactory>& engineFactory) {
@@ -18,26 +18,75 @@
 */
 
 #include <ored/report/inmemoryreport.hpp>
-#include <ored/utilities/serializationdate.hpp>
-#include <ored/utilities/serializationperiod.hpp>
 
 #include <boost/algorithm/string/join.hpp>
-#include <boost/serialization/serialization.hpp>
-#include <boost/serialization/vector.hpp>
-#include <boost/serialization/variant.hpp>
-#include <boost/archive/binary_oarchive.hpp>
-#include <boost/archive/binary_iarchive.hpp>
 
+#include <cstdio>
 #include <fstream>
+#include <limits>
 
 namespace ore {
 namespace data {
 
+namespace {
+
+template <class T> void writeRaw(std::ostream& os, const T* data, Size n) {
+    if (n > 0)
+        os.write(reinterpret_cast<const char*>(data), n * sizeof(T));
+}
+
+template <class T> void readRaw(std::istream& is, T* data, Size n) {
+    if (n > 0)
+        is.read(reinterpret_cast<char*>(data), n * sizeof(T));
+}
+
+void writeSize(std::ostream& os, Size n) {
+    std::uint64_t tmp = n;
+    writeRaw(os, &tmp, 1);
+}
+
+Size readSize(std::istream& is) {
+    std::uint64_t tmp;
+    readRaw(is, &tmp, 1);
+    return static_cast<Size>(tmp);
+}
+
+} // namespace
+
+Size InMemoryReport::Column::size(int which) const {
+    switch (which) {
+    case 0:
+        return sizes.size();
+    case 1:
+        return reals.size();
+    case 2:
+        return strings.size();
+    case 3:
+        return dates.size();
+    case 4:
+        return periods.size();
+    default:
+        QL_FAIL("InMemoryReport: unexpected column type " << which);
+    }
+}
+
+void InMemoryReport::Column::clear() {
+    sizes.clear();
+    reals.clear();
+    strings.clear();
+    dates.clear();
+    periods.clear();
+}
+
+InMemoryReport::SpillFile::~SpillFile() { std::remove(name.c_str()); }
+
 Report& InMemoryReport::addColumn(const string& name, const ReportType& rt, Size precision) {
+    QL_REQUIRE(files_.empty(), "InMemoryReport: cannot add column '" << name << "' after rows were spilled to disk");
     headers_.push_back(name);
     columnTypes_.push_back(rt);
     columnPrecision_.push_back(precision);
-    data_.push_back(vector<ReportType>()); // Initialise vector for column
+    data_.columns.push_back(Column()); // Initialise storage for column
+    dataCache_.push_back(nullptr);
     i_++;
     return *this;
 }
@@ -46,18 +95,112 @@ Report& InMemoryReport::next() {
     QL_REQUIRE(i_ == headers_.size(), "Cannot go to next line, only " << i_ << " entries filled, report headers are: "
                                                                       << boost::join(headers_, ","));
     i_ = 0;
-    if (bufferSize_ && data_[0].size() == bufferSize_ && !headers_.empty()) {
-        std::string s = std::tmpnam(nullptr);
-        std::ofstream os(s.c_str(), std::ios::binary);
-        boost::archive::binary_oarchive oa(os, boost::archive::no_header);
-        for (Size i = 0; i < headers_.size(); i++) {
-            oa << data_[i];
-            data_[i].clear();
+    if (bufferSize_ && !headers_.empty() && data_.columns[0].size(columnTypes_[0].which()) == bufferSize_)
+        spill();
+    return *this;
+}
+
+void InMemoryReport::spill() {
+    // value() relies on every segment holding the same number of rows for all columns
+    for (Size i = 0; i < headers_.size(); ++i) {
+        Size n = data_.columns[i].size(columnTypes_[i].which());
+        QL_REQUIRE(n == bufferSize_, "InMemoryReport: column " << headers_[i] << " has " << n
+                                                               << " rows when spilling to disk, expected "
+                                                               << bufferSize_);
+    }
+
+    auto file = QuantLib::ext::make_shared<SpillFile>(std::tmpnam(nullptr));
+    std::ofstream os(file->name.c_str(), std::ios::binary);
+    QL_REQUIRE(os.is_open(), "InMemoryReport: could not open spill file '" << file->name << "'");
+
+    // string dictionary of the segment
+    writeSize(os, data_.dictionary.size());
+    for (auto const& s : data_.dictionary) {
+        writeSize(os, s.size());
+        writeRaw(os, s.data(), s.size());
+    }
+
+    // column data, dates are written as serial numbers (0 = null date), periods as length and units
+    for (Size i = 0; i < headers_.size(); ++i) {
+        Column& c = data_.columns[i];
+        int w = columnTypes_[i].which();
+        Size n = c.size(w);
+        writeSize(os, n);
+        if (w == 0) {
+            vector<std::uint64_t> tmp(c.sizes.begin(), c.sizes.end());
+            writeRaw(os, tmp.data(), n);
+        } else if (w == 1) {
+            writeRaw(os, c.reals.data(), n);
+        } else if (w == 2) {
+            writeRaw(os, c.strings.data(), n);
+        } else if (w == 3) {
+            vector<std::int32_t> tmp(n);
+            for (Size j = 0; j < n; ++j)
+                tmp[j] = c.dates[j] == Date() ? 0 : static_cast<std::int32_t>(c.dates[j].serialNumber());
+            writeRaw(os, tmp.data(), n);
+        } else if (w == 4) {
+            vector<std::int32_t> tmp(2 * n);
+            for (Size j = 0; j < n; ++j) {
+                tmp[2 * j] = c.periods[j].length();
+                tmp[2 * j + 1] = static_cast<std::int32_t>(c.periods[j].units());
+            }
+            writeRaw(os, tmp.data(), 2 * n);
         }
-        os.close();
-        files_.push_back(s);
+        file->columnSizes.push_back(n);
+        c.clear();
     }
-    return *this;
+    os.close();
+    QL_REQUIRE(!os.fail(), "InMemoryReport: error while writing spill file '" << file->name << "'");
+
+    data_.dictionary.clear();
+    dictionaryIndex_.clear();
+    files_.push_back(file);
+}
+
+void InMemoryReport::load(Segment& segment, const SpillFile& file) const {
+    std::ifstream is(file.name.c_str(), std::ios::binary);
+    QL_REQUIRE(is.is_open(), "InMemoryReport: could not open spill file '" << file.name << "'");
+
+    segment.dictionary.resize(readSize(is));
+    for (auto& s : segment.dictionary) {
+        s.resize(readSize(is));
+        readRaw(is, &s[0], s.size());
+    }
+
+    segment.columns.resize(headers_.size());
+    for (Size i = 0; i < headers_.size(); ++i) {
+        Column& c = segment.columns[i];
+        c.clear();
+        Size n = readSize(is);
+        QL_REQUIRE(n == file.columnSizes[i], "InMemoryReport: spill file '" << file.name << "' contains " << n
+                                                 << " rows for column " << headers_[i] << ", expected "
+                                                 << file.columnSizes[i]);
+        int w = columnTypes_[i].which();
+        if (w == 0) {
+            vector<std::uint64_t> tmp(n);
+            readRaw(is, tmp.data(), n);
+            c.sizes.assign(tmp.begin(), tmp.end());
+        } else if (w == 1) {
+            c.reals.resize(n);
+            readRaw(is, c.reals.data(), n);
+        } else if (w == 2) {
+            c.strings.resize(n);
+            readRaw(is, c.strings.data(), n);
+        } else if (w == 3) {
+            vector<std::int32_t> tmp(n);
+            readRaw(is, tmp.data(), n);
+            c.dates.resize(n);
+            for (Size j = 0; j < n; ++j)
+                c.dates[j] = tmp[j] == 0 ? Date() : Date(static_cast<Date::serial_type>(tmp[j]));
+        } else if (w == 4) {
+            vector<std::int32_t> tmp(2 * n);
+            readRaw(is, tmp.data(), 2 * n);
+            c.periods.resize(n);
+            for (Size j = 0; j < n; ++j)
+                c.periods[j] = Period(tmp[2 * j], static_cast<QuantLib::TimeUnit>(tmp[2 * j + 1]));
+        }
+    }
+    QL_REQUIRE(!is.fail(), "InMemoryReport: error while reading spill file '" << file.name << "'");
 }
 
 Report& InMemoryReport::add(const ReportType& rt) {
@@ -68,7 +211,36 @@ Report& InMemoryReport::add(const ReportType& rt) {
                                                            << headers_[i_] << " of type " << columnTypes_[i_].which()
                                                            << ", report headers are: " << boost::join(headers_, ","));
 
-    data_[i_].push_back(rt);
+    Column& c = data_.columns[i_];
+    switch (rt.which()) {
+    case 0:
+        c.sizes.push_back(boost::get<Size>(rt));
+        break;
+    case 1:
+        c.reals.push_back(boost::get<Real>(rt));
+        break;
+    case 2: {
+        const string& s = boost::get<string>(rt);
+        auto it = dictionaryIndex_.find(s);
+        if (it == dictionaryIndex_.end()) {
+            QL_REQUIRE(data_.dictionary.size() < std::numeric_limits<std::uint32_t>::max(),
+                       "InMemoryReport: string dictionary is full, use a smaller buffer size");
+            it = dictionaryIndex_.emplace(s, static_cast<std::uint32_t>(data_.dictionary.size())).first;
+            data_.dictionary.push_back(s);
+        }
+        c.strings.push_back(it->second);
+        break;
+    }
+    case 3:
+        c.dates.push_back(boost::get<Date>(rt));
+        break;
+    case 4:
+        c.periods.push_back(boost::get<Period>(rt));
+        break;
+    default:
+        QL_FAIL("InMemoryReport: unexpected value type " << rt.which());
+    }
+    dataCache_[i_] = nullptr;
     i_++;
     return *this;
 }
@@ -91,7 +263,7 @@ Report& InMemoryReport::add(const InMemoryReport& report) {
         
     for (Size rowIdx = 0; rowIdx < report.rows(); rowIdx++) {
         for (Size columnIdx = 0; columnIdx < report.columns(); columnIdx++) {
-            add(report.data(columnIdx)[rowIdx]);
+            add(report.value(columnIdx, rowIdx));
         }
         next();
     }
@@ -105,14 +277,64 @@ void InMemoryReport::end() {
                                                      << ", report headers are: " << boost::join(headers_, ","));
 }
 
+Size InMemoryReport::rows(Size column) const {
+    Size n = data_.columns[column].size(columnTypes_[column].which());
+    for (auto const& f : files_)
+        n += f->columnSizes[column];
+    return n;
+}
+
+Report::ReportType InMemoryReport::value(const Segment& segment, Size column, Size row) const {
+    const Column& c = segment.columns[column];
+    switch (columnTypes_[column].which()) {
+    case 0:
+        return c.sizes[row];
+    case 1:
+        return c.reals[row];
+    case 2:
+        return segment.dictionary[c.strings[row]];
+    case 3:
+        return c.dates[row];
+    case 4:
+        return c.periods[row];
+    default:
+        QL_FAIL("InMemoryReport: unexpected column type " << columnTypes_[column].which());
+    }
+}
+
+Report::ReportType InMemoryReport::value(Size column, Size row) const {
+    QL_REQUIRE(column < columns(), "InMemoryReport::value(): column " << column << " out of range, report has "
+                                                                      << columns() << " columns");
+    // each spilled segment holds exactly bufferSize_ rows of every column
+    Size offset = files_.size() * bufferSize_;
+    if (row < offset) {
+        Size k = row / bufferSize_;
+        if (loadedFile_ != k) {
+            load(loaded_, *files_[k]);
+            loadedFile_ = k;
+        }
+        return value(loaded_, column, row - k * bufferSize_);
+    }
+    QL_REQUIRE(row - offset < data_.columns[column].size(columnTypes_[column].which()),
+               "InMemoryReport::value(): row " << row << " out of range for column " << header(column) << ", have "
+                                               << rows(column) << " rows");
+    return value(data_, column, row - offset);
+}
+
 const vector<Report::ReportType>& InMemoryReport::data(Size i) const {
-    QL_REQUIRE(files_.empty(), "Member function InMemoryReport::data() is not supported "
-        "when buffering is active");
-    QL_REQUIRE(data_[i].size() == rows(), "internal error: report column "
-                                              << i << " (" << header(i) << ") contains " << data_[i].size()
-                                              << " rows, expected are " << rows()
-                                              << " rows, report headers are: " << boost::join(headers_, ","));
-    return data_[i];
+    QL_REQUIRE(rows(i) == rows(), "internal error: report column "
+                                      << i << " (" << header(i) << ") contains " << rows(i)
+                                      << " rows, expected are " << rows()
+                                      << " rows, report headers are: " << boost::join(headers_, ","));
+    if (!dataCache_[i]) {
+        auto d = QuantLib::ext::make_shared<vector<ReportType>>();
+        Size n = rows(i);
+        d->reserve(n);
+        for (Size j = 0; j < n; ++j)
+            d->push_back(value(i, j));
+        dataCache_[i] = d;
+    }
+    return *dataCache_[i];
 }
 
 void InMemoryReport::toFile(const string& filename, const char sep, const bool commentCharacter, char quoteChar,
@@ -127,31 +349,24 @@ void InMemoryReport::toFile(const string& filename, const char sep, const bool c
     auto numColumns = columns();
     if (numColumns > 0) {
 
-        for (auto &f : files_) {
-            vector<vector<ReportType>> data(numColumns);
-            std::ifstream is(f.c_str(), std::ios::binary);
-            boost::archive::binary_iarchive ia(is, boost::archive::no_header);
-            for (Size i = 0; i < numColumns; i++) {
-                ia >> data[i];
-            }
-            is.close();
-
-            for (Size i = 0; i < data[0].size(); i++) {
+        auto write = [this, &cReport, numColumns](const Segment& segment) {
+            Size numRows = segment.columns[0].size(columnTypes_[0].which());
+            for (Size i = 0; i < numRows; i++) {
                 cReport.next();
                 for (Size j = 0; j < numColumns; j++) {
-                    cReport.add(data[j][i]);
+                    cReport.add(value(segment, j, i));
                 }
             }
-        }
+        };
 
-        auto numRows = data_[0].size();
-
-        for (Size i = 0; i < numRows; i++) {
-            cReport.next();
-            for (Size j = 0; j < numColumns; j++) {
-                cReport.add(data_[j][i]);
-            }
+        // read the spilled segments one at a time
+        Segment segment;
+        for (auto const& f : files_) {
+            load(segment, *f);
+            write(segment);
         }
+
+        write(data_);
     }
 
     cReport.end();
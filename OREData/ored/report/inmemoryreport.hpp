@@ -27,7 +27,12 @@
 #include <ored/report/csvreport.hpp>
 #include <ored/report/report.hpp>
 #include <ql/errors.hpp>
+#include <ql/shared_ptr.hpp>
 #include <ql/tuple.hpp>
+#include <ql/utilities/null.hpp>
+
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace ore {
@@ -35,13 +40,17 @@ namespace data {
 using std::string;
 using std::vector;
 
-/*! InMemoryReport just stores report information in local vectors and provides an interface to access
+/*! InMemoryReport stores report information column by column and provides an interface to access
  *  the values. It could be used as a backend to a GUI
+
+ Each column holds a contiguous vector of its declared type, string values are dictionary encoded. If a
+ buffer size is given, the rows are spilled to binary segment files whenever the number of rows held in memory
+ reaches the buffer size. The segment files are removed when the last copy of the report is destroyed.
  \ingroup report
  */
 class InMemoryReport : public Report {
 public:
-    explicit InMemoryReport(Size bufferSize=100000) : i_(0), bufferSize_(bufferSize) {}
+    explicit InMemoryReport(Size bufferSize=100000) : i_(0), bufferSize_(bufferSize), loadedFile_(QuantLib::Null<Size>()) {}
 
     Report& addColumn(const string& name, const ReportType& rt, Size precision = 0) override;
     Report& next() override;
@@ -51,25 +60,61 @@ public:
 
     // InMemoryInterface
     Size columns() const { return headers_.size(); }
-    Size rows() const { return columns() == 0 ? 0 : files_.size() * bufferSize_ + data_[0].size(); }
+    Size rows() const { return columns() == 0 ? 0 : rows(0); }
     const string& header(Size i) const { return headers_[i]; }
     bool hasHeader(string h) const { return std::find(headers_.begin(), headers_.end(), h) != headers_.end(); }
     ReportType columnType(Size i) const { return columnTypes_[i]; }
     Size columnPrecision(Size i) const { return columnPrecision_[i]; }
-    //! Returns the data
+    //! Returns the value in the given column and row, reading spilled rows back from the segment files if required
+    ReportType value(Size column, Size row) const;
+    /*! Returns the data of column i. The column is materialised as a vector of variants on first access, prefer
+        value() for large reports. */
     const vector<ReportType>& data(Size i) const;
     void toFile(const string& filename, const char sep = ',', const bool commentCharacter = true, char quoteChar = '\0',
                 const string& nullString = "#N/A", bool lowerHeader = false);
     void jumpToColumn(Size i) { i_ = i; }
 
 private:
+    //! typed storage of a single column, only the vector matching the column type is used
+    struct Column {
+        vector<Size> sizes;
+        vector<Real> reals;
+        vector<std::uint32_t> strings;
+        vector<Date> dates;
+        vector<Period> periods;
+        Size size(int which) const;
+        void clear();
+    };
+    //! a set of columns with the dictionary for their string values
+    struct Segment {
+        vector<Column> columns;
+        vector<string> dictionary;
+    };
+    //! a binary spill file, removed from disk on destruction
+    struct SpillFile {
+        explicit SpillFile(const string& name) : name(name) {}
+        ~SpillFile();
+        string name;
+        vector<Size> columnSizes;
+    };
+
+    Size rows(Size column) const;
+    ReportType value(const Segment& segment, Size column, Size row) const;
+    void spill();
+    void load(Segment& segment, const SpillFile& file) const;
+
     Size i_;
     Size bufferSize_;
     vector<string> headers_;
     vector<ReportType> columnTypes_;
     vector<Size> columnPrecision_;
-    vector<vector<ReportType>> data_;
-    vector<string> files_;
+    Segment data_;
+    std::unordered_map<string, std::uint32_t> dictionaryIndex_;
+    vector<QuantLib::ext::shared_ptr<SpillFile>> files_;
+    // the most recently read spill file and the materialised columns returned by data()
+    mutable Size loadedFile_;
+    mutable Segment loaded_;
+    mutable vector<QuantLib::ext::shared_ptr<vector<ReportType>>> dataCache_;
 };
 
 //! InMemoryReport with access to plain types instead of boost::variant<>, to facilitate language bindings
@@ -88,12 +133,12 @@ public:
     vector<Date> dataAsDate(Size i) const { return data_T<Date>(i, 3); }
     vector<Period> dataAsPeriod(Size i) const { return data_T<Period>(i, 4); }
     // for convenience, access by row j and column i
-    Size rows() const { return columns() == 0 ? 0 : imReport_->data(0).size(); }
-    int dataAsSize(Size j, Size i) const { return int(boost::get<Size>(imReport_->data(i).at(j))); }
-    Real dataAsReal(Size j, Size i) const { return boost::get<Real>(imReport_->data(i).at(j)); }
-    string dataAsString(Size j, Size i) const { return boost::get<string>(imReport_->data(i).at(j)); }
-    Date dataAsDate(Size j, Size i) const { return boost::get<Date>(imReport_->data(i).at(j)); }
-    Period dataAsPeriod(Size j, Size i) const { return boost::get<Period>(imReport_->data(i).at(j)); }
+    Size rows() const { return imReport_->rows(); }
+    int dataAsSize(Size j, Size i) const { return int(boost::get<Size>(imReport_->value(i, j))); }
+    Real dataAsReal(Size j, Size i) const { return boost::get<Real>(imReport_->value(i, j)); }
+    string dataAsString(Size j, Size i) const { return boost::get<string>(imReport_->value(i, j)); }
+    Date dataAsDate(Size j, Size i) const { return boost::get<Date>(imReport_->value(i, j)); }
+    Period dataAsPeriod(Size j, Size i) const { return boost::get<Period>(imReport_->value(i, j)); }
 
 private:
     template <typename T> vector<T> data_T(Size i, Size w) const {
@@ -101,8 +146,10 @@ private:
                    "PlainTypeInMemoryReport::data_T(column=" << i << ",expectedType=" << w
                    << "): Type mismatch, have " << columnType(i));
         vector<T> tmp;
-        for(auto const& d: imReport_->data(i))
-            tmp.push_back(boost::get<T>(d));
+        Size n = imReport_->rows();
+        tmp.reserve(n);
+        for (Size j = 0; j < n; ++j)
+            tmp.push_back(boost::get<T>(imReport_->value(i, j)));
         return tmp;
     }
     vector<int> sizeToInt(const vector<Size>& v) const {
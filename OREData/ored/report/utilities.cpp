@@ -40,7 +40,7 @@ addColumnToExisitingReport(const std::string& columnName, const std::string& val
             newReport->next();
             newReport->add(value);
             for (size_t col = 0; col < report->columns(); col++) {
-                newReport->add(report->data(col)[row]);
+                newReport->add(report->value(col, row));
             }
         }
         newReport->end();
@@ -65,10 +65,10 @@ addColumnsToExisitingReport(const QuantLib::ext::shared_ptr<ore::data::InMemoryR
         for (size_t row = 0; row < report->rows(); row++) {
             newReport->next();
             for (size_t i = 0; i < newColsReport->columns(); ++i) {
-                newReport->add(newColsReport->data(i)[0]);
+                newReport->add(newColsReport->value(i, 0));
             }
             for (size_t col = 0; col < report->columns(); col++) {
-                newReport->add(report->data(col)[row]);
+                newReport->add(report->value(col, row));
             }
         }
         newReport->end();
@@ -0,0 +1,95 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <ored/utilities/parallel.hpp>
+
+#include <ql/indexes/indexmanager.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+using namespace QuantLib;
+
+namespace ore {
+namespace data {
+
+SessionState::SessionState(const bool withFixings) {
+#ifdef QL_ENABLE_SESSIONS
+    evaluationDate_ = Settings::instance().evaluationDate();
+    includeReferenceDateEvents_ = Settings::instance().includeReferenceDateEvents();
+    includeTodaysCashFlows_ = Settings::instance().includeTodaysCashFlows();
+    enforcesTodaysHistoricFixings_ = Settings::instance().enforcesTodaysHistoricFixings();
+    if (withFixings) {
+        for (auto const& name : IndexManager::instance().histories())
+            fixings_[name] = IndexManager::instance().getHistory(name);
+    }
+#endif
+}
+
+void SessionState::apply() const {
+#ifdef QL_ENABLE_SESSIONS
+    Settings::instance().evaluationDate() = evaluationDate_;
+    Settings::instance().includeReferenceDateEvents() = includeReferenceDateEvents_;
+    Settings::instance().includeTodaysCashFlows() = includeTodaysCashFlows_;
+    Settings::instance().enforcesTodaysHistoricFixings() = enforcesTodaysHistoricFixings_;
+    for (auto const& [name, history] : fixings_)
+        IndexManager::instance().setHistory(name, history);
+#endif
+}
+
+void runTasks(const Size n, const Size nThreads, const std::function<void(Size)>& task, const bool withFixings) {
+
+    const Size nWorkers = std::min(nThreads, n);
+    if (nWorkers <= 1) {
+        for (Size i = 0; i < n; ++i)
+            task(i);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(n);
+    std::atomic<Size> next(0);
+    const SessionState sessionState(withFixings);
+
+    auto job = [n, &task, &errors, &next, &sessionState]() {
+        sessionState.apply();
+        for (Size i = next++; i < n; i = next++) {
+            try {
+                task(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> jobs;
+    for (Size t = 0; t < nWorkers; ++t)
+        jobs.emplace_back(job);
+    for (auto& t : jobs)
+        t.join();
+
+    for (auto const& e : errors) {
+        if (e)
+            std::rethrow_exception(e);
+    }
+}
+
+} // namespace data
+} // namespace ore
@@ -0,0 +1,73 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file ored/utilities/parallel.hpp
+    \brief Run independent tasks on worker threads
+    \ingroup utilities
+*/
+
+#pragma once
+
+#include <ql/settings.hpp>
+#include <ql/timeseries.hpp>
+#include <ql/types.hpp>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <type_traits>
+
+namespace ore {
+namespace data {
+
+//! The session dependent singleton state of the calling thread
+/*! With QL_ENABLE_SESSIONS each thread has its own Settings and IndexManager, so worker threads start from a copy
+    of the caller's state. The copy holds the evaluation date, the Settings flags and, optionally, the fixings of
+    the IndexManager. Without sessions the singletons are shared by all threads and nothing is copied.
+
+    \ingroup utilities
+*/
+class SessionState {
+public:
+    //! captures the state of the current thread
+    explicit SessionState(const bool withFixings = true);
+    //! sets the state in the current thread
+    void apply() const;
+
+private:
+#ifdef QL_ENABLE_SESSIONS
+    QuantLib::Date evaluationDate_;
+    bool includeReferenceDateEvents_ = false;
+    std::decay_t<decltype(QuantLib::Settings::instance().includeTodaysCashFlows())> includeTodaysCashFlows_;
+    bool enforcesTodaysHistoricFixings_ = false;
+    std::map<std::string, QuantLib::TimeSeries<QuantLib::Real>> fixings_;
+#endif
+};
+
+/*! Run task(0), ..., task(n - 1) on up to nThreads worker threads. A task must only write to state it owns. Each
+    worker starts from the SessionState of the calling thread, the fixings are only copied if \p withFixings is
+    true. If a task throws, the remaining tasks are still run and the exception of the task with the lowest index
+    is rethrown. If nThreads <= 1 or n <= 1 the tasks are run in order on the calling thread.
+
+    \ingroup utilities
+*/
+void runTasks(const QuantLib::Size n, const QuantLib::Size nThreads,
+              const std::function<void(QuantLib::Size)>& task, const bool withFixings = true);
+
+} // namespace data
+} // namespace ore
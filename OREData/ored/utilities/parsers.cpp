@@ -1425,6 +1425,16 @@ QuantExt::McMultiLegBaseEngine::RegressorModel parseRegressorModel(const std::st
     }
 }
 
+QuantExt::LgmConvolutionSolver2::Method parseLgmConvolutionSolverMethod(const std::string& s) {
+    if (s == "Direct")
+        return QuantExt::LgmConvolutionSolver2::Method::Direct;
+    else if (s == "FFT")
+        return QuantExt::LgmConvolutionSolver2::Method::FFT;
+    else {
+        QL_FAIL("LGM convolution method '" << s << "' not recognized, expected Direct, FFT");
+    }
+}
+
 MporCashFlowMode parseMporCashFlowMode(const string& s){
     static map<string, MporCashFlowMode> m = {{"Unspecified", MporCashFlowMode::Unspecified},
                                               {"NonePay", MporCashFlowMode::NonePay},
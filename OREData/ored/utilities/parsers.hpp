@@ -36,6 +36,7 @@
 #include <qle/instruments/cdsoption.hpp>
 #include <qle/methods/multipathgeneratorbase.hpp>
 #include <qle/models/crossassetmodel.hpp>
+#include <qle/models/lgmconvolutionsolver2.hpp>
 #include <qle/pricingengines/mcmultilegbaseengine.hpp>
 #include <qle/termstructures/sabrparametricvolatility.hpp>
 
@@ -586,6 +587,12 @@ QuantLib::Pillar::Choice parsePillarChoice(const std::string& s);
 */
 QuantExt::McMultiLegBaseEngine::RegressorModel parseRegressorModel(const std::string& s);
 
+//! Convert text to QuantExt::LgmConvolutionSolver2::Method
+/*!
+\ingroup utilities
+*/
+QuantExt::LgmConvolutionSolver2::Method parseLgmConvolutionSolverMethod(const std::string& s);
+
 enum MporCashFlowMode { Unspecified, NonePay, BothPay, WePay, TheyPay };
 
 //! Convert text to MporCashFlowMode
@@ -0,0 +1,212 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <ored/utilities/profiler.hpp>
+
+#include <ql/errors.hpp>
+#include <ql/utilities/null.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace ore {
+namespace data {
+
+namespace {
+
+// accumulated time of the child scopes of the open scopes on this thread
+thread_local std::vector<double> childTimes;
+
+std::string jsonEscape(const std::string& s) {
+    std::ostringstream os;
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            os << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        else
+            os << c;
+    }
+    return os.str();
+}
+
+} // namespace
+
+std::atomic<bool> Profiler::enabled_(false);
+
+Profiler::Profiler() : epoch_(std::chrono::steady_clock::now()), generation_(0) {}
+
+void Profiler::start() {
+    clear();
+    epoch_ = std::chrono::steady_clock::now();
+    enabled_.store(true);
+}
+
+void Profiler::stop() { enabled_.store(false); }
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.clear();
+    ++generation_;
+}
+
+double Profiler::now() const {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch_).count();
+}
+
+Profiler::ThreadBuffer& Profiler::threadBuffer() {
+    // the buffer is registered with the profiler on first use and again after each clear()
+    thread_local QuantLib::ext::shared_ptr<ThreadBuffer> buffer;
+    thread_local QuantLib::Size generation = QuantLib::Null<QuantLib::Size>();
+    if (!buffer || generation != generation_.load()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer = QuantLib::ext::make_shared<ThreadBuffer>();
+        buffer->thread = buffers_.size() + 1;
+        buffers_.push_back(buffer);
+        generation = generation_.load();
+    }
+    return *buffer;
+}
+
+void Profiler::record(Event&& event) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    event.thread = buffer.thread;
+    buffer.events.push_back(std::move(event));
+}
+
+std::vector<Profiler::Event> Profiler::events() const {
+    std::vector<Event> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto const& b : buffers_) {
+            std::lock_guard<std::mutex> bufferLock(b->mutex);
+            result.insert(result.end(), b->events.begin(), b->events.end());
+        }
+    }
+    std::stable_sort(result.begin(), result.end(), [](const Event& a, const Event& b) {
+        return a.start < b.start || (a.start == b.start && a.depth < b.depth);
+    });
+    return result;
+}
+
+void Profiler::writeChromeTrace(std::ostream& os) const {
+    std::vector<Event> evts = events();
+    std::set<QuantLib::Size> threads;
+    for (auto const& e : evts)
+        threads.insert(e.thread);
+
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (auto t : threads) {
+        os << (first ? "\n" : ",\n");
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t << ",\"args\":{\"name\":\"thread "
+           << t << "\"}}";
+        first = false;
+    }
+    for (auto const& e : evts) {
+        os << (first ? "\n" : ",\n");
+        os << "{\"name\":\"" << jsonEscape(e.name) << "\",\"cat\":\"" << jsonEscape(e.category)
+           << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread << ",\"ts\":" << e.start << ",\"dur\":" << e.duration
+           << "}";
+        first = false;
+    }
+    os << "\n]}\n";
+}
+
+void Profiler::writeChromeTrace(const std::string& fileName) const {
+    std::ofstream os(fileName);
+    QL_REQUIRE(os.is_open(), "Profiler::writeChromeTrace(): could not open file '" << fileName << "'");
+    writeChromeTrace(os);
+    os.close();
+    QL_REQUIRE(!os.fail(), "Profiler::writeChromeTrace(): error while writing file '" << fileName << "'");
+}
+
+void Profiler::writeSummary(Report& report) const {
+    struct Summary {
+        std::string category;
+        QuantLib::Size calls = 0;
+        std::set<QuantLib::Size> threads;
+        double total = 0.0, self = 0.0, min = QL_MAX_REAL, max = 0.0;
+    };
+    std::map<std::string, Summary> summaries;
+    for (auto const& e : events()) {
+        Summary& s = summaries[e.name];
+        s.category = e.category;
+        ++s.calls;
+        s.threads.insert(e.thread);
+        s.total += e.duration;
+        s.self += e.self;
+        s.min = std::min(s.min, e.duration);
+        s.max = std::max(s.max, e.duration);
+    }
+
+    std::vector<std::pair<std::string, Summary>> sorted(summaries.begin(), summaries.end());
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const std::pair<std::string, Summary>& a, const std::pair<std::string, Summary>& b) {
+                         return a.second.total > b.second.total;
+                     });
+
+    report.addColumn("Name", std::string())
+        .addColumn("Category", std::string())
+        .addColumn("Calls", QuantLib::Size())
+        .addColumn("Threads", QuantLib::Size())
+        .addColumn("TotalTime", double(), 6)
+        .addColumn("SelfTime", double(), 6)
+        .addColumn("AverageTime", double(), 6)
+        .addColumn("MinTime", double(), 6)
+        .addColumn("MaxTime", double(), 6);
+    for (auto const& s : sorted) {
+        report.next()
+            .add(s.first)
+            .add(s.second.category)
+            .add(s.second.calls)
+            .add(s.second.threads.size())
+            .add(s.second.total * 1E-6)
+            .add(s.second.self * 1E-6)
+            .add(s.second.total / static_cast<double>(s.second.calls) * 1E-6)
+            .add(s.second.min * 1E-6)
+            .add(s.second.max * 1E-6);
+    }
+    report.end();
+}
+
+void ScopedTimer::begin(const char* name, const std::string& detail, const char* category) {
+    name_ = detail.empty() ? std::string(name) : std::string(name) + " [" + detail + "]";
+    category_ = category;
+    childTimes.push_back(0.0);
+    start_ = Profiler::instance().now();
+}
+
+void ScopedTimer::end() {
+    Profiler& profiler = Profiler::instance();
+    double duration = profiler.now() - start_;
+    double children = childTimes.back();
+    childTimes.pop_back();
+    if (!childTimes.empty())
+        childTimes.back() += duration;
+    profiler.record({std::move(name_), category_, 0, childTimes.size(), start_, duration, duration - children});
+}
+
+} // namespace data
+} // namespace ore
@@ -0,0 +1,144 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file ored/utilities/profiler.hpp
+    \brief Scoped timers with Chrome trace and summary report export
+    \ingroup utilities
+*/
+
+#pragma once
+
+#include <ored/report/report.hpp>
+
+#include <ql/patterns/singleton.hpp>
+#include <ql/shared_ptr.hpp>
+#include <ql/types.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ore {
+namespace data {
+
+//! Collects the timings recorded by ScopedTimer instances
+/*! The profiler is disabled by default, in which case a ScopedTimer does not do anything beyond checking a flag.
+    When enabled, each thread records its events into its own buffer, so that concurrent timers do not contend.
+    The events can be exported as a Chrome trace (chrome://tracing, Perfetto) or aggregated into a summary report.
+
+    \ingroup utilities
+*/
+class Profiler : public QuantLib::Singleton<Profiler, std::integral_constant<bool, true>> {
+    friend class QuantLib::Singleton<Profiler, std::integral_constant<bool, true>>;
+
+public:
+    //! A timed scope, times are in microseconds since the profiler was started
+    struct Event {
+        std::string name;
+        std::string category;
+        QuantLib::Size thread;
+        QuantLib::Size depth;
+        double start;
+        double duration;
+        double self;
+    };
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    //! Clear all recorded events and enable the profiler
+    void start();
+    //! Disable the profiler, the recorded events are kept
+    void stop();
+    //! Remove all recorded events
+    void clear();
+
+    //! The recorded events of all threads, ordered by start time
+    std::vector<Event> events() const;
+
+    //! Write the events in the Chrome trace event format
+    void writeChromeTrace(std::ostream& os) const;
+    void writeChromeTrace(const std::string& fileName) const;
+
+    //! Write the total, self, average, min and max times in seconds per scope name
+    void writeSummary(Report& report) const;
+
+    //! microseconds since the profiler was started
+    double now() const;
+    void record(Event&& event);
+
+private:
+    Profiler();
+
+    struct ThreadBuffer {
+        std::mutex mutex;
+        QuantLib::Size thread;
+        std::vector<Event> events;
+    };
+    ThreadBuffer& threadBuffer();
+
+    static std::atomic<bool> enabled_;
+    std::chrono::steady_clock::time_point epoch_;
+    std::atomic<QuantLib::Size> generation_;
+    mutable std::mutex mutex_;
+    std::vector<QuantLib::ext::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+//! Records the lifetime of the enclosing scope with the Profiler, if the profiler is enabled
+/*! The optional detail (e.g. an analytic type or a report name) is appended to the name of the scope.
+
+    \ingroup utilities
+*/
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const char* name, const char* category = "ore") : active_(Profiler::enabled()) {
+        if (active_)
+            begin(name, std::string(), category);
+    }
+    ScopedTimer(const char* name, const std::string& detail, const char* category = "ore")
+        : active_(Profiler::enabled()) {
+        if (active_)
+            begin(name, detail, category);
+    }
+    ~ScopedTimer() {
+        if (active_)
+            end();
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    void begin(const char* name, const std::string& detail, const char* category);
+    void end();
+
+    bool active_;
+    std::string name_;
+    const char* category_;
+    double start_;
+};
+
+} // namespace data
+} // namespace ore
+
+#define ORE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ORE_PROFILE_CONCAT(a, b) ORE_PROFILE_CONCAT_IMPL(a, b)
+
+//! Time the enclosing scope under the given name
+#define ORE_PROFILE_SCOPE(...) ore::data::ScopedTimer ORE_PROFILE_CONCAT(oreProfileScope_, __LINE__)(__VA_ARGS__)
@@ -19,9 +19,14 @@
 
 #include <boost/make_shared.hpp>
 #include <boost/test/unit_test.hpp>
+#include <ored/portfolio/enginedata.hpp>
+#include <ored/portfolio/enginefactory.hpp>
+#include <ored/portfolio/failedtrade.hpp>
 #include <ored/portfolio/fxforward.hpp>
 #include <ored/portfolio/portfolio.hpp>
 #include <oret/toplevelfixture.hpp>
+#include <sstream>
+#include <test/oredtestmarket.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -120,6 +125,103 @@ BOOST_AUTO_TEST_CASE(testIds) {
     BOOST_CHECK(portfolio->ids() == trade_ids);
 }
 
+BOOST_AUTO_TEST_CASE(testFromXMLMultiThreaded) {
+
+    BOOST_TEST_MESSAGE("Testing portfolio trade deserialisation on several threads...");
+
+    // valid fx forwards, with a trade that does not parse and a duplicate id in between
+    std::ostringstream xml;
+    xml << "<Portfolio>";
+    Size nTrades = 50;
+    for (Size i = 0; i < nTrades; ++i) {
+        string id = i == 20 ? "FXFWD_10" : "FXFWD_" + std::to_string(i);
+        string amount = i == 30 ? "not a number" : std::to_string(1000000 + i);
+        xml << "<Trade id=\"" << id << "\"><TradeType>FxForward</TradeType>"
+            << "<Envelope><CounterParty>CPTY_A</CounterParty><NettingSetId>CPTY_A</NettingSetId></Envelope>"
+            << "<FxForwardData><ValueDate>2026-03-01</ValueDate><BoughtCurrency>EUR</BoughtCurrency>"
+            << "<BoughtAmount>" << amount << "</BoughtAmount><SoldCurrency>USD</SoldCurrency>"
+            << "<SoldAmount>1100000</SoldAmount></FxForwardData></Trade>";
+    }
+    xml << "</Portfolio>";
+
+    Portfolio serial(true, false, 1), parallel(true, false, 4);
+    serial.fromXMLString(xml.str());
+    parallel.fromXMLString(xml.str());
+
+    // the duplicate id is not added a second time, the trade that does not parse is replaced by a failed trade
+    BOOST_REQUIRE_EQUAL(serial.size(), nTrades - 1);
+    BOOST_CHECK(serial.ids() == parallel.ids());
+    for (auto const& [id, trade] : serial.trades()) {
+        auto other = parallel.get(id);
+        BOOST_REQUIRE(other);
+        BOOST_CHECK_EQUAL(trade->tradeType(), other->tradeType());
+    }
+    BOOST_CHECK_EQUAL(parallel.get("FXFWD_30")->tradeType(), "Failed");
+    BOOST_CHECK_EQUAL(QuantLib::ext::dynamic_pointer_cast<FailedTrade>(parallel.get("FXFWD_30"))->underlyingTradeType(),
+                      "FxForward");
+    BOOST_CHECK_EQUAL(parallel.get("FXFWD_10")->tradeType(), "FxForward");
+    auto fwd = QuantLib::ext::dynamic_pointer_cast<FxForward>(parallel.get("FXFWD_10"));
+    BOOST_REQUIRE(fwd);
+    BOOST_CHECK_EQUAL(fwd->boughtAmount(), 1000010.0);
+
+    // a trade node without id aborts the load in either case
+    string noId = "<Portfolio><Trade><TradeType>FxForward</TradeType></Trade></Portfolio>";
+    BOOST_CHECK_THROW(Portfolio(true, false, 4).fromXMLString(noId), QuantLib::Error);
+}
+
+BOOST_AUTO_TEST_CASE(testBuildMultiThreaded) {
+
+    BOOST_TEST_MESSAGE("Testing concurrent portfolio build against a sequential build...");
+#if !defined(QL_ENABLE_SESSIONS) || !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+    BOOST_TEST_MESSAGE("QL_ENABLE_SESSIONS or QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN is not set, the concurrent build "
+                       "falls back to a sequential build");
+#endif
+
+    Date asof(5, Feb, 2016);
+    Settings::instance().evaluationDate() = asof;
+    auto market = QuantLib::ext::make_shared<OredTestMarket>(asof);
+    auto engineData = QuantLib::ext::make_shared<EngineData>();
+    engineData->model("FxForward") = "DiscountedCashflows";
+    engineData->engine("FxForward") = "DiscountingFxForwardEngine";
+
+    // fx forwards against several currencies, the trades selling ZAR fail to build since there is no ZAR curve
+    std::vector<string> currencies = {"USD", "GBP", "CHF", "JPY", "ZAR"};
+    std::ostringstream xml;
+    xml << "<Portfolio>";
+    Size nTrades = 40;
+    for (Size i = 0; i < nTrades; ++i) {
+        xml << "<Trade id=\"FXFWD_" << i << "\"><TradeType>FxForward</TradeType>"
+            << "<Envelope><CounterParty>CPTY_A</CounterParty><NettingSetId>CPTY_A</NettingSetId></Envelope>"
+            << "<FxForwardData><ValueDate>2018-03-01</ValueDate><BoughtCurrency>EUR</BoughtCurrency>"
+            << "<BoughtAmount>" << 1000000 + i << "</BoughtAmount><SoldCurrency>" << currencies[i % 5]
+            << "</SoldCurrency><SoldAmount>1100000</SoldAmount></FxForwardData></Trade>";
+    }
+    xml << "</Portfolio>";
+
+    Portfolio serial(true, false), parallel(true, false);
+    serial.fromXMLString(xml.str());
+    parallel.fromXMLString(xml.str());
+    serial.build(QuantLib::ext::make_shared<EngineFactory>(engineData, market), "test", false, 1);
+    parallel.build(QuantLib::ext::make_shared<EngineFactory>(engineData, market), "test", false, 4);
+
+    BOOST_REQUIRE_EQUAL(serial.size(), nTrades);
+    BOOST_CHECK(serial.ids() == parallel.ids());
+    Size failed = 0;
+    for (auto const& [id, trade] : serial.trades()) {
+        auto other = parallel.get(id);
+        BOOST_REQUIRE(other);
+        BOOST_CHECK_EQUAL(trade->tradeType(), other->tradeType());
+        if (trade->tradeType() == "Failed") {
+            ++failed;
+            continue;
+        }
+        BOOST_CHECK_EQUAL(trade->npvCurrency(), other->npvCurrency());
+        BOOST_CHECK_EQUAL(trade->instrument()->NPV(), other->instrument()->NPV());
+    }
+    BOOST_CHECK_EQUAL(failed, nTrades / 5);
+    BOOST_CHECK_EQUAL(parallel.get("FXFWD_4")->tradeType(), "Failed");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <ored/report/inmemoryreport.hpp>
+#include <ored/utilities/profiler.hpp>
+#include <oret/toplevelfixture.hpp>
+
+#include <sstream>
+#include <thread>
+
+using namespace ore::data;
+using namespace QuantLib;
+
+BOOST_FIXTURE_TEST_SUITE(OREDataTestSuite, ore::test::TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(ProfilerTests)
+
+BOOST_AUTO_TEST_CASE(testDisabled) {
+
+    BOOST_TEST_MESSAGE("Testing that a disabled profiler does not record events");
+
+    Profiler::instance().stop();
+    Profiler::instance().clear();
+    { ORE_PROFILE_SCOPE("outer"); }
+    BOOST_CHECK(!Profiler::enabled());
+    BOOST_CHECK(Profiler::instance().events().empty());
+}
+
+BOOST_AUTO_TEST_CASE(testNestedScopes) {
+
+    BOOST_TEST_MESSAGE("Testing nested scopes and self times");
+
+    Profiler::instance().start();
+    {
+        ORE_PROFILE_SCOPE("outer");
+        for (Size i = 0; i < 2; ++i) {
+            ORE_PROFILE_SCOPE("inner", std::to_string(i));
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    Profiler::instance().stop();
+
+    auto events = Profiler::instance().events();
+    BOOST_REQUIRE_EQUAL(events.size(), 3);
+    BOOST_CHECK_EQUAL(events[0].name, "outer");
+    BOOST_CHECK_EQUAL(events[0].depth, 0);
+    BOOST_CHECK_EQUAL(events[1].name, "inner [0]");
+    BOOST_CHECK_EQUAL(events[1].depth, 1);
+    BOOST_CHECK_EQUAL(events[2].name, "inner [1]");
+    BOOST_CHECK_CLOSE(events[0].self, events[0].duration - events[1].duration - events[2].duration, 1E-6);
+    BOOST_CHECK_GE(events[0].duration, events[1].duration + events[2].duration);
+    BOOST_CHECK_EQUAL(events[1].self, events[1].duration);
+
+    std::ostringstream os;
+    Profiler::instance().writeChromeTrace(os);
+    BOOST_CHECK(os.str().find("\"name\":\"inner [1]\"") != std::string::npos);
+    BOOST_CHECK(os.str().find("\"ph\":\"X\"") != std::string::npos);
+
+    InMemoryReport report;
+    Profiler::instance().writeSummary(report);
+    BOOST_REQUIRE_EQUAL(report.rows(), 3);
+    BOOST_CHECK_EQUAL(boost::get<std::string>(report.value(0, 0)), "outer");
+    BOOST_CHECK_EQUAL(boost::get<Size>(report.value(2, 0)), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testThreads) {
+
+    BOOST_TEST_MESSAGE("Testing that events are recorded per thread");
+
+    Profiler::instance().start();
+    auto work = []() {
+        ORE_PROFILE_SCOPE("work");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    };
+    std::thread t1(work), t2(work);
+    t1.join();
+    t2.join();
+    Profiler::instance().stop();
+
+    auto events = Profiler::instance().events();
+    BOOST_REQUIRE_EQUAL(events.size(), 2);
+    BOOST_CHECK(events[0].thread != events[1].thread);
+
+    InMemoryReport report;
+    Profiler::instance().writeSummary(report);
+    BOOST_REQUIRE_EQUAL(report.rows(), 1);
+    BOOST_CHECK_EQUAL(boost::get<Size>(report.value(2, 0)), 2);
+    BOOST_CHECK_EQUAL(boost::get<Size>(report.value(3, 0)), 2);
+    Profiler::instance().clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
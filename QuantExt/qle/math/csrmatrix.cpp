@@ -0,0 +1,205 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <qle/math/csrmatrix.hpp>
+
+#include <ql/errors.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace QuantExt {
+
+using namespace QuantLib;
+
+CsrMatrix::CsrMatrix(Size rows, Size columns, std::vector<Size> rowPointers, std::vector<Size> columnIndices,
+                     std::vector<Real> values)
+    : rows_(rows), columns_(columns), rowPointers_(std::move(rowPointers)), columnIndices_(std::move(columnIndices)),
+      values_(std::move(values)) {
+    QL_REQUIRE(rowPointers_.size() == rows_ + 1,
+               "CsrMatrix: row pointers size (" << rowPointers_.size() << ") must be rows + 1 (" << rows_ + 1 << ")");
+    QL_REQUIRE(rowPointers_.front() == 0, "CsrMatrix: first row pointer must be 0");
+    QL_REQUIRE(rowPointers_.back() == values_.size() && columnIndices_.size() == values_.size(),
+               "CsrMatrix: inconsistent number of non-zero entries, last row pointer "
+                   << rowPointers_.back() << ", column indices " << columnIndices_.size() << ", values "
+                   << values_.size());
+    for (Size i = 0; i < rows_; ++i) {
+        QL_REQUIRE(rowPointers_[i] <= rowPointers_[i + 1], "CsrMatrix: row pointers must be non-decreasing");
+        for (Size k = rowPointers_[i]; k < rowPointers_[i + 1]; ++k) {
+            QL_REQUIRE(columnIndices_[k] < columns_,
+                       "CsrMatrix: column index " << columnIndices_[k] << " in row " << i << " out of range");
+            QL_REQUIRE(k == rowPointers_[i] || columnIndices_[k - 1] < columnIndices_[k],
+                       "CsrMatrix: column indices in row " << i << " must be strictly increasing");
+        }
+    }
+}
+
+CsrMatrix::CsrMatrix(const SparseMatrix& m, const Real threshold)
+    : rows_(m.size1()), columns_(m.size2()), rowPointers_(m.size1() + 1, 0) {
+    columnIndices_.reserve(m.nnz());
+    values_.reserve(m.nnz());
+    for (auto i1 = m.begin1(); i1 != m.end1(); ++i1) {
+        for (auto i2 = i1.begin(); i2 != i1.end(); ++i2) {
+            if (std::abs(*i2) > threshold) {
+                columnIndices_.push_back(i2.index2());
+                values_.push_back(*i2);
+                ++rowPointers_[i2.index1() + 1];
+            }
+        }
+    }
+    for (Size i = 0; i < rows_; ++i)
+        rowPointers_[i + 1] += rowPointers_[i];
+}
+
+Real CsrMatrix::operator()(Size i, Size j) const {
+    QL_REQUIRE(i < rows_ && j < columns_, "CsrMatrix: index (" << i << "," << j << ") out of range for matrix ("
+                                                                << rows_ << "x" << columns_ << ")");
+    auto begin = columnIndices_.begin() + rowPointers_[i];
+    auto end = columnIndices_.begin() + rowPointers_[i + 1];
+    auto it = std::lower_bound(begin, end, j);
+    if (it == end || *it != j)
+        return 0.0;
+    return values_[std::distance(columnIndices_.begin(), it)];
+}
+
+CsrMatrix CsrMatrix::transpose() const {
+    std::vector<Size> rowPointers(columns_ + 1, 0);
+    std::vector<Size> columnIndices(values_.size());
+    std::vector<Real> values(values_.size());
+    for (auto const& j : columnIndices_)
+        ++rowPointers[j + 1];
+    for (Size j = 0; j < columns_; ++j)
+        rowPointers[j + 1] += rowPointers[j];
+    // processing the rows in increasing order keeps the column indices of the transposed matrix sorted
+    std::vector<Size> next(rowPointers.begin(), rowPointers.end() - 1);
+    for (Size i = 0; i < rows_; ++i) {
+        for (Size k = rowPointers_[i]; k < rowPointers_[i + 1]; ++k) {
+            Size pos = next[columnIndices_[k]]++;
+            columnIndices[pos] = i;
+            values[pos] = values_[k];
+        }
+    }
+    return CsrMatrix(columns_, rows_, std::move(rowPointers), std::move(columnIndices), std::move(values));
+}
+
+void CsrMatrix::multiply(const Real* x, Real* y) const {
+    for (Size i = 0; i < rows_; ++i) {
+        Real tmp = 0.0;
+        for (Size k = rowPointers_[i]; k < rowPointers_[i + 1]; ++k)
+            tmp += values_[k] * x[columnIndices_[k]];
+        y[i] = tmp;
+    }
+}
+
+Array CsrMatrix::operator*(const Array& x) const {
+    QL_REQUIRE(x.size() == columns_,
+               "CsrMatrix: vector size (" << x.size() << ") does not match number of columns (" << columns_ << ")");
+    Array y(rows_);
+    multiply(x.begin(), y.begin());
+    return y;
+}
+
+namespace {
+
+// Gustavson's algorithm for rows [rowBegin, rowEnd) of C = A B, the rows are stored in the output vectors
+void multiplyRows(const CsrMatrix& A, const CsrMatrix& B, const Size rowBegin, const Size rowEnd,
+                  const Real threshold, std::vector<Size>& rowSizes, std::vector<Size>& columnIndices,
+                  std::vector<Real>& values) {
+    std::vector<Real> acc(B.columns(), 0.0);
+    std::vector<bool> used(B.columns(), false);
+    std::vector<Size> pattern;
+    for (Size i = rowBegin; i < rowEnd; ++i) {
+        pattern.clear();
+        for (Size k = A.rowPointers()[i]; k < A.rowPointers()[i + 1]; ++k) {
+            Size j = A.columnIndices()[k];
+            Real a = A.values()[k];
+            for (Size l = B.rowPointers()[j]; l < B.rowPointers()[j + 1]; ++l) {
+                Size c = B.columnIndices()[l];
+                if (!used[c]) {
+                    used[c] = true;
+                    pattern.push_back(c);
+                }
+                acc[c] += a * B.values()[l];
+            }
+        }
+        std::sort(pattern.begin(), pattern.end());
+        Size n = 0;
+        for (auto const c : pattern) {
+            if (std::abs(acc[c]) > threshold) {
+                columnIndices.push_back(c);
+                values.push_back(acc[c]);
+                ++n;
+            }
+            acc[c] = 0.0;
+            used[c] = false;
+        }
+        rowSizes[i - rowBegin] = n;
+    }
+}
+
+} // namespace
+
+CsrMatrix multiply(const CsrMatrix& A, const CsrMatrix& B, const Size nThreads, const Real threshold) {
+    QL_REQUIRE(A.columns() == B.rows(), "CsrMatrix multiply: A (" << A.rows() << "x" << A.columns() << ") and B ("
+                                                                  << B.rows() << "x" << B.columns()
+                                                                  << ") are not compatible");
+    Size nChunks = std::max<Size>(1, std::min(nThreads, A.rows()));
+    std::vector<Size> chunkBegin(nChunks + 1);
+    for (Size c = 0; c <= nChunks; ++c)
+        chunkBegin[c] = A.rows() * c / nChunks;
+
+    std::vector<std::vector<Size>> rowSizes(nChunks), columnIndices(nChunks);
+    std::vector<std::vector<Real>> values(nChunks);
+    for (Size c = 0; c < nChunks; ++c)
+        rowSizes[c].resize(chunkBegin[c + 1] - chunkBegin[c]);
+
+    if (nChunks == 1) {
+        multiplyRows(A, B, 0, A.rows(), threshold, rowSizes[0], columnIndices[0], values[0]);
+    } else {
+        std::vector<std::thread> jobs;
+        for (Size c = 0; c < nChunks; ++c) {
+            jobs.emplace_back([&A, &B, &chunkBegin, &rowSizes, &columnIndices, &values, threshold, c]() {
+                multiplyRows(A, B, chunkBegin[c], chunkBegin[c + 1], threshold, rowSizes[c], columnIndices[c],
+                             values[c]);
+            });
+        }
+        for (auto& t : jobs)
+            t.join();
+    }
+
+    // concatenate the chunks
+    std::vector<Size> resRowPointers(A.rows() + 1, 0);
+    std::vector<Size> resColumnIndices;
+    std::vector<Real> resValues;
+    Size nnz = 0;
+    for (Size c = 0; c < nChunks; ++c)
+        nnz += values[c].size();
+    resColumnIndices.reserve(nnz);
+    resValues.reserve(nnz);
+    for (Size c = 0; c < nChunks; ++c) {
+        for (Size i = 0; i < rowSizes[c].size(); ++i)
+            resRowPointers[chunkBegin[c] + i + 1] = resRowPointers[chunkBegin[c] + i] + rowSizes[c][i];
+        resColumnIndices.insert(resColumnIndices.end(), columnIndices[c].begin(), columnIndices[c].end());
+        resValues.insert(resValues.end(), values[c].begin(), values[c].end());
+    }
+
+    return CsrMatrix(A.rows(), B.columns(), std::move(resRowPointers), std::move(resColumnIndices),
+                     std::move(resValues));
+}
+
+} // namespace QuantExt
@@ -0,0 +1,86 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file qle/math/csrmatrix.hpp
+    \brief compressed sparse row matrix
+    \ingroup math
+*/
+
+#pragma once
+
+#include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <ql/types.hpp>
+
+#include <vector>
+
+namespace QuantExt {
+
+//! Compressed sparse row matrix
+/*! Immutable sparse matrix in CSR format, i.e. the non-zero entries of row i are stored at positions
+    rowPointers()[i], ..., rowPointers()[i+1]-1 of columnIndices() and values(). The column indices of
+    each row are stored in increasing order.
+
+    Compared to QuantLib::SparseMatrix (a ublas compressed matrix) the layout is fixed after construction,
+    which makes products with vectors and other sparse matrices cheap and allows to process rows in parallel.
+
+    \ingroup math
+*/
+class CsrMatrix {
+public:
+    CsrMatrix() : rows_(0), columns_(0), rowPointers_(1, 0) {}
+    /*! Construct from CSR data. The column indices within each row must be strictly increasing. */
+    CsrMatrix(QuantLib::Size rows, QuantLib::Size columns, std::vector<QuantLib::Size> rowPointers,
+              std::vector<QuantLib::Size> columnIndices, std::vector<QuantLib::Real> values);
+    /*! Construct from a ublas sparse matrix, entries with absolute value less or equal to the threshold are
+        dropped. */
+    explicit CsrMatrix(const QuantLib::SparseMatrix& m, const QuantLib::Real threshold = 0.0);
+
+    //! \name Inspectors
+    //@{
+    QuantLib::Size rows() const { return rows_; }
+    QuantLib::Size columns() const { return columns_; }
+    QuantLib::Size nonZeros() const { return values_.size(); }
+    const std::vector<QuantLib::Size>& rowPointers() const { return rowPointers_; }
+    const std::vector<QuantLib::Size>& columnIndices() const { return columnIndices_; }
+    const std::vector<QuantLib::Real>& values() const { return values_; }
+    //! element access by binary search within the row, returns zero for entries that are not stored
+    QuantLib::Real operator()(QuantLib::Size i, QuantLib::Size j) const;
+    //@}
+
+    //! transposed matrix, again in CSR format
+    CsrMatrix transpose() const;
+
+    //! y = A x, where x has columns() and y has rows() elements
+    void multiply(const QuantLib::Real* x, QuantLib::Real* y) const;
+    QuantLib::Array operator*(const QuantLib::Array& x) const;
+
+private:
+    QuantLib::Size rows_, columns_;
+    std::vector<QuantLib::Size> rowPointers_;
+    std::vector<QuantLib::Size> columnIndices_;
+    std::vector<QuantLib::Real> values_;
+};
+
+/*! Sparse matrix product C = A B. The rows of C are computed independently, if nThreads > 1 they are
+    distributed over that many threads. The result does not depend on the number of threads. Entries with
+    absolute value less or equal to the threshold are dropped from the result. */
+CsrMatrix multiply(const CsrMatrix& A, const CsrMatrix& B, const QuantLib::Size nThreads = 1,
+                   const QuantLib::Real threshold = 0.0);
+
+} // namespace QuantExt
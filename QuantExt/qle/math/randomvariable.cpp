@@ -37,6 +37,7 @@
 
 #include <iostream>
 #include <map>
+#include <numeric>
 
 // if defined, RandomVariableStats are updated (this might impact perfomance!), default is undefined
 //#define ENABLE_RANDOMVARIABLE_STATS
@@ -547,8 +548,12 @@ RandomVariable& RandomVariable::operator+=(const RandomVariable& y) {
         constantData_ += y.constantData_;
     else {
         resumeCalcStats();
-        for (Size i = 0; i < n_; ++i) {
-            data_[i] += y[i];
+        if (y.deterministic_) {
+            for (Size i = 0; i < n_; ++i)
+                data_[i] += y.constantData_;
+        } else {
+            for (Size i = 0; i < n_; ++i)
+                data_[i] += y.data_[i];
         }
         stopCalcStats(n_);
     }
@@ -571,8 +576,12 @@ RandomVariable& RandomVariable::operator-=(const RandomVariable& y) {
         constantData_ -= y.constantData_;
     else {
         resumeCalcStats();
-        for (Size i = 0; i < n_; ++i) {
-            data_[i] -= y[i];
+        if (y.deterministic_) {
+            for (Size i = 0; i < n_; ++i)
+                data_[i] -= y.constantData_;
+        } else {
+            for (Size i = 0; i < n_; ++i)
+                data_[i] -= y.data_[i];
         }
         stopCalcStats(n_);
     }
@@ -595,8 +604,12 @@ RandomVariable& RandomVariable::operator*=(const RandomVariable& y) {
         constantData_ *= y.constantData_;
     else {
         resumeCalcStats();
-        for (Size i = 0; i < n_; ++i) {
-            data_[i] *= y[i];
+        if (y.deterministic_) {
+            for (Size i = 0; i < n_; ++i)
+                data_[i] *= y.constantData_;
+        } else {
+            for (Size i = 0; i < n_; ++i)
+                data_[i] *= y.data_[i];
         }
         stopCalcStats(n_);
     }
@@ -619,8 +632,12 @@ RandomVariable& RandomVariable::operator/=(const RandomVariable& y) {
         constantData_ /= y.constantData_;
     else {
         resumeCalcStats();
-        for (Size i = 0; i < n_; ++i) {
-            data_[i] /= y[i];
+        if (y.deterministic_) {
+            for (Size i = 0; i < n_; ++i)
+                data_[i] /= y.constantData_;
+        } else {
+            for (Size i = 0; i < n_; ++i)
+                data_[i] /= y.data_[i];
         }
         stopCalcStats(n_);
     }
@@ -630,6 +647,12 @@ RandomVariable& RandomVariable::operator/=(const RandomVariable& y) {
 RandomVariable operator+(RandomVariable x, const RandomVariable& y) {
     if (!x.initialised() || !y.initialised())
         return RandomVariable();
+    // apply a deterministic x as a scalar to a copy of y instead of expanding it
+    if (x.deterministic() && !y.deterministic()) {
+        RandomVariable tmp(y);
+        tmp += x;
+        return tmp;
+    }
     x += y;
     return x;
 }
@@ -644,6 +667,12 @@ RandomVariable operator-(RandomVariable x, const RandomVariable& y) {
 RandomVariable operator*(RandomVariable x, const RandomVariable& y) {
     if (!x.initialised() || !y.initialised())
         return RandomVariable();
+    // apply a deterministic x as a scalar to a copy of y instead of expanding it
+    if (x.deterministic() && !y.deterministic()) {
+        RandomVariable tmp(y);
+        tmp *= x;
+        return tmp;
+    }
     x *= y;
     return x;
 }
@@ -667,8 +696,12 @@ RandomVariable max(RandomVariable x, const RandomVariable& y) {
         x.constantData_ = std::max(x.constantData_, y.constantData_);
     else {
         resumeCalcStats();
-        for (Size i = 0; i < x.size(); ++i) {
-            x.data_[i] = std::max(x.data_[i], y[i]);
+        if (y.deterministic_) {
+            for (Size i = 0; i < x.size(); ++i)
+                x.data_[i] = std::max(x.data_[i], y.constantData_);
+        } else {
+            for (Size i = 0; i < x.size(); ++i)
+                x.data_[i] = std::max(x.data_[i], y.data_[i]);
         }
         stopCalcStats(x.size());
     }
@@ -687,8 +720,12 @@ RandomVariable min(RandomVariable x, const RandomVariable& y) {
         x.constantData_ = std::min(x.constantData_, y.constantData_);
     else {
         resumeCalcStats();
-        for (Size i = 0; i < x.size(); ++i) {
-            x.data_[i] = std::min(x.data_[i], y[i]);
+        if (y.deterministic_) {
+            for (Size i = 0; i < x.size(); ++i)
+                x.data_[i] = std::min(x.data_[i], y.constantData_);
+        } else {
+            for (Size i = 0; i < x.size(); ++i)
+                x.data_[i] = std::min(x.data_[i], y.data_[i]);
         }
         stopCalcStats(x.size());
     }
@@ -709,8 +746,12 @@ RandomVariable pow(RandomVariable x, const RandomVariable& y) {
         x.constantData_ = std::pow(x.constantData_, y.constantData_);
     else {
         resumeCalcStats();
-        for (Size i = 0; i < x.size(); ++i) {
-            x.data_[i] = std::pow(x.data_[i], y[i]);
+        if (y.deterministic_) {
+            for (Size i = 0; i < x.size(); ++i)
+                x.data_[i] = std::pow(x.data_[i], y.constantData_);
+        } else {
+            for (Size i = 0; i < x.size(); ++i)
+                x.data_[i] = std::pow(x.data_[i], y.data_[i]);
         }
         stopCalcStats(x.size());
     }
@@ -1161,6 +1202,26 @@ std::vector<const RandomVariable*> vec2vecptr(const std::vector<RandomVariable>&
     return result;
 }
 
+namespace {
+Matrix regressionDesignMatrix(
+    const Size n, const std::vector<const RandomVariable*>& regressor,
+    const std::vector<std::function<RandomVariable(const std::vector<const RandomVariable*>&)>>& basisFn,
+    const Filter& filter) {
+    Matrix A(n, basisFn.size());
+    for (Size j = 0; j < basisFn.size(); ++j) {
+        RandomVariable a = basisFn[j](regressor);
+        if (filter.initialised()) {
+            a = applyFilter(a, filter);
+        }
+        if (a.deterministic())
+            std::fill(A.column_begin(j), A.column_end(j), a[0]);
+        else
+            a.copyToMatrixCol(A, j);
+    }
+    return A;
+}
+} // namespace
+
 Array regressionCoefficients(
     RandomVariable r, std::vector<const RandomVariable*> regressor,
     const std::vector<std::function<RandomVariable(const std::vector<const RandomVariable*>&)>>& basisFn,
@@ -1180,17 +1241,7 @@ Array regressionCoefficients(
 
     resumeCalcStats();
 
-    Matrix A(r.size(), basisFn.size());
-    for (Size j = 0; j < basisFn.size(); ++j) {
-        RandomVariable a = basisFn[j](regressor);
-        if (filter.initialised()) {
-            a = applyFilter(a, filter);
-        }
-        if (a.deterministic())
-            std::fill(A.column_begin(j), A.column_end(j), a[0]);
-        else
-            a.copyToMatrixCol(A, j);
-    }
+    Matrix A = regressionDesignMatrix(r.size(), regressor, basisFn, filter);
 
     if (!debugLabel.empty()) {
         for (Size i = 0; i < r.size(); ++i) {
@@ -1239,6 +1290,79 @@ Array regressionCoefficients(
     return res;
 }
 
+RegressionFactorisation::RegressionFactorisation(
+    const std::vector<const RandomVariable*>& regressor,
+    const std::vector<std::function<RandomVariable(const std::vector<const RandomVariable*>&)>>& basisFn,
+    const Filter& filter)
+    : filter_(filter) {
+
+    QL_REQUIRE(!regressor.empty(), "RegressionFactorisation: regressor vector is empty");
+    Size n = regressor.front()->size();
+    for (auto const reg : regressor) {
+        QL_REQUIRE(reg->size() == n,
+                   "RegressionFactorisation: regressor sizes do not match (" << reg->size() << ", " << n << ")");
+    }
+    QL_REQUIRE(filter.size() == 0 || filter.size() == n,
+               "RegressionFactorisation: filter size (" << filter.size() << ") must match regressor size (" << n
+                                                        << ")");
+    QL_REQUIRE(n >= basisFn.size(), "RegressionFactorisation: sample size ("
+                                        << n << ") must be geq basis fns size (" << basisFn.size() << ")");
+
+    resumeCalcStats();
+
+    // A P = Q R with column pivoting, so that the diagonal of R is decreasing in absolute value
+
+    ipvt_ = qrDecomposition(regressionDesignMatrix(n, regressor, basisFn, filter), q_, r_, true);
+
+    // as in qrSolve(), the solution components from the first zero diagonal element of R on are set to zero
+
+    rank_ = 0;
+    while (rank_ < r_.rows() && r_[rank_][rank_] != 0.0)
+        ++rank_;
+
+    // rough estimate, QR is O(mn^2)
+    stopCalcStats(n * basisFn.size() * basisFn.size());
+}
+
+Array RegressionFactorisation::solve(RandomVariable r) const {
+
+    QL_REQUIRE(r.size() == q_.rows(),
+               "RegressionFactorisation::solve(): regressand size (" << r.size() << ") must match regressor size ("
+                                                                     << q_.rows() << ")");
+
+    resumeCalcStats();
+
+    if (filter_.initialised())
+        r = applyFilter(r, filter_);
+
+    // y = Q^T b
+
+    Array y(rank_, 0.0);
+    if (r.deterministic()) {
+        for (Size i = 0; i < rank_; ++i)
+            y[i] = std::accumulate(q_.column_begin(i), q_.column_end(i), Real(0.0)) * r[0];
+    } else {
+        Array b(r.size());
+        r.copyToArray(b);
+        for (Size i = 0; i < rank_; ++i)
+            y[i] = std::inner_product(q_.column_begin(i), q_.column_end(i), b.begin(), Real(0.0));
+    }
+
+    // solve R z = y and undo the column permutation
+
+    Array res(q_.columns(), 0.0);
+    for (Size i = rank_; i > 0; --i) {
+        Real z = y[i - 1];
+        for (Size j = i; j < rank_; ++j)
+            z -= r_[i - 1][j] * y[j];
+        y[i - 1] = z / r_[i - 1][i - 1];
+        res[ipvt_[i - 1]] = y[i - 1];
+    }
+
+    stopCalcStats(q_.rows() * rank_);
+    return res;
+}
+
 RandomVariable conditionalExpectation(
     const std::vector<const RandomVariable*>& regressor,
     const std::vector<std::function<RandomVariable(const std::vector<const RandomVariable*>&)>>& basisFn,
@@ -309,6 +309,27 @@ Array regressionCoefficients(
     const Filter& filter = Filter(), const RandomVariableRegressionMethod = RandomVariableRegressionMethod::QR,
     const std::string& debugLabel = std::string());
 
+/* QR factorisation of a regression design matrix. The factorisation is computed once and can then be used to
+   compute the regression coefficients for several regressands, each at the cost of a back substitution. The
+   coefficients agree with regressionCoefficients() using the QR method up to rounding differences. */
+class RegressionFactorisation {
+public:
+    RegressionFactorisation(
+        const std::vector<const RandomVariable*>& regressor,
+        const std::vector<std::function<RandomVariable(const std::vector<const RandomVariable*>&)>>& basisFn,
+        const Filter& filter = Filter());
+    // compute the regression coefficients for the given regressand
+    Array solve(RandomVariable r) const;
+    Size size() const { return q_.rows(); }
+    Size basisSize() const { return q_.columns(); }
+
+private:
+    Filter filter_;
+    Matrix q_, r_;
+    std::vector<Size> ipvt_;
+    Size rank_;
+};
+
 // evaluate regression function
 RandomVariable conditionalExpectation(
     const std::vector<const RandomVariable*>& regressor,
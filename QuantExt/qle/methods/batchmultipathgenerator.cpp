@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <qle/methods/batchmultipathgenerator.hpp>
+#include <qle/processes/irlgm1fstateprocess.hpp>
+
+namespace QuantExt {
+
+namespace {
+// the same scramble seeds as used by makeMultiPathGenerator()
+QuantLib::ext::shared_ptr<MultiPathVariateGeneratorBase>
+makeVariateGenerator(const SequenceType s, const Size timeSteps, const BigNatural seed,
+                     const SobolBrownianGenerator::Ordering ordering,
+                     const SobolRsg::DirectionIntegers directionIntegers) {
+    switch (s) {
+    case Burley2020Sobol:
+        return QuantLib::ext::make_shared<MultiPathVariateGeneratorBurley2020Sobol>(1, timeSteps, seed, directionIntegers,
+                                                                                    seed == 0 ? 0 : seed + 1);
+    case Burley2020SobolBrownianBridge:
+        return QuantLib::ext::make_shared<MultiPathVariateGeneratorBurley2020SobolBrownianBridge>(
+            1, timeSteps, ordering, seed, directionIntegers, seed == 0 ? 0 : seed + 1);
+    default:
+        return makeMultiPathVariateGenerator(s, 1, timeSteps, seed, ordering, directionIntegers);
+    }
+}
+} // namespace
+
+BatchMultiPathGenerator::BatchMultiPathGenerator(const SequenceType s,
+                                                 const QuantLib::ext::shared_ptr<StochasticProcess>& process,
+                                                 const TimeGrid& timeGrid, const BigNatural seed,
+                                                 const SobolBrownianGenerator::Ordering ordering,
+                                                 const SobolRsg::DirectionIntegers directionIntegers)
+    : sequenceType_(s), process_(process), timeGrid_(timeGrid), seed_(seed), ordering_(ordering),
+      directionIntegers_(directionIntegers) {
+    QL_REQUIRE(timeGrid_.size() > 1, "BatchMultiPathGenerator: time grid must contain at least one step");
+    if (auto lgm = QuantLib::ext::dynamic_pointer_cast<IrLgm1fStateProcess>(process_)) {
+        // the lgm state process is driftless with deterministic variance
+        stdDevs_.resize(timeGrid_.size() - 1);
+        for (Size j = 0; j < stdDevs_.size(); ++j)
+            stdDevs_[j] = lgm->stdDeviation(timeGrid_[j], 0.0, timeGrid_.dt(j));
+        variates_.resize(stdDevs_.size());
+    }
+    reset();
+}
+
+void BatchMultiPathGenerator::reset() {
+    if (stdDevs_.empty())
+        pathGenerator_ =
+            makeMultiPathGenerator(sequenceType_, process_, timeGrid_, seed_, ordering_, directionIntegers_);
+    else
+        variateGenerator_ =
+            makeVariateGenerator(sequenceType_, stdDevs_.size(), seed_, ordering_, directionIntegers_);
+}
+
+void BatchMultiPathGenerator::next(std::vector<std::vector<RandomVariable>>& paths) const {
+    QL_REQUIRE(paths.size() == timeGrid_.size() - 1, "BatchMultiPathGenerator::next(): paths size ("
+                                                         << paths.size() << ") does not match number of time steps ("
+                                                         << timeGrid_.size() - 1 << ")");
+    for (auto& p : paths) {
+        QL_REQUIRE(p.size() == process_->size(), "BatchMultiPathGenerator::next(): number of states ("
+                                                     << p.size() << ") does not match process size ("
+                                                     << process_->size() << ")");
+        for (auto& r : p)
+            r.expand();
+    }
+
+    Size samples = paths.front().front().size();
+
+    if (!stdDevs_.empty()) {
+
+        // write the variates into the buffers ...
+
+        for (Size i = 0; i < samples; ++i) {
+            variateGenerator_->nextVariates(variates_);
+            for (Size j = 0; j < variates_.size(); ++j)
+                paths[j][0].data()[i] = variates_[j];
+        }
+
+        // ... and build the paths one time step at a time
+
+        Real x0 = process_->initialValues()[0];
+        for (Size j = 0; j < paths.size(); ++j) {
+            Real* x = paths[j][0].data();
+            Real stdDev = stdDevs_[j];
+            if (j == 0) {
+                for (Size i = 0; i < samples; ++i)
+                    x[i] = x0 + stdDev * x[i];
+            } else {
+                const Real* xPrevious = paths[j - 1][0].data();
+                for (Size i = 0; i < samples; ++i)
+                    x[i] = xPrevious[i] + stdDev * x[i];
+            }
+        }
+
+    } else {
+
+        for (Size i = 0; i < samples; ++i) {
+            const MultiPath& path = pathGenerator_->next().value;
+            for (Size j = 0; j < paths.size(); ++j) {
+                for (Size k = 0; k < paths[j].size(); ++k) {
+                    paths[j][k].data()[i] = path[k][j + 1];
+                }
+            }
+        }
+    }
+}
+
+} // namespace QuantExt
@@ -0,0 +1,73 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file batchmultipathgenerator.hpp
+    \brief path generator filling time / state / path buffers for a batch of paths
+    \ingroup methods
+*/
+
+#pragma once
+
+#include <qle/math/randomvariable.hpp>
+#include <qle/methods/multipathgeneratorbase.hpp>
+#include <qle/methods/multipathvariategenerator.hpp>
+
+namespace QuantExt {
+
+//! Batch multi path generator
+/*! Generates a batch of paths and stores them time / state major, i.e. paths[j][k] holds the values of state k at
+    time grid point j + 1 on all paths of the batch. This is the layout consumed by the regression based engines.
+
+    For the one dimensional LGM state process the variates are written directly into the buffers and the paths are
+    built one time step at a time over all paths, which avoids the evolution path by path through the process
+    interface. For all other processes the generator falls back on the multi path generator from
+    makeMultiPathGenerator(). In both cases the paths coincide with those generated by makeMultiPathGenerator()
+    for the same sequence type, seed, ordering and direction integers.
+
+    \ingroup methods
+*/
+class BatchMultiPathGenerator {
+public:
+    BatchMultiPathGenerator(const SequenceType s, const QuantLib::ext::shared_ptr<StochasticProcess>& process,
+                            const TimeGrid& timeGrid, const BigNatural seed,
+                            const SobolBrownianGenerator::Ordering ordering = SobolBrownianGenerator::Steps,
+                            const SobolRsg::DirectionIntegers directionIntegers = SobolRsg::JoeKuoD7);
+
+    /*! Fills paths with the next batch of paths, paths must have size (time grid size - 1) x (process size), the
+        batch size is given by the size of the random variables, which are expanded if necessary. */
+    void next(std::vector<std::vector<RandomVariable>>& paths) const;
+    void reset();
+
+private:
+    SequenceType sequenceType_;
+    QuantLib::ext::shared_ptr<StochasticProcess> process_;
+    TimeGrid timeGrid_;
+    BigNatural seed_;
+    SobolBrownianGenerator::Ordering ordering_;
+    SobolRsg::DirectionIntegers directionIntegers_;
+
+    // one dimensional lgm process
+    std::vector<Real> stdDevs_;
+    QuantLib::ext::shared_ptr<MultiPathVariateGeneratorBase> variateGenerator_;
+    mutable std::vector<Real> variates_;
+
+    // general process
+    QuantLib::ext::shared_ptr<MultiPathGeneratorBase> pathGenerator_;
+};
+
+} // namespace QuantExt
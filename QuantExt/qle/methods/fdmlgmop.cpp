@@ -28,10 +28,15 @@ namespace QuantExt {
 
 FdmLgmOp::FdmLgmOp(const ext::shared_ptr<FdmMesher>& mesher, const ext::shared_ptr<StochasticProcess1D>& process)
     : mesher_(mesher), process_(process), dxMap_(FirstDerivativeOp(0, mesher)), dxxMap_(SecondDerivativeOp(0, mesher)),
-      mapT_(0, mesher) {}
+      mapT_(0, mesher), v_(Null<Real>()) {}
 
 void FdmLgmOp::setTime(Time t1, Time t2) {
     Real v = process_->variance(t1, 0.0, t2 - t1) / (t2 - t1);
+    // consecutive steps of a constant volatility period and rollbacks of several arrays over the same step share
+    // the operator
+    if (v == v_)
+        return;
+    v_ = v;
     mapT_.axpyb(Array(), dxMap_, dxxMap_.mult(0.5 * Array(mesher_->layout()->size(), v)), Array(1, 0));
 }
 
@@ -55,5 +55,7 @@ private:
     FirstDerivativeOp dxMap_;
     TripleBandLinearOp dxxMap_;
     TripleBandLinearOp mapT_;
+    // the variance rate mapT_ was last built for, the operator is only rebuilt if it changes
+    Real v_;
 };
 } // namespace QuantExt
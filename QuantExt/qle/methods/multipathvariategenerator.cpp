@@ -42,6 +42,15 @@ Sample<std::vector<Array>> MultiPathVariateGeneratorBase::next() const {
     return result;
 }
 
+Real MultiPathVariateGeneratorBase::nextVariates(std::vector<Real>& output) const {
+    QL_REQUIRE(output.size() == timeSteps_ * dimension_, "MultiPathVariateGeneratorBase::nextVariates(): output size ("
+                                                             << output.size() << ") does not match time steps ("
+                                                             << timeSteps_ << ") x dimension (" << dimension_ << ")");
+    Sample<std::vector<Real>> sequence = nextSequence();
+    std::copy(sequence.value.begin(), sequence.value.end(), output.begin());
+    return sequence.weight;
+}
+
 MultiPathVariateGeneratorMersenneTwister::MultiPathVariateGeneratorMersenneTwister(const Size dimension,
                                                                                    const Size timeSteps,
                                                                                    BigNatural seed,
@@ -126,6 +135,20 @@ Sample<std::vector<Array>> MultiPathVariateGeneratorSobolBrownianBridgeBase::nex
     return Sample<std::vector<Array>>(output, weight);
 }
 
+Real MultiPathVariateGeneratorSobolBrownianBridgeBase::nextVariates(std::vector<Real>& output) const {
+    QL_REQUIRE(output.size() == timeSteps_ * dimension_,
+               "MultiPathVariateGeneratorSobolBrownianBridgeBase::nextVariates(): output size ("
+                   << output.size() << ") does not match time steps (" << timeSteps_ << ") x dimension (" << dimension_
+                   << ")");
+    step_.resize(dimension_);
+    Real weight = gen_->nextPath();
+    for (Size i = 0; i < timeSteps_; ++i) {
+        gen_->nextStep(step_);
+        std::copy(step_.begin(), step_.end(), output.begin() + i * dimension_);
+    }
+    return weight;
+}
+
 MultiPathVariateGeneratorSobolBrownianBridge::MultiPathVariateGeneratorSobolBrownianBridge(
     const Size dimension, const Size timeSteps, SobolBrownianGenerator::Ordering ordering, BigNatural seed,
     SobolRsg::DirectionIntegers directionIntegers)
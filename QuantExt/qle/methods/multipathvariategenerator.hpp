@@ -34,6 +34,10 @@ public:
     MultiPathVariateGeneratorBase(const Size dimension, const Size timeSteps);
     virtual ~MultiPathVariateGeneratorBase() {}
     virtual Sample<std::vector<Array>> next() const;
+    /*! writes the variates of the next path to output instead of allocating an array per time step as next() does,
+        the variate for time step i and factor j is stored at i * dimension + j, output must have size
+        timeSteps * dimension, returns the sample weight */
+    virtual Real nextVariates(std::vector<Real>& output) const;
     virtual void reset() = 0;
 
 protected:
@@ -103,6 +107,7 @@ public:
         SobolBrownianGenerator::Ordering ordering = SobolBrownianGenerator::Steps, BigNatural seed = 0,
         SobolRsg::DirectionIntegers directionIntegers = SobolRsg::JoeKuoD7);
     Sample<std::vector<Array>> next() const override;
+    Real nextVariates(std::vector<Real>& output) const override;
 
 protected:
     Sample<std::vector<Real>> nextSequence() const override;
@@ -112,6 +117,7 @@ protected:
     SobolRsg::DirectionIntegers directionIntegers_;
 
     QuantLib::ext::shared_ptr<SobolBrownianGeneratorBase> gen_;
+    mutable std::vector<Real> step_;
 };
 
 class MultiPathVariateGeneratorSobolBrownianBridge : public MultiPathVariateGeneratorSobolBrownianBridgeBase {
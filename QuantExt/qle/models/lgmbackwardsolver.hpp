@@ -29,6 +29,8 @@
 #include <qle/math/randomvariable.hpp>
 #include <qle/models/lgm.hpp>
 
+#include <vector>
+
 namespace QuantExt {
 
 //! Interface for LGM1F backward solver
@@ -48,6 +50,17 @@ public:
     virtual RandomVariable rollback(const RandomVariable& v, const Real t1, const Real t0,
                                     Size steps = Null<Size>()) const = 0;
 
+    /* roll back several deflated NPV arrays from t1 to t0 on the same time grid. Solvers that can share work
+       between the arrays override this, the default rolls back each array separately. */
+    virtual std::vector<RandomVariable> rollback(const std::vector<RandomVariable>& v, const Real t1, const Real t0,
+                                                 Size steps = Null<Size>()) const {
+        std::vector<RandomVariable> result;
+        result.reserve(v.size());
+        for (auto const& w : v)
+            result.push_back(rollback(w, t1, t0, steps));
+        return result;
+    }
+
     /* the underlying model */
     virtual const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model() const = 0;
 };
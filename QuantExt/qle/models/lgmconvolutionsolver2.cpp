@@ -20,12 +20,15 @@
 #include <qle/models/lgmconvolutionsolver2.hpp>
 
 #include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+
+#include <algorithm>
 
 namespace QuantExt {
 
 LgmConvolutionSolver2::LgmConvolutionSolver2(const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model, const Real sy,
-                                             const Size ny, const Real sx, const Size nx)
-    : model_(model), nx_(static_cast<int>(nx)) {
+                                             const Size ny, const Real sx, const Size nx, const Method method)
+    : model_(model), nx_(static_cast<int>(nx)), method_(method) {
 
     // precompute weights
 
@@ -36,26 +39,33 @@ LgmConvolutionSolver2::LgmConvolutionSolver2(const QuantLib::ext::shared_ptr<Lin
     // y-grid spacing
     h_ = 1.0 / static_cast<Real>(ny);
 
+    y_.resize(2 * my_ + 1); // x-coordinate / standard deviation of x
+    for (int i = 0; i <= 2 * my_; i++)
+        y_[i] = h_ * (i - my_);
+
     // weights for convolution in the rollback step
+    w_ = convolutionWeights(h_, my_);
+}
+
+std::vector<Real> LgmConvolutionSolver2::convolutionWeights(const Real h, const int m) {
     CumulativeNormalDistribution N;
     NormalDistribution G;
-
-    y_.resize(2 * my_ + 1); // x-coordinate / standard deviation of x
-    w_.resize(2 * my_ + 1); // probability weight around y-grid point i
-    for (int i = 0; i <= 2 * my_; i++) {
-        y_[i] = h_ * (i - my_);
-        if (i == 0 || i == 2 * my_)
-            w_[i] = (1. + y_[0] / h_) * N(y_[0] + h_) - y_[0] / h_ * N(y_[0]) + (G(y_[0] + h_) - G(y_[0])) / h_;
+    std::vector<Real> w(2 * m + 1); // probability weight around y-grid point i
+    Real y0 = -h * m;
+    for (int i = 0; i <= 2 * m; i++) {
+        Real y = h * (i - m);
+        if (i == 0 || i == 2 * m)
+            w[i] = (1. + y0 / h) * N(y0 + h) - y0 / h * N(y0) + (G(y0 + h) - G(y0)) / h;
         else
-            w_[i] = (1. + y_[i] / h_) * N(y_[i] + h_) - 2. * y_[i] / h_ * N(y_[i]) -
-                    (1. - y_[i] / h_) * N(y_[i] - h_) // opposite sign in the paper
-                    + (G(y_[i] + h_) - 2. * G(y_[i]) + G(y_[i] - h_)) / h_;
-        // w_[i] might be negative due to numerical errors
-        if (w_[i] < 0.0) {
-            QL_REQUIRE(w_[i] > -1.0E-10, "LgmConvolutionSolver: negative w (" << w_[i] << ") at i=" << i);
-            w_[i] = 0.0;
+            w[i] = (1. + y / h) * N(y + h) - 2. * y / h * N(y) - (1. - y / h) * N(y - h) // opposite sign in the paper
+                   + (G(y + h) - 2. * G(y) + G(y - h)) / h;
+        // w[i] might be negative due to numerical errors
+        if (w[i] < 0.0) {
+            QL_REQUIRE(w[i] > -1.0E-10, "LgmConvolutionSolver: negative w (" << w[i] << ") at i=" << i);
+            w[i] = 0.0;
         }
     }
+    return w;
 }
 
 RandomVariable LgmConvolutionSolver2::stateGrid(const Real t) const {
@@ -91,11 +101,13 @@ RandomVariable LgmConvolutionSolver2::rollback(const RandomVariable& v, const Re
         }
         return RandomVariable(2 * mx_ + 1, value);
     } else {
-        RandomVariable value(2 * mx_ + 1, 0.0);
-        value.expand();
         // rollback from t1 to t0 > 0
         Real std = std::sqrt(model_->parametrization()->zeta(t1) - model_->parametrization()->zeta(t0));
         Real dx2 = std::sqrt(model_->parametrization()->zeta(t0)) / static_cast<Real>(nx_);
+        RandomVariable value(2 * mx_ + 1, 0.0);
+        if (method_ == Method::FFT && rollbackFft(v, dx, dx2, std, value))
+            return value;
+        value.expand();
         for (int k = 0; k <= 2 * mx_; k++) {
             for (int i = 0; i <= 2 * my_; i++) {
                 // Map y index to x index, not integer in generalTo
@@ -114,4 +126,77 @@ RandomVariable LgmConvolutionSolver2::rollback(const RandomVariable& v, const Re
     }
 }
 
+bool LgmConvolutionSolver2::rollbackFft(const RandomVariable& v, const Real dx, const Real dx2, const Real std,
+                                        RandomVariable& value) const {
+
+    // kernel grid spacing in units of the standard deviation of the step and kernel half width in grid points,
+    // the kernel covers at least the range sy = my * h of the direct convolution
+
+    if (!(dx2 > 0.0) || !(std > 0.0))
+        return false;
+    Real h = dx2 / std;
+    Real width = std::ceil(static_cast<Real>(my_) * h_ / h);
+
+    // the values are needed on the state grid at t0 extended by the kernel width on both sides, the size of the
+    // fft must be at least the length of this grid to avoid wrap around in the part of the result we use
+
+    Size directCost = static_cast<Size>(2 * mx_ + 1) * static_cast<Size>(2 * my_ + 1);
+    if (width > static_cast<Real>(directCost))
+        return false;
+    int J = static_cast<int>(width);
+    Size L = 2 * mx_ + 2 * J + 1;
+    Size order = FastFourierTransform::min_order(L);
+    Size n = static_cast<Size>(1) << order;
+
+    // rough cost estimate: one forward and one inverse transform vs. the double loop of the direct convolution
+    if (5 * n * order > directCost)
+        return false;
+
+    // kernel spectrum, we store the transform of the reversed kernel, so that the convolution below yields
+    // sum_j K_j u_{k+j}, and cap the size of the cache which might grow e.g. under vol bumps
+
+    auto key = std::make_pair(std * std, dx2);
+    QuantLib::ext::shared_ptr<const std::vector<std::complex<Real>>> spec;
+    {
+        std::lock_guard<std::mutex> lock(kernelSpectraMutex_);
+        if (auto s = kernelSpectra_.find(key); s != kernelSpectra_.end())
+            spec = s->second;
+    }
+    if (spec == nullptr) {
+        std::vector<Real> k = convolutionWeights(h, J);
+        std::reverse(k.begin(), k.end());
+        auto tmp = QuantLib::ext::make_shared<std::vector<std::complex<Real>>>(n, 0.0);
+        FastFourierTransform(order).transform(k.begin(), k.end(), tmp->begin());
+        spec = tmp;
+        std::lock_guard<std::mutex> lock(kernelSpectraMutex_);
+        if (kernelSpectra_.size() >= 1024)
+            kernelSpectra_.clear();
+        kernelSpectra_.insert(std::make_pair(key, spec));
+    }
+
+    // values at x = dx2 * (k - mx) for k = -J, ..., 2mx + J via linear interpolation with flat extrapolation, as in
+    // the direct convolution
+
+    std::vector<Real> u(L);
+    for (Size l = 0; l < L; ++l) {
+        Real kp = dx2 * (static_cast<int>(l) - J - mx_) / dx + mx_;
+        int kk = int(floor(kp));
+        u[l] = kk < 0 ? v[0] : (kk + 1 > 2 * mx_ ? v[2 * mx_] : (kp - kk) * v[kk + 1] + (1.0 + kk - kp) * v[kk]);
+    }
+
+    // convolution, the result at state grid point k is the entry 2J + k of the (linear) convolution
+
+    FastFourierTransform fft(order);
+    std::vector<std::complex<Real>> uHat(n, 0.0), conv(n, 0.0);
+    fft.transform(u.begin(), u.end(), uHat.begin());
+    for (Size i = 0; i < n; ++i)
+        uHat[i] *= (*spec)[i];
+    fft.inverse_transform(uHat.begin(), uHat.end(), conv.begin());
+
+    value.expand();
+    for (int k = 0; k <= 2 * mx_; ++k)
+        value.set(k, conv[2 * J + k].real() / static_cast<Real>(n));
+    return true;
+}
+
 } // namespace QuantExt
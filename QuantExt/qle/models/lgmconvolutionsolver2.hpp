@@ -28,29 +28,62 @@
 #include <qle/math/randomvariable.hpp>
 #include <qle/models/lgmbackwardsolver.hpp>
 
+#include <complex>
+#include <map>
+#include <mutex>
+
 namespace QuantExt {
 
 //! Numerical convolution solver for the LGM model
 /*! Reference: Hagan, Methodology for callable swaps and Bermudan
                exercise into swaptions
+
+    The rollback from t1 to t0 > 0 can be computed in two ways:
+
+    - Direct: the convolution integral is evaluated for each state grid point, the cost per step is O(mx * my)
+    - FFT: the values are interpolated on an equidistant grid with the spacing of the state grid at t0 and convolved
+           with the discretised transition density using fast fourier transforms, the cost per step is O(n log n)
+           with n = 2 mx + 1 plus the width of the kernel in units of the state grid spacing at t0. The kernel
+           spectra are cached per pair (variance of the step, state grid spacing at t0), so that the rollbacks of
+           several instruments over the same exercise schedule reuse them. The cache is guarded by a mutex, so that
+           one solver can be shared by engines used from several threads. If the kernel width is so large that
+           the FFT is estimated to be slower than the direct convolution, the step falls back to the latter.
+
+    Both methods integrate the linearly interpolated values against the normal density truncated at sy standard
+    deviations, their results agree up to the discretisation error of the grids.
 */
 
 class LgmConvolutionSolver2 : public LgmBackwardSolver {
 public:
+    enum class Method { Direct, FFT };
+
     LgmConvolutionSolver2(const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model, const Real sy, const Size ny,
-                          const Real sx, const Size nx);
+                          const Real sx, const Size nx, const Method method = Method::Direct);
     Size gridSize() const override { return 2 * mx_ + 1; }
     RandomVariable stateGrid(const Real t) const override;
+    using LgmBackwardSolver::rollback;
     // steps are always ignored, since we can take large steps
     RandomVariable rollback(const RandomVariable& v, const Real t1, const Real t0,
                             Size steps = Null<Size>()) const override;
     const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model() const override { return model_; }
+    Method method() const { return method_; }
 
 private:
+    // weights w_i for y_i = h * (i - m), i = 0, ..., 2m
+    static std::vector<Real> convolutionWeights(const Real h, const int m);
+    // returns false if the fft is not applicable or estimated to be slower than the direct convolution
+    bool rollbackFft(const RandomVariable& v, const Real dx, const Real dx2, const Real std,
+                     RandomVariable& value) const;
+
     QuantLib::ext::shared_ptr<LinearGaussMarkovModel> model_;
     int mx_, my_, nx_;
     Real h_;
     std::vector<Real> y_, w_;
+    Method method_;
+    // kernel spectra keyed by (variance of the step, state grid spacing at t0)
+    mutable std::map<std::pair<Real, Real>, QuantLib::ext::shared_ptr<const std::vector<std::complex<Real>>>>
+        kernelSpectra_;
+    mutable std::mutex kernelSpectraMutex_;
 };
 
 } // namespace QuantExt
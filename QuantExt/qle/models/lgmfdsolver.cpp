@@ -48,15 +48,13 @@ RandomVariable LgmFdSolver::stateGrid(Real) const { return mesherLocations_; }
 
 const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& LgmFdSolver::model() const { return model_; }
 
-RandomVariable LgmFdSolver::rollback(const RandomVariable& v, const Real t1, const Real t0, Size steps) const {
-    if (QuantLib::close_enough(t0, t1) || v.deterministic())
-        return v;
-    QL_REQUIRE(t0 < t1, "LgmCFdSolver::rollback(): t0 (" << t0 << ") < t1 (" << t1 << ") required.");
-    if (steps == Null<Size>())
-        steps = std::max<Size>(1, static_cast<Size>(static_cast<double>(timeStepsPerYear_) * (t1 - t0) + 0.5));
-    Array workingArray(v.size());
-    v.copyToArray(workingArray);
-    solver_->rollback(workingArray, t1, t0, steps, 0);
+Size LgmFdSolver::timeSteps(const Real t1, const Real t0, const Size steps) const {
+    if (steps != Null<Size>())
+        return steps;
+    return std::max<Size>(1, static_cast<Size>(static_cast<double>(timeStepsPerYear_) * (t1 - t0) + 0.5));
+}
+
+RandomVariable LgmFdSolver::result(const Array& workingArray, const Real t0) const {
     if (QuantLib::close_enough(t0, 0.0)) {
         Array x = mesher_->locations(0);
         MonotonicCubicNaturalSpline interpolation(x.begin(), x.end(), workingArray.begin());
@@ -67,4 +65,56 @@ RandomVariable LgmFdSolver::rollback(const RandomVariable& v, const Real t1, con
     }
 }
 
+RandomVariable LgmFdSolver::rollback(const RandomVariable& v, const Real t1, const Real t0, Size steps) const {
+    if (QuantLib::close_enough(t0, t1) || v.deterministic())
+        return v;
+    QL_REQUIRE(t0 < t1, "LgmCFdSolver::rollback(): t0 (" << t0 << ") < t1 (" << t1 << ") required.");
+    Array workingArray(v.size());
+    v.copyToArray(workingArray);
+    solver_->rollback(workingArray, t1, t0, timeSteps(t1, t0, steps), 0);
+    return result(workingArray, t0);
+}
+
+std::vector<RandomVariable> LgmFdSolver::rollback(const std::vector<RandomVariable>& v, const Real t1,
+                                                  const Real t0, Size steps) const {
+    if (QuantLib::close_enough(t0, t1))
+        return v;
+    QL_REQUIRE(t0 < t1, "LgmCFdSolver::rollback(): t0 (" << t0 << ") < t1 (" << t1 << ") required.");
+
+    std::vector<Size> stochastic;
+    for (Size k = 0; k < v.size(); ++k) {
+        if (!v[k].deterministic())
+            stochastic.push_back(k);
+    }
+
+    // nothing to share between the arrays
+    if (stochastic.size() <= 1)
+        return LgmBackwardSolver::rollback(v, t1, t0, steps);
+
+    std::vector<Array> workingArrays;
+    workingArrays.reserve(stochastic.size());
+    for (auto k : stochastic) {
+        workingArrays.push_back(Array(v[k].size()));
+        v[k].copyToArray(workingArrays.back());
+    }
+
+    // same time grid as the single array rollback, all arrays take one step before the next step is taken, so
+    // that the operator, which is only updated on a change of the step variance, serves all of them
+    steps = timeSteps(t1, t0, steps);
+    Real dt = (t1 - t0) / static_cast<Real>(steps);
+    Real t = t1;
+    for (Size i = 0; i < steps; ++i, t -= dt) {
+        Real next = t - dt;
+        if (std::fabs(t0 - next) < std::sqrt(QL_EPSILON))
+            next = t0;
+        for (auto& a : workingArrays)
+            solver_->rollback(a, t, next, 1, 0);
+    }
+
+    std::vector<RandomVariable> res(v);
+    for (Size j = 0; j < stochastic.size(); ++j)
+        res[stochastic[j]] = result(workingArrays[j], t0);
+    return res;
+}
+
 } // namespace QuantExt
@@ -45,9 +45,16 @@ public:
     // if steps are not given, the time steps per year specified in the constructor
     RandomVariable rollback(const RandomVariable& v, const Real t1, const Real t0,
                             Size steps = Null<Size>()) const override;
+    /* the arrays are stepped through the time grid together, so that the operator is set up once per time step
+       for all of them instead of once per time step and array */
+    std::vector<RandomVariable> rollback(const std::vector<RandomVariable>& v, const Real t1, const Real t0,
+                                         Size steps = Null<Size>()) const override;
     const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model() const override;
 
 private:
+    Size timeSteps(const Real t1, const Real t0, const Size steps) const;
+    RandomVariable result(const Array& workingArray, const Real t0) const;
+
     QuantLib::ext::shared_ptr<LinearGaussMarkovModel> model_;
     Real maxTime_;
     QuantLib::FdmSchemeDesc scheme_;
@@ -27,6 +27,8 @@
 #include <qle/models/hullwhitebucketing.hpp>
 #include <functional>
 #include <iostream>
+#include <map>
+#include <mutex>
 
 // clang-format off
 namespace QuantExt {
@@ -87,14 +89,32 @@ private:
     mutable std::vector<std::vector<QuantLib::Real>> lgdVV_;
     // conditional probability of default with recovery rate, same dimension as lgdVV_
     mutable std::vector<std::vector<QuantLib::Real>> cprVV_;
-    
+
+    // common factor grid of the segment integration and the weights delta * density, date independent
+    std::vector<QuantLib::Real> factorNodes_;
+    std::vector<QuantLib::Real> factorDensities_;
+
+    // unconditional loss distributions by date and recovery rate together with the marginal probabilities, factor
+    // weights and recoveries they were built from, cleared on model reset
+    struct CachedDistribution {
+        std::vector<QuantLib::Real> prob;
+        std::vector<std::vector<QuantLib::Real>> factorWeights;
+        std::vector<QuantLib::Real> recoveries;
+        QuantLib::Distribution dist;
+    };
+    mutable std::map<std::pair<QuantLib::Date, QuantLib::Real>, CachedDistribution> distCache_;
+    // guards distCache_ and the mutable work members above, which the const pricing methods update
+    mutable std::mutex mutex_;
+
     QuantLib::Distribution lossDistrib(const QuantLib::Date& d, Real recoveryRate = Null<Real>()) const;
+    QuantLib::Distribution computeLossDistrib(const QuantLib::Date& d, const std::vector<QuantLib::Real>& prob,
+                                              Real recoveryRate = Null<Real>()) const;
     // update lgdVV_
     void updateLGDs(Real recoveryRate = Null<Real>()) const;
-    // update q_and c_
-    void updateThresholds(QuantLib::Date d, Real recoveryRate = Null<Real>()) const;
+    // update q_and c_ from the marginal default probabilities
+    void updateThresholds(const std::vector<QuantLib::Real>& prob, Real recoveryRate = Null<Real>()) const;
     // update cprVV_
-    std::vector<Real> updateCPRs(std::vector<QuantLib::Real> factor, Real recoveryRate = Null<Real>()) const;
+    std::vector<Real> updateCPRs(const std::vector<QuantLib::Real>& factor, Real recoveryRate = Null<Real>()) const;
 
     void resetModel() override;
 
@@ -162,6 +182,14 @@ PoolLossModel<CopulaPolicy>::PoolLossModel(
       detachAmount_(0.0) {
 
     QL_REQUIRE(copula->numFactors() == 1, "Multifactor PoolLossModel not yet implemented.");
+
+    // The factor nodes and their densities do not depend on the date, set them up once
+    QuantLib::Real factor = min_ + delta_ / 2.0;
+    for (QuantLib::Size k = 0; k < nSteps_; ++k) {
+        factorNodes_.push_back(factor);
+        factorDensities_.push_back(delta_ * copula_->density(std::vector<QuantLib::Real>(1, factor)));
+        factor += delta_;
+    }
 }
 
 template <class CopulaPolicy>
@@ -294,12 +322,9 @@ void PoolLossModel<CopulaPolicy>::updateLGDs(Real recoveryRate) const {
 }
 
 template <class CopulaPolicy>
-void PoolLossModel<CopulaPolicy>::updateThresholds(QuantLib::Date d, Real recoveryRate) const {
+void PoolLossModel<CopulaPolicy>::updateThresholds(const std::vector<QuantLib::Real>& prob, Real recoveryRate) const {
     // Initialize probability of default function Q and thresholds C according to spec
 
-    // Marginal probabilities of default for each remaining entity in basket
-    std::vector<QuantLib::Real> prob = basket_->remainingProbabilities(d);
-
     q_.resize(notionals_.size());
     c_.resize(notionals_.size());
 
@@ -355,36 +380,40 @@ std::vector<std::vector<Real>> PoolLossModel<CopulaPolicy>::marginalProbabilitie
 }
 
 template <class CopulaPolicy>
-std::vector<Real> PoolLossModel<CopulaPolicy>::updateCPRs(std::vector<QuantLib::Real> factor, Real recoveryRate) const {
+std::vector<Real> PoolLossModel<CopulaPolicy>::updateCPRs(const std::vector<QuantLib::Real>& factor, Real recoveryRate) const {
     cprVV_.clear();
 
+    // Vector of default probabilities conditional on the common market factor M: P(\tau_i < t | M = m).
+    // Each conditional probability is evaluated once per threshold and reused below.
+    std::vector<Real> probs(c_.size());
+
     Real tiny = 1.0e-10;
     if (useStochasticRecovery_ && recoveryRate == Null<Real>()) {
         cprVV_.resize(notionals_.size(), std::vector<Real>());
+        std::vector<Real> cp;
         for (Size i = 0; i < c_.size(); ++i) {
+            cp.resize(c_[i].size());
+            for (Size j = 0; j < c_[i].size(); ++j)
+                cp[j] = copula_->conditionalDefaultProbabilityInvP(c_[i][j], i, factor);
             cprVV_[i].resize(c_[i].size() - 1, 0.0);
-            Real pd = copula_->conditionalDefaultProbabilityInvP(c_[i][0], i, factor);
+            Real pd = cp[0];
             Real sum = 0.0;
             for (Size j = 1; j < c_[i].size(); ++j) {
                 // probability of recovery j conditional on default of i
-                cprVV_[i][j-1] = copula_->conditionalDefaultProbabilityInvP(c_[i][j-1], i, factor)
-                    - copula_->conditionalDefaultProbabilityInvP(c_[i][j], i, factor);
+                cprVV_[i][j-1] = cp[j-1] - cp[j];
                 sum += cprVV_[i][j-1];
             }
             QL_REQUIRE(fabs(sum - pd) < tiny, "probability check failed for factor0 " << factor[0]);
+            probs[i] = pd;
         }
     }
     else {
         cprVV_.resize(notionals_.size(), std::vector<Real>(1, 0));
         for (Size i = 0; i < c_.size(); ++i) {
             cprVV_[i][0] = copula_->conditionalDefaultProbabilityInvP(c_[i][0], i, factor);
+            probs[i] = cprVV_[i][0];
         }
     }
-    
-    // Vector of default probabilities conditional on the common market factor M: P(\tau_i < t | M = m).
-    std::vector<Real> probs;
-    for (Size i = 0; i < c_.size(); i++)
-        probs.push_back(copula_->conditionalDefaultProbabilityInvP(c_[i][0], i, factor));
 
     return probs;
 }
@@ -399,11 +428,39 @@ void PoolLossModel<CopulaPolicy>::resetModel() {
     attachAmount_ = basket_->remainingAttachmentAmount();
     detachAmount_ = basket_->remainingDetachmentAmount();
     copula_->resetBasket(basket_.currentLink());
+    std::lock_guard<std::mutex> lock(mutex_);
+    distCache_.clear();
 }
     
 template <class CopulaPolicy>
 QuantLib::Distribution PoolLossModel<CopulaPolicy>::lossDistrib(const QuantLib::Date& d, Real recoveryRate) const {
 
+    // Marginal probabilities of default for each remaining entity in basket
+    std::vector<QuantLib::Real> prob = basket_->remainingProbabilities(d);
+
+    // Reuse the distribution if neither the marginal probabilities, the correlation nor the recoveries changed since it
+    // was built, e.g. when the tranche is repriced for a move in the discount curve only
+    const std::vector<std::vector<QuantLib::Real>>& factorWeights = copula_->factorWeights();
+    const std::vector<QuantLib::Real>& recoveries = copula_->recoveries();
+    auto key = std::make_pair(d, recoveryRate);
+
+    // the computation below updates the mutable work members, so the lock is held until the cache is updated
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto cached = distCache_.find(key);
+    if (cached != distCache_.end() && cached->second.prob == prob && cached->second.factorWeights == factorWeights &&
+        cached->second.recoveries == recoveries)
+        return cached->second.dist;
+
+    QuantLib::Distribution dist = computeLossDistrib(d, prob, recoveryRate);
+    distCache_[key] = CachedDistribution{prob, factorWeights, recoveries, dist};
+    return dist;
+}
+
+template <class CopulaPolicy>
+QuantLib::Distribution PoolLossModel<CopulaPolicy>::computeLossDistrib(const QuantLib::Date& d,
+                                                                       const std::vector<QuantLib::Real>& prob,
+                                                                       Real recoveryRate) const {
+
     bool check = false;
     
     Real maximum = detachAmount_; 
@@ -413,7 +470,7 @@ QuantLib::Distribution PoolLossModel<CopulaPolicy>::lossDistrib(const QuantLib::
     updateLGDs(recoveryRate);
 
     // Update probabilities qij and thresholds cij, needs to stay here because date dependent
-    updateThresholds(d, recoveryRate);
+    updateThresholds(prob, recoveryRate);
 
     // Init bucketing class
     HullWhiteBucketing hwb(minimum, maximum, nBuckets_);
@@ -438,8 +495,6 @@ QuantLib::Distribution PoolLossModel<CopulaPolicy>::lossDistrib(const QuantLib::
         // FIXME: Ensure quadrature works with stochastic recovery
 
         QuantLib::GaussHermiteIntegration Integrator(nSteps_);
-        // Marginal probabilities for each remaining entity in basket, P(\tau_i < t).
-        std::vector<QuantLib::Real> prob = basket_->remainingProbabilities(d);
         LossModelConditionalDist<CopulaPolicy> lmcd(copula_, bucketing, prob, lgd_);
 
         for (QuantLib::Size j = 0; j < nBuckets_; j++) {
@@ -455,10 +510,11 @@ QuantLib::Distribution PoolLossModel<CopulaPolicy>::lossDistrib(const QuantLib::
 
     } else {
 
-        std::vector<QuantLib::Real> factor{ min_ + delta_ / 2.0 };      
+        std::vector<QuantLib::Real> factor(1);
 
         for (QuantLib::Size k = 0; k < nSteps_; k++) {
-            
+
+            factor[0] = factorNodes_[k];
             std::vector<Real> cpr = updateCPRs(factor, recoveryRate);
 
             // Loss distribution up to date d conditional on common factor M = m.
@@ -486,7 +542,7 @@ QuantLib::Distribution PoolLossModel<CopulaPolicy>::lossDistrib(const QuantLib::
             }
 
             // Update final distribution with contribution from common factor M = m.
-            Real densitydm = delta_ * copula_->density(factor);
+            Real densitydm = factorDensities_[k];
 
             if (useQlBucketing) {
                 for (Size j = 0; j < nBuckets_; j++) {
@@ -511,9 +567,6 @@ QuantLib::Distribution PoolLossModel<CopulaPolicy>::lossDistrib(const QuantLib::
                     A[j-1] += hwb.averageLoss()[j] * densitydm;
                 }
             }
-            
-            // Move to next value of common factor in [min,max] region.
-            factor[0] += delta_;
         }
 
         if (!useQlBucketing) {
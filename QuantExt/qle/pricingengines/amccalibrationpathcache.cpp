@@ -0,0 +1,176 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <qle/pricingengines/amccalibrationpathcache.hpp>
+
+#include <tuple>
+
+namespace QuantExt {
+
+bool AmcRegressionFactorisations::Key::operator<(const Key& k) const {
+    return std::tie(polynomOrder, polynomType, regressionVarianceCutoff, regressorTimesModelIndices) <
+           std::tie(k.polynomOrder, k.polynomType, k.regressionVarianceCutoff, k.regressorTimesModelIndices);
+}
+
+QuantLib::ext::shared_ptr<const RegressionFactorisation> AmcRegressionFactorisations::factorisation(
+    const Key& key, const std::function<QuantLib::ext::shared_ptr<const RegressionFactorisation>()>& make) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto f = factorisations_.find(key);
+        if (f != factorisations_.end()) {
+            ++hits_;
+            return f->second;
+        }
+    }
+    auto f = make();
+    std::lock_guard<std::mutex> lock(mutex_);
+    // keep the factorisation of another thread that computed it in the meantime
+    return factorisations_.insert(std::make_pair(key, f)).first->second;
+}
+
+Size AmcRegressionFactorisations::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return factorisations_.size();
+}
+
+Size AmcRegressionFactorisations::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+bool AmcCalibrationPathCache::Key::operator<(const Key& k) const {
+    return std::tie(samples, sequenceType, seed, ordering, directionIntegers, times, stdDevs) <
+           std::tie(k.samples, k.sequenceType, k.seed, k.ordering, k.directionIntegers, k.times, k.stdDevs);
+}
+
+void AmcCalibrationPathCache::setMemoryBudget(const Size bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    memoryBudget_ = bytes;
+    evict(memoryBudget_);
+}
+
+Size AmcCalibrationPathCache::memoryBudget() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memoryBudget_;
+}
+
+bool AmcCalibrationPathCache::enabled() const { return memoryBudget() > 0; }
+
+QuantLib::ext::shared_ptr<const AmcCalibrationPathCache::Paths>
+AmcCalibrationPathCache::paths(const Key& key, const std::function<Paths()>& generate) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto e = entries_.find(key);
+        if (e != entries_.end()) {
+            ++hits_;
+            lru_.splice(lru_.begin(), lru_, e->second.lruPos);
+            return e->second.paths;
+        }
+        ++misses_;
+    }
+
+    auto p = QuantLib::ext::make_shared<const Paths>(generate());
+    Size m = memory(*p);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // another thread might have generated the same paths in the meantime
+    auto e = entries_.find(key);
+    if (e != entries_.end()) {
+        lru_.splice(lru_.begin(), lru_, e->second.lruPos);
+        return e->second.paths;
+    }
+
+    if (m > memoryBudget_)
+        return p;
+
+    evict(memoryBudget_ - m);
+    lru_.push_front(key);
+    entries_[key] = Entry{p, nullptr, m, lru_.begin()};
+    memoryUsage_ += m;
+    return p;
+}
+
+QuantLib::ext::shared_ptr<AmcRegressionFactorisations> AmcCalibrationPathCache::factorisations(const Key& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!shareRegressionFactorisations_)
+        return nullptr;
+    auto e = entries_.find(key);
+    if (e == entries_.end())
+        return nullptr;
+    if (e->second.factorisations == nullptr)
+        e->second.factorisations = QuantLib::ext::make_shared<AmcRegressionFactorisations>();
+    return e->second.factorisations;
+}
+
+void AmcCalibrationPathCache::setShareRegressionFactorisations(const bool b) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shareRegressionFactorisations_ = b;
+}
+
+bool AmcCalibrationPathCache::shareRegressionFactorisations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return shareRegressionFactorisations_;
+}
+
+void AmcCalibrationPathCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+    memoryUsage_ = 0;
+    hits_ = misses_ = 0;
+}
+
+Size AmcCalibrationPathCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+Size AmcCalibrationPathCache::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memoryUsage_;
+}
+
+Size AmcCalibrationPathCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+Size AmcCalibrationPathCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+Size AmcCalibrationPathCache::memory(const Paths& p) {
+    Size m = 0;
+    for (auto const& v : p)
+        for (auto const& r : v)
+            m += r.deterministic() ? sizeof(Real) : r.size() * sizeof(Real);
+    return m;
+}
+
+void AmcCalibrationPathCache::evict(const Size budget) {
+    while (memoryUsage_ > budget && !lru_.empty()) {
+        auto e = entries_.find(lru_.back());
+        memoryUsage_ -= e->second.memory;
+        entries_.erase(e);
+        lru_.pop_back();
+    }
+}
+
+} // namespace QuantExt
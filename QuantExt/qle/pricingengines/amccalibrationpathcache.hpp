@@ -0,0 +1,157 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file amccalibrationpathcache.hpp
+    \brief cache for amc calibration paths shared across trades
+    \ingroup engines
+*/
+
+#pragma once
+
+#include <qle/math/randomvariable.hpp>
+#include <qle/methods/multipathgeneratorbase.hpp>
+
+#include <ql/methods/montecarlo/lsmbasissystem.hpp>
+#include <ql/patterns/singleton.hpp>
+
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace QuantExt {
+
+//! Regression design matrix factorisations on a fixed set of calibration paths
+/*! On a fixed set of calibration paths the design matrix of an unfiltered regression is determined by the regressors
+    (the observed states at the observed times), the basis system and the factor reduction cutoff. Regressions sharing
+    these can use the same factorisation, which is computed once and then shared. This is the case for the several
+    regressions an amc engine performs per observation time, and for trades with the same regressor specification
+    sharing the paths via the AmcCalibrationPathCache.
+
+    \ingroup engines
+*/
+class AmcRegressionFactorisations {
+public:
+    struct Key {
+        std::set<std::pair<Real, Size>> regressorTimesModelIndices;
+        Size polynomOrder;
+        LsmBasisSystem::PolynomialType polynomType;
+        Real regressionVarianceCutoff;
+        bool operator<(const Key& k) const;
+    };
+
+    /*! Returns the factorisation for the given key, if it is not yet stored, it is computed using the given function.
+        The computation is done outside the lock. */
+    QuantLib::ext::shared_ptr<const RegressionFactorisation>
+    factorisation(const Key& key, const std::function<QuantLib::ext::shared_ptr<const RegressionFactorisation>()>& make);
+
+    Size size() const;
+    Size hits() const;
+
+private:
+    mutable std::mutex mutex_;
+    Size hits_ = 0;
+    std::map<Key, QuantLib::ext::shared_ptr<const RegressionFactorisation>> factorisations_;
+};
+
+//! Cache for amc calibration paths
+/*! Holds calibration paths generated by the amc engines, so that trades requiring the same paths can share them
+    instead of generating them again. The paths are handed out as shared pointers to const, i.e. they are read only
+    and can be used concurrently by several engines.
+
+    The key identifies the paths by their content rather than by the model they were generated from: for the one
+    dimensional LGM state process the paths are fully determined by the standard deviations of the state variable
+    increments on the time grid and the settings of the path generator. A recalibration or a bumped volatility
+    therefore leads to a different key and never to stale paths.
+
+    The cache is bounded by a memory budget given in bytes. If an insertion exceeds the budget, the least recently
+    used entries are evicted. A budget of zero (the default) disables the cache.
+
+    If the sharing of regression factorisations is enabled, each entry also carries an AmcRegressionFactorisations
+    instance that is shared by all trades using the paths. The factorisations are not accounted for in the memory
+    budget, they require about as much memory as the paths per stored regressor specification and basis function.
+
+    \ingroup engines
+*/
+class AmcCalibrationPathCache
+    : public QuantLib::Singleton<AmcCalibrationPathCache, std::integral_constant<bool, true>> {
+    friend class QuantLib::Singleton<AmcCalibrationPathCache, std::integral_constant<bool, true>>;
+
+public:
+    typedef std::vector<std::vector<RandomVariable>> Paths;
+
+    struct Key {
+        std::vector<Real> times;
+        std::vector<Real> stdDevs;
+        SequenceType sequenceType;
+        BigNatural seed;
+        SobolBrownianGenerator::Ordering ordering;
+        SobolRsg::DirectionIntegers directionIntegers;
+        Size samples;
+        bool operator<(const Key& k) const;
+    };
+
+    //! Sets the memory budget in bytes, zero disables the cache, existing entries exceeding the budget are evicted
+    void setMemoryBudget(const Size bytes);
+    Size memoryBudget() const;
+    bool enabled() const;
+
+    /*! Returns the paths for the given key. If they are not cached, they are generated using the given function and
+        stored in the cache if the memory budget allows for that. The generation is done outside the lock. */
+    QuantLib::ext::shared_ptr<const Paths> paths(const Key& key, const std::function<Paths()>& generate);
+
+    /*! Returns the regression factorisations attached to the cached paths for the given key, or a null pointer if the
+        paths are not cached or the sharing of regression factorisations is disabled. */
+    QuantLib::ext::shared_ptr<AmcRegressionFactorisations> factorisations(const Key& key);
+
+    //! Enables the sharing of regression factorisations between regressions with the same design matrix
+    void setShareRegressionFactorisations(const bool b);
+    bool shareRegressionFactorisations() const;
+
+    //! Removes all entries and resets the statistics
+    void clear();
+
+    Size size() const;
+    Size memoryUsage() const;
+    Size hits() const;
+    Size misses() const;
+
+private:
+    AmcCalibrationPathCache() = default;
+    static Size memory(const Paths& p);
+    void evict(const Size budget);
+
+    struct Entry {
+        QuantLib::ext::shared_ptr<const Paths> paths;
+        QuantLib::ext::shared_ptr<AmcRegressionFactorisations> factorisations;
+        Size memory;
+        std::list<Key>::iterator lruPos;
+    };
+
+    mutable std::mutex mutex_;
+    Size memoryBudget_ = 0;
+    bool shareRegressionFactorisations_ = false;
+    Size memoryUsage_ = 0;
+    Size hits_ = 0, misses_ = 0;
+    std::map<Key, Entry> entries_;
+    // most recently used key at the front
+    std::list<Key> lru_;
+};
+
+} // namespace QuantExt
@@ -26,6 +26,7 @@
 #include <qle/cashflows/overnightindexedcoupon.hpp>
 #include <qle/cashflows/subperiodscoupon.hpp>
 #include <qle/math/randomvariablelsmbasissystem.hpp>
+#include <qle/methods/batchmultipathgenerator.hpp>
 #include <qle/pricingengines/mcmultilegbaseengine.hpp>
 #include <qle/processes/irlgm1fstateprocess.hpp>
 
@@ -782,41 +783,59 @@ void McMultiLegBaseEngine::calculate() const {
 
     QL_REQUIRE(!simulationTimes.empty(),
                "McMultiLegBaseEngine::calculate(): no simulation times, this is not expected.");
-    std::vector<std::vector<RandomVariable>> pathValues(
-        simulationTimes.size(),
-        std::vector<RandomVariable>(model_->stateProcess()->size(), RandomVariable(calibrationSamples_)));
-    std::vector<std::vector<const RandomVariable*>> pathValuesRef(
-        simulationTimes.size(), std::vector<const RandomVariable*>(model_->stateProcess()->size()));
-
-    for (Size i = 0; i < pathValues.size(); ++i) {
-        for (Size j = 0; j < pathValues[i].size(); ++j) {
-            pathValues[i][j].expand();
-            pathValuesRef[i][j] = &pathValues[i][j];
-        }
-    }
-
     TimeGrid timeGrid(simulationTimes.begin(), simulationTimes.end());
 
     QuantLib::ext::shared_ptr<StochasticProcess> process = model_->stateProcess();
+    QuantLib::ext::shared_ptr<IrLgm1fStateProcess> lgmProcess;
     if (model_->dimension() == 1) {
         // use lgm process if possible for better performance
-        auto tmp = QuantLib::ext::make_shared<IrLgm1fStateProcess>(model_->irlgm1f(0));
-        tmp->resetCache(timeGrid.size() - 1);
-        process = tmp;
+        lgmProcess = QuantLib::ext::make_shared<IrLgm1fStateProcess>(model_->irlgm1f(0));
+        lgmProcess->resetCache(timeGrid.size() - 1);
+        process = lgmProcess;
     } else if (auto tmp = QuantLib::ext::dynamic_pointer_cast<CrossAssetStateProcess>(process)) {
         // enable cache
         tmp->resetCache(timeGrid.size() - 1);
     }
 
-    auto pathGenerator = makeMultiPathGenerator(calibrationPathGenerator_, process, timeGrid, calibrationSeed_,
-                                                ordering_, directionIntegers_);
+    auto generatePaths = [this, &simulationTimes, &process, &timeGrid]() {
+        AmcCalibrationPathCache::Paths paths(
+            simulationTimes.size(), std::vector<RandomVariable>(process->size(), RandomVariable(calibrationSamples_)));
+        BatchMultiPathGenerator pathGenerator(calibrationPathGenerator_, process, timeGrid, calibrationSeed_, ordering_,
+                                              directionIntegers_);
+        pathGenerator.next(paths);
+        return paths;
+    };
+
+    /* the one dimensional lgm paths are determined by the state standard deviations on the time grid, so they can be
+       shared with other trades via the calibration path cache, multi dimensional paths also depend on the curves */
+    QuantLib::ext::shared_ptr<const AmcCalibrationPathCache::Paths> pathValuesPtr;
+    QuantLib::ext::shared_ptr<AmcRegressionFactorisations> factorisations;
+    if (lgmProcess && AmcCalibrationPathCache::instance().enabled()) {
+        AmcCalibrationPathCache::Key key{std::vector<Real>(timeGrid.begin() + 1, timeGrid.end()),
+                                         std::vector<Real>(timeGrid.size() - 1),
+                                         calibrationPathGenerator_,
+                                         calibrationSeed_,
+                                         ordering_,
+                                         directionIntegers_,
+                                         calibrationSamples_};
+        for (Size j = 0; j < key.stdDevs.size(); ++j)
+            key.stdDevs[j] = lgmProcess->stdDeviation(timeGrid[j], 0.0, timeGrid.dt(j));
+        pathValuesPtr = AmcCalibrationPathCache::instance().paths(key, generatePaths);
+        // trades sharing the paths also share the regression factorisations on them
+        factorisations = AmcCalibrationPathCache::instance().factorisations(key);
+    } else {
+        pathValuesPtr = QuantLib::ext::make_shared<const AmcCalibrationPathCache::Paths>(generatePaths());
+    }
+    if (factorisations == nullptr && AmcCalibrationPathCache::instance().shareRegressionFactorisations())
+        factorisations = QuantLib::ext::make_shared<AmcRegressionFactorisations>();
+    const AmcCalibrationPathCache::Paths& pathValues = *pathValuesPtr;
 
-    for (Size i = 0; i < calibrationSamples_; ++i) {
-        const MultiPath& path = pathGenerator->next().value;
-        for (Size j = 0; j < simulationTimes.size(); ++j) {
-            for (Size k = 0; k < model_->stateProcess()->size(); ++k) {
-                pathValues[j][k].data()[i] = path[k][j + 1];
-            }
+    std::vector<std::vector<const RandomVariable*>> pathValuesRef(
+        simulationTimes.size(), std::vector<const RandomVariable*>(model_->stateProcess()->size()));
+
+    for (Size i = 0; i < pathValues.size(); ++i) {
+        for (Size j = 0; j < pathValues[i].size(); ++j) {
+            pathValuesRef[i][j] = &pathValues[i][j];
         }
     }
 
@@ -878,7 +897,7 @@ void McMultiLegBaseEngine::calculate() const {
                 *t, cashflowInfo, [&cfStatus](std::size_t i) { return cfStatus[i] == CfStatus::done; }, **model_,
                 regressorModel_, regressionVarianceCutoff_);
             regModelUndExInto[counter].train(polynomOrder_, polynomType_, pathValueUndExInto, pathValuesRef,
-                                             simulationTimes);
+                                             simulationTimes, Filter(), factorisations.get());
         }
 
         if (isExerciseTime) {
@@ -898,7 +917,8 @@ void McMultiLegBaseEngine::calculate() const {
             regModelOption[counter] = RegressionModel(
                 *t, cashflowInfo, [&cfStatus](std::size_t i) { return cfStatus[i] == CfStatus::done; }, **model_,
                 regressorModel_, regressionVarianceCutoff_);
-            regModelOption[counter].train(polynomOrder_, polynomType_, pathValueOption, pathValuesRef, simulationTimes);
+            regModelOption[counter].train(polynomOrder_, polynomType_, pathValueOption, pathValuesRef, simulationTimes,
+                                          Filter(), factorisations.get());
         }
 
         if (isXvaTime) {
@@ -906,14 +926,15 @@ void McMultiLegBaseEngine::calculate() const {
                 *t, cashflowInfo, [&cfStatus](std::size_t i) { return cfStatus[i] != CfStatus::open; }, **model_,
                 regressorModel_, regressionVarianceCutoff_);
             regModelUndDirty[counter].train(polynomOrder_, polynomType_, pathValueUndDirty, pathValuesRef,
-                                            simulationTimes);
+                                            simulationTimes, Filter(), factorisations.get());
         }
 
         if (exercise_ != nullptr) {
             regModelOption[counter] = RegressionModel(
                 *t, cashflowInfo, [&cfStatus](std::size_t i) { return cfStatus[i] == CfStatus::done; }, **model_,
                 regressorModel_, regressionVarianceCutoff_);
-            regModelOption[counter].train(polynomOrder_, polynomType_, pathValueOption, pathValuesRef, simulationTimes);
+            regModelOption[counter].train(polynomOrder_, polynomType_, pathValueOption, pathValuesRef, simulationTimes,
+                                          Filter(), factorisations.get());
         }
 
         --counter;
@@ -1149,7 +1170,8 @@ void McMultiLegBaseEngine::RegressionModel::train(const Size polynomOrder,
                                                   const LsmBasisSystem::PolynomialType polynomType,
                                                   const RandomVariable& regressand,
                                                   const std::vector<std::vector<const RandomVariable*>>& paths,
-                                                  const std::set<Real>& pathTimes, const Filter& filter) {
+                                                  const std::set<Real>& pathTimes, const Filter& filter,
+                                                  AmcRegressionFactorisations* factorisations) {
 
     // check if the model is in the correct state
 
@@ -1184,10 +1206,19 @@ void McMultiLegBaseEngine::RegressionModel::train(const Size polynomOrder,
 
         basisFns_ = multiPathBasisSystem(regressor.size(), polynomOrder, polynomType, Null<Size>());
 
-        // compute the regression coefficients
+        // compute the regression coefficients, reusing the design matrix factorisation if possible
 
-        regressionCoeffs_ =
-            regressionCoefficients(regressand, regressor, basisFns_, filter, RandomVariableRegressionMethod::QR);
+        if (factorisations != nullptr && !filter.initialised()) {
+            auto factorisation = factorisations->factorisation(
+                {regressorTimesModelIndices_, polynomOrder, polynomType, regressionVarianceCutoff_},
+                [&regressor, this]() {
+                    return QuantLib::ext::make_shared<const RegressionFactorisation>(regressor, basisFns_);
+                });
+            regressionCoeffs_ = factorisation->solve(regressand);
+        } else {
+            regressionCoeffs_ =
+                regressionCoefficients(regressand, regressor, basisFns_, filter, RandomVariableRegressionMethod::QR);
+        }
 
     } else {
 
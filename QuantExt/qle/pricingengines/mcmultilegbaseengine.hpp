@@ -29,6 +29,7 @@
 #include <qle/models/crossassetmodel.hpp>
 #include <qle/models/lgmvectorised.hpp>
 #include <qle/pricingengines/amccalculator.hpp>
+#include <qle/pricingengines/amccalibrationpathcache.hpp>
 
 #include <ql/indexes/interestrateindex.hpp>
 #include <ql/instruments/swaption.hpp>
@@ -142,10 +143,12 @@ private:
         RegressionModel(const Real observationTime, const std::vector<CashflowInfo>& cashflowInfo,
                         const std::function<bool(std::size_t)>& cashflowRelevant, const CrossAssetModel& model,
                         const RegressorModel regressorModel, const Real regressionVarianceCutoff = Null<Real>());
-        // pathTimes must contain the observation time and the relevant cashflow simulation times
+        /* pathTimes must contain the observation time and the relevant cashflow simulation times, if factorisations
+           are given and no filter is used, the design matrix factorisation is taken from / stored there */
         void train(const Size polynomOrder, const LsmBasisSystem::PolynomialType polynomType,
                    const RandomVariable& regressand, const std::vector<std::vector<const RandomVariable*>>& paths,
-                   const std::set<Real>& pathTimes, const Filter& filter = Filter());
+                   const std::set<Real>& pathTimes, const Filter& filter = Filter(),
+                   AmcRegressionFactorisations* factorisations = nullptr);
         // pathTimes do not need to contain the observation time or the relevant cashflow simulation times
         RandomVariable apply(const Array& initialState, const std::vector<std::vector<const RandomVariable*>>& paths,
                              const std::set<Real>& pathTimes) const;
@@ -486,16 +486,22 @@ void NumericLgmMultiLegOptionEngineBase::calculate() const {
         // roll back
 
         if (t_from != t_to) {
-            underlyingNpv = solver_->rollback(underlyingNpv, t_from, t_to);
-            optionNpv = solver_->rollback(optionNpv, t_from, t_to);
+            // roll back all values in one call, so that the solver can share the time stepping between them
+            std::vector<RandomVariable*> values{&underlyingNpv, &optionNpv};
             for (auto& c : cache) {
-                if (!c.initialised())
-                    continue;
-                c = solver_->rollback(c, t_from, t_to);
+                if (c.initialised())
+                    values.push_back(&c);
             }
             // need to roll back provisionalNpv only for the last step t_1 -> t_0 = 0
             if (it == std::next(timeGrid.rend(), -1))
-                provisionalNpv = solver_->rollback(provisionalNpv, t_from, t_to);
+                values.push_back(&provisionalNpv);
+            std::vector<RandomVariable> batch;
+            batch.reserve(values.size());
+            for (auto v : values)
+                batch.push_back(std::move(*v));
+            batch = solver_->rollback(batch, t_from, t_to);
+            for (Size i = 0; i < values.size(); ++i)
+                *values[i] = std::move(batch[i]);
         }
     }
 
@@ -525,8 +531,9 @@ NumericLgmMultiLegOptionEngine::NumericLgmMultiLegOptionEngine(const QuantLib::e
                                                                const Real sy, const Size ny, const Real sx,
                                                                const Size nx,
                                                                const Handle<YieldTermStructure>& discountCurve,
-                                                               const Size americanExerciseTimeStepsPerYear)
-    : NumericLgmMultiLegOptionEngineBase(QuantLib::ext::make_shared<LgmConvolutionSolver2>(model, sy, ny, sx, nx),
+                                                               const Size americanExerciseTimeStepsPerYear,
+                                                               const LgmConvolutionSolver2::Method method)
+    : NumericLgmMultiLegOptionEngineBase(QuantLib::ext::make_shared<LgmConvolutionSolver2>(model, sy, ny, sx, nx, method),
                                          discountCurve, americanExerciseTimeStepsPerYear) {
     registerWith(solver_->model());
     registerWith(discountCurve_);
@@ -564,8 +571,9 @@ void NumericLgmMultiLegOptionEngine::calculate() const {
 NumericLgmSwaptionEngine::NumericLgmSwaptionEngine(const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model,
                                                    const Real sy, const Size ny, const Real sx, const Size nx,
                                                    const Handle<YieldTermStructure>& discountCurve,
-                                                   const Size americanExerciseTimeStepsPerYear)
-    : NumericLgmMultiLegOptionEngineBase(QuantLib::ext::make_shared<LgmConvolutionSolver2>(model, sy, ny, sx, nx),
+                                                   const Size americanExerciseTimeStepsPerYear,
+                                                   const LgmConvolutionSolver2::Method method)
+    : NumericLgmMultiLegOptionEngineBase(QuantLib::ext::make_shared<LgmConvolutionSolver2>(model, sy, ny, sx, nx, method),
                                          discountCurve, americanExerciseTimeStepsPerYear) {
     registerWith(solver_->model());
     registerWith(discountCurve_);
@@ -604,8 +612,9 @@ void NumericLgmSwaptionEngine::calculate() const {
 
 NumericLgmNonstandardSwaptionEngine::NumericLgmNonstandardSwaptionEngine(
     const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model, const Real sy, const Size ny, const Real sx, const Size nx,
-    const Handle<YieldTermStructure>& discountCurve, const Size americanExerciseTimeStepsPerYear)
-    : NumericLgmMultiLegOptionEngineBase(QuantLib::ext::make_shared<LgmConvolutionSolver2>(model, sy, ny, sx, nx),
+    const Handle<YieldTermStructure>& discountCurve, const Size americanExerciseTimeStepsPerYear,
+    const LgmConvolutionSolver2::Method method)
+    : NumericLgmMultiLegOptionEngineBase(QuantLib::ext::make_shared<LgmConvolutionSolver2>(model, sy, ny, sx, nx, method),
                                          discountCurve, americanExerciseTimeStepsPerYear) {
     registerWith(solver_->model());
     registerWith(discountCurve_);
@@ -21,6 +21,7 @@
 
 #include <qle/instruments/multilegoption.hpp>
 #include <qle/models/lgmbackwardsolver.hpp>
+#include <qle/models/lgmconvolutionsolver2.hpp>
 #include <qle/models/lgmvectorised.hpp>
 
 #include <ql/instruments/nonstandardswaption.hpp>
@@ -91,7 +92,8 @@ public:
     NumericLgmMultiLegOptionEngine(const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model, const Real sy, const Size ny,
                                    const Real sx, const Size nx,
                                    const Handle<YieldTermStructure>& discountCurve = Handle<YieldTermStructure>(),
-                                   const Size americanExerciseTimeStepsPerYear = 24);
+                                   const Size americanExerciseTimeStepsPerYear = 24,
+                                   const LgmConvolutionSolver2::Method method = LgmConvolutionSolver2::Method::Direct);
 
     NumericLgmMultiLegOptionEngine(const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model, const Real maxTime = 50.0,
                                    const QuantLib::FdmSchemeDesc scheme = QuantLib::FdmSchemeDesc::Douglas(),
@@ -109,7 +111,8 @@ public:
     NumericLgmSwaptionEngine(const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model, const Real sy, const Size ny,
                              const Real sx, const Size nx,
                              const Handle<YieldTermStructure>& discountCurve = Handle<YieldTermStructure>(),
-                             const Size americanExerciseTimeStepsPerYear = 24);
+                             const Size americanExerciseTimeStepsPerYear = 24,
+                             const LgmConvolutionSolver2::Method method = LgmConvolutionSolver2::Method::Direct);
 
     NumericLgmSwaptionEngine(const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model, const Real maxTime = 50.0,
                              const QuantLib::FdmSchemeDesc scheme = QuantLib::FdmSchemeDesc::Douglas(),
@@ -128,7 +131,8 @@ public:
     NumericLgmNonstandardSwaptionEngine(const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model, const Real sy,
                                         const Size ny, const Real sx, const Size nx,
                                         const Handle<YieldTermStructure>& discountCurve = Handle<YieldTermStructure>(),
-                                        const Size americanExerciseTimeStepsPerYear = 24);
+                                        const Size americanExerciseTimeStepsPerYear = 24,
+                                        const LgmConvolutionSolver2::Method method = LgmConvolutionSolver2::Method::Direct);
 
     NumericLgmNonstandardSwaptionEngine(const QuantLib::ext::shared_ptr<LinearGaussMarkovModel>& model,
                                         const Real maxTime = 50.0,
@@ -227,6 +227,7 @@
 #include <qle/math/computeenvironment.hpp>
 #include <qle/math/constantinterpolation.hpp>
 #include <qle/math/covariancesalvage.hpp>
+#include <qle/math/csrmatrix.hpp>
 #include <qle/math/deltagammavar.hpp>
 #include <qle/math/differentialevolution_mt.hpp>
 #include <qle/math/discretedistribution.hpp>
@@ -249,6 +250,7 @@
 #include <qle/math/stabilisedglls.hpp>
 #include <qle/math/stoplightbounds.hpp>
 #include <qle/math/trace.hpp>
+#include <qle/methods/batchmultipathgenerator.hpp>
 #include <qle/methods/brownianbridgepathinterpolator.hpp>
 #include <qle/methods/fdmblackscholesmesher.hpp>
 #include <qle/methods/fdmblackscholesop.hpp>
@@ -354,6 +356,7 @@
 #include <qle/models/zeroinflationmodeltermstructure.hpp>
 #include <qle/pricingengines/accrualbondrepoengine.hpp>
 #include <qle/pricingengines/amccalculator.hpp>
+#include <qle/pricingengines/amccalibrationpathcache.hpp>
 #include <qle/pricingengines/analyticbarrierengine.hpp>
 #include <qle/pricingengines/analyticcashsettledeuropeanengine.hpp>
 #include <qle/pricingengines/analyticcclgmfxoptionengine.hpp>
@@ -0,0 +1,104 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+// clang-format off
+#include <boost/test/unit_test.hpp>
+// clang-format on
+
+#include <qle/pricingengines/amccalibrationpathcache.hpp>
+
+#include "toplevelfixture.hpp"
+
+using namespace QuantLib;
+using namespace QuantExt;
+
+using namespace boost::unit_test_framework;
+
+BOOST_FIXTURE_TEST_SUITE(QuantExtTestSuite, qle::test::TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(AmcCalibrationPathCacheTest)
+
+namespace {
+AmcCalibrationPathCache::Key makeKey(const Real stdDev, const Size samples) {
+    return AmcCalibrationPathCache::Key{
+        {1.0, 2.0}, {stdDev, stdDev}, SobolBrownianBridge, 42, SobolBrownianGenerator::Steps, SobolRsg::JoeKuoD7,
+        samples};
+}
+
+AmcCalibrationPathCache::Paths makePaths(const Size samples, Size& calls) {
+    ++calls;
+    AmcCalibrationPathCache::Paths paths(2, std::vector<RandomVariable>(1, RandomVariable(samples, 1.0)));
+    for (auto& p : paths)
+        p[0].expand();
+    return paths;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(testSharingAndEviction) {
+
+    BOOST_TEST_MESSAGE("Testing amc calibration path cache sharing and eviction...");
+
+    auto& cache = AmcCalibrationPathCache::instance();
+    cache.clear();
+
+    Size calls = 0;
+    const Size samples = 1000, pathMemory = 2 * samples * sizeof(Real);
+
+    // disabled cache generates but does not store the paths
+    cache.setMemoryBudget(0);
+    cache.paths(makeKey(0.01, samples), [&calls]() { return makePaths(samples, calls); });
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+
+    // budget for two entries
+    cache.setMemoryBudget(2 * pathMemory);
+    auto p1 = cache.paths(makeKey(0.01, samples), [&calls]() { return makePaths(samples, calls); });
+    auto p2 = cache.paths(makeKey(0.01, samples), [&calls]() { return makePaths(samples, calls); });
+    BOOST_CHECK_EQUAL(calls, 2);
+    BOOST_CHECK_EQUAL(p1.get(), p2.get());
+    BOOST_CHECK_EQUAL(cache.hits(), 1);
+    BOOST_CHECK_EQUAL(cache.memoryUsage(), pathMemory);
+
+    // a different step std dev is a different key
+    cache.paths(makeKey(0.02, samples), [&calls]() { return makePaths(samples, calls); });
+    BOOST_CHECK_EQUAL(calls, 3);
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+
+    // touch the first entry, so that the second one is evicted by the next insertion
+    cache.paths(makeKey(0.01, samples), [&calls]() { return makePaths(samples, calls); });
+    cache.paths(makeKey(0.03, samples), [&calls]() { return makePaths(samples, calls); });
+    BOOST_CHECK_EQUAL(calls, 4);
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+    BOOST_CHECK_EQUAL(cache.memoryUsage(), 2 * pathMemory);
+    cache.paths(makeKey(0.01, samples), [&calls]() { return makePaths(samples, calls); });
+    BOOST_CHECK_EQUAL(calls, 4);
+    cache.paths(makeKey(0.02, samples), [&calls]() { return makePaths(samples, calls); });
+    BOOST_CHECK_EQUAL(calls, 5);
+
+    // the evicted paths stay valid for their holders
+    BOOST_CHECK_EQUAL(p1->size(), 2);
+    BOOST_CHECK_EQUAL((*p1)[1][0].at(samples - 1), 1.0);
+
+    cache.clear();
+    cache.setMemoryBudget(0);
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+    BOOST_CHECK_EQUAL(cache.memoryUsage(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,80 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+// clang-format off
+#include <boost/test/unit_test.hpp>
+// clang-format on
+
+#include <qle/methods/batchmultipathgenerator.hpp>
+#include <qle/models/irlgm1fconstantparametrization.hpp>
+#include <qle/processes/irlgm1fstateprocess.hpp>
+
+#include "toplevelfixture.hpp"
+
+#include <ql/currencies/europe.hpp>
+#include <ql/processes/ornsteinuhlenbeckprocess.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+
+using namespace QuantLib;
+using namespace QuantExt;
+
+using namespace boost::unit_test_framework;
+
+BOOST_FIXTURE_TEST_SUITE(QuantExtTestSuite, qle::test::TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(BatchMultiPathGeneratorTest)
+
+BOOST_AUTO_TEST_CASE(testConsistencyWithMultiPathGenerator) {
+
+    BOOST_TEST_MESSAGE("Testing batch multi path generator against multi path generator...");
+
+    Handle<YieldTermStructure> yts(QuantLib::ext::make_shared<FlatForward>(0, NullCalendar(), 0.02, Actual365Fixed()));
+    auto lgmProcess = QuantLib::ext::make_shared<IrLgm1fStateProcess>(
+        QuantLib::ext::make_shared<IrLgm1fConstantParametrization>(EURCurrency(), yts, 0.01, 0.01));
+    auto ouProcess = QuantLib::ext::make_shared<OrnsteinUhlenbeckProcess>(0.1, 0.2, 0.05, 0.03);
+
+    std::vector<Real> times{0.5, 1.0, 2.0, 3.5, 5.0, 10.0};
+    TimeGrid grid(times.begin(), times.end());
+    Size samples = 100;
+
+    for (auto const& process : std::vector<QuantLib::ext::shared_ptr<StochasticProcess>>{lgmProcess, ouProcess}) {
+        for (auto s : {MersenneTwister, MersenneTwisterAntithetic, Sobol, Burley2020Sobol, SobolBrownianBridge,
+                       Burley2020SobolBrownianBridge}) {
+            // seed 0 draws a random seed in the generators, so the two would not match
+            for (BigNatural seed : {1, 42}) {
+                BatchMultiPathGenerator batchGen(s, process, grid, seed);
+                auto pathGen = makeMultiPathGenerator(s, process, grid, seed);
+                std::vector<std::vector<RandomVariable>> paths(grid.size() - 1,
+                                                               std::vector<RandomVariable>(1, RandomVariable(samples)));
+                batchGen.next(paths);
+                for (Size i = 0; i < samples; ++i) {
+                    const MultiPath& p = pathGen->next().value;
+                    for (Size j = 0; j < grid.size() - 1; ++j) {
+                        BOOST_CHECK_SMALL(paths[j][0][i] - p[0][j + 1], 1.0E-12);
+                    }
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
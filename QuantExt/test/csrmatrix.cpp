@@ -0,0 +1,111 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+// clang-format off
+#include <boost/test/unit_test.hpp>
+// clang-format on
+
+#include <qle/math/csrmatrix.hpp>
+
+#include "toplevelfixture.hpp"
+
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+
+using namespace QuantLib;
+using namespace QuantExt;
+
+using namespace boost::unit_test_framework;
+
+BOOST_FIXTURE_TEST_SUITE(QuantExtTestSuite, qle::test::TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(CsrMatrixTest)
+
+namespace {
+SparseMatrix randomSparseMatrix(Size rows, Size columns, Real density, MersenneTwisterUniformRng& mt) {
+    SparseMatrix m(rows, columns);
+    for (Size i = 0; i < rows; ++i) {
+        for (Size j = 0; j < columns; ++j) {
+            if (mt.nextReal() < density)
+                m(i, j) = mt.nextReal() - 0.5;
+        }
+    }
+    return m;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(testConstructionAndTranspose) {
+    BOOST_TEST_MESSAGE("Test CSR matrix construction and transposition");
+
+    MersenneTwisterUniformRng mt(42);
+    SparseMatrix m = randomSparseMatrix(20, 30, 0.2, mt);
+    CsrMatrix a(m);
+    CsrMatrix at = a.transpose();
+
+    BOOST_CHECK_EQUAL(a.rows(), 20);
+    BOOST_CHECK_EQUAL(a.columns(), 30);
+    BOOST_CHECK_EQUAL(at.rows(), 30);
+    BOOST_CHECK_EQUAL(at.columns(), 20);
+    BOOST_CHECK_EQUAL(a.nonZeros(), at.nonZeros());
+
+    for (Size i = 0; i < 20; ++i) {
+        for (Size j = 0; j < 30; ++j) {
+            BOOST_CHECK_EQUAL(a(i, j), m(i, j));
+            BOOST_CHECK_EQUAL(at(j, i), m(i, j));
+        }
+    }
+
+    BOOST_CHECK_THROW(CsrMatrix(2, 2, {0, 2, 2}, {1, 0}, {1.0, 2.0}), QuantLib::Error);
+} // testConstructionAndTranspose
+
+BOOST_AUTO_TEST_CASE(testProducts) {
+    BOOST_TEST_MESSAGE("Test CSR matrix vector and matrix matrix products");
+
+    MersenneTwisterUniformRng mt(42);
+    SparseMatrix ma = randomSparseMatrix(50, 40, 0.1, mt);
+    SparseMatrix mb = randomSparseMatrix(40, 30, 0.1, mt);
+    CsrMatrix a(ma), b(mb);
+
+    Array x(40);
+    for (Size i = 0; i < 40; ++i)
+        x[i] = mt.nextReal();
+    Array y = a * x;
+    for (Size i = 0; i < 50; ++i) {
+        Real ex = 0.0;
+        for (Size k = 0; k < 40; ++k)
+            ex += ma(i, k) * x[k];
+        BOOST_CHECK_SMALL(y[i] - ex, 1E-14);
+    }
+
+    CsrMatrix c1 = multiply(a, b);
+    CsrMatrix c4 = multiply(a, b, 4);
+    BOOST_CHECK_EQUAL(c1.nonZeros(), c4.nonZeros());
+    for (Size i = 0; i < 50; ++i) {
+        for (Size j = 0; j < 30; ++j) {
+            Real ex = 0.0;
+            for (Size k = 0; k < 40; ++k)
+                ex += ma(i, k) * mb(k, j);
+            BOOST_CHECK_SMALL(c1(i, j) - ex, 1E-14);
+            // the result must not depend on the number of threads
+            BOOST_CHECK_EQUAL(c1(i, j), c4(i, j));
+        }
+    }
+} // testProducts
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,115 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+// clang-format off
+#include <boost/test/unit_test.hpp>
+// clang-format on
+
+#include <qle/models/irlgm1fconstantparametrization.hpp>
+#include <qle/models/lgmconvolutionsolver2.hpp>
+#include <qle/pricingengines/numericlgmmultilegoptionengine.hpp>
+
+#include "toplevelfixture.hpp"
+
+#include <ql/currencies/europe.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/instruments/swaption.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+
+using namespace QuantLib;
+using namespace QuantExt;
+
+using namespace boost::unit_test_framework;
+
+BOOST_FIXTURE_TEST_SUITE(QuantExtTestSuite, qle::test::TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(LgmConvolutionSolverTest)
+
+BOOST_AUTO_TEST_CASE(testRollbackAccuracy) {
+
+    BOOST_TEST_MESSAGE("Testing LGM convolution solver rollback (direct and FFT) against analytic expectation...");
+
+    Handle<YieldTermStructure> yts(QuantLib::ext::make_shared<FlatForward>(0, NullCalendar(), 0.02, Actual365Fixed()));
+    auto lgm = QuantLib::ext::make_shared<LinearGaussMarkovModel>(
+        QuantLib::ext::make_shared<IrLgm1fConstantParametrization>(EURCurrency(), yts, 0.01, 0.01));
+
+    // E[exp(a x(t1)) | x(t0)] = exp(a x(t0) + a^2 (zeta(t1) - zeta(t0)) / 2)
+    Real a = 20.0;
+    std::vector<std::pair<Real, Real>> steps = {{1.0, 2.0}, {5.0, 10.0}, {9.0, 10.0}, {0.5, 10.0}};
+
+    for (auto method : {LgmConvolutionSolver2::Method::Direct, LgmConvolutionSolver2::Method::FFT}) {
+        LgmConvolutionSolver2 solver(lgm, 7.0, 16, 7.0, 32, method);
+        for (auto const& s : steps) {
+            Real z0 = lgm->parametrization()->zeta(s.first), z1 = lgm->parametrization()->zeta(s.second);
+            RandomVariable x1 = solver.stateGrid(s.second), x0 = solver.stateGrid(s.first);
+            RandomVariable v = exp(RandomVariable(x1.size(), a) * x1);
+            RandomVariable r = solver.rollback(v, s.second, s.first);
+            for (Size k = 0; k < x0.size(); ++k) {
+                // the grid is truncated at 7 standard deviations, we check the center only
+                if (std::abs(x0[k]) > 3.0 * std::sqrt(z0))
+                    continue;
+                Real expected = std::exp(a * x0[k] + 0.5 * a * a * (z1 - z0));
+                BOOST_CHECK_SMALL(r[k] / expected - 1.0, 2.0E-4);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testBermudanSwaptionFftVsDirect) {
+
+    BOOST_TEST_MESSAGE("Testing LGM convolution solver on bermudan swaptions, direct vs FFT...");
+
+    Date evalDate(12, January, 2015);
+    Settings::instance().evaluationDate() = evalDate;
+    Handle<YieldTermStructure> yts(QuantLib::ext::make_shared<FlatForward>(evalDate, 0.02, Actual365Fixed()));
+    auto euribor6m = QuantLib::ext::make_shared<Euribor>(6 * Months, yts);
+    auto lgm = QuantLib::ext::make_shared<LinearGaussMarkovModel>(
+        QuantLib::ext::make_shared<IrLgm1fConstantParametrization>(EURCurrency(), yts, 0.0070, 0.03));
+
+    // fine grids as used for sensitivities
+    auto directEngine = QuantLib::ext::make_shared<NumericLgmSwaptionEngine>(
+        lgm, 7.0, 32, 7.0, 64, yts, 24, LgmConvolutionSolver2::Method::Direct);
+    auto fftEngine = QuantLib::ext::make_shared<NumericLgmSwaptionEngine>(lgm, 7.0, 32, 7.0, 64, yts, 24,
+                                                                          LgmConvolutionSolver2::Method::FFT);
+
+    for (Size i = 0; i < 5; ++i) {
+        Real strike = 0.01 + 0.004 * static_cast<Real>(i);
+        QuantLib::ext::shared_ptr<VanillaSwap> swap = MakeVanillaSwap(20 * Years, euribor6m, strike, 1 * Years)
+                                                          .withFixedLegTenor(1 * Years)
+                                                          .withNominal(1.0);
+        std::vector<Date> exerciseDates;
+        for (Size j = 1; j < swap->fixedSchedule().size() - 1; ++j)
+            exerciseDates.push_back(TARGET().advance(swap->fixedSchedule()[j], -2 * Days));
+        Swaption swaption(swap, QuantLib::ext::make_shared<BermudanExercise>(exerciseDates));
+        swaption.setPricingEngine(directEngine);
+        Real npvDirect = swaption.NPV();
+        swaption.setPricingEngine(fftEngine);
+        Real npvFft = swaption.NPV();
+        BOOST_TEST_MESSAGE("strike " << strike << " npv direct " << npvDirect << " fft " << npvFft << " diff "
+                                     << npvFft - npvDirect);
+        BOOST_CHECK_SMALL(npvFft - npvDirect, 2.0E-5);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+// clang-format off
+#include <boost/test/unit_test.hpp>
+// clang-format on
+
+#include <qle/models/irlgm1fconstantparametrization.hpp>
+#include <qle/models/lgmfdsolver.hpp>
+
+#include "toplevelfixture.hpp"
+
+#include <ql/currencies/europe.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+
+using namespace QuantLib;
+using namespace QuantExt;
+
+using namespace boost::unit_test_framework;
+
+BOOST_FIXTURE_TEST_SUITE(QuantExtTestSuite, qle::test::TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(LgmFdSolverTest)
+
+BOOST_AUTO_TEST_CASE(testBatchedRollback) {
+
+    BOOST_TEST_MESSAGE("Testing LGM fd solver batched rollback against single rollbacks...");
+
+    Handle<YieldTermStructure> yts(QuantLib::ext::make_shared<FlatForward>(0, NullCalendar(), 0.02, Actual365Fixed()));
+    auto lgm = QuantLib::ext::make_shared<LinearGaussMarkovModel>(
+        QuantLib::ext::make_shared<IrLgm1fConstantParametrization>(EURCurrency(), yts, 0.01, 0.01));
+
+    LgmFdSolver solver(lgm, 20.0);
+    std::vector<std::pair<Real, Real>> steps = {{1.0, 2.0}, {5.0, 10.0}, {0.0, 3.0}};
+
+    for (auto const& s : steps) {
+        RandomVariable x1 = solver.stateGrid(s.second);
+        std::vector<RandomVariable> v = {exp(RandomVariable(x1.size(), 20.0) * x1), RandomVariable(x1.size(), 1.0),
+                                         max(x1, RandomVariable(x1.size(), 0.0))};
+        std::vector<RandomVariable> batch = solver.rollback(v, s.second, s.first);
+        BOOST_REQUIRE_EQUAL(batch.size(), v.size());
+        for (Size i = 0; i < v.size(); ++i) {
+            RandomVariable single = solver.rollback(v[i], s.second, s.first);
+            BOOST_REQUIRE_EQUAL(batch[i].size(), single.size());
+            for (Size k = 0; k < single.size(); ++k)
+                BOOST_CHECK_SMALL((batch[i][k] - single[k]) / std::max(1.0, std::abs(single[k])), 1.0E-10);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,128 @@
+/*
+ Copyright (C) 2024 Growth Mindset Pty Ltd
+ All rights reserved.
+
+ This file is part of VRE, a free-software/open-source library
+ for transparent pricing and risk analysis
+
+ VRE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include "toplevelfixture.hpp"
+#include <boost/test/unit_test.hpp>
+#include <ql/currencies/america.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/credit/flathazardrate.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <qle/models/poollossmodel.hpp>
+
+using namespace QuantLib;
+using namespace QuantExt;
+using namespace boost::unit_test_framework;
+
+namespace {
+
+struct PoolData {
+    PoolData() : correlation(QuantLib::ext::make_shared<SimpleQuote>(0.3)) {
+        refDate = Settings::instance().evaluationDate();
+        pool = QuantLib::ext::make_shared<Pool>();
+        for (Size i = 0; i < 3; ++i) {
+            names.push_back("NAME_" + std::to_string(i));
+            notionals.push_back(1.0E6);
+            recoveries.push_back(0.4);
+            hazardRates.push_back(QuantLib::ext::make_shared<SimpleQuote>(0.01 * (i + 1)));
+            Handle<DefaultProbabilityTermStructure> curve(
+                QuantLib::ext::make_shared<FlatHazardRate>(refDate, Handle<Quote>(hazardRates.back()), Actual365Fixed()));
+            DefaultProbKey key = NorthAmericaCorpDefaultKey(USDCurrency(), SeniorSec, Period(), 1.0);
+            Issuer issuer(std::vector<std::pair<DefaultProbKey, Handle<DefaultProbabilityTermStructure>>>(
+                              1, std::make_pair(key, curve)),
+                          DefaultEventSet());
+            pool->add(names.back(), issuer, key);
+        }
+    }
+
+    // a new tranche with a new loss model on the same pool and market quotes
+    QuantLib::ext::shared_ptr<QuantExt::Basket> basket() const {
+        auto copula = QuantLib::ext::make_shared<ExtendedGaussianConstantLossLM>(
+            Handle<Quote>(correlation), recoveries, std::vector<std::vector<Real>>(),
+            std::vector<std::vector<Real>>(), LatentModelIntegrationType::GaussianQuadrature, names.size(),
+            GaussianCopulaPolicy::initTraits());
+        auto model = QuantLib::ext::make_shared<GaussPoolLossModel>(true, copula, 100, 5.0, -5.0, 50, false, false);
+        auto basket = QuantLib::ext::make_shared<QuantExt::Basket>(refDate, names, notionals, pool, 0.0, 0.1);
+        basket->setLossModel(model);
+        return basket;
+    }
+
+    Date refDate;
+    std::vector<std::string> names;
+    std::vector<Real> notionals, recoveries;
+    std::vector<QuantLib::ext::shared_ptr<SimpleQuote>> hazardRates;
+    QuantLib::ext::shared_ptr<SimpleQuote> correlation;
+    QuantLib::ext::shared_ptr<Pool> pool;
+};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(QuantExtTestSuite, qle::test::TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(PoolLossModelTest)
+
+BOOST_AUTO_TEST_CASE(testCachedDistribution) {
+
+    BOOST_TEST_MESSAGE("Testing that the pool loss model reuses its loss distribution for unchanged inputs...");
+
+    Settings::instance().evaluationDate() = Date(15, March, 2024);
+    PoolData data;
+    auto basket = data.basket();
+    Date d = data.refDate + 5 * Years;
+
+    Real etl = basket->expectedTrancheLoss(d);
+    BOOST_CHECK(etl > 0.0);
+    BOOST_CHECK_EQUAL(basket->expectedTrancheLoss(d), etl);
+    BOOST_CHECK_EQUAL(basket->expectedTrancheLoss(d), data.basket()->expectedTrancheLoss(d));
+}
+
+BOOST_AUTO_TEST_CASE(testCorrelationChange) {
+
+    BOOST_TEST_MESSAGE("Testing that the pool loss model rebuilds its loss distribution on a correlation change...");
+
+    Settings::instance().evaluationDate() = Date(15, March, 2024);
+    PoolData data;
+    auto basket = data.basket();
+    Date d = data.refDate + 5 * Years;
+
+    Real etl = basket->expectedTrancheLoss(d);
+    data.correlation->setValue(0.6);
+    Real bumpedEtl = basket->expectedTrancheLoss(d);
+    BOOST_CHECK(std::fabs(bumpedEtl - etl) > 1.0);
+    BOOST_CHECK_CLOSE(bumpedEtl, data.basket()->expectedTrancheLoss(d), 1.0E-10);
+}
+
+BOOST_AUTO_TEST_CASE(testDefaultProbabilityChange) {
+
+    BOOST_TEST_MESSAGE("Testing that the pool loss model rebuilds its loss distribution on a default probability "
+                       "change...");
+
+    Settings::instance().evaluationDate() = Date(15, March, 2024);
+    PoolData data;
+    auto basket = data.basket();
+    Date d = data.refDate + 5 * Years;
+
+    Real etl = basket->expectedTrancheLoss(d);
+    data.hazardRates[1]->setValue(0.05);
+    Real bumpedEtl = basket->expectedTrancheLoss(d);
+    BOOST_CHECK(bumpedEtl > etl);
+    BOOST_CHECK_CLOSE(bumpedEtl, data.basket()->expectedTrancheLoss(d), 1.0E-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
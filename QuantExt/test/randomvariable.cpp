@@ -27,6 +27,7 @@
 #include <qle/math/randomvariable.hpp>
 
 #include <ql/time/date.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 
 #include <boost/math/distributions/normal.hpp>
@@ -162,6 +163,40 @@ BOOST_AUTO_TEST_CASE(testFunctions) {
     BOOST_CHECK_CLOSE((normalPdf(X)).at(0), boost::math::pdf(n, x), tol);
 }
 
+BOOST_AUTO_TEST_CASE(testRegressionFactorisation) {
+    BOOST_TEST_MESSAGE("Testing regression factorisation...");
+
+    const Size n = 1000;
+    MersenneTwisterUniformRng rng(42);
+    RandomVariable x(n), y(n), r1(n), r2(n);
+    for (Size i = 0; i < n; ++i) {
+        x.set(i, rng.nextReal() - 0.5);
+        y.set(i, rng.nextReal() - 0.5);
+        r1.set(i, 1.0 + 2.0 * x[i] - y[i] * y[i] + 0.1 * (rng.nextReal() - 0.5));
+        r2.set(i, std::max(x[i] + y[i], 0.0));
+    }
+    std::vector<const RandomVariable*> regressor = {&x, &y};
+    auto basisFns = multiPathBasisSystem(2, 3, LsmBasisSystem::Monomial);
+
+    // one factorisation, several regressands, w/o and with filter
+    RegressionFactorisation f(regressor, basisFns);
+    Filter filter = x > RandomVariable(n, 0.0);
+    RegressionFactorisation ff(regressor, basisFns, filter);
+
+    for (auto const& r : {r1, r2, RandomVariable(n, 3.0)}) {
+        Array c = f.solve(r);
+        Array cref = regressionCoefficients(r, regressor, basisFns);
+        Array cf = ff.solve(r);
+        Array cfref = regressionCoefficients(r, regressor, basisFns, filter);
+        BOOST_REQUIRE_EQUAL(c.size(), cref.size());
+        BOOST_REQUIRE_EQUAL(cf.size(), cfref.size());
+        for (Size i = 0; i < c.size(); ++i) {
+            BOOST_CHECK_SMALL(c[i] - cref[i], 1E-10);
+            BOOST_CHECK_SMALL(cf[i] - cfref[i], 1E-10);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testBlack) {
     BOOST_TEST_MESSAGE("Testing black formula...");
 